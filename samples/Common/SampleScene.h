@@ -9,13 +9,17 @@ typedef enum
     SampleSceneNodeType_Mesh = 1
 } SampleSceneNodeType;
 
-typedef struct
+#define SAMPLE_SCENE_SECTION_ID(a, b, c, d) ((uint32_t)(a) | ((uint32_t)(b) << 8) | ((uint32_t)(c) << 16) | ((uint32_t)(d) << 24))
+
+// NOTE: Sections of the scene container. The element count of each section gives the number of items.
+typedef enum
 {
-    char FileId[5];
-    uint32_t MeshCount;
-    uint32_t NodeCount;
-    uint32_t MaterialCount;
-} SampleSceneHeader;
+    SampleSceneSection_Materials = SAMPLE_SCENE_SECTION_ID('M', 'A', 'T', 'L'),
+    SampleSceneSection_Nodes = SAMPLE_SCENE_SECTION_ID('N', 'O', 'D', 'E'),
+    SampleSceneSection_Meshes = SAMPLE_SCENE_SECTION_ID('M', 'E', 'S', 'H'),
+    SampleSceneSection_MeshPrimitives = SAMPLE_SCENE_SECTION_ID('M', 'P', 'R', 'M'),
+    SampleSceneSection_MeshData = SAMPLE_SCENE_SECTION_ID('M', 'D', 'A', 'T')
+} SampleSceneSection;
 
 typedef struct
 {
@@ -40,7 +44,10 @@ typedef struct
 {
     char Name[50];
     // TODO: Vertex size, etc.
+    // Index of the first primitive in the mesh primitives section.
+    uint32_t MeshPrimitiveOffset;
     uint32_t MeshPrimitiveCount;
+    // Offset in the mesh data section.
     uint32_t MeshBufferOffset;
     uint32_t MeshBufferSizeInBytes;
 } SampleMeshHeader;
@@ -51,13 +58,9 @@ typedef struct
     uint32_t MeshletCount;
     uint32_t VertexBufferOffset;
     uint32_t MeshletOffset;
+    uint32_t MeshletBoundsOffset;
+    uint32_t MeshletLodOffset;
     uint32_t MeshletVertexIndexOffset;
     uint32_t MeshletTriangleIndexOffset;
     int32_t MaterialId;
 } SampleMeshPrimitiveHeader;
-
-typedef struct
-{
-    uint32_t Offset;
-    uint32_t SizeInBytes;
-} SampleDataBlockEntry;
@@ -9,17 +9,20 @@
 // TODO: The struct here are temporary. The final data will be placed in buffer
 typedef struct 
 {
-    const char* Path;
     SampleMeshHeader MeshHeader;
+    // NOTE: Points directly into the scene container mapping
     SampleMeshPrimitiveHeader* MeshPrimitives;
+    ElemDataSpan MeshBufferData;
     SampleGpuBuffer MeshBuffer;
 } SampleMeshData;
 
 typedef struct
 {
     const char* Path;
-    SampleTextureHeader TextureHeader;
-    SampleTextureDataBlockEntry* MipDataEntries;
+    ElemTextureContainer TextureContainer;
+    ElemTextureContainerInfo TextureInfo;
+    // NOTE: Smallest mip level uploaded to the GPU texture. Equals to the mip count when nothing is uploaded.
+    uint32_t ResidentMipLevel;
     SampleGpuTexture GpuTexture;
     bool IsLoaded;
 } SampleTextureData;
@@ -48,6 +51,7 @@ typedef struct
     uint32_t NodeCount;
     SampleSceneNodeHeader* Nodes;
     SampleGpuBuffer MaterialBuffer;
+    ElemSceneContainer SceneContainer;
 } SampleSceneData;
 
 // TODO: Change that. For now we use that simple implementation
@@ -55,27 +59,20 @@ typedef struct
 SampleTextureData TextureCache[MAX_TEXTURE_COUNT];
 uint32_t CurrentTextureCacheIndex = 0u;
 
-void SampleLoadMesh(const char* path, uint32_t offset, SampleMeshData* meshData)
+void SampleLoadMesh(ElemSceneContainer sceneContainer, uint32_t meshIndex, SampleMeshData* meshData)
 {
     *meshData = (SampleMeshData){};
-    meshData->Path = path;
 
-    FILE* file = SampleOpenFile(path, true);
-    assert(file);
+    ElemSceneContainerSection meshSection = ElemGetSceneContainerSection(sceneContainer, SampleSceneSection_Meshes);
+    ElemSceneContainerSection meshPrimitiveSection = ElemGetSceneContainerSection(sceneContainer, SampleSceneSection_MeshPrimitives);
+    ElemSceneContainerSection meshDataSection = ElemGetSceneContainerSection(sceneContainer, SampleSceneSection_MeshData);
 
-    if (offset > 0)
-    {
-        fseek(file, offset, SEEK_SET);
-    }
-    
-    fread(&meshData->MeshHeader, sizeof(SampleMeshHeader), 1, file);
+    assert(meshIndex < meshSection.ElementCount);
+    meshData->MeshHeader = ((SampleMeshHeader*)meshSection.Data.Items)[meshIndex];
+    meshData->MeshPrimitives = &((SampleMeshPrimitiveHeader*)meshPrimitiveSection.Data.Items)[meshData->MeshHeader.MeshPrimitiveOffset];
 
-    // TODO: Can we get rid of the malloc?
-
-    meshData->MeshPrimitives = (SampleMeshPrimitiveHeader*)malloc(sizeof(SampleMeshPrimitiveHeader) * meshData->MeshHeader.MeshPrimitiveCount);
-    fread(meshData->MeshPrimitives, sizeof(SampleMeshPrimitiveHeader), meshData->MeshHeader.MeshPrimitiveCount, file);
-
-    fclose(file);
+    assert(meshData->MeshHeader.MeshBufferOffset + meshData->MeshHeader.MeshBufferSizeInBytes <= meshDataSection.Data.Length);
+    meshData->MeshBufferData = (ElemDataSpan) { .Items = meshDataSection.Data.Items + meshData->MeshHeader.MeshBufferOffset, .Length = meshData->MeshHeader.MeshBufferSizeInBytes };
 }
 
 // TODO: We should be able to replace this whole function with IO Queues
@@ -84,26 +81,15 @@ void SampleLoadMeshData(ElemCommandList commandList, SampleMeshData* meshData, S
     // TODO: Construct debug name
     meshData->MeshBuffer = SampleCreateGpuBuffer(gpuMemory, meshData->MeshHeader.MeshBufferSizeInBytes, meshData->MeshHeader.Name);
 
-    // TODO: To replace with file IO 
-    assert(meshData->Path);
-    uint8_t* meshBufferData = (uint8_t*)malloc(sizeof(uint8_t) * meshData->MeshHeader.MeshBufferSizeInBytes);
-
-    FILE* file = SampleOpenFile(meshData->Path, true);
-    assert(file);
-
-    fseek(file, meshData->MeshHeader.MeshBufferOffset, SEEK_SET);
-    fread(meshBufferData, sizeof(uint8_t), meshData->MeshHeader.MeshBufferSizeInBytes, file);
-    fclose(file);
-
+    // NOTE: The data is copied from the file mapping, the pages are loaded by the OS on first access.
     ElemCopyDataToGraphicsResourceParameters copyParameters =
     {
         .Resource = meshData->MeshBuffer.Buffer,
         .SourceType = ElemCopyDataSourceType_Memory,
-        .SourceMemoryData = { .Items = (uint8_t*)meshBufferData, .Length = meshData->MeshHeader.MeshBufferSizeInBytes } 
+        .SourceMemoryData = meshData->MeshBufferData
     };
 
     ElemCopyDataToGraphicsResource(commandList, &copyParameters);
-    free(meshBufferData);
 }
 
 void SampleFreeMesh(SampleMeshData* meshData)
@@ -112,8 +98,29 @@ void SampleFreeMesh(SampleMeshData* meshData)
     {
         SampleFreeGpuBuffer(&meshData->MeshBuffer);
     }
+}
 
-    // TODO: Free mallocs
+ElemGraphicsFormat SampleGetTextureGraphicsFormat(ElemGraphicsFormat format, bool isSrgb)
+{
+    if (!isSrgb)
+    {
+        return format;
+    }
+
+    switch (format)
+    {
+        case ElemGraphicsFormat_BC1:
+            return ElemGraphicsFormat_BC1_SRGB;
+
+        case ElemGraphicsFormat_BC3:
+            return ElemGraphicsFormat_BC3_SRGB;
+
+        case ElemGraphicsFormat_BC7:
+            return ElemGraphicsFormat_BC7_SRGB;
+
+        default:
+            return format;
+    }
 }
 
 void SampleLoadTexture(const char* path, SampleTextureData** textureDataPointer, SampleGpuMemory* gpuMemory, bool isSrgb)
@@ -151,59 +158,55 @@ void SampleLoadTexture(const char* path, SampleTextureData** textureDataPointer,
     strcpy(tmp, path);
     textureData->Path = tmp;
 
-    FILE* file = SampleOpenFile(path, true);
+    textureData->TextureContainer = ElemOpenTextureContainer(path);
 
-    if (!file)
+    if (textureData->TextureContainer == ELEM_HANDLE_NULL)
     {
         printf("NO TEXT: %s\n", path);
         return;
     }
-    assert(file);
-    
-    fread(&textureData->TextureHeader, sizeof(SampleTextureHeader), 1, file);
-
-    textureData->MipDataEntries = (SampleTextureDataBlockEntry*)malloc(sizeof(SampleTextureDataBlockEntry) * textureData->TextureHeader.MipCount);
-    fread(textureData->MipDataEntries, sizeof(SampleTextureDataBlockEntry), textureData->TextureHeader.MipCount, file);
 
-    fclose(file);
+    textureData->TextureInfo = ElemGetTextureContainerInfo(textureData->TextureContainer);
+    textureData->ResidentMipLevel = textureData->TextureInfo.MipLevels;
 
     // TODO: For now we create the texture here but later, we should do it on the fly and update the material buffer
     // TODO: Get texture name without folder and extension
-    // TODO: Get the correct format
-
-    // TODO: We need to take into account the format of the texture
-    ElemGraphicsFormat format = isSrgb ? ElemGraphicsFormat_BC7_SRGB : ElemGraphicsFormat_BC7;
-    textureData->GpuTexture = SampleCreateGpuTexture(gpuMemory, textureData->TextureHeader.Width, textureData->TextureHeader.Height, textureData->TextureHeader.MipCount, format, textureData->Path);
+    ElemGraphicsFormat format = SampleGetTextureGraphicsFormat(textureData->TextureInfo.Format, isSrgb);
+    textureData->GpuTexture = SampleCreateGpuTexture(gpuMemory, textureData->TextureInfo.Width, textureData->TextureInfo.Height, textureData->TextureInfo.MipLevels, format, textureData->Path);
 }
 
-// TODO: In the future we will need to load individual mips from disk
-void SampleLoadTextureData(ElemCommandList commandList, SampleTextureData* textureData, SampleGpuMemory* gpuMemory)
+// NOTE: Uploads the mips from the smallest one that is not resident down to firstMipLevel. The mip data is read
+// directly from the container mapping so only the requested mips are loaded from the disk.
+void SampleLoadTextureMips(ElemCommandList commandList, SampleTextureData* textureData, uint32_t firstMipLevel)
 {
-    assert(textureData->Path);
+    assert(textureData->TextureContainer != ELEM_HANDLE_NULL);
 
-    // TODO: Replace that with file logic
-    for (uint32_t i = 0; i < textureData->TextureHeader.MipCount; i++)
+    while (textureData->ResidentMipLevel > firstMipLevel)
     {
-        SampleTextureDataBlockEntry mipEntry = textureData->MipDataEntries[i];
-        uint8_t* mipData = (uint8_t*)malloc(sizeof(uint8_t) * mipEntry.SizeInBytes);
-
-        FILE* file = SampleOpenFile(textureData->Path, true);
-        assert(file);
-
-        fseek(file, mipEntry.Offset, SEEK_SET);
-        fread(mipData, sizeof(uint8_t), mipEntry.SizeInBytes, file);
-        fclose(file);
+        ElemTextureContainerMip mip = ElemGetTextureContainerMip(textureData->TextureContainer, textureData->ResidentMipLevel - 1);
 
         ElemCopyDataToGraphicsResourceParameters copyParameters =
         {
             .Resource = textureData->GpuTexture.Texture,
-            .TextureMipLevel = i,
+            .TextureMipLevel = mip.MipLevel,
             .SourceType = ElemCopyDataSourceType_Memory,
-            .SourceMemoryData = { .Items = (uint8_t*)mipData, .Length = mipEntry.SizeInBytes } 
+            .SourceMemoryData = mip.Data
         };
 
         ElemCopyDataToGraphicsResource(commandList, &copyParameters);
-        free(mipData);
+        textureData->ResidentMipLevel--;
+    }
+}
+
+void SampleLoadTextureData(ElemCommandList commandList, SampleTextureData* textureData, SampleGpuMemory* gpuMemory)
+{
+    assert(textureData->Path);
+
+    // TODO: Upload only the lowest mips here and request the others based on the screen coverage once the shaders
+    // can clamp the sampled mip level.
+    if (textureData->TextureContainer != ELEM_HANDLE_NULL)
+    {
+        SampleLoadTextureMips(commandList, textureData, 0);
     }
 
     // TODO: This is not true, the data will be loaded when the command list is executed
@@ -216,6 +219,11 @@ void SampleFreeTexture(SampleTextureData* textureData)
     {
         SampleFreeGpuTexture(&textureData->GpuTexture);
     }
+
+    if (textureData->TextureContainer != ELEM_HANDLE_NULL)
+    {
+        ElemCloseTextureContainer(textureData->TextureContainer);
+    }
     // TODO: Free mallocs
 }
 
@@ -272,63 +280,56 @@ void SampleFreeMaterial(SampleMaterialData* materialData)
 
 void SampleLoadScene(const char* path, SampleSceneData* sceneData, SampleGpuMemory* gpuMemory)
 {
-    // TODO: When IOQueues are implemented, we only need to read the header, not the whole file!
+    *sceneData = (SampleSceneData){};
 
-    FILE* file = SampleOpenFile(path, true);
-    assert(file);
+    char absolutePath[MAX_PATH];
+    SampleGetFullPath(absolutePath, path, true);
 
-    SampleSceneHeader sceneHeader;
-    fread(&sceneHeader, sizeof(sceneHeader), 1, file);
+    // NOTE: The container is memory mapped, only the pages that are accessed are read from disk.
+    sceneData->SceneContainer = ElemOpenSceneContainer(absolutePath);
 
-    if (!(sceneHeader.FileId[0] == 'S' && sceneHeader.FileId[1] == 'C' && sceneHeader.FileId[2] == 'E' && sceneHeader.FileId[3] == 'N' && sceneHeader.FileId[4] == 'E'))
+    if (sceneData->SceneContainer == ELEM_HANDLE_NULL)
     {
         printf("ERROR: Wrong scene format\n");
+        return;
     }
-    
-    printf("Scene Loaded: Meshes Count=%d, Material Count=%d, Nodes Count=%d\n", sceneHeader.MeshCount, sceneHeader.MaterialCount, sceneHeader.NodeCount);
-
-    sceneData->MeshCount = sceneHeader.MeshCount;
-    sceneData->MaterialCount = sceneHeader.MaterialCount;
-    sceneData->NodeCount = sceneHeader.NodeCount;
-
-    // TODO: Replace malloc with an utility function that we will replace
-    sceneData->Meshes = (SampleMeshData*)malloc(sizeof(SampleMeshData) * sceneHeader.MeshCount);
 
-    SampleDataBlockEntry* meshDataBlocks = (SampleDataBlockEntry*)malloc(sizeof(SampleDataBlockEntry) * sceneHeader.MeshCount);
-    fread(meshDataBlocks, sizeof(SampleDataBlockEntry), sceneHeader.MeshCount, file);
+    ElemSceneContainerSection materialSection = ElemGetSceneContainerSection(sceneData->SceneContainer, SampleSceneSection_Materials);
+    ElemSceneContainerSection nodeSection = ElemGetSceneContainerSection(sceneData->SceneContainer, SampleSceneSection_Nodes);
+    ElemSceneContainerSection meshSection = ElemGetSceneContainerSection(sceneData->SceneContainer, SampleSceneSection_Meshes);
 
-    sceneData->Materials = (SampleMaterialData*)malloc(sizeof(SampleMaterialData) * sceneHeader.MaterialCount);
-    SampleSceneMaterialHeader* materialHeaders = (SampleSceneMaterialHeader*)malloc(sizeof(SampleSceneMaterialHeader) * sceneHeader.MaterialCount);
-    fread(materialHeaders, sizeof(SampleSceneMaterialHeader), sceneHeader.MaterialCount, file);
+    sceneData->MeshCount = meshSection.ElementCount;
+    sceneData->MaterialCount = materialSection.ElementCount;
+    sceneData->NodeCount = nodeSection.ElementCount;
+    sceneData->Nodes = (SampleSceneNodeHeader*)nodeSection.Data.Items;
 
-    sceneData->Nodes = (SampleSceneNodeHeader*)malloc(sizeof(SampleSceneNodeHeader) * sceneHeader.NodeCount);
-    fread(sceneData->Nodes, sizeof(SampleSceneNodeHeader), sceneHeader.NodeCount, file);
+    printf("Scene Loaded: Meshes Count=%d, Material Count=%d, Nodes Count=%d\n", sceneData->MeshCount, sceneData->MaterialCount, sceneData->NodeCount);
 
-    fclose(file);
+    // TODO: Replace malloc with an utility function that we will replace
+    sceneData->Meshes = (SampleMeshData*)malloc(sizeof(SampleMeshData) * sceneData->MeshCount);
 
     for (uint32_t i = 0; i < sceneData->MeshCount; i++)
     {
-        SampleLoadMesh(path, meshDataBlocks[i].Offset, &sceneData->Meshes[i]);
+        SampleLoadMesh(sceneData->SceneContainer, i, &sceneData->Meshes[i]);
     }
 
     char directoryPath[MAX_PATH];
     GetFileDirectory(path, directoryPath, MAX_PATH);
 
-    if (sceneHeader.MaterialCount > 0)
+    if (sceneData->MaterialCount > 0)
     {
-        ShaderMaterial* shaderMaterials = (ShaderMaterial*)malloc(sizeof(ShaderMaterial) * sceneHeader.MaterialCount);
+        SampleSceneMaterialHeader* materialHeaders = (SampleSceneMaterialHeader*)materialSection.Data.Items;
+        sceneData->Materials = (SampleMaterialData*)malloc(sizeof(SampleMaterialData) * sceneData->MaterialCount);
+        ShaderMaterial* shaderMaterials = (ShaderMaterial*)malloc(sizeof(ShaderMaterial) * sceneData->MaterialCount);
 
         for (uint32_t i = 0; i < sceneData->MaterialCount; i++)
         {
             SampleLoadMaterial(&materialHeaders[i], &sceneData->Materials[i], &shaderMaterials[i], gpuMemory, directoryPath);
         }
 
-        sceneData->MaterialBuffer = SampleCreateGpuBufferAndUploadData(gpuMemory, shaderMaterials, sceneHeader.MaterialCount * sizeof(ShaderMaterial), "MaterialBuffer");
+        sceneData->MaterialBuffer = SampleCreateGpuBufferAndUploadData(gpuMemory, shaderMaterials, sceneData->MaterialCount * sizeof(ShaderMaterial), "MaterialBuffer");
         free(shaderMaterials);
     }
-
-    free(materialHeaders);
-    free(meshDataBlocks);
 }
 
 void SampleFreeScene(SampleSceneData* sceneData)
@@ -347,4 +348,12 @@ void SampleFreeScene(SampleSceneData* sceneData)
     {
         SampleFreeGpuBuffer(&sceneData->MaterialBuffer);
     }
+
+    if (sceneData->SceneContainer != ELEM_HANDLE_NULL)
+    {
+        ElemCloseSceneContainer(sceneData->SceneContainer);
+    }
+
+    free(sceneData->Meshes);
+    free(sceneData->Materials);
 }
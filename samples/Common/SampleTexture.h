@@ -5,20 +5,10 @@
 typedef enum
 {
     SampleTextureFormat_Unknown = 0,
-    SampleTextureFormat_BC7 = 1
+    SampleTextureFormat_BC7 = 1,
+    SampleTextureFormat_BC1 = 2,
+    SampleTextureFormat_BC3 = 3,
+    SampleTextureFormat_BC4 = 4,
+    SampleTextureFormat_BC5 = 5,
+    SampleTextureFormat_BC6H = 6
 } SampleTextureFormat;
-
-typedef struct
-{
-    char FileId[7];
-    SampleTextureFormat Format;
-    uint32_t Width;
-    uint32_t Height;
-    uint32_t MipCount;
-} SampleTextureHeader;
-
-typedef struct
-{
-    uint32_t Offset;
-    uint32_t SizeInBytes;
-} SampleTextureDataBlockEntry;
@@ -468,4 +468,115 @@ void DisplayOutputMessages(const char* prefix, ElemToolsMessageSpan messages)
         fflush(stdout);
     }
 }
+
+// -----------------------------------------------------------------------------
+// Tools Manifest Functions
+// -----------------------------------------------------------------------------
+typedef struct
+{
+    const char* InputPath;
+    const char* OutputPath;
+} SampleManifestEntry;
+
+// NOTE: Each line of the manifest contains the input and the output path separated by spaces. The manifest
+// data is modified in place so the entries point directly into it. Lines starting with # are ignored.
+uint32_t SampleParseManifest(char* manifestData, SampleManifestEntry* entries, uint32_t maxEntryCount)
+{
+    uint32_t entryCount = 0;
+    char* line = manifestData;
+
+    while (*line != '\0' && entryCount < maxEntryCount)
+    {
+        char* lineEnd = line + strcspn(line, "\r\n");
+        char* nextLine = *lineEnd != '\0' ? lineEnd + 1 : lineEnd;
+        *lineEnd = '\0';
+
+        char* inputPath = strtok(line, " \t");
+        char* outputPath = strtok(NULL, " \t");
+        line = nextLine;
+
+        if (inputPath == NULL || inputPath[0] == '#')
+        {
+            continue;
+        }
+
+        if (outputPath == NULL)
+        {
+            printf("Invalid manifest line: %s\n", inputPath);
+            continue;
+        }
+
+        entries[entryCount++] = (SampleManifestEntry) { .InputPath = inputPath, .OutputPath = outputPath };
+    }
+
+    return entryCount;
+}
+
+// -----------------------------------------------------------------------------
+// Tools Cache Functions
+// -----------------------------------------------------------------------------
+#ifdef _WIN32
+#include <direct.h>
+#define SampleMakeDirectory(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define SampleMakeDirectory(path) mkdir(path, 0755)
+#endif
+
+void SampleCreateDirectory(const char* path)
+{
+    char directory[MAX_PATH];
+    memset(directory, 0, MAX_PATH);
+
+    for (uint32_t i = 0; i < strlen(path) && i < MAX_PATH - 1; i++)
+    {
+        directory[i] = path[i] == '\\' ? '/' : path[i];
+
+        if (directory[i] == '/' && i > 0)
+        {
+            SampleMakeDirectory(directory);
+        }
+    }
+
+    SampleMakeDirectory(directory);
+}
+
+void SampleGetCacheFilePath(const char* cacheDirectory, uint64_t hash, const char* extension, char* destination, uint32_t destinationSize)
+{
+    snprintf(destination, destinationSize, "%s%016llx%s", cacheDirectory, (unsigned long long)hash, extension);
+}
+
+// NOTE: The data is written to a temporary file first so an interrupted compilation never leaves
+// a truncated entry in the cache.
+bool SampleWriteCacheFile(const char* path, const void* data, uint32_t sizeInBytes)
+{
+    char temporaryPath[MAX_PATH];
+    snprintf(temporaryPath, MAX_PATH, "%s.tmp", path);
+
+    FILE* file = fopen(temporaryPath, "wb");
+
+    if (file == NULL)
+    {
+        return false;
+    }
+
+    size_t bytesWritten = fwrite(data, 1, sizeInBytes, file);
+    fclose(file);
+
+    if (bytesWritten < sizeInBytes)
+    {
+        remove(temporaryPath);
+        return false;
+    }
+
+    remove(path);
+
+    if (rename(temporaryPath, path) != 0)
+    {
+        remove(temporaryPath);
+        return false;
+    }
+
+    return true;
+}
 #endif
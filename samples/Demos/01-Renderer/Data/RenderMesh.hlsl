@@ -11,10 +11,11 @@ struct ShaderParameters
     uint32_t MeshletTriangleIndexOffset;
     float Scale;
     float3 Translation;
-    uint32_t Reserved;
+    uint32_t MeshletBoundsOffset;
     float4 Rotation;
     uint32_t MaterialId;
     uint32_t TextureSampler;
+    uint32_t MeshletLodOffset;
 };
 
 [[vk::push_constant]]
@@ -24,6 +25,9 @@ struct FrameData
 {
     float4x4 ViewProjMatrix;
     uint32_t ShowMeshlets;
+    float3 CameraPosition;
+    float LodErrorScale;
+    float LodErrorThreshold;
 };
 
 typedef struct
@@ -33,12 +37,41 @@ typedef struct
     float4 AlbedoFactor;
 } ShaderMaterial;
 
-struct ElemMeshlet
+struct ElemEncodedMeshlet
 {
+    uint32_t BaseVertex;
     uint32_t VertexIndexOffset;
-    uint32_t VertexIndexCount;
     uint32_t TriangleOffset;
+    uint32_t PackedCounts;
+};
+
+struct Meshlet
+{
+    uint32_t BaseVertex;
+    uint32_t VertexIndexOffset;
+    uint32_t TriangleOffset;
+    uint32_t VertexIndexCount;
     uint32_t TriangleCount;
+    uint32_t VertexIndexSize;
+};
+
+struct ElemMeshletLodInfo
+{
+    float3 SelfSphereCenter;
+    float SelfSphereRadius;
+    float SelfError;
+    float3 ParentSphereCenter;
+    float ParentSphereRadius;
+    float ParentError;
+    uint32_t LodLevel;
+};
+
+struct MeshletBounds
+{
+    float3 SphereCenter;
+    float SphereRadius;
+    float3 ConeAxis;
+    float ConeCutoff;
 };
 
 // Compress Data
@@ -67,6 +100,122 @@ float3 RotateQuaternion(float3 v, float4 q)
 	return v + 2.0 * cross(q.xyz, cross(q.xyz, v) + q.w * v);
 }
 
+Meshlet LoadMeshlet(ByteAddressBuffer meshBuffer, uint meshletIndex)
+{
+    ElemEncodedMeshlet encodedMeshlet = meshBuffer.Load<ElemEncodedMeshlet>(parameters.MeshletOffset + meshletIndex * sizeof(ElemEncodedMeshlet));
+
+    Meshlet result;
+    result.BaseVertex = encodedMeshlet.BaseVertex;
+    result.VertexIndexOffset = encodedMeshlet.VertexIndexOffset;
+    result.TriangleOffset = encodedMeshlet.TriangleOffset;
+    result.VertexIndexCount = encodedMeshlet.PackedCounts & 0xFF;
+    result.TriangleCount = (encodedMeshlet.PackedCounts >> 8) & 0xFF;
+    result.VertexIndexSize = (encodedMeshlet.PackedCounts >> 16) & 0xFF;
+
+    return result;
+}
+
+uint LoadMeshletVertexIndex(ByteAddressBuffer meshBuffer, Meshlet meshlet, uint index)
+{
+    uint byteOffset = parameters.MeshletVertexIndexOffset + meshlet.VertexIndexOffset + index * meshlet.VertexIndexSize;
+    uint value = meshBuffer.Load(byteOffset & ~3);
+
+    if (meshlet.VertexIndexSize == 1)
+    {
+        value = (value >> ((byteOffset & 3) * 8)) & 0xFF;
+    }
+    else if (meshlet.VertexIndexSize == 2)
+    {
+        value = (value >> ((byteOffset & 2) * 8)) & 0xFFFF;
+    }
+
+    return meshlet.BaseVertex + value;
+}
+
+uint3 LoadMeshletTriangle(ByteAddressBuffer meshBuffer, Meshlet meshlet, uint index)
+{
+    // NOTE: Triangles are packed on 3 bytes so they can straddle two words. The encoder pads the stream so the
+    // second word of the last triangle is always readable.
+    uint byteOffset = parameters.MeshletTriangleIndexOffset + meshlet.TriangleOffset + index * 3;
+    uint2 words = meshBuffer.Load2(byteOffset & ~3);
+    uint shift = (byteOffset & 3) * 8;
+    uint packedTriangle = shift == 0 ? words.x : (words.x >> shift) | (words.y << (32 - shift));
+
+    return unpack_u8u32(packedTriangle).xyz;
+}
+
+MeshletBounds LoadMeshletBounds(ByteAddressBuffer meshBuffer, uint meshletIndex)
+{
+    // NOTE: Bounds are stored as ElemMeshletCompactBounds (half4 sphere, snorm8x4 cone)
+    uint3 packedBounds = meshBuffer.Load3(parameters.MeshletBoundsOffset + meshletIndex * 12);
+
+    MeshletBounds result;
+    result.SphereCenter = f16tof32(uint3(packedBounds.x, packedBounds.x >> 16, packedBounds.y));
+    result.SphereRadius = f16tof32(packedBounds.y >> 16);
+
+    float4 cone = float4(unpack_s8s32(packedBounds.z)) / 127.0;
+    result.ConeAxis = cone.xyz;
+    result.ConeCutoff = cone.w;
+
+    return result;
+}
+
+bool IsSphereOutsideFrustum(float3 center, float radius, float4x4 viewProjMatrix)
+{
+    // NOTE: Planes are extracted from the columns because we use row vectors (v * M).
+    // The far plane is not tested because the projection uses an infinite reversed Z.
+    float4 planes[5] =
+    {
+        viewProjMatrix._14_24_34_44 + viewProjMatrix._11_21_31_41,
+        viewProjMatrix._14_24_34_44 - viewProjMatrix._11_21_31_41,
+        viewProjMatrix._14_24_34_44 + viewProjMatrix._12_22_32_42,
+        viewProjMatrix._14_24_34_44 - viewProjMatrix._12_22_32_42,
+        viewProjMatrix._14_24_34_44 - viewProjMatrix._13_23_33_43
+    };
+
+    for (uint i = 0; i < 5; i++)
+    {
+        if (dot(planes[i].xyz, center) + planes[i].w < -radius * length(planes[i].xyz))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool IsMeshletCulled(MeshletBounds bounds, FrameData frameData)
+{
+    float3 worldCenter = RotateQuaternion(bounds.SphereCenter, parameters.Rotation) * parameters.Scale + parameters.Translation;
+    float worldRadius = bounds.SphereRadius * parameters.Scale;
+
+    if (IsSphereOutsideFrustum(worldCenter, worldRadius, frameData.ViewProjMatrix))
+    {
+        return true;
+    }
+
+    // NOTE: The cone cutoff is not affected by uniform scaling
+    float3 worldConeAxis = RotateQuaternion(bounds.ConeAxis, parameters.Rotation);
+    float3 cameraToCenter = worldCenter - frameData.CameraPosition;
+
+    return dot(cameraToCenter, worldConeAxis) >= bounds.ConeCutoff * length(cameraToCenter) + worldRadius;
+}
+
+float ComputeProjectedLodError(float3 sphereCenter, float sphereRadius, float error, FrameData frameData)
+{
+    float3 worldCenter = RotateQuaternion(sphereCenter, parameters.Rotation) * parameters.Scale + parameters.Translation;
+    float distance = max(length(worldCenter - frameData.CameraPosition) - sphereRadius * parameters.Scale, 0.0001);
+
+    return error * parameters.Scale / distance * frameData.LodErrorScale;
+}
+
+bool IsMeshletLodVisible(ElemMeshletLodInfo lodInfo, FrameData frameData)
+{
+    // NOTE: Siblings share the same parent data, so they always take the same decision and the LOD levels never overlap.
+    return ComputeProjectedLodError(lodInfo.SelfSphereCenter, lodInfo.SelfSphereRadius, lodInfo.SelfError, frameData) <= frameData.LodErrorThreshold &&
+           ComputeProjectedLodError(lodInfo.ParentSphereCenter, lodInfo.ParentSphereRadius, lodInfo.ParentError, frameData) > frameData.LodErrorThreshold;
+}
+
 [shader("mesh")]
 [OutputTopology("triangle")]
 [NumThreads(126, 1, 1)]
@@ -79,16 +228,25 @@ void MeshMain(in uint groupId: SV_GroupID,
 
     ByteAddressBuffer meshBuffer = ResourceDescriptorHeap[parameters.MeshBuffer];
 
-    ElemMeshlet meshlet = meshBuffer.Load<ElemMeshlet>(parameters.MeshletOffset + meshletIndex * sizeof(ElemMeshlet));
+    Meshlet meshlet = LoadMeshlet(meshBuffer, meshletIndex);
+
+    ByteAddressBuffer frameDataBuffer = ResourceDescriptorHeap[parameters.FrameDataBufferIndex];
+    FrameData frameData = frameDataBuffer.Load<FrameData>(0);
+
+    // TODO: Move the LOD selection and the culling to an amplification shader when the pipeline state supports it
+    ElemMeshletLodInfo lodInfo = meshBuffer.Load<ElemMeshletLodInfo>(parameters.MeshletLodOffset + meshletIndex * sizeof(ElemMeshletLodInfo));
+
+    if (!IsMeshletLodVisible(lodInfo, frameData) || IsMeshletCulled(LoadMeshletBounds(meshBuffer, meshletIndex), frameData))
+    {
+        SetMeshOutputCounts(0, 0);
+        return;
+    }
 
     SetMeshOutputCounts(meshlet.VertexIndexCount, meshlet.TriangleCount);
 
     if (groupThreadId < meshlet.VertexIndexCount)
     {
-        ByteAddressBuffer frameDataBuffer = ResourceDescriptorHeap[parameters.FrameDataBufferIndex];
-        FrameData frameData = frameDataBuffer.Load<FrameData>(0);
-
-        uint vertexIndex = meshBuffer.Load<uint>(parameters.MeshletVertexIndexOffset + (meshlet.VertexIndexOffset + groupThreadId) * sizeof(uint));
+        uint vertexIndex = LoadMeshletVertexIndex(meshBuffer, meshlet, groupThreadId);
         Vertex vertex = meshBuffer.Load<Vertex>(parameters.VertexBufferOffset + vertexIndex * sizeof(Vertex));
 
         float3 worldPosition = RotateQuaternion(vertex.Position, parameters.Rotation) * parameters.Scale + parameters.Translation;
@@ -107,9 +265,7 @@ void MeshMain(in uint groupId: SV_GroupID,
 
     if (groupThreadId < meshlet.TriangleCount)
     {
-        uint triangleIndex = meshBuffer.Load<uint>(parameters.MeshletTriangleIndexOffset + (meshlet.TriangleOffset + groupThreadId) * sizeof(uint));
-
-        indices[groupThreadId] = unpack_u8u32(triangleIndex).xyz;
+        indices[groupThreadId] = LoadMeshletTriangle(meshBuffer, meshlet, groupThreadId);
     }
 }
 
@@ -20,16 +20,20 @@ typedef struct
     uint32_t MeshletTriangleIndexOffset;
     float Scale;
     ElemVector3 Translation;
-    uint32_t Reserved;
+    uint32_t MeshletBoundsOffset;
     ElemVector4 Rotation;
     uint32_t MaterialId;
     uint32_t TextureSampler;
+    uint32_t MeshletLodOffset;
 } ShaderParameters;
 
 typedef struct
 {
     SampleMatrix4x4 ViewProjMatrix;
     uint32_t ShowMeshlets;
+    ElemVector3 CameraPosition;
+    float LodErrorScale;
+    float LodErrorThreshold;
 } ShaderFrameData;
 
 // TODO: Group common variables into separate structs
@@ -82,10 +86,15 @@ void CreateDepthBuffer(ApplicationPayload* applicationPayload, uint32_t width, u
     applicationPayload->DepthBuffer = ElemCreateGraphicsResource(applicationPayload->DepthBufferHeap, 0, &resourceInfo);
 }
 
-void UpdateFrameData(ApplicationPayload* applicationPayload, SampleMatrix4x4 viewProjMatrix, bool showMeshlets)
+void UpdateFrameData(ApplicationPayload* applicationPayload, SampleMatrix4x4 viewProjMatrix, SampleMatrix4x4 projectionMatrix, ElemVector3 cameraPosition, uint32_t renderHeight, bool showMeshlets)
 {
     applicationPayload->FrameData.ViewProjMatrix = viewProjMatrix;
     applicationPayload->FrameData.ShowMeshlets = showMeshlets;
+    applicationPayload->FrameData.CameraPosition = cameraPosition;
+
+    // NOTE: Converts a mesh space error at a distance of 1 into pixels. We accept one pixel of error.
+    applicationPayload->FrameData.LodErrorScale = projectionMatrix.m[1][1] * renderHeight * 0.5f;
+    applicationPayload->FrameData.LodErrorThreshold = 1.0f;
 
     ElemUploadGraphicsBufferData(applicationPayload->FrameDataBuffer.Buffer, 0, (ElemDataSpan) { .Items = (uint8_t*)&applicationPayload->FrameData, .Length = sizeof(ShaderFrameData) });
 }
@@ -226,7 +235,7 @@ void UpdateSwapChain(const ElemSwapChainUpdateParameters* updateParameters, void
 
     SampleInputsCameraState* inputsCameraState = &applicationPayload->InputsCamera.State;
 
-    UpdateFrameData(applicationPayload, inputsCameraState->ViewProjMatrix, inputsCameraState->Action);
+    UpdateFrameData(applicationPayload, inputsCameraState->ViewProjMatrix, inputsCameraState->ProjectionMatrix, inputsCameraState->Camera.Position, updateParameters->SwapChainInfo.Height, inputsCameraState->Action);
 
     // TODO: We need to have a kind of queue system. The problem here is that if we don't have any
     // data to load we will create empty lists
@@ -354,6 +363,8 @@ void UpdateSwapChain(const ElemSwapChainUpdateParameters* updateParameters, void
                 SampleMeshPrimitiveHeader* meshPrimitive = &meshData->MeshPrimitives[j];
                 applicationPayload->ShaderParameters.VertexBufferOffset = meshPrimitive->VertexBufferOffset;
                 applicationPayload->ShaderParameters.MeshletOffset = meshPrimitive->MeshletOffset;
+                applicationPayload->ShaderParameters.MeshletBoundsOffset = meshPrimitive->MeshletBoundsOffset;
+                applicationPayload->ShaderParameters.MeshletLodOffset = meshPrimitive->MeshletLodOffset;
                 applicationPayload->ShaderParameters.MeshletVertexIndexOffset = meshPrimitive->MeshletVertexIndexOffset;
                 applicationPayload->ShaderParameters.MeshletTriangleIndexOffset = meshPrimitive->MeshletTriangleIndexOffset;
                 applicationPayload->ShaderParameters.Scale = sceneNode->Scale;
@@ -1,25 +1,52 @@
 #include "ElementalTools.h"
 #include "SampleUtils.h"
 
-int main(int argc, const char* argv[]) 
+#define SHADER_COMPILER_MAX_ENTRIES 4096
+#define SHADER_COMPILER_MAX_DEFINES 64
+
+int main(int argc, const char* argv[])
 {
     if (argc < 3)
     {
         printf("USAGE: ShaderCompiler [options] inputfile outputfile\n");
+        printf("       ShaderCompiler [options] --manifest manifestfile\n");
         printf("\n");
         printf("OPTIONS:\n");
+        printf("   --manifest\tFile that contains one 'inputfile outputfile' entry per line. The shaders are compiled in parallel.\n");
         printf("   --target-api\tTarget API to use: DirectX12, Vulkan, Metal. Default: to the default system target API.\n");
         printf("   --target-platform\tTarget Platform to use: Windows, MacOS, iOS. Default: to the default system target API.\n");
         printf("   --debug\tCompile with debug information.\n");
+        printf("   --define\tPreprocessor define with the NAME or NAME=VALUE format. Can be used multiple times.\n");
+        printf("   --cache-directory\tDirectory used to reuse the shaders that didn't change. Default: .cache/ next to the output file or the manifest.\n");
+        printf("   --no-cache\tAlways compile the shaders.\n");
         printf("\n");
         return 0;
     }
 
-    int32_t inputPathIndex = argc - 2;
-    const char* inputPath = argv[inputPathIndex];
+    SampleManifestEntry* entries = (SampleManifestEntry*)calloc(SHADER_COMPILER_MAX_ENTRIES, sizeof(SampleManifestEntry));
+    uint32_t entryCount = 0;
+    ElemDataSpan manifestData = {};
+
+    // NOTE: The cache directory is shared by all the entries so it is created next to the manifest in manifest mode.
+    const char* cacheBasePath = argv[argc - 1];
+
+    if (strcmp(argv[argc - 2], "--manifest") == 0)
+    {
+        // NOTE: One more byte is always allocated by SampleReadFile so the data is null terminated.
+        manifestData = SampleReadFile(argv[argc - 1], false);
 
-    int32_t outputPathIndex = argc - 1;
-    const char* outputPath = argv[outputPathIndex];
+        if (manifestData.Length == 0)
+        {
+            printf("Cannot read manifest file: %s\n", argv[argc - 1]);
+            return 1;
+        }
+
+        entryCount = SampleParseManifest((char*)manifestData.Items, entries, SHADER_COMPILER_MAX_ENTRIES);
+    }
+    else
+    {
+        entries[entryCount++] = (SampleManifestEntry) { .InputPath = argv[argc - 2], .OutputPath = argv[argc - 1] };
+    }
 
     // TODO: Get extension by default and provide an option
 
@@ -36,6 +63,10 @@ int main(int argc, const char* argv[])
     #endif
 
     bool debugMode = false;
+    const char* cacheDirectoryOption = NULL;
+    bool useCache = true;
+    ElemShaderDefine defines[SHADER_COMPILER_MAX_DEFINES];
+    uint32_t defineCount = 0;
 
     // TODO: Add more checks
     for (uint32_t i = 1; i < (uint32_t)(argc - 2); i++)
@@ -66,20 +97,91 @@ int main(int argc, const char* argv[])
         {
             debugMode = true;
         }
+        else if (strcmp(argv[i], "--cache-directory") == 0 && i + 1 < (uint32_t)(argc - 2))
+        {
+            cacheDirectoryOption = argv[++i];
+        }
+        else if (strcmp(argv[i], "--no-cache") == 0)
+        {
+            useCache = false;
+        }
+        else if (strcmp(argv[i], "--define") == 0 && i + 1 < (uint32_t)(argc - 2) && defineCount < SHADER_COMPILER_MAX_DEFINES)
+        {
+            // NOTE: The argument is split in place so the define points directly into it.
+            char* defineString = (char*)argv[++i];
+            char* separator = strchr(defineString, '=');
+
+            if (separator)
+            {
+                *separator = '\0';
+            }
+
+            defines[defineCount++] = (ElemShaderDefine) { .Name = defineString, .Value = separator ? separator + 1 : NULL };
+        }
+    }
+
+    char cacheDirectory[MAX_PATH] = {};
+
+    if (useCache)
+    {
+        if (cacheDirectoryOption)
+        {
+            strncpy(cacheDirectory, cacheDirectoryOption, MAX_PATH - 1);
+        }
+        else
+        {
+            GetFileDirectory(cacheBasePath, cacheDirectory, MAX_PATH);
+            strncat(cacheDirectory, ".cache/", MAX_PATH - strlen(cacheDirectory) - 1);
+        }
+
+        SampleCreateDirectory(cacheDirectory);
+    }
+
+    SampleInitTimer();
+    double initialTimer = SampleGetTimerValueInMS();
+
+    ElemCompileShaderLibraryEntry* compileEntries = (ElemCompileShaderLibraryEntry*)calloc(entryCount + 1, sizeof(ElemCompileShaderLibraryEntry));
+
+    for (uint32_t i = 0; i < entryCount; i++)
+    {
+        printf("Compiling shader: %s (DebugMode=%d)\n", entries[i].InputPath, debugMode);
+        compileEntries[i] = (ElemCompileShaderLibraryEntry) { .Path = entries[i].InputPath };
     }
 
-    printf("Compiling shader: %s (DebugMode=%d)\n", inputPath, debugMode);
+    ElemCompileShaderLibrariesResult compilationResults = ElemCompileShaderLibraries(targetApi, targetPlatform, (ElemCompileShaderLibraryEntrySpan) { .Items = compileEntries, .Length = entryCount }, &(ElemCompileShaderOptions)
+    {
+        .DebugMode = debugMode,
+        .Defines = { .Items = defines, .Length = defineCount },
+        .CacheDirectory = useCache ? cacheDirectory : NULL
+    });
 
-    ElemShaderCompilationResult compilationResult = ElemCompileShaderLibrary(targetApi, targetPlatform, inputPath, &(ElemCompileShaderOptions) { .DebugMode = debugMode });
-    
-    DisplayOutputMessages("ShaderCompiler", compilationResult.Messages);
+    bool hasErrors = false;
 
-    if (compilationResult.HasErrors)
+    for (uint32_t i = 0; i < compilationResults.Results.Length; i++)
     {
-        return 1;
+        ElemShaderCompilationResult* compilationResult = &compilationResults.Results.Items[i];
+        DisplayOutputMessages("ShaderCompiler", compilationResult->Messages);
+
+        if (compilationResult->HasErrors)
+        {
+            printf("Cannot compile shader: %s\n", entries[i].InputPath);
+            hasErrors = true;
+            continue;
+        }
+
+        printf("Writing shader data to: %s\n", entries[i].OutputPath);
+
+        if (SampleWriteDataToFile(entries[i].OutputPath, compilationResult->Data, false) != 0)
+        {
+            hasErrors = true;
+        }
     }
 
-    // TODO: Add timing informations
-    printf("Writing shader data to: %s\n", outputPath);
-    return SampleWriteDataToFile(outputPath, compilationResult.Data, false);
+    printf("Shaders compiled in %.2fs (%d files)\n", (SampleGetTimerValueInMS() - initialTimer) / 1000.0, entryCount);
+
+    free(compileEntries);
+    free(entries);
+    free(manifestData.Items);
+
+    return hasErrors ? 1 : 0;
 }
@@ -4,32 +4,84 @@
 
 // TODO: Restore MeshBuilder to use for hello mesh?
 
-bool WriteMeshData(FILE* file, ElemSceneMesh mesh)
+// NOTE: Bump the version when the mesh data layout or the meshlet building changes so the old cache
+// entries are not reused.
+#define SCENE_MESH_CACHE_VERSION 1
+
+// NOTE: The limits must match the mesh shader output declaration of the renderer. The options are static
+// so the padding bytes are zeroed, they are part of the mesh cache key.
+static const ElemBuildMeshletLodHierarchyOptions MeshletLodHierarchyOptions =
 {
-    assert(file);
-    uint32_t meshHeaderOffset = ftell(file);
-    
-    SampleMeshHeader meshHeader =
+    .MeshletOptions = 
     {
-        .MeshPrimitiveCount = mesh.MeshPrimitives.Length
-    };
-    
-    strncpy(meshHeader.Name, mesh.Name, 50);
+        .MeshletMaxVertexCount = 64,
+        .MeshletMaxTriangleCount = 124
+    }
+};
 
-    fwrite(&meshHeader, sizeof(SampleMeshHeader), 1, file);
-    uint32_t meshPrimitiveHeadersOffset = ftell(file);
-    
-    SampleMeshPrimitiveHeader* meshPrimitiveHeaders = (SampleMeshPrimitiveHeader*)malloc(sizeof(SampleMeshPrimitiveHeader) * mesh.MeshPrimitives.Length);
-    fwrite(meshPrimitiveHeaders, sizeof(SampleMeshPrimitiveHeader), mesh.MeshPrimitives.Length, file);
+typedef struct
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t MeshPrimitiveCount;
+    uint32_t MeshBufferSizeInBytes;
+} SceneMeshCacheHeader;
 
-    meshHeader.MeshBufferOffset = ftell(file);
+typedef struct
+{
+    uint32_t VertexSize;
+    uint32_t VertexCount;
+    uint32_t VertexFormat;
+    uint32_t IndexCount;
+    ElemToolsBoundingBox PositionBounds;
+} SceneMeshPrimitiveCacheKey;
+
+typedef struct
+{
+    // NULL when the cache is disabled.
+    const char* CacheDirectory;
+    uint32_t ReusedMeshCount;
+    uint32_t BuiltMeshCount;
+} SceneMeshCache;
+
+typedef struct
+{
+    uint8_t* Data;
+    uint32_t Length;
+    uint32_t Capacity;
+} SceneDataBuffer;
+
+uint32_t WriteSceneDataBuffer(SceneDataBuffer* buffer, const void* data, uint32_t sizeInBytes)
+{
+    if (buffer->Length + sizeInBytes > buffer->Capacity)
+    {
+        uint32_t capacity = buffer->Capacity > 0 ? buffer->Capacity * 2 : 1024 * 1024;
+
+        while (capacity < buffer->Length + sizeInBytes)
+        {
+            capacity *= 2;
+        }
+
+        buffer->Data = (uint8_t*)realloc(buffer->Data, capacity);
+        buffer->Capacity = capacity;
+    }
+
+    uint32_t offset = buffer->Length;
+    memcpy(buffer->Data + offset, data, sizeInBytes);
+    buffer->Length += sizeInBytes;
+
+    return offset;
+}
+
+bool WriteMeshData(SceneDataBuffer* meshDataBuffer, SampleMeshPrimitiveHeader* meshPrimitiveHeaders, SampleMeshHeader* meshHeader, ElemSceneMesh mesh)
+{
+    meshHeader->MeshBufferOffset = meshDataBuffer->Length;
 
     for (uint32_t i = 0; i < mesh.MeshPrimitives.Length; i++)
     {
         ElemSceneMeshPrimitive* meshPrimitive = &mesh.MeshPrimitives.Items[i];
 
-        // TODO: LOD!
-        ElemBuildMeshletResult result = ElemBuildMeshlets(meshPrimitive->VertexBuffer, meshPrimitive->IndexBuffer, NULL);
+        ElemBuildMeshletResult result = ElemBuildMeshletLodHierarchy(meshPrimitive->VertexBuffer, meshPrimitive->IndexBuffer, &MeshletLodHierarchyOptions);
 
         DisplayOutputMessages("BuildMeshlets", result.Messages);
 
@@ -38,85 +90,184 @@ bool WriteMeshData(FILE* file, ElemSceneMesh mesh)
             return false; 
         }
 
+        // NOTE: The streams are not compressed because they are read directly by the mesh shader
+        ElemEncodeMeshletsResult encodedResult = ElemEncodeMeshlets(&result, NULL);
+
+        DisplayOutputMessages("EncodeMeshlets", encodedResult.Messages);
+
+        if (encodedResult.HasErrors)
+        {
+            return false; 
+        }
+
         SampleMeshPrimitiveHeader* meshPrimitiveHeader = &meshPrimitiveHeaders[i];
         meshPrimitiveHeader->MaterialId = meshPrimitive->MaterialId;
         meshPrimitiveHeader->MeshletCount = result.Meshlets.Length;
 
-        meshPrimitiveHeader->VertexBufferOffset = ftell(file) - meshHeader.MeshBufferOffset;
-        fwrite(result.VertexBuffer.Data.Items, sizeof(uint8_t), result.VertexBuffer.Data.Length, file);
+        meshPrimitiveHeader->VertexBufferOffset = WriteSceneDataBuffer(meshDataBuffer, result.VertexBuffer.Data.Items, result.VertexBuffer.Data.Length) - meshHeader->MeshBufferOffset;
+        meshPrimitiveHeader->MeshletOffset = WriteSceneDataBuffer(meshDataBuffer, encodedResult.Meshlets.Items, encodedResult.Meshlets.Length * sizeof(ElemEncodedMeshlet)) - meshHeader->MeshBufferOffset;
+        meshPrimitiveHeader->MeshletBoundsOffset = WriteSceneDataBuffer(meshDataBuffer, result.MeshletCompactBounds.Items, result.MeshletCompactBounds.Length * sizeof(ElemMeshletCompactBounds)) - meshHeader->MeshBufferOffset;
+        meshPrimitiveHeader->MeshletLodOffset = WriteSceneDataBuffer(meshDataBuffer, result.MeshletLods.Items, result.MeshletLods.Length * sizeof(ElemMeshletLodInfo)) - meshHeader->MeshBufferOffset;
+        meshPrimitiveHeader->MeshletVertexIndexOffset = WriteSceneDataBuffer(meshDataBuffer, encodedResult.MeshletVertexIndexBuffer.Items, encodedResult.MeshletVertexIndexBuffer.Length) - meshHeader->MeshBufferOffset;
+        meshPrimitiveHeader->MeshletTriangleIndexOffset = WriteSceneDataBuffer(meshDataBuffer, encodedResult.MeshletTriangleIndexBuffer.Items, encodedResult.MeshletTriangleIndexBuffer.Length) - meshHeader->MeshBufferOffset;
+    }
 
-        meshPrimitiveHeader->MeshletOffset = ftell(file) - meshHeader.MeshBufferOffset;
-        fwrite(result.Meshlets.Items, sizeof(ElemMeshlet), result.Meshlets.Length, file);
+    meshHeader->MeshBufferSizeInBytes = meshDataBuffer->Length - meshHeader->MeshBufferOffset;
+    return true;
+}
 
-        meshPrimitiveHeader->MeshletVertexIndexOffset = ftell(file) - meshHeader.MeshBufferOffset;
-        fwrite(result.MeshletVertexIndexBuffer.Items, sizeof(uint32_t), result.MeshletVertexIndexBuffer.Length, file);
+// NOTE: The key only depends on the loaded mesh data and the build options. The material ids are not
+// part of it because they are patched when the entry is reused.
+uint64_t ComputeMeshCacheKey(ElemSceneMesh mesh)
+{
+    // NOTE: The tools version is part of the key so the entries are rebuilt when the meshlet builders change.
+    const char* toolsVersion = ElemToolsGetVersionLabel();
+    uint64_t hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = (uint8_t*)toolsVersion, .Length = (uint32_t)strlen(toolsVersion) }, SCENE_MESH_CACHE_VERSION);
+    hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = (uint8_t*)&MeshletLodHierarchyOptions, .Length = sizeof(MeshletLodHierarchyOptions) }, hash);
 
-        meshPrimitiveHeader->MeshletTriangleIndexOffset = ftell(file) - meshHeader.MeshBufferOffset;
-        fwrite(result.MeshletTriangleIndexBuffer.Items, sizeof(uint32_t), result.MeshletTriangleIndexBuffer.Length, file);
+    for (uint32_t i = 0; i < mesh.MeshPrimitives.Length; i++)
+    {
+        ElemSceneMeshPrimitive* meshPrimitive = &mesh.MeshPrimitives.Items[i];
+
+        SceneMeshPrimitiveCacheKey primitiveKey =
+        {
+            .VertexSize = meshPrimitive->VertexBuffer.VertexSize,
+            .VertexCount = meshPrimitive->VertexBuffer.VertexCount,
+            .VertexFormat = meshPrimitive->VertexBuffer.Format,
+            .IndexCount = meshPrimitive->IndexBuffer.Length,
+            .PositionBounds = meshPrimitive->VertexBuffer.PositionBounds
+        };
+
+        hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = (uint8_t*)&primitiveKey, .Length = sizeof(SceneMeshPrimitiveCacheKey) }, hash);
+        hash = ElemToolsComputeDataHash(meshPrimitive->VertexBuffer.Data, hash);
+        hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = (uint8_t*)meshPrimitive->IndexBuffer.Items, .Length = meshPrimitive->IndexBuffer.Length * sizeof(uint32_t) }, hash);
     }
 
-    meshHeader.MeshBufferSizeInBytes = ftell(file) - meshHeader.MeshBufferOffset;
+    return hash;
+}
 
-    fseek(file, meshHeaderOffset, SEEK_SET);
-    fwrite(&meshHeader, sizeof(SampleMeshHeader), 1, file);
-    
-    fseek(file, meshPrimitiveHeadersOffset, SEEK_SET);
-    fwrite(meshPrimitiveHeaders, sizeof(SampleMeshPrimitiveHeader), mesh.MeshPrimitives.Length, file);
+bool ReadCachedMeshData(const char* cacheFilePath, SceneDataBuffer* meshDataBuffer, SampleMeshPrimitiveHeader* meshPrimitiveHeaders, SampleMeshHeader* meshHeader, ElemSceneMesh mesh)
+{
+    ElemDataSpan cacheData = SampleReadFile(cacheFilePath, false);
 
-    fseek(file, 0, SEEK_END);
-    
+    if (cacheData.Length == 0)
+    {
+        return false;
+    }
+
+    SceneMeshCacheHeader* cacheHeader = (SceneMeshCacheHeader*)cacheData.Items;
+    uint32_t primitiveHeadersSize = mesh.MeshPrimitives.Length * sizeof(SampleMeshPrimitiveHeader);
+
+    if (cacheData.Length < sizeof(SceneMeshCacheHeader) ||
+        memcmp(cacheHeader->FileId, "MESHDATA", 8) != 0 ||
+        cacheHeader->Version != SCENE_MESH_CACHE_VERSION ||
+        cacheHeader->MeshPrimitiveCount != mesh.MeshPrimitives.Length ||
+        cacheData.Length != sizeof(SceneMeshCacheHeader) + primitiveHeadersSize + cacheHeader->MeshBufferSizeInBytes)
+    {
+        free(cacheData.Items);
+        return false;
+    }
+
+    memcpy(meshPrimitiveHeaders, cacheData.Items + sizeof(SceneMeshCacheHeader), primitiveHeadersSize);
+
+    for (uint32_t i = 0; i < mesh.MeshPrimitives.Length; i++)
+    {
+        meshPrimitiveHeaders[i].MaterialId = mesh.MeshPrimitives.Items[i].MaterialId;
+    }
+
+    meshHeader->MeshBufferOffset = WriteSceneDataBuffer(meshDataBuffer, cacheData.Items + sizeof(SceneMeshCacheHeader) + primitiveHeadersSize, cacheHeader->MeshBufferSizeInBytes);
+    meshHeader->MeshBufferSizeInBytes = cacheHeader->MeshBufferSizeInBytes;
+
+    free(cacheData.Items);
     return true;
 }
 
-bool WriteSceneData(FILE* file, ElemLoadSceneResult scene, const char* sceneInputPath)
+void WriteCachedMeshData(const char* cacheFilePath, SceneDataBuffer* meshDataBuffer, SampleMeshPrimitiveHeader* meshPrimitiveHeaders, SampleMeshHeader* meshHeader)
 {
-    assert(file);
-
-    SampleSceneHeader sceneHeader =
+    SceneMeshCacheHeader cacheHeader =
     {
-        .FileId = { 'S', 'C', 'E', 'N', 'E' },
-        .MeshCount = scene.Meshes.Length,
-        .MaterialCount = scene.Materials.Length,
-        .NodeCount = scene.Nodes.Length
+        .FileId = { 'M', 'E', 'S', 'H', 'D', 'A', 'T', 'A' },
+        .Version = SCENE_MESH_CACHE_VERSION,
+        .MeshPrimitiveCount = meshHeader->MeshPrimitiveCount,
+        .MeshBufferSizeInBytes = meshHeader->MeshBufferSizeInBytes
     };
 
-    fwrite(&sceneHeader, sizeof(SampleSceneHeader), 1, file);
+    SceneDataBuffer cacheData = {};
+    WriteSceneDataBuffer(&cacheData, &cacheHeader, sizeof(SceneMeshCacheHeader));
+    WriteSceneDataBuffer(&cacheData, meshPrimitiveHeaders, meshHeader->MeshPrimitiveCount * sizeof(SampleMeshPrimitiveHeader));
+    WriteSceneDataBuffer(&cacheData, meshDataBuffer->Data + meshHeader->MeshBufferOffset, meshHeader->MeshBufferSizeInBytes);
+
+    if (!SampleWriteCacheFile(cacheFilePath, cacheData.Data, cacheData.Length))
+    {
+        printf("Warning: Cannot write mesh cache file: %s\n", cacheFilePath);
+    }
+
+    free(cacheData.Data);
+}
+
+bool WriteMeshDataWithCache(SceneMeshCache* meshCache, SceneDataBuffer* meshDataBuffer, SampleMeshPrimitiveHeader* meshPrimitiveHeaders, SampleMeshHeader* meshHeader, ElemSceneMesh mesh)
+{
+    if (meshCache->CacheDirectory == NULL)
+    {
+        meshCache->BuiltMeshCount++;
+        return WriteMeshData(meshDataBuffer, meshPrimitiveHeaders, meshHeader, mesh);
+    }
+
+    char cacheFilePath[MAX_PATH];
+    SampleGetCacheFilePath(meshCache->CacheDirectory, ComputeMeshCacheKey(mesh), ".mesh", cacheFilePath, MAX_PATH);
+
+    if (ReadCachedMeshData(cacheFilePath, meshDataBuffer, meshPrimitiveHeaders, meshHeader, mesh))
+    {
+        meshCache->ReusedMeshCount++;
+        return true;
+    }
+
+    if (!WriteMeshData(meshDataBuffer, meshPrimitiveHeaders, meshHeader, mesh))
+    {
+        return false;
+    }
+
+    WriteCachedMeshData(cacheFilePath, meshDataBuffer, meshPrimitiveHeaders, meshHeader);
+    meshCache->BuiltMeshCount++;
+
+    return true;
+}
+
+bool WriteSceneData(FILE* file, ElemLoadSceneResult scene, const char* sceneInputPath, SceneMeshCache* meshCache)
+{
+    assert(file);
 
     // TODO: Get rid of malloc?
-    SampleDataBlockEntry* meshDataOffsets = (SampleDataBlockEntry*)malloc(sizeof(SampleDataBlockEntry) * scene.Meshes.Length);
-    fwrite(meshDataOffsets, sizeof(SampleDataBlockEntry), scene.Meshes.Length, file);
+    SampleSceneMaterialHeader* materialHeaders = (SampleSceneMaterialHeader*)calloc(scene.Materials.Length + 1, sizeof(SampleSceneMaterialHeader));
     
     for (uint32_t i = 0; i < scene.Materials.Length; i++)
     {
         ElemSceneMaterial* material = &scene.Materials.Items[i];
+        SampleSceneMaterialHeader* materialHeader = &materialHeaders[i];
 
-        SampleSceneMaterialHeader materialHeader =
-        {
-            .AlbedoFactor = material->AlbedoFactor
-        };
-
-        strncpy(materialHeader.Name, material->Name, 50);
+        materialHeader->AlbedoFactor = material->AlbedoFactor;
+        strncpy(materialHeader->Name, material->Name, 50);
 
         // TODO: Here we need to compute a list of unique textures and add them to a list
         // so we don't need to compute that unique list at runtime
         if (material->AlbedoTexturePath)
         {
-            GetRelativeResourcePath(sceneInputPath, material->AlbedoTexturePath, ".texture", materialHeader.AlbedoTexturePath, 255);
+            GetRelativeResourcePath(sceneInputPath, material->AlbedoTexturePath, ".texture", materialHeader->AlbedoTexturePath, 255);
         }
         
         if (material->NormalTexturePath)
         {
-            GetRelativeResourcePath(sceneInputPath, material->NormalTexturePath, ".texture", materialHeader.NormalTexturePath, 255);
+            GetRelativeResourcePath(sceneInputPath, material->NormalTexturePath, ".texture", materialHeader->NormalTexturePath, 255);
         }
-
-        fwrite(&materialHeader, sizeof(SampleSceneMaterialHeader), 1, file);
     }
 
+    SampleSceneNodeHeader* nodeHeaders = (SampleSceneNodeHeader*)calloc(scene.Nodes.Length + 1, sizeof(SampleSceneNodeHeader));
+
     for (uint32_t i = 0; i < scene.Nodes.Length; i++)
     {
         ElemSceneNode* node = &scene.Nodes.Items[i];
 
-        SampleSceneNodeHeader fileNode =
+        nodeHeaders[i] = (SampleSceneNodeHeader)
         {
             .NodeType = (SampleSceneNodeType)node->NodeType,
             .ReferenceIndex = node->ReferenceIndex,
@@ -125,30 +276,65 @@ bool WriteSceneData(FILE* file, ElemLoadSceneResult scene, const char* sceneInpu
             .Translation = node->Translation
         };
 
-        strncpy(fileNode.Name, node->Name, 50);
-        fwrite(&fileNode, sizeof(SampleSceneNodeHeader), 1, file);
+        strncpy(nodeHeaders[i].Name, node->Name, 50);
+    }
+
+    uint32_t meshPrimitiveCount = 0;
 
-        //printf("Node: '%s' MeshId=%d (T=%f,%f,%f)\n", node->Name, node->ReferenceIndex, node->Translation.X, node->Translation.Y, node->Translation.Z);
+    for (uint32_t i = 0; i < scene.Meshes.Length; i++)
+    {
+        meshPrimitiveCount += scene.Meshes.Items[i].MeshPrimitives.Length;
     }
 
+    SampleMeshHeader* meshHeaders = (SampleMeshHeader*)calloc(scene.Meshes.Length + 1, sizeof(SampleMeshHeader));
+    SampleMeshPrimitiveHeader* meshPrimitiveHeaders = (SampleMeshPrimitiveHeader*)calloc(meshPrimitiveCount + 1, sizeof(SampleMeshPrimitiveHeader));
+    SceneDataBuffer meshDataBuffer = {};
+
     double beforeMeshlets = SampleGetTimerValueInMS();
+    uint32_t currentMeshPrimitiveOffset = 0;
 
     for (uint32_t i = 0; i < scene.Meshes.Length; i++)
     {
-        uint32_t dataOffset = ftell(file);
+        ElemSceneMesh mesh = scene.Meshes.Items[i];
+        SampleMeshHeader* meshHeader = &meshHeaders[i];
+
+        strncpy(meshHeader->Name, mesh.Name, 50);
+        meshHeader->MeshPrimitiveOffset = currentMeshPrimitiveOffset;
+        meshHeader->MeshPrimitiveCount = mesh.MeshPrimitives.Length;
 
-        bool result = WriteMeshData(file, scene.Meshes.Items[i]);
+        bool result = WriteMeshDataWithCache(meshCache, &meshDataBuffer, &meshPrimitiveHeaders[currentMeshPrimitiveOffset], meshHeader, mesh);
         assert(result);
 
-        meshDataOffsets[i] = (SampleDataBlockEntry) { .Offset = dataOffset, .SizeInBytes = ftell(file) - dataOffset };
+        currentMeshPrimitiveOffset += mesh.MeshPrimitives.Length;
     }
 
-    printf("Built meshlets in %.2fs\n", (SampleGetTimerValueInMS() - beforeMeshlets) / 1000.0);
+    printf("Built meshlets in %.2fs (Meshes reused from cache: %d, built: %d)\n", (SampleGetTimerValueInMS() - beforeMeshlets) / 1000.0, meshCache->ReusedMeshCount, meshCache->BuiltMeshCount);
 
-    fseek(file, sizeof(sceneHeader), SEEK_SET);
-    fwrite(meshDataOffsets, sizeof(SampleDataBlockEntry), scene.Meshes.Length, file);
+    ElemSceneContainerSectionData sections[] =
+    {
+        { .Id = SampleSceneSection_Materials, .ElementSize = sizeof(SampleSceneMaterialHeader), .Data = { .Items = (uint8_t*)materialHeaders, .Length = scene.Materials.Length * sizeof(SampleSceneMaterialHeader) } },
+        { .Id = SampleSceneSection_Nodes, .ElementSize = sizeof(SampleSceneNodeHeader), .Data = { .Items = (uint8_t*)nodeHeaders, .Length = scene.Nodes.Length * sizeof(SampleSceneNodeHeader) } },
+        { .Id = SampleSceneSection_Meshes, .ElementSize = sizeof(SampleMeshHeader), .Data = { .Items = (uint8_t*)meshHeaders, .Length = scene.Meshes.Length * sizeof(SampleMeshHeader) } },
+        { .Id = SampleSceneSection_MeshPrimitives, .ElementSize = sizeof(SampleMeshPrimitiveHeader), .Data = { .Items = (uint8_t*)meshPrimitiveHeaders, .Length = meshPrimitiveCount * sizeof(SampleMeshPrimitiveHeader) } },
+        { .Id = SampleSceneSection_MeshData, .Data = { .Items = meshDataBuffer.Data, .Length = meshDataBuffer.Length } }
+    };
 
-    return true;
+    ElemBuildSceneContainerResult containerResult = ElemBuildSceneContainer((ElemSceneContainerSectionDataSpan) { .Items = sections, .Length = sizeof(sections) / sizeof(ElemSceneContainerSectionData) }, NULL);
+
+    DisplayOutputMessages("BuildSceneContainer", containerResult.Messages);
+
+    if (!containerResult.HasErrors)
+    {
+        fwrite(containerResult.Data.Items, sizeof(uint8_t), containerResult.Data.Length, file);
+    }
+
+    free(materialHeaders);
+    free(nodeHeaders);
+    free(meshHeaders);
+    free(meshPrimitiveHeaders);
+    free(meshDataBuffer.Data);
+
+    return !containerResult.HasErrors;
 }
 
 int main(int argc, const char* argv[]) 
@@ -160,6 +346,8 @@ int main(int argc, const char* argv[])
         printf("\n");
         printf("OPTIONS:\n");
         printf("   --meshlet-triangle-count\tTBD: TBD. Default: TBD.\n");
+        printf("   --cache-directory\tDirectory used to reuse the meshes that didn't change. Default: .cache/ next to the output file.\n");
+        printf("   --no-cache\tRebuild all the meshes.\n");
         printf("\n");
         return 0;
     }
@@ -170,11 +358,29 @@ int main(int argc, const char* argv[])
     int32_t outputPathIndex = argc - 1;
     const char* outputPath = argv[outputPathIndex];
 
+    char cacheDirectory[MAX_PATH];
+    GetFileDirectory(outputPath, cacheDirectory, MAX_PATH);
+    strncat(cacheDirectory, ".cache/", MAX_PATH - strlen(cacheDirectory) - 1);
+
+    bool useCache = true;
+
     // TODO: Add more checks
     for (uint32_t i = 1; i < (uint32_t)(argc - 2); i++)
     {
         printf("Options: %s\n", argv[i]);
 
+        if (strcmp(argv[i], "--cache-directory") == 0 && i + 1 < (uint32_t)(argc - 2))
+        {
+            const char* cacheDirectoryString = argv[++i];
+            uint32_t length = strlen(cacheDirectoryString);
+
+            snprintf(cacheDirectory, MAX_PATH, "%s%s", cacheDirectoryString, (length > 0 && cacheDirectoryString[length - 1] != '/') ? "/" : "");
+        }
+        else if (strcmp(argv[i], "--no-cache") == 0)
+        {
+            useCache = false;
+        }
+
         /*if (strcmp(argv[i], "--target-platform") == 0)
         {
             const char* targetPlatformString = argv[i + 1];
@@ -236,8 +442,17 @@ int main(int argc, const char* argv[])
 
     printf("Writing Scene data to: %s\n", outputPath);
 
+    SceneMeshCache meshCache = {};
+
+    if (useCache)
+    {
+        SampleCreateDirectory(cacheDirectory);
+        meshCache.CacheDirectory = cacheDirectory;
+        printf("Using cache directory: %s\n", cacheDirectory);
+    }
+
     FILE* file = fopen(outputPath, "wb");
-    WriteSceneData(file, scene, inputPath);
+    WriteSceneData(file, scene, inputPath, &meshCache);
     fclose(file);
     printf("Scene compiled in %.2fs\n", (SampleGetTimerValueInMS() - initialTimer) / 1000.0);
 }
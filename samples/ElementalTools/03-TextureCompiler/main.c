@@ -2,141 +2,360 @@
 #include "SampleUtils.h"
 #include "SampleTexture.h"
 
-int main(int argc, const char* argv[]) 
+// NOTE: Bump the version when the texture layout or the compression changes so the old cache entries
+// are not reused.
+#define TEXTURE_CACHE_VERSION 3
+#define TEXTURE_COMPILER_MAX_ENTRIES 4096
+
+typedef struct
 {
-    // TODO: Refactor options parsing and put it in a header common
-    // to tools sample and normal samples
-    if (argc < 3)
+    const char* InputPath;
+    const char* OutputPath;
+    // Empty when the cache is disabled.
+    char CacheFilePath[MAX_PATH];
+} TextureCompilerEntry;
+
+typedef struct
+{
+    const char* Name;
+    ElemToolsGraphicsFormat ToolsFormat;
+    SampleTextureFormat SampleFormat;
+} TextureCompilerFormat;
+
+static const TextureCompilerFormat TextureCompilerFormats[] =
+{
+    { "bc7", ElemToolsGraphicsFormat_BC7, SampleTextureFormat_BC7 },
+    { "bc1", ElemToolsGraphicsFormat_BC1, SampleTextureFormat_BC1 },
+    { "bc3", ElemToolsGraphicsFormat_BC3, SampleTextureFormat_BC3 },
+    { "bc4", ElemToolsGraphicsFormat_BC4, SampleTextureFormat_BC4 },
+    { "bc5", ElemToolsGraphicsFormat_BC5, SampleTextureFormat_BC5 },
+    { "bc6h", ElemToolsGraphicsFormat_BC6H, SampleTextureFormat_BC6H }
+};
+
+typedef struct
+{
+    TextureCompilerEntry* Entries;
+    // Index of the compiler entry for each texture that is built.
+    uint32_t* EntryIndices;
+    bool HasErrors;
+} TextureCompilerPayload;
+
+const TextureCompilerFormat* FindTextureCompilerFormat(const char* name)
+{
+    for (uint32_t i = 0; i < sizeof(TextureCompilerFormats) / sizeof(TextureCompilerFormat); i++)
     {
-        printf("USAGE: TextureCompiler [options] inputfile outputfile\n");
-        printf("\n");
-        printf("OPTIONS:\n");
-        printf("\n");
-        return 0;
+        if (strcmp(TextureCompilerFormats[i].Name, name) == 0)
+        {
+            return &TextureCompilerFormats[i];
+        }
     }
 
-    int32_t inputPathIndex = argc - 2;
-    const char* inputPath = argv[inputPathIndex];
+    return NULL;
+}
 
-    int32_t outputPathIndex = argc - 1;
-    const char* outputPath = argv[outputPathIndex];
+bool CopyTextureFromCache(const char* cacheFilePath, const char* outputPath)
+{
+    ElemDataSpan cacheData = SampleReadFile(cacheFilePath, false);
 
-    // TODO: Add more checks
-    for (uint32_t i = 1; i < (uint32_t)(argc - 2); i++)
+    if (cacheData.Length == 0)
     {
-        printf("Options: %s\n", argv[i]);
+        free(cacheData.Items);
+        return false;
     }
 
-    printf("Compiling texture: %s\n", inputPath);
-
-    SampleInitTimer();
-    double initialTimer = SampleGetTimerValueInMS();
+    bool result = SampleWriteDataToFile(outputPath, cacheData, false) == 0;
+    free(cacheData.Items);
 
-    ElemLoadTextureResult loadTextureResult = ElemLoadTexture(inputPath, NULL);
+    return result;
+}
 
-    DisplayOutputMessages("LoadTexture", loadTextureResult.Messages);
+// NOTE: The key is computed from the source file content so touching the file or moving it
+// doesn't invalidate the entry.
+bool GetTextureCacheFilePath(const char* cacheDirectory, const char* inputPath, SampleTextureFormat outputFormat, char* cacheFilePath)
+{
+    ElemDataSpan inputData = SampleReadFile(inputPath, false);
 
-    if (loadTextureResult.HasErrors)
+    if (inputData.Length == 0)
     {
-        return 1;
+        return false;
     }
 
-    printf("Loaded texture in %.2fs\n", (SampleGetTimerValueInMS() - initialTimer) / 1000.0);
+    const char* toolsVersion = ElemToolsGetVersionLabel();
+    uint64_t hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = (uint8_t*)toolsVersion, .Length = (uint32_t)strlen(toolsVersion) }, TEXTURE_CACHE_VERSION);
+    hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = (uint8_t*)&outputFormat, .Length = sizeof(SampleTextureFormat) }, hash);
+    hash = ElemToolsComputeDataHash((ElemToolsDataSpan) { .Items = inputData.Items, .Length = inputData.Length }, hash);
 
-    ElemTextureMipDataSpan mipData = loadTextureResult.MipData;
+    SampleGetCacheFilePath(cacheDirectory, hash, ".texture", cacheFilePath, MAX_PATH);
+    free(inputData.Items);
+
+    return true;
+}
+
+bool WriteTextureFile(const char* outputPath, const ElemBuildTextureResult* result)
+{
+    ElemBuildTextureContainerResult containerResult = ElemBuildTextureContainer(result->Format, result->MipData, NULL);
+    DisplayOutputMessages("BuildTextureContainer", containerResult.Messages);
 
-    if (mipData.Length == 0)
+    if (containerResult.HasErrors)
     {
-        printf("No mip data in the image...");
-        return 1;
+        return false;
     }
 
-    if (mipData.Length == 1)
+    // TODO: Create the directory if it doesn't exist
+    return SampleWriteDataToFile(outputPath, containerResult.Data, false) == 0;
+}
+
+void BuildTextureHandler(const ElemBuildTextureResult* result, void* payload)
+{
+    TextureCompilerPayload* compilerPayload = (TextureCompilerPayload*)payload;
+    TextureCompilerEntry* entry = &compilerPayload->Entries[compilerPayload->EntryIndices[result->Index]];
+
+    DisplayOutputMessages("BuildTexture", result->Messages);
+
+    if (result->HasErrors)
     {
-        double beforeMipGenerationTimer = SampleGetTimerValueInMS();
-        printf("Generating MipData...\n");
+        printf("Cannot compile texture: %s\n", entry->InputPath);
+        compilerPayload->HasErrors = true;
+        return;
+    }
+
+    printf("Writing texture data to: %s (%dx%d, %d mips)\n", entry->OutputPath, result->Width, result->Height, result->MipData.Length);
 
-        ElemGenerateTextureMipDataResult generateMipDataResult = ElemGenerateTextureMipData(loadTextureResult.Format, &loadTextureResult.MipData.Items[0], NULL);
+    if (!WriteTextureFile(entry->OutputPath, result))
+    {
+        printf("Cannot write texture file: %s\n", entry->OutputPath);
+        compilerPayload->HasErrors = true;
+        return;
+    }
 
-        DisplayOutputMessages("GenerateTextureMipData", generateMipDataResult.Messages);
+    if (entry->CacheFilePath[0] != '\0')
+    {
+        ElemDataSpan outputData = SampleReadFile(entry->OutputPath, false);
 
-        if (generateMipDataResult.HasErrors)
+        if (outputData.Length == 0 || !SampleWriteCacheFile(entry->CacheFilePath, outputData.Items, outputData.Length))
         {
-            return 1;
+            printf("Warning: Cannot write texture cache file: %s\n", entry->CacheFilePath);
         }
 
-        printf("GeneratedMips Count: %d\n", generateMipDataResult.MipData.Length);
-        
-        mipData = generateMipDataResult.MipData;
-        printf("Generated MipData in %.2fs\n", (SampleGetTimerValueInMS() - beforeMipGenerationTimer) / 1000.0);
+        free(outputData.Items);
     }
-    
-    printf("Writing texture data to: %s\n", outputPath);
+}
 
-    // TODO: Create the directory if it doesn't exist
+// NOTE: Only decodes the source textures so the throughput of the loaders can be measured on real data.
+bool BenchmarkTextureDecoding(const TextureCompilerEntry* entries, uint32_t entryCount)
+{
+    double totalElapsedMilliseconds = 0.0;
+    uint64_t totalPixelCount = 0;
+    uint64_t totalSizeInBytes = 0;
+    bool hasErrors = false;
+
+    for (uint32_t i = 0; i < entryCount; i++)
+    {
+        double startTimer = SampleGetTimerValueInMS();
+        ElemLoadTextureResult result = ElemLoadTexture(entries[i].InputPath, NULL);
+        double elapsedMilliseconds = SampleGetTimerValueInMS() - startTimer;
+
+        DisplayOutputMessages("LoadTexture", result.Messages);
+
+        if (result.HasErrors)
+        {
+            printf("Cannot load texture: %s\n", entries[i].InputPath);
+            hasErrors = true;
+            continue;
+        }
+
+        uint64_t sizeInBytes = 0;
+
+        for (uint32_t j = 0; j < result.MipData.Length; j++)
+        {
+            sizeInBytes += result.MipData.Items[j].Data.Length;
+        }
+
+        printf("Decoded %s (%dx%d) in %.2fms (%.2f MB/s)\n", entries[i].InputPath, result.Width, result.Height, elapsedMilliseconds, (double)sizeInBytes / (1024.0 * 1024.0) / (elapsedMilliseconds / 1000.0));
 
-    FILE* file = fopen(outputPath, "wb");
+        totalElapsedMilliseconds += elapsedMilliseconds;
+        totalPixelCount += (uint64_t)result.Width * result.Height;
+        totalSizeInBytes += sizeInBytes;
+    }
 
-    SampleTextureHeader textureHeader =
+    if (totalElapsedMilliseconds > 0.0)
     {
-        .FileId = { 'T', 'E', 'X', 'T', 'U', 'R', 'E' },
-        .Format = SampleTextureFormat_BC7, // TODO: Don't hardcode this
-        .Width = loadTextureResult.Width,
-        .Height = loadTextureResult.Height,
-        .MipCount = mipData.Length
-    };
+        printf("Decode throughput: %.2f MB/s, %.2f Mpixels/s (%d files)\n", (double)totalSizeInBytes / (1024.0 * 1024.0) / (totalElapsedMilliseconds / 1000.0), (double)totalPixelCount / 1000000.0 / (totalElapsedMilliseconds / 1000.0), entryCount);
+    }
+
+    return !hasErrors;
+}
 
-    fwrite(&textureHeader, sizeof(SampleTextureHeader), 1, file);
+int main(int argc, const char* argv[])
+{
+    // TODO: Refactor options parsing and put it in a header common
+    // to tools sample and normal samples
+    if (argc < 3)
+    {
+        printf("USAGE: TextureCompiler [options] inputfile outputfile\n");
+        printf("       TextureCompiler [options] --manifest manifestfile\n");
+        printf("\n");
+        printf("OPTIONS:\n");
+        printf("   --manifest\tFile that contains one 'inputfile outputfile' entry per line. The textures are compiled in parallel.\n");
+        printf("   --format\tCompressed format of the textures: bc1, bc3, bc4, bc5, bc6h or bc7. Default: bc7.\n");
+        printf("   --max-textures-in-flight\tMaximum number of textures processed at the same time. Default: 16.\n");
+        printf("   --cache-directory\tDirectory used to reuse the textures that didn't change. Default: .cache/ next to the output file.\n");
+        printf("   --no-cache\tAlways compile the textures.\n");
+        printf("   --benchmark-decode\tOnly decode the input textures and display the decode throughput.\n");
+        printf("\n");
+        return 0;
+    }
 
-    // TODO: Get rid of malloc?
-    SampleTextureDataBlockEntry* mipDataOffsets = (SampleTextureDataBlockEntry*)malloc(sizeof(SampleTextureDataBlockEntry) * mipData.Length);
-    fwrite(mipDataOffsets, sizeof(SampleTextureDataBlockEntry), mipData.Length, file);
+    TextureCompilerEntry* entries = (TextureCompilerEntry*)calloc(TEXTURE_COMPILER_MAX_ENTRIES, sizeof(TextureCompilerEntry));
+    uint32_t entryCount = 0;
+    ElemDataSpan manifestData = {};
 
-    if (loadTextureResult.Format != ElemToolsGraphicsFormat_BC7)
+    if (strcmp(argv[argc - 2], "--manifest") == 0)
     {
-        double beforeEncodeTimer = SampleGetTimerValueInMS();
-        // TODO: Add format in the logging message
-        printf("Compressing data...\n");
+        // NOTE: One more byte is always allocated by SampleReadFile so the data is null terminated.
+        manifestData = SampleReadFile(argv[argc - 1], false);
+
+        if (manifestData.Length == 0)
+        {
+            printf("Cannot read manifest file: %s\n", argv[argc - 1]);
+            return 1;
+        }
 
-        for (uint32_t i = 0; i < mipData.Length; i++)
+        SampleManifestEntry* manifestEntries = (SampleManifestEntry*)calloc(TEXTURE_COMPILER_MAX_ENTRIES, sizeof(SampleManifestEntry));
+        entryCount = SampleParseManifest((char*)manifestData.Items, manifestEntries, TEXTURE_COMPILER_MAX_ENTRIES);
+
+        for (uint32_t i = 0; i < entryCount; i++)
         {
-            ElemTextureMipData* mipLevelData = &mipData.Items[i];
-            printf("Mip level %d Size: %dx%d\n", i, mipLevelData->Width, mipLevelData->Height);
+            entries[i] = (TextureCompilerEntry) { .InputPath = manifestEntries[i].InputPath, .OutputPath = manifestEntries[i].OutputPath };
+        }
 
-            ElemCompressTextureMipDataResult compressedTextureData = ElemCompressTextureMipData(ElemToolsGraphicsFormat_BC7, mipLevelData, NULL);
+        free(manifestEntries);
+    }
+    else
+    {
+        entries[entryCount++] = (TextureCompilerEntry) { .InputPath = argv[argc - 2], .OutputPath = argv[argc - 1] };
+    }
+
+    const char* cacheDirectoryOption = NULL;
+    const TextureCompilerFormat* outputFormat = &TextureCompilerFormats[0];
+    uint32_t maxTextureCountInFlight = 0;
+    bool useCache = true;
+    bool benchmarkDecode = false;
+
+    // TODO: Add more checks
+    for (uint32_t i = 1; i < (uint32_t)(argc - 2); i++)
+    {
+        printf("Options: %s\n", argv[i]);
 
-            DisplayOutputMessages("CompressTextureMipData", compressedTextureData.Messages);
+        if (strcmp(argv[i], "--cache-directory") == 0 && i + 1 < (uint32_t)(argc - 2))
+        {
+            cacheDirectoryOption = argv[++i];
+        }
+        else if (strcmp(argv[i], "--format") == 0 && i + 1 < (uint32_t)(argc - 2))
+        {
+            outputFormat = FindTextureCompilerFormat(argv[++i]);
 
-            if (compressedTextureData.HasErrors)
+            if (outputFormat == NULL)
             {
+                printf("Unknown texture format: %s\n", argv[i]);
                 return 1;
             }
+        }
+        else if (strcmp(argv[i], "--max-textures-in-flight") == 0 && i + 1 < (uint32_t)(argc - 2))
+        {
+            maxTextureCountInFlight = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--no-cache") == 0)
+        {
+            useCache = false;
+        }
+        else if (strcmp(argv[i], "--benchmark-decode") == 0)
+        {
+            benchmarkDecode = true;
+        }
+    }
+
+    SampleInitTimer();
+    double initialTimer = SampleGetTimerValueInMS();
+
+    if (benchmarkDecode)
+    {
+        bool result = BenchmarkTextureDecoding(entries, entryCount);
+
+        free(entries);
+        free(manifestData.Items);
+
+        return result ? 0 : 1;
+    }
+
+    ElemBuildTextureEntry* buildEntries = (ElemBuildTextureEntry*)calloc(entryCount + 1, sizeof(ElemBuildTextureEntry));
+    uint32_t* entryIndices = (uint32_t*)calloc(entryCount + 1, sizeof(uint32_t));
+    uint32_t buildEntryCount = 0;
+    uint32_t reusedTextureCount = 0;
+
+    for (uint32_t i = 0; i < entryCount; i++)
+    {
+        TextureCompilerEntry* entry = &entries[i];
+        printf("Compiling texture: %s\n", entry->InputPath);
+
+        if (useCache)
+        {
+            char cacheDirectory[MAX_PATH];
+
+            if (cacheDirectoryOption)
+            {
+                uint32_t length = strlen(cacheDirectoryOption);
+                snprintf(cacheDirectory, MAX_PATH, "%s%s", cacheDirectoryOption, (length > 0 && cacheDirectoryOption[length - 1] != '/') ? "/" : "");
+            }
+            else
+            {
+                GetFileDirectory(entry->OutputPath, cacheDirectory, MAX_PATH);
+                strncat(cacheDirectory, ".cache/", MAX_PATH - strlen(cacheDirectory) - 1);
+            }
 
-            uint32_t dataOffset = ftell(file);
-            fwrite(compressedTextureData.MipData.Data.Items, sizeof(uint8_t), compressedTextureData.MipData.Data.Length, file);
+            SampleCreateDirectory(cacheDirectory);
 
-            mipDataOffsets[i] = (SampleTextureDataBlockEntry) { .Offset = dataOffset, .SizeInBytes = ftell(file) - dataOffset };
+            if (GetTextureCacheFilePath(cacheDirectory, entry->InputPath, outputFormat->SampleFormat, entry->CacheFilePath) && CopyTextureFromCache(entry->CacheFilePath, entry->OutputPath))
+            {
+                printf("Texture reused from cache: %s\n", entry->CacheFilePath);
+                reusedTextureCount++;
+                continue;
+            }
         }
 
-        printf("Compressed data in %.2fs\n", (SampleGetTimerValueInMS() - beforeEncodeTimer) / 1000.0);
+        buildEntries[buildEntryCount] = (ElemBuildTextureEntry) { .Path = entry->InputPath, .Format = outputFormat->ToolsFormat };
+        entryIndices[buildEntryCount++] = i;
     }
-    else
+
+    TextureCompilerPayload payload =
+    {
+        .Entries = entries,
+        .EntryIndices = entryIndices
+    };
+
+    if (buildEntryCount > 0)
     {
-        for (uint32_t i = 0; i < mipData.Length; i++)
+        ElemBuildTexturesResult buildResult = ElemBuildTextures((ElemBuildTextureEntrySpan) { .Items = buildEntries, .Length = buildEntryCount }, &(ElemBuildTexturesOptions)
         {
-            ElemTextureMipData* mipLevelData = &mipData.Items[i];
-            printf("Mip level %d Size: %dx%d\n", i, mipLevelData->Width, mipLevelData->Height);
+            .MaxTextureCountInFlight = maxTextureCountInFlight,
+            .BuildTextureHandler = BuildTextureHandler,
+            .BuildTextureHandlerPayload = &payload
+        });
 
-            uint32_t dataOffset = ftell(file);
-            fwrite(mipLevelData->Data.Items, sizeof(uint8_t), mipLevelData->Data.Length, file);
+        DisplayOutputMessages("BuildTextures", buildResult.Messages);
 
-            mipDataOffsets[i] = (SampleTextureDataBlockEntry) { .Offset = dataOffset, .SizeInBytes = ftell(file) - dataOffset };
+        if (buildResult.HasErrors)
+        {
+            payload.HasErrors = true;
         }
     }
 
-    fseek(file, sizeof(SampleTextureHeader), SEEK_SET);
-    fwrite(mipDataOffsets, sizeof(SampleTextureDataBlockEntry), mipData.Length, file);
+    printf("Textures compiled in %.2fs (Reused from cache: %d, built: %d)\n", (SampleGetTimerValueInMS() - initialTimer) / 1000.0, reusedTextureCount, buildEntryCount);
+
+    free(buildEntries);
+    free(entryIndices);
+    free(entries);
+    free(manifestData.Items);
 
-    fclose(file);
-    printf("Texture compiled in %.2fs\n", (SampleGetTimerValueInMS() - initialTimer) / 1000.0);
+    return payload.HasErrors ? 1 : 0;
 }
@@ -63,6 +63,8 @@ MetalCommandListDataFull* GetMetalCommandListDataFull(ElemCommandList commandLis
 
 void ResetMetalCommandEncoder(ElemCommandList commandList);
 
+ElemFence CreateMetalCommandQueueFence(ElemCommandQueue commandQueue, MTL::CommandBuffer* commandBuffer);
+
 ElemCommandQueue MetalCreateCommandQueue(ElemGraphicsDevice graphicsDevice, ElemCommandQueueType type, const ElemCommandQueueOptions* options);
 void MetalFreeCommandQueue(ElemCommandQueue commandQueue);
 void MetalResetCommandAllocation(ElemGraphicsDevice graphicsDevice);
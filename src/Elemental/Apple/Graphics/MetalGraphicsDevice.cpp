@@ -1,5 +1,6 @@
 #include "MetalGraphicsDevice.h"
 #include "MetalConfig.h"
+#include "Graphics/ResourceDeleteQueue.h"
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemLogging.h"
@@ -414,6 +415,8 @@ void MetalFreeGraphicsDevice(ElemGraphicsDevice graphicsDevice)
 {
     SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
 
+    FreeResourceDeleteQueueBackgroundThread();
+
     auto graphicsDeviceData = GetMetalGraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
     
@@ -18,6 +18,7 @@ struct MetalGraphicsDeviceData
     MetalArgumentBuffer SamplerArgumentBuffer;
     MemoryArena MemoryArena;
     uint64_t UploadBufferGeneration;
+    uint64_t FrameIndex;
     Span<UploadBufferDevicePool<NS::SharedPtr<MTL::Buffer>>*> UploadBufferPools;
     uint32_t CurrentUploadBufferPoolIndex;
 };
@@ -8,6 +8,7 @@
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
+#include "SystemPlatformFunctions.h"
 
 SystemDataPool<MetalGraphicsHeapData, MetalGraphicsHeapDataFull> metalGraphicsHeapPool;
 SystemDataPool<MetalResourceData, MetalResourceDataFull> metalResourcePool;
@@ -78,6 +79,27 @@ MTL::PixelFormat ConvertToMetalResourceFormat(ElemGraphicsFormat format)
         case ElemGraphicsFormat_BC7_SRGB:
             return MTL::PixelFormatBC7_RGBAUnorm_sRGB;
 
+        case ElemGraphicsFormat_BC1:
+            return MTL::PixelFormatBC1_RGBA;
+
+        case ElemGraphicsFormat_BC1_SRGB:
+            return MTL::PixelFormatBC1_RGBA_sRGB;
+
+        case ElemGraphicsFormat_BC3:
+            return MTL::PixelFormatBC3_RGBA;
+
+        case ElemGraphicsFormat_BC3_SRGB:
+            return MTL::PixelFormatBC3_RGBA_sRGB;
+
+        case ElemGraphicsFormat_BC4:
+            return MTL::PixelFormatBC4_RUnorm;
+
+        case ElemGraphicsFormat_BC5:
+            return MTL::PixelFormatBC5_RGUnorm;
+
+        case ElemGraphicsFormat_BC6H:
+            return MTL::PixelFormatBC6H_RGBUfloat;
+
         default:
             return MTL::PixelFormatR8Unorm;
     }
@@ -108,6 +130,27 @@ ElemGraphicsFormat ConvertFromMetalResourceFormat(MTL::PixelFormat format)
         case MTL::PixelFormatBC7_RGBAUnorm_sRGB:
             return ElemGraphicsFormat_BC7_SRGB;
 
+        case MTL::PixelFormatBC1_RGBA:
+            return ElemGraphicsFormat_BC1;
+
+        case MTL::PixelFormatBC1_RGBA_sRGB:
+            return ElemGraphicsFormat_BC1_SRGB;
+
+        case MTL::PixelFormatBC3_RGBA:
+            return ElemGraphicsFormat_BC3;
+
+        case MTL::PixelFormatBC3_RGBA_sRGB:
+            return ElemGraphicsFormat_BC3_SRGB;
+
+        case MTL::PixelFormatBC4_RUnorm:
+            return ElemGraphicsFormat_BC4;
+
+        case MTL::PixelFormatBC5_RGUnorm:
+            return ElemGraphicsFormat_BC5;
+
+        case MTL::PixelFormatBC6H_RGBUfloat:
+            return ElemGraphicsFormat_BC6H;
+
         default:
             return ElemGraphicsFormat_Raw;
     }
@@ -367,6 +410,12 @@ ElemGraphicsResource MetalCreateGraphicsResource(ElemGraphicsHeap graphicsHeap,
             return ELEM_HANDLE_NULL;
         }
 
+        if (resourceInfo->Usage != ElemGraphicsResourceUsage_Read && GetGraphicsFormatBlockSizeInBytes(resourceInfo->Format) > 0)
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Texture2D with a block compressed format should only use the Read usage.");
+            return ELEM_HANDLE_NULL;
+        }
+
         auto textureDescriptor = CreateMetalTextureDescriptor(resourceInfo);
         resource = NS::TransferPtr(graphicsHeapData->DeviceObject->newTexture(textureDescriptor.get(), graphicsHeapOffset));
     }
@@ -444,6 +493,145 @@ ElemGraphicsResourceInfo MetalGetGraphicsResourceInfo(ElemGraphicsResource resou
     };
 }
 
+ElemGraphicsResource MetalCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+{
+    InitMetalResourceMemory();
+
+    SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
+    SystemAssert(resourceInfo);
+
+    auto graphicsDeviceData = GetMetalGraphicsDeviceData(graphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    if (!CheckSparseGraphicsResourceInfo(resourceInfo))
+    {
+        return ELEM_HANDLE_NULL;
+    }
+
+    // TODO: Metal sparse textures can only map tiles from a sparse heap and not from placement heaps so we always
+    // use the software fallback for now. The texture is created in the heap when the packed mips are bound.
+    auto textureDescriptor = CreateMetalTextureDescriptor(resourceInfo);
+    auto sizeAndAlignInfo = graphicsDeviceData->Device->heapTextureSizeAndAlign(textureDescriptor.get());
+
+    auto handle = SystemAddDataPoolItem(metalResourcePool, {
+        .Type = ElemGraphicsResourceType_Texture2D,
+        .Width = resourceInfo->Width,
+        .Height = resourceInfo->Height,
+        .MipLevels = resourceInfo->MipLevels,
+        .Format = resourceInfo->Format,
+        .Usage = resourceInfo->Usage
+    }); 
+
+    auto sparseResourceInfo = *resourceInfo;
+    sparseResourceInfo.DebugName = nullptr;
+
+    SystemAddDataPoolItemFull(metalResourcePool, handle, {
+        .GraphicsDevice = graphicsDevice,
+        .IsSparse = true,
+        .TileInfo =
+        {
+            .TileWidth = resourceInfo->Width,
+            .TileHeight = resourceInfo->Height,
+            .TileSizeInBytes = (uint32_t)SystemAlign(sizeAndAlignInfo.size, sizeAndAlignInfo.align),
+            .TileAlignmentInBytes = (uint32_t)sizeAndAlignInfo.align,
+            .PackedMipLevel = 0,
+            .PackedMipTileCount = 1,
+            .IsSoftwareFallback = true
+        },
+        .SparseResourceInfo = sparseResourceInfo
+    });
+
+    return handle;
+}
+
+ElemGraphicsResourceTileInfo MetalGetGraphicsResourceTileInfo(ElemGraphicsResource resource)
+{
+    SystemAssert(resource != ELEM_HANDLE_NULL);
+
+    auto resourceDataFull = GetMetalResourceDataFull(resource);
+
+    if (!resourceDataFull || !resourceDataFull->IsSparse)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Resource should be created with ElemCreateSparseGraphicsResource.");
+        return {};
+    }
+
+    return resourceDataFull->TileInfo;
+}
+
+ElemFence MetalBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options)
+{
+    SystemAssert(commandQueue != ELEM_HANDLE_NULL);
+    SystemAssert(resource != ELEM_HANDLE_NULL);
+
+    auto commandQueueData = GetMetalCommandQueueData(commandQueue);
+    SystemAssert(commandQueueData);
+
+    auto resourceData = GetMetalResourceData(resource);
+    auto resourceDataFull = GetMetalResourceDataFull(resource);
+
+    if (!resourceData || !resourceDataFull || !resourceDataFull->IsSparse)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Resource should be created with ElemCreateSparseGraphicsResource.");
+        return {};
+    }
+
+    auto tileInfo = &resourceDataFull->TileInfo;
+
+    for (uint32_t i = 0; i < bindings.Length; i++)
+    {
+        auto binding = &bindings.Items[i];
+        uint64_t graphicsHeapSizeInBytes = 0;
+
+        if (binding->GraphicsHeap != ELEM_HANDLE_NULL)
+        {
+            auto graphicsHeapData = GetMetalGraphicsHeapData(binding->GraphicsHeap);
+            SystemAssert(graphicsHeapData);
+
+            graphicsHeapSizeInBytes = graphicsHeapData->SizeInBytes;
+        }
+
+        if (!CheckGraphicsResourceTileBinding(&resourceDataFull->SparseResourceInfo, tileInfo, binding, graphicsHeapSizeInBytes))
+        {
+            return {};
+        }
+    }
+
+    for (uint32_t i = 0; i < bindings.Length; i++)
+    {
+        auto binding = &bindings.Items[i];
+
+        if (binding->GraphicsHeap != ELEM_HANDLE_NULL && !resourceData->DeviceObject)
+        {
+            auto graphicsHeapData = GetMetalGraphicsHeapData(binding->GraphicsHeap);
+            auto textureDescriptor = CreateMetalTextureDescriptor(&resourceDataFull->SparseResourceInfo);
+
+            resourceData->DeviceObject = NS::TransferPtr(graphicsHeapData->DeviceObject->newTexture(textureDescriptor.get(), binding->GraphicsHeapOffset));
+            resourceData->GraphicsHeap = binding->GraphicsHeap;
+        }
+    }
+
+    auto commandBuffer = NS::TransferPtr(commandQueueData->DeviceObject->commandBufferWithUnretainedReferences());
+
+    if (options && options->FencesToWait.Length > 0)
+    {
+        for (uint32_t i = 0; i < options->FencesToWait.Length; i++)
+        {
+            auto fenceToWait = options->FencesToWait.Items[i];
+
+            auto commandQueueToWaitData = GetMetalCommandQueueData(fenceToWait.CommandQueue);
+            SystemAssert(commandQueueToWaitData);
+
+            commandBuffer->encodeWait(commandQueueToWaitData->QueueEvent.get(), fenceToWait.FenceValue);
+        }
+    }
+
+    auto fence = CreateMetalCommandQueueFence(commandQueue, commandBuffer.get());
+    commandBuffer->commit();
+
+    return fence;
+}
+
 void MetalUploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data)
 {
     SystemAssert(resource != ELEM_HANDLE_NULL);
@@ -614,11 +802,12 @@ void MetalCopyDataToGraphicsResource(ElemCommandList commandList, const ElemCopy
 
     if (resourceData->Type == ElemGraphicsResourceType_Texture2D)
     {
-        if (resourceData->Format == ElemGraphicsFormat_BC7 ||
-            resourceData->Format == ElemGraphicsFormat_BC7_SRGB)
+        auto blockSizeInBytes = GetGraphicsFormatBlockSizeInBytes(resourceData->Format);
+
+        if (blockSizeInBytes > 0)
         {
-            uploadBufferAlignment = 16u;
-            uploadBufferSizeInBytes = SystemAlign(uploadBufferSizeInBytes, 16u);
+            uploadBufferAlignment = blockSizeInBytes;
+            uploadBufferSizeInBytes = SystemAlign(uploadBufferSizeInBytes, blockSizeInBytes);
         }
     }
 
@@ -665,11 +854,11 @@ void MetalCopyDataToGraphicsResource(ElemCommandList commandList, const ElemCopy
         auto mipHeight = SystemMax(1u, resourceData->Height >> mipLevel);
 
         auto sourceBytesPerRow = mipWidth * 4;
+        auto blockSizeInBytes = GetGraphicsFormatBlockSizeInBytes(resourceData->Format);
 
-        if (resourceData->Format == ElemGraphicsFormat_BC7 ||
-            resourceData->Format == ElemGraphicsFormat_BC7_SRGB)
+        if (blockSizeInBytes > 0)
         {
-            sourceBytesPerRow = ((mipWidth + 3) / 4) * 16;
+            sourceBytesPerRow = ((mipWidth + 3) / 4) * blockSizeInBytes;
         }
 
         copyCommandEncoder->copyFromBuffer(uploadBuffer.PoolItem->Buffer.get(), uploadBuffer.Offset, sourceBytesPerRow, 0, MTL::Size(mipWidth, mipHeight, 1), 
@@ -756,17 +945,15 @@ void MetalFreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor descript
     metalResourceDescriptorInfos[descriptor].Resource = ELEM_HANDLE_NULL;
 }
 
-void MetalProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
+uint32_t TrimMetalUploadBufferPools(ElemGraphicsDevice graphicsDevice)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
 
-    ProcessResourceDeleteQueue();
-    SystemClearMemoryArena(metalReadBackMemoryArena);
-    
     auto graphicsDeviceData = GetMetalGraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
 
     graphicsDeviceData->UploadBufferGeneration++;
+    uint32_t trimmedCount = 0;
     
     for (uint32_t i = 0; i < graphicsDeviceData->UploadBufferPools.Length; i++)
     {
@@ -785,9 +972,58 @@ void MetalProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
                 uploadBufferToDelete->Buffer.reset();
                 uploadBufferToDelete->CurrentOffset = 0;
                 uploadBufferToDelete->SizeInBytes = 0;
+                trimmedCount++;
             }
         }
     }
+
+    return trimmedCount;
+}
+
+void MetalProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
+{
+    WaitForResourceDeleteQueueBackgroundProcessing();
+    ProcessResourceDeleteQueue();
+    SystemClearMemoryArena(metalReadBackMemoryArena);
+    TrimMetalUploadBufferPools(graphicsDevice);
+}
+
+ElemGraphicsDeviceFrameInfo MetalAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options)
+{
+    auto graphicsDeviceData = GetMetalGraphicsDeviceData(graphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    auto ticksPerMilliseconds = (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds() / 1000.0;
+    auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    // NOTE: The previous background pass must be completed before touching the delete queue again.
+    auto deleteQueueInfo = WaitForResourceDeleteQueueBackgroundProcessing();
+
+    MetalResetCommandAllocation(graphicsDevice);
+    SystemClearMemoryArena(metalReadBackMemoryArena);
+
+    auto trimStartTimestamp = SystemPlatformGetHighPerformanceCounter();
+    auto trimmedUploadBufferCount = TrimMetalUploadBufferPools(graphicsDevice);
+    auto trimEndTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    if (options && options->ProcessDeleteQueueOnBackgroundThread)
+    {
+        ProcessResourceDeleteQueueInBackground();
+    }
+    else
+    {
+        deleteQueueInfo = ProcessResourceDeleteQueue();
+    }
+
+    return
+    {
+        .FrameIndex = graphicsDeviceData->FrameIndex++,
+        .UploadBufferTrimDurationInMilliseconds = (double)(trimEndTimestamp - trimStartTimestamp) / ticksPerMilliseconds,
+        .TrimmedUploadBufferCount = trimmedUploadBufferCount,
+        .DeleteQueueDurationInMilliseconds = deleteQueueInfo.DurationInMilliseconds,
+        .DeletedResourceCount = deleteQueueInfo.DeletedEntryCount,
+        .TotalDurationInMilliseconds = (double)(SystemPlatformGetHighPerformanceCounter() - startTimestamp) / ticksPerMilliseconds
+    };
 }
 
 MTL::SamplerMinMagFilter ConvertToMetalMinMagFilter(ElemGraphicsSamplerFilter filter)
@@ -31,6 +31,9 @@ struct MetalResourceData
 struct MetalResourceDataFull
 {
     ElemGraphicsDevice GraphicsDevice;
+    bool IsSparse;
+    ElemGraphicsResourceTileInfo TileInfo;
+    ElemGraphicsResourceInfo SparseResourceInfo;
 };
 
 struct MetalGraphicsSamplerInfo
@@ -57,6 +60,10 @@ ElemGraphicsResource MetalCreateGraphicsResource(ElemGraphicsHeap graphicsHeap,
 void MetalFreeGraphicsResource(ElemGraphicsResource resource, const ElemFreeGraphicsResourceOptions* options);
 ElemGraphicsResourceInfo MetalGetGraphicsResourceInfo(ElemGraphicsResource resource);
 
+ElemGraphicsResource MetalCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo);
+ElemGraphicsResourceTileInfo MetalGetGraphicsResourceTileInfo(ElemGraphicsResource resource);
+ElemFence MetalBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options);
+
 void MetalUploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data);
 ElemDataSpan MetalDownloadGraphicsBufferData(ElemGraphicsResource resource, const ElemDownloadGraphicsBufferDataOptions* options);
 void MetalCopyDataToGraphicsResource(ElemCommandList commandList, const ElemCopyDataToGraphicsResourceParameters* parameters);
@@ -66,6 +73,7 @@ ElemGraphicsResourceDescriptorInfo MetalGetGraphicsResourceDescriptorInfo(ElemGr
 void MetalFreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor descriptor, const ElemFreeGraphicsResourceDescriptorOptions* options);
 
 void MetalProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice);
+ElemGraphicsDeviceFrameInfo MetalAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options);
 
 ElemGraphicsResource CreateMetalGraphicsResourceFromResource(ElemGraphicsDevice graphicsDevice, ElemGraphicsResourceType type, ElemGraphicsHeap graphicsHeap, ElemGraphicsResourceUsage usage, NS::SharedPtr<MTL::Resource> resource, bool isPresentTexture);
 
@@ -81,27 +81,23 @@ MetalShaderFunctionData GetMetalShaderFunction(MetalShaderLibraryData* shaderLib
     SystemAssert(function);
     MetalShaderFunctionData result = {};
 
-    for (uint32_t i = 0; i < shaderLibraryData->GraphicsShaders.Length; i++)
-    {
-        auto shader = shaderLibraryData->Shaders[i];
+    auto shaderIndex = FindShaderIndex(&shaderLibraryData->Shaders, shaderType, function);
 
-        if (shader.ShaderType == shaderType && SystemFindSubString(shader.Name, function) != -1)
+    if (shaderIndex != -1)
+    {
+        auto shader = shaderLibraryData->Shaders.Shaders[shaderIndex];
+        result.Function = NS::TransferPtr(shaderLibraryData->GraphicsShaders[shaderIndex]->newFunction(NS::String::string(function, NS::UTF8StringEncoding)));
+        
+        for (uint32_t i = 0; i < shader.Metadata.Length; i++)
         {
-            result.Function = NS::TransferPtr(shaderLibraryData->GraphicsShaders[i]->newFunction(NS::String::string(function, NS::UTF8StringEncoding)));
-            
-            for (uint32_t j = 0; j < shader.Metadata.Length; j++)
-            {
-                auto metaData = shader.Metadata[j];
+            auto metaData = shader.Metadata[i];
 
-                if (metaData.Type == ShaderMetadataType_ThreadGroupSize)
-                {
-                    result.MetaData.ThreadSizeX = metaData.Value[0];
-                    result.MetaData.ThreadSizeY = metaData.Value[1];
-                    result.MetaData.ThreadSizeZ = metaData.Value[2];
-                }
+            if (metaData.Type == ShaderMetadataType_ThreadGroupSize)
+            {
+                result.MetaData.ThreadSizeX = metaData.Value[0];
+                result.MetaData.ThreadSizeY = metaData.Value[1];
+                result.MetaData.ThreadSizeZ = metaData.Value[2];
             }
-
-            break;
         }
     }
         
@@ -188,7 +184,7 @@ MTL::BlendFactor ConvertToMetalBlendFactor(ElemGraphicsBlendFactor blendFactor)
     }
 }
 
-ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData)
+ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex)
 {
     InitMetalShaderLibraryMemory();
     SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
@@ -200,7 +196,8 @@ ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, El
     
     NS::SharedPtr<MTL::Library> metalLibrary = {};
     Span<NS::SharedPtr<MTL::Library>> graphicsShaderData = {};
-    ReadOnlySpan<Shader> shaders = {};
+    ShaderLibrary shaders = {};
+    MemoryArena libraryMemoryArena = {};
 
     if (CheckMetalShaderDataHeader(shaderLibraryData, "MTL"))
     {
@@ -219,16 +216,24 @@ ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, El
     }
     else 
     {
-        auto dataSpan = Span<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length); 
+        // NOTE: The shaders point directly into the library data so it is copied because the caller can free it. The
+        // copy is stored in the memory arena of the library so it is released by MetalFreeShaderLibrary.
+        auto libraryData = ReadOnlySpan<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length);
+        libraryMemoryArena = SystemAllocateMemoryArena(GetShaderLibraryMemorySize(libraryData, sizeof(NS::SharedPtr<MTL::Library>)));
 
-        // HACK: This is bad to allocate this here but this should be temporary
-        // Here the solution should be to define a memory arena per library (malloc style)
-        shaders = ReadShaders(MetalGraphicsMemoryArena, dataSpan);
-        graphicsShaderData = SystemPushArray<NS::SharedPtr<MTL::Library>>(MetalGraphicsMemoryArena, shaders.Length);
+        auto dataSpan = SystemDuplicateBuffer<uint8_t>(libraryMemoryArena, libraryData); 
+
+        shaders = ReadShaders(libraryMemoryArena, dataSpan, permutationIndex);
+        graphicsShaderData = SystemPushArrayZero<NS::SharedPtr<MTL::Library>>(libraryMemoryArena, shaders.Shaders.Length);
         
-        for (uint32_t i = 0; i < shaders.Length; i++)
+        for (uint32_t i = 0; i < shaders.Shaders.Length; i++)
         {
-            auto dispatchData = dispatch_data_create(shaders[i].ShaderCode.Pointer, shaders[i].ShaderCode.Length, nullptr, nullptr);
+            if (shaders.Shaders[i].ShaderCode.Length == 0)
+            {
+                continue;
+            }
+
+            auto dispatchData = dispatch_data_create(shaders.Shaders[i].ShaderCode.Pointer, shaders.Shaders[i].ShaderCode.Length, nullptr, nullptr);
 
             NS::Error* errorPointer;
             graphicsShaderData[i] = NS::TransferPtr(graphicsDeviceData->Device->newLibrary(dispatchData, &errorPointer));
@@ -246,12 +251,20 @@ ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, El
                 }
 
                 SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Cannot create shader library. Error Code: %d => %s", libraryError->code(), errorMessage);
+
+                for (uint32_t j = 0; j < i; j++)
+                {
+                    graphicsShaderData[j].reset();
+                }
+
+                SystemFreeMemoryArena(libraryMemoryArena);
                 return ELEM_HANDLE_NULL;
             }
         }
     }
 
     auto handle = SystemAddDataPoolItem(metalShaderLibraryPool, {
+        .MemoryArena = libraryMemoryArena,
         .MetalLibrary = metalLibrary,
         .GraphicsShaders = graphicsShaderData,
         .Shaders = shaders
@@ -262,7 +275,24 @@ ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, El
 
 void MetalFreeShaderLibrary(ElemShaderLibrary shaderLibrary)
 {
-    // TODO: Free data
+    SystemAssert(shaderLibrary != ELEM_HANDLE_NULL);
+
+    auto shaderLibraryData = GetMetalShaderLibraryData(shaderLibrary);
+    SystemAssert(shaderLibraryData);
+
+    for (uint32_t i = 0; i < shaderLibraryData->GraphicsShaders.Length; i++)
+    {
+        shaderLibraryData->GraphicsShaders[i].reset();
+    }
+
+    shaderLibraryData->MetalLibrary.reset();
+
+    if (shaderLibraryData->MemoryArena.Storage != nullptr)
+    {
+        SystemFreeMemoryArena(shaderLibraryData->MemoryArena);
+    }
+
+    SystemRemoveDataPoolItem(metalShaderLibraryPool, shaderLibrary);
 }
 
 ElemPipelineState MetalCompileGraphicsPipelineState(ElemGraphicsDevice graphicsDevice, const ElemGraphicsPipelineStateParameters* parameters)
@@ -6,9 +6,10 @@
 
 struct MetalShaderLibraryData
 {
+    MemoryArena MemoryArena;
     NS::SharedPtr<MTL::Library> MetalLibrary;
     Span<NS::SharedPtr<MTL::Library>> GraphicsShaders;
-    ReadOnlySpan<Shader> Shaders;
+    ShaderLibrary Shaders;
 };
 
 struct MetalShaderMetaData
@@ -41,7 +42,7 @@ MetalPipelineStateDataFull* GetMetalPipelineStateDataFull(ElemPipelineState pipe
 
 bool CheckMetalCommandEncoderType(const MetalCommandListData* commandListData, MetalCommandEncoderType type);
 
-ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData);
+ElemShaderLibrary MetalCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex);
 void MetalFreeShaderLibrary(ElemShaderLibrary shaderLibrary);
 ElemPipelineState MetalCompileGraphicsPipelineState(ElemGraphicsDevice graphicsDevice, const ElemGraphicsPipelineStateParameters* parameters);
 ElemPipelineState MetalCompileComputePipelineState(ElemGraphicsDevice graphicsDevice, const ElemComputePipelineStateParameters* parameters);
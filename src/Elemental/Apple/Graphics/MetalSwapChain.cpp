@@ -302,6 +302,11 @@ void MetalDisplayLinkHandler::metalDisplayLinkNeedsUpdate(CA::MetalDisplayLink*
             .SizeChanged = sizeChanged
         };
 
+        auto graphicsDeviceData = GetMetalGraphicsDeviceData(swapChainData->GraphicsDevice);
+        SystemAssert(graphicsDeviceData);
+
+        auto frameIndex = graphicsDeviceData->FrameIndex;
+
         _updateHandler(&updateParameters, _updatePayload);
         ResetInputsFrame();
 
@@ -313,6 +318,10 @@ void MetalDisplayLinkHandler::metalDisplayLinkNeedsUpdate(CA::MetalDisplayLink*
         
         MetalFreeGraphicsResource(backBufferTexture, nullptr);
 
-        MetalProcessGraphicsResourceDeleteQueue(swapChainData->GraphicsDevice);
+        // NOTE: If the application has advanced the frame itself during the update, we don't do it twice.
+        if (graphicsDeviceData->FrameIndex == frameIndex)
+        {
+            MetalAdvanceGraphicsDeviceFrame(swapChainData->GraphicsDevice, nullptr);
+        }
     }
 }
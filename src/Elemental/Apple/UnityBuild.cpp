@@ -31,6 +31,9 @@
 
 #include "Inputs/Inputs.cpp"
 
+#include "Scenes/SceneContainer.cpp"
+#include "Textures/TextureContainer.cpp"
+
 #include "PosixPlatformFunctions.cpp"
 #include "SystemPlatformFunctions.cpp"
 #include "SystemLogging.cpp"
@@ -1,5 +1,7 @@
 #include "Resource.h"
 #include "GraphicsCommon.h"
+#include "SystemFunctions.h"
+#include "SystemLogging.h"
 
 bool CheckDepthStencilFormat(ElemGraphicsFormat format)
 {
@@ -11,6 +13,127 @@ bool CheckDepthStencilFormat(ElemGraphicsFormat format)
     return false;
 }
 
+uint32_t GetGraphicsFormatBlockSizeInBytes(ElemGraphicsFormat format)
+{
+    switch (format)
+    {
+        case ElemGraphicsFormat_BC1:
+        case ElemGraphicsFormat_BC1_SRGB:
+        case ElemGraphicsFormat_BC4:
+            return 8;
+
+        case ElemGraphicsFormat_BC3:
+        case ElemGraphicsFormat_BC3_SRGB:
+        case ElemGraphicsFormat_BC5:
+        case ElemGraphicsFormat_BC6H:
+        case ElemGraphicsFormat_BC7:
+        case ElemGraphicsFormat_BC7_SRGB:
+            return 16;
+
+        default:
+            return 0;
+    }
+}
+
+uint32_t GetGraphicsFormatElementSizeInBytes(ElemGraphicsFormat format)
+{
+    switch (format)
+    {
+        case ElemGraphicsFormat_B8G8R8A8_SRGB:
+        case ElemGraphicsFormat_B8G8R8A8:
+        case ElemGraphicsFormat_D32_FLOAT:
+            return 4;
+
+        case ElemGraphicsFormat_R16G16B16A16_FLOAT:
+            return 8;
+
+        case ElemGraphicsFormat_R32G32B32A32_FLOAT:
+            return 16;
+
+        case ElemGraphicsFormat_Raw:
+            return 1;
+
+        default:
+            return GetGraphicsFormatBlockSizeInBytes(format);
+    }
+}
+
+bool CheckSparseGraphicsResourceInfo(const ElemGraphicsResourceInfo* resourceInfo)
+{
+    SystemAssert(resourceInfo);
+
+    if (resourceInfo->Type != ElemGraphicsResourceType_Texture2D)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse resources are only supported for Texture2D.");
+        return false;
+    }
+
+    if (resourceInfo->Width == 0 || resourceInfo->Height == 0 || resourceInfo->MipLevels == 0)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse Texture2D width, height and mipLevels should not be equals to 0.");
+        return false;
+    }
+
+    if (resourceInfo->Usage & (ElemGraphicsResourceUsage_RenderTarget | ElemGraphicsResourceUsage_DepthStencil))
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse Texture2D should only use the Read or Write usage.");
+        return false;
+    }
+
+    if (resourceInfo->Usage != ElemGraphicsResourceUsage_Read && GetGraphicsFormatBlockSizeInBytes(resourceInfo->Format) > 0)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Texture2D with a block compressed format should only use the Read usage.");
+        return false;
+    }
+
+    return true;
+}
+
+bool CheckGraphicsResourceTileBinding(const ElemGraphicsResourceInfo* resourceInfo, const ElemGraphicsResourceTileInfo* tileInfo, const ElemGraphicsResourceTileBinding* binding, uint64_t graphicsHeapSizeInBytes)
+{
+    SystemAssert(resourceInfo);
+    SystemAssert(tileInfo);
+    SystemAssert(binding);
+
+    if (binding->MipLevel >= resourceInfo->MipLevels)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse tile binding mip level should be less than the texture mip levels.");
+        return false;
+    }
+
+    uint64_t tileCount = tileInfo->PackedMipTileCount;
+
+    if (binding->MipLevel < tileInfo->PackedMipLevel)
+    {
+        auto mipWidth = SystemMax(resourceInfo->Width >> binding->MipLevel, 1u);
+        auto mipHeight = SystemMax(resourceInfo->Height >> binding->MipLevel, 1u);
+        auto mipTileCountX = (mipWidth + tileInfo->TileWidth - 1) / tileInfo->TileWidth;
+        auto mipTileCountY = (mipHeight + tileInfo->TileHeight - 1) / tileInfo->TileHeight;
+
+        if (binding->TileCountX == 0 || binding->TileCountY == 0 || 
+            binding->TileX + binding->TileCountX > mipTileCountX || 
+            binding->TileY + binding->TileCountY > mipTileCountY)
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse tile binding region should be inside the mip level.");
+            return false;
+        }
+
+        tileCount = (uint64_t)binding->TileCountX * binding->TileCountY;
+    }
+
+    if (binding->GraphicsHeap != ELEM_HANDLE_NULL)
+    {
+        if ((binding->GraphicsHeapOffset % tileInfo->TileAlignmentInBytes) != 0 || 
+            binding->GraphicsHeapOffset + tileCount * tileInfo->TileSizeInBytes > graphicsHeapSizeInBytes)
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse tile binding heap range should be aligned on the tile alignment and fit in the graphics heap.");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 ElemAPI ElemGraphicsHeap ElemCreateGraphicsHeap(ElemGraphicsDevice graphicsDevice, uint64_t sizeInBytes, const ElemGraphicsHeapOptions* options)
 {
     DispatchReturnGraphicsFunction(CreateGraphicsHeap, graphicsDevice, sizeInBytes, options);
@@ -46,6 +169,21 @@ ElemAPI ElemGraphicsResourceInfo ElemGetGraphicsResourceInfo(ElemGraphicsResourc
     DispatchReturnGraphicsFunction(GetGraphicsResourceInfo, resource);
 }
 
+ElemAPI ElemGraphicsResource ElemCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+{
+    DispatchReturnGraphicsFunction(CreateSparseGraphicsResource, graphicsDevice, resourceInfo);
+}
+
+ElemAPI ElemGraphicsResourceTileInfo ElemGetGraphicsResourceTileInfo(ElemGraphicsResource resource)
+{
+    DispatchReturnGraphicsFunction(GetGraphicsResourceTileInfo, resource);
+}
+
+ElemAPI ElemFence ElemBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options)
+{
+    DispatchReturnGraphicsFunction(BindGraphicsResourceTiles, commandQueue, resource, bindings, options);
+}
+
 ElemAPI void ElemUploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data)
 {
     DispatchGraphicsFunction(UploadGraphicsBufferData, resource, offset, data);
@@ -86,6 +224,11 @@ ElemAPI void ElemProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsD
     DispatchGraphicsFunction(ProcessGraphicsResourceDeleteQueue, graphicsDevice);
 }
 
+ElemAPI ElemGraphicsDeviceFrameInfo ElemAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options)
+{
+    DispatchReturnGraphicsFunction(AdvanceGraphicsDeviceFrame, graphicsDevice, options);
+}
+
 ElemAPI ElemGraphicsSampler ElemCreateGraphicsSampler(ElemGraphicsDevice graphicsDevice, const ElemGraphicsSamplerInfo* samplerInfo)
 {
     DispatchReturnGraphicsFunction(CreateGraphicsSampler, graphicsDevice, samplerInfo);
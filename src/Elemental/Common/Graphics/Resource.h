@@ -3,3 +3,12 @@
 #include "../Elemental.h"
 
 bool CheckDepthStencilFormat(ElemGraphicsFormat format);
+
+// NOTE: Returns 0 for the formats that are not block compressed.
+uint32_t GetGraphicsFormatBlockSizeInBytes(ElemGraphicsFormat format);
+
+// NOTE: Returns the size of a texel, or of a block for the block compressed formats.
+uint32_t GetGraphicsFormatElementSizeInBytes(ElemGraphicsFormat format);
+
+bool CheckSparseGraphicsResourceInfo(const ElemGraphicsResourceInfo* resourceInfo);
+bool CheckGraphicsResourceTileBinding(const ElemGraphicsResourceInfo* resourceInfo, const ElemGraphicsResourceTileInfo* tileInfo, const ElemGraphicsResourceTileBinding* binding, uint64_t graphicsHeapSizeInBytes);
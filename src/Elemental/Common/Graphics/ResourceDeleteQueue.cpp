@@ -1,16 +1,17 @@
 #include "ResourceDeleteQueue.h"
+#include "SystemFunctions.h"
 #include "SystemLogging.h"
+#include "SystemPlatformFunctions.h"
 
 #define RESOURCE_DELETEQUEUE_MAX_ITEMS 512
 
-// TODO: Thread safe
-
 struct ResourceDeleteQueueEntry
 {
     ElemHandle Resource;
     ResourceDeleteType Type;
     ElemFence Fences[16];
     uint32_t FenceCount;
+    bool FencesCompleted;
     int32_t NextEntry;
 };
 
@@ -18,6 +19,36 @@ Span<ResourceDeleteQueueEntry> GraphicsResourceDeleteQueue;
 uint32_t CurrentGraphicsResourceDeleteQueueIndex;
 int32_t GraphicsResourceDeleteQueueFreeListIndex;
 
+// NOTE: Enqueue and the fence checks can run on different threads when the processing is done in the background
+// so the queue is protected by a simple spin lock. Both operations are short so contention is low.
+// The resources are always freed on the calling thread because the data pools and descriptor free lists
+// are not thread safe.
+uint32_t GraphicsResourceDeleteQueueLock;
+
+SystemThread GraphicsResourceDeleteQueueThread;
+SystemSignal GraphicsResourceDeleteQueueStartSignal;
+SystemSignal GraphicsResourceDeleteQueueCompletedSignal;
+bool GraphicsResourceDeleteQueueThreadCreated;
+bool GraphicsResourceDeleteQueueThreadExit;
+bool GraphicsResourceDeleteQueuePassRunning;
+uint64_t GraphicsResourceDeleteQueueBackgroundTicks;
+
+void LockResourceDeleteQueue()
+{
+    uint32_t expectedValue = 0;
+
+    while (!SystemAtomicCompareExchange(GraphicsResourceDeleteQueueLock, expectedValue, 1u))
+    {
+        expectedValue = 0;
+        SystemYieldThread();
+    }
+}
+
+void UnlockResourceDeleteQueue()
+{
+    SystemAtomicStore(GraphicsResourceDeleteQueueLock, 0u);
+}
+
 void InitResourceDeleteQueueMemory(MemoryArena memoryArena)
 {
     if (GraphicsResourceDeleteQueue.Length == 0)
@@ -32,9 +63,11 @@ void EnqueueResourceDeleteEntry(MemoryArena memoryArena, ElemHandle resource, Re
 {
     InitResourceDeleteQueueMemory(memoryArena);
 
-    ResourceDeleteQueueEntry entry = { .Resource = resource, .Type = type, .FenceCount = fences.Length, .NextEntry = -1 };
+    ResourceDeleteQueueEntry entry = { .Resource = resource, .Type = type, .FenceCount = fences.Length, .FencesCompleted = false, .NextEntry = -1 };
     SystemCopyBuffer(Span<ElemFence>(entry.Fences, 16), ReadOnlySpan<ElemFence>(fences.Items, fences.Length));
 
+    LockResourceDeleteQueue();
+
     uint32_t index = 0;
 
     if (GraphicsResourceDeleteQueueFreeListIndex != -1)
@@ -48,48 +81,181 @@ void EnqueueResourceDeleteEntry(MemoryArena memoryArena, ElemHandle resource, Re
     }
 
     GraphicsResourceDeleteQueue[index] = entry;
+
+    UnlockResourceDeleteQueue();
+}
+
+bool IsResourceDeleteQueueEntryPending(ResourceDeleteQueueEntry* entry)
+{
+    return (entry->Type == ResourceDeleteType_Resource && entry->Resource != ELEM_HANDLE_NULL) ||
+           (entry->Type == ResourceDeleteType_Descriptor && (int)entry->Resource != -1) ||
+           (entry->Type == ResourceDeleteType_Sampler && (int)entry->Resource != -1);
 }
 
-void ProcessResourceDeleteQueue()
+void CheckResourceDeleteQueueFences()
 {
+    LockResourceDeleteQueue();
+
     for (uint32_t i = 0; i < CurrentGraphicsResourceDeleteQueueIndex; i++)
     {
         auto entry = &GraphicsResourceDeleteQueue[i];
 
-        if ((entry->Type == ResourceDeleteType_Resource && entry->Resource != ELEM_HANDLE_NULL) ||
-            (entry->Type == ResourceDeleteType_Descriptor && (int)entry->Resource != -1) ||
-            (entry->Type == ResourceDeleteType_Sampler && (int)entry->Resource != -1))
+        if (!IsResourceDeleteQueueEntryPending(entry) || entry->FencesCompleted)
         {
-            auto fencesCompleted = true;
+            continue;
+        }
 
-            for (uint32_t j = 0; j < entry->FenceCount; j++)
-            {
-                if (!ElemIsFenceCompleted(entry->Fences[j]))
-                {
-                    fencesCompleted = false;
-                    break;
-                }
-            }
+        auto fencesCompleted = true;
 
-            if (fencesCompleted)
+        for (uint32_t j = 0; j < entry->FenceCount; j++)
+        {
+            if (!ElemIsFenceCompleted(entry->Fences[j]))
             {
-                if (entry->Type == ResourceDeleteType_Resource)
-                {
-                    ElemFreeGraphicsResource(entry->Resource, nullptr);
-                }
-                else if (entry->Type == ResourceDeleteType_Descriptor)
-                {
-                    ElemFreeGraphicsResourceDescriptor(entry->Resource, nullptr);
-                }
-                else if (entry->Type == ResourceDeleteType_Sampler)
-                {
-                    ElemFreeGraphicsSampler(entry->Resource, nullptr);
-                }
-
-                entry->Resource = ELEM_HANDLE_NULL;
-                entry->NextEntry = GraphicsResourceDeleteQueueFreeListIndex;
-                GraphicsResourceDeleteQueueFreeListIndex = i;
+                fencesCompleted = false;
+                break;
             }
         }
+
+        entry->FencesCompleted = fencesCompleted;
     }
+
+    UnlockResourceDeleteQueue();
+}
+
+uint32_t FreeCompletedResourceDeleteQueueEntries()
+{
+    uint32_t deletedEntryCount = 0;
+
+    LockResourceDeleteQueue();
+
+    for (uint32_t i = 0; i < CurrentGraphicsResourceDeleteQueueIndex; i++)
+    {
+        auto entry = &GraphicsResourceDeleteQueue[i];
+
+        if (!IsResourceDeleteQueueEntryPending(entry) || !entry->FencesCompleted)
+        {
+            continue;
+        }
+
+        if (entry->Type == ResourceDeleteType_Resource)
+        {
+            ElemFreeGraphicsResource(entry->Resource, nullptr);
+        }
+        else if (entry->Type == ResourceDeleteType_Descriptor)
+        {
+            ElemFreeGraphicsResourceDescriptor(entry->Resource, nullptr);
+        }
+        else if (entry->Type == ResourceDeleteType_Sampler)
+        {
+            ElemFreeGraphicsSampler(entry->Resource, nullptr);
+        }
+
+        entry->Resource = ELEM_HANDLE_NULL;
+        entry->FencesCompleted = false;
+        entry->NextEntry = GraphicsResourceDeleteQueueFreeListIndex;
+        GraphicsResourceDeleteQueueFreeListIndex = i;
+        deletedEntryCount++;
+    }
+
+    UnlockResourceDeleteQueue();
+
+    return deletedEntryCount;
+}
+
+ResourceDeleteQueueProcessInfo ProcessResourceDeleteQueue()
+{
+    auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    CheckResourceDeleteQueueFences();
+    auto deletedEntryCount = FreeCompletedResourceDeleteQueueEntries();
+
+    auto elapsedTicks = SystemPlatformGetHighPerformanceCounter() - startTimestamp;
+
+    return
+    {
+        .DeletedEntryCount = deletedEntryCount,
+        .DurationInMilliseconds = (double)elapsedTicks * 1000.0 / (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds()
+    };
+}
+
+void ResourceDeleteQueueThreadFunction(void* parameters)
+{
+    while (true)
+    {
+        SystemWaitSignal(GraphicsResourceDeleteQueueStartSignal);
+
+        if (GraphicsResourceDeleteQueueThreadExit)
+        {
+            break;
+        }
+
+        auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+        CheckResourceDeleteQueueFences();
+        GraphicsResourceDeleteQueueBackgroundTicks = SystemPlatformGetHighPerformanceCounter() - startTimestamp;
+
+        SystemSetSignal(GraphicsResourceDeleteQueueCompletedSignal);
+    }
+
+    SystemFreeStackMemoryArena();
+}
+
+void ProcessResourceDeleteQueueInBackground()
+{
+    SystemAssert(!GraphicsResourceDeleteQueuePassRunning);
+
+    if (!GraphicsResourceDeleteQueueThreadCreated)
+    {
+        GraphicsResourceDeleteQueueStartSignal = SystemCreateSignal();
+        GraphicsResourceDeleteQueueCompletedSignal = SystemCreateSignal();
+        GraphicsResourceDeleteQueueThreadExit = false;
+        GraphicsResourceDeleteQueueThread = SystemCreateThread(ResourceDeleteQueueThreadFunction, nullptr);
+        GraphicsResourceDeleteQueueThreadCreated = true;
+    }
+
+    GraphicsResourceDeleteQueueBackgroundTicks = 0;
+    GraphicsResourceDeleteQueuePassRunning = true;
+    SystemSetSignal(GraphicsResourceDeleteQueueStartSignal);
+}
+
+ResourceDeleteQueueProcessInfo WaitForResourceDeleteQueueBackgroundProcessing()
+{
+    if (!GraphicsResourceDeleteQueuePassRunning)
+    {
+        return {};
+    }
+
+    SystemWaitSignal(GraphicsResourceDeleteQueueCompletedSignal);
+    GraphicsResourceDeleteQueuePassRunning = false;
+
+    // NOTE: The background pass only checks the fences. The entries that are ready are freed here
+    // on the calling thread.
+    auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+    auto deletedEntryCount = FreeCompletedResourceDeleteQueueEntries();
+    auto elapsedTicks = SystemPlatformGetHighPerformanceCounter() - startTimestamp + GraphicsResourceDeleteQueueBackgroundTicks;
+
+    return
+    {
+        .DeletedEntryCount = deletedEntryCount,
+        .DurationInMilliseconds = (double)elapsedTicks * 1000.0 / (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds()
+    };
+}
+
+void FreeResourceDeleteQueueBackgroundThread()
+{
+    WaitForResourceDeleteQueueBackgroundProcessing();
+
+    if (!GraphicsResourceDeleteQueueThreadCreated)
+    {
+        return;
+    }
+
+    GraphicsResourceDeleteQueueThreadExit = true;
+    SystemSetSignal(GraphicsResourceDeleteQueueStartSignal);
+
+    SystemWaitThread(GraphicsResourceDeleteQueueThread);
+    SystemFreeThread(GraphicsResourceDeleteQueueThread);
+    SystemFreeSignal(GraphicsResourceDeleteQueueStartSignal);
+    SystemFreeSignal(GraphicsResourceDeleteQueueCompletedSignal);
+
+    GraphicsResourceDeleteQueueThreadCreated = false;
 }
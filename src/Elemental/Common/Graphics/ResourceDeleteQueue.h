@@ -10,5 +10,17 @@ enum ResourceDeleteType
     ResourceDeleteType_Sampler
 };
 
+struct ResourceDeleteQueueProcessInfo
+{
+    uint32_t DeletedEntryCount;
+    double DurationInMilliseconds;
+};
+
 void EnqueueResourceDeleteEntry(MemoryArena memoryArena, ElemHandle resource, ResourceDeleteType type, ElemFenceSpan fences);
-void ProcessResourceDeleteQueue();
+ResourceDeleteQueueProcessInfo ProcessResourceDeleteQueue();
+
+// NOTE: Only one background pass can be in flight. The caller must wait for it before starting a new one.
+// The background pass only checks the fences, the resources are freed by the wait on the calling thread.
+void ProcessResourceDeleteQueueInBackground();
+ResourceDeleteQueueProcessInfo WaitForResourceDeleteQueueBackgroundProcessing();
+void FreeResourceDeleteQueueBackgroundThread();
@@ -13,7 +13,12 @@ bool IsBlendEnabled(ElemGraphicsPipelineStateRenderTarget renderTargetParameters
 
 ElemAPI ElemShaderLibrary ElemCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData)
 {
-    DispatchReturnGraphicsFunction(CreateShaderLibrary, graphicsDevice, shaderLibraryData);
+    DispatchReturnGraphicsFunction(CreateShaderLibrary, graphicsDevice, shaderLibraryData, 0);
+}
+
+ElemAPI ElemShaderLibrary ElemCreateShaderLibraryPermutation(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex)
+{
+    DispatchReturnGraphicsFunction(CreateShaderLibrary, graphicsDevice, shaderLibraryData, permutationIndex);
 }
 
 ElemAPI void ElemFreeShaderLibrary(ElemShaderLibrary shaderLibrary)
@@ -1,78 +1,220 @@
 #include "ShaderReader.h"
+#include "SystemFunctions.h"
+#include "SystemLogging.h"
 
+#define SHADER_LIBRARY_MIN_MEMORY_SIZE 64 * 1024
+
+// NOTE: The returned spans point into the data so it must stay alive while the shaders are used.
 template<typename T>
-T ReadShaderData(ReadOnlySpan<uint8_t> data, uint32_t* currentOffset)
+ReadOnlySpan<T> GetShaderLibrarySpan(ReadOnlySpan<uint8_t> data, uint32_t offset, uint32_t count)
 {
-    auto dataSpan = Span<uint8_t>((uint8_t*)data.Pointer, data.Length);
-    auto result = *(T*)dataSpan.Slice(*currentOffset).Pointer; 
-    *currentOffset += sizeof(T);
-    return result;
+    return ReadOnlySpan<T>((T*)(data.Pointer + offset), count);
 }
 
-Span<uint8_t> ReadShaderData(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data, uint32_t* currentOffset)
+ReadOnlySpan<char> GetShaderLibraryString(ReadOnlySpan<uint8_t> data, uint32_t offset, uint32_t length)
 {
-    auto shaderPartSizeInBytes = ReadShaderData<uint32_t>(data, currentOffset);
-    auto result = SystemPushArray<uint8_t>(memoryArena, shaderPartSizeInBytes);
+    return ReadOnlySpan<char>((const char*)(data.Pointer + offset), length);
+}
 
-    auto dataSpan = Span<uint8_t>((uint8_t*)data.Pointer, data.Length);
-    SystemCopyBuffer(result, ReadOnlySpan<uint8_t>(dataSpan.Slice(*currentOffset, shaderPartSizeInBytes))); 
-    *currentOffset += shaderPartSizeInBytes;
-    return result;
+// NOTE: The sizes are computed in 64 bits so corrupted offsets or counts cannot wrap around.
+bool CheckShaderLibraryRange(const ShaderLibraryHeader* header, uint64_t offset, uint64_t sizeInBytes)
+{
+    return offset <= header->DataSizeInBytes && sizeInBytes <= header->DataSizeInBytes - offset;
 }
 
-ReadOnlySpan<char> ReadShaderStringData(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data, uint32_t* currentOffset)
+// NOTE: All the offsets and indices are validated once when the library is loaded so the shaders can be
+// read without checks afterwards.
+bool ValidateShaderLibrary(ReadOnlySpan<uint8_t> data)
 {
-    auto stringLength = ReadShaderData<uint32_t>(data, currentOffset);
-    auto result = SystemPushArray<uint8_t>(memoryArena, stringLength);
+    auto header = (const ShaderLibraryHeader*)data.Pointer;
+
+    if (!CheckShaderLibraryRange(header, header->ShadersOffset, (uint64_t)header->ShaderCount * sizeof(ShaderLibraryShaderEntry)) ||
+        !CheckShaderLibraryRange(header, header->FunctionsOffset, (uint64_t)header->FunctionCount * sizeof(ShaderLibraryFunctionEntry)) ||
+        !CheckShaderLibraryRange(header, header->FunctionHashTableOffset, (uint64_t)header->FunctionHashTableSize * sizeof(uint32_t)) ||
+        !CheckShaderLibraryRange(header, header->PermutationTableOffset, (uint64_t)header->PermutationCount * header->FunctionCount * sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    if ((header->FunctionHashTableSize & (header->FunctionHashTableSize - 1)) != 0)
+    {
+        return false;
+    }
+
+    auto shaderEntries = GetShaderLibrarySpan<ShaderLibraryShaderEntry>(data, header->ShadersOffset, header->ShaderCount);
+
+    for (uint32_t i = 0; i < shaderEntries.Length; i++)
+    {
+        auto shaderEntry = &shaderEntries[i];
+
+        if (!CheckShaderLibraryRange(header, shaderEntry->NameOffset, shaderEntry->NameLength) ||
+            !CheckShaderLibraryRange(header, shaderEntry->MetadataOffset, (uint64_t)shaderEntry->MetadataCount * sizeof(ShaderMetadata)) ||
+            !CheckShaderLibraryRange(header, shaderEntry->CodeOffset, shaderEntry->CodeSizeInBytes))
+        {
+            return false;
+        }
+    }
+
+    auto functionEntries = GetShaderLibrarySpan<ShaderLibraryFunctionEntry>(data, header->FunctionsOffset, header->FunctionCount);
+
+    for (uint32_t i = 0; i < functionEntries.Length; i++)
+    {
+        if (!CheckShaderLibraryRange(header, functionEntries[i].NameOffset, functionEntries[i].NameLength))
+        {
+            return false;
+        }
+    }
+
+    auto permutationShaderIndices = GetShaderLibrarySpan<uint32_t>(data, header->PermutationTableOffset, header->PermutationCount * header->FunctionCount);
+
+    for (uint32_t i = 0; i < permutationShaderIndices.Length; i++)
+    {
+        if (permutationShaderIndices[i] != SHADER_PERMUTATION_NO_PART && permutationShaderIndices[i] >= header->ShaderCount)
+        {
+            return false;
+        }
+    }
+
+    auto functionHashTable = GetShaderLibrarySpan<uint32_t>(data, header->FunctionHashTableOffset, header->FunctionHashTableSize);
+
+    for (uint32_t i = 0; i < functionHashTable.Length; i++)
+    {
+        if (functionHashTable[i] != SHADER_PERMUTATION_NO_PART && functionHashTable[i] >= header->FunctionCount)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
 
-    auto dataSpan = Span<uint8_t>((uint8_t*)data.Pointer, data.Length);
-    SystemCopyBuffer(result, ReadOnlySpan<uint8_t>(dataSpan.Slice(*currentOffset, stringLength))); 
-    *currentOffset += stringLength;
-    return ReadOnlySpan<char>((char*)result.Pointer);
+uint64_t ComputeShaderFunctionHash(ShaderType shaderType, ReadOnlySpan<char> name)
+{
+    return XXH64(name.Pointer, name.Length, (uint64_t)shaderType);
 }
 
-ReadOnlySpan<Shader> ReadShaders(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data)
+size_t GetShaderLibraryMemorySize(ReadOnlySpan<uint8_t> data, size_t extraSizePerFunction)
 {
-    uint32_t currentOffset = 0;
+    auto sizeInBytes = SHADER_LIBRARY_MIN_MEMORY_SIZE + SystemAlign(data.Length, 8);
+
+    if (data.Length >= sizeof(ShaderLibraryHeader))
+    {
+        auto header = (const ShaderLibraryHeader*)data.Pointer;
+
+        // NOTE: The header is not validated yet, the function entries are stored in the data so their count is bounded
+        // by its size.
+        auto functionCount = SystemMin((size_t)header->FunctionCount, data.Length / sizeof(ShaderLibraryFunctionEntry));
+        sizeInBytes += SystemAlign(functionCount * sizeof(Shader), 8) + SystemAlign(functionCount * extraSizePerFunction, 8);
+    }
 
-    char signature[9] = { };
+    return sizeInBytes;
+}
 
-    for (uint32_t i = 0; i < ARRAYSIZE(signature) - 1; i++)
+ShaderLibrary ReadShaders(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data, uint32_t permutationIndex)
+{
+    if (data.Length < sizeof(ShaderLibraryHeader))
     {
-        signature[i] = ReadShaderData<char>(data, &currentOffset);
+        return {}; 
     }
 
-    if (!strstr(signature, "ELEMSLIB"))
+    auto header = (const ShaderLibraryHeader*)data.Pointer;
+
+    if (memcmp(header->FileId, "ELEMSLIB", sizeof(header->FileId)) != 0)
     {
         return {}; 
     }
 
-    auto shaderPartsCount = ReadShaderData<uint32_t>(data, &currentOffset);
-    auto shaderParts = SystemPushArray<Shader>(memoryArena, shaderPartsCount);
+    if (header->Version != SHADER_LIBRARY_VERSION)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Shader library version %d is not supported, the shaders need to be compiled again.", header->Version);
+        return {};
+    }
+
+    if (header->DataSizeInBytes > data.Length)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Shader library is truncated, its size is %d bytes but %d bytes are expected.", (uint32_t)data.Length, header->DataSizeInBytes);
+        return {};
+    }
+
+    if (!ValidateShaderLibrary(data))
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Shader library data is invalid, the shaders need to be compiled again.");
+        return {};
+    }
+
+    if (permutationIndex >= header->PermutationCount)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Shader permutation index %d is out of range, the library has %d permutations.", permutationIndex, header->PermutationCount);
+        return {};
+    }
+
+    auto shaderEntries = GetShaderLibrarySpan<ShaderLibraryShaderEntry>(data, header->ShadersOffset, header->ShaderCount);
+    auto functionEntries = GetShaderLibrarySpan<ShaderLibraryFunctionEntry>(data, header->FunctionsOffset, header->FunctionCount);
+    auto permutationShaderIndices = GetShaderLibrarySpan<uint32_t>(data, header->PermutationTableOffset + permutationIndex * header->FunctionCount * sizeof(uint32_t), header->FunctionCount);
+
+    auto shaders = SystemPushArray<Shader>(memoryArena, header->FunctionCount);
 
-    for (uint32_t i = 0; i < shaderPartsCount; i++)
+    for (uint32_t i = 0; i < functionEntries.Length; i++)
     {
-        shaderParts[i].ShaderType = ReadShaderData<ShaderType>(data, &currentOffset);
-        auto name = ReadShaderStringData(memoryArena, data, &currentOffset);
+        auto functionEntry = functionEntries[i];
+        auto shaderIndex = permutationShaderIndices[i];
 
-        auto metadataLength = ReadShaderData<uint32_t>(data, &currentOffset);
-        auto metadata = SystemPushArray<ShaderMetadata>(memoryArena, metadataLength);
+        shaders[i] = 
+        {
+            .ShaderType = (ShaderType)functionEntry.ShaderType,
+            .Name = GetShaderLibraryString(data, functionEntry.NameOffset, functionEntry.NameLength)
+        };
 
-        for (uint32_t j = 0; j < metadataLength; j++)
+        if (shaderIndex != SHADER_PERMUTATION_NO_PART)
         {
-            metadata[j].Type = ReadShaderData<ShaderMetadataType>(data, &currentOffset);
+            auto shaderEntry = shaderEntries[shaderIndex];
 
-            for (uint32_t k = 0; k < ARRAYSIZE(metadata[j].Value); k++)
-            {
-                metadata[j].Value[k] = ReadShaderData<uint32_t>(data, &currentOffset);
-            }
+            shaders[i].Metadata = GetShaderLibrarySpan<ShaderMetadata>(data, shaderEntry.MetadataOffset, shaderEntry.MetadataCount);
+            shaders[i].ShaderCode = GetShaderLibrarySpan<uint8_t>(data, shaderEntry.CodeOffset, shaderEntry.CodeSizeInBytes);
         }
-
-        shaderParts[i].Name = name;
-        shaderParts[i].Metadata = metadata;
-        shaderParts[i].ShaderCode = ReadShaderData(memoryArena, data, &currentOffset);
     }
 
-    return shaderParts;
+    return 
+    {
+        .Shaders = shaders,
+        .FunctionHashTable = GetShaderLibrarySpan<uint32_t>(data, header->FunctionHashTableOffset, header->FunctionHashTableSize)
+    };
 }
 
+// NOTE: The hash table uses linear probing and its size is a power of 2.
+int32_t FindShaderIndex(const ShaderLibrary* shaderLibrary, ShaderType shaderType, const char* function)
+{
+    SystemAssert(function);
+
+    auto hashTable = shaderLibrary->FunctionHashTable;
+
+    if (hashTable.Length == 0)
+    {
+        return -1;
+    }
+
+    auto functionName = ReadOnlySpan<char>(function);
+    auto hashTableMask = hashTable.Length - 1;
+    auto hashTableIndex = ComputeShaderFunctionHash(shaderType, functionName) & hashTableMask;
+
+    for (uint32_t i = 0; i < hashTable.Length; i++)
+    {
+        auto shaderIndex = hashTable[hashTableIndex];
+
+        if (shaderIndex == SHADER_PERMUTATION_NO_PART)
+        {
+            break;
+        }
+
+        auto shader = &shaderLibrary->Shaders[shaderIndex];
+
+        if (shader->ShaderType == shaderType && shader->Name.Length == functionName.Length && memcmp(shader->Name.Pointer, functionName.Pointer, functionName.Length) == 0)
+        {
+            return shader->ShaderCode.Length > 0 ? (int32_t)shaderIndex : -1;
+        }
+
+        hashTableIndex = (hashTableIndex + 1) & hashTableMask;
+    }
+
+    return -1;
+}
@@ -31,4 +31,63 @@ struct Shader
     ReadOnlySpan<uint8_t> ShaderCode;
 };
 
-ReadOnlySpan<Shader> ReadShaders(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data);
+// NOTE: The layout must match the one written by the shader compiler. All the offsets are relative to the
+// start of the data and all the fields are 4 bytes so the structures can be read in place.
+#define SHADER_LIBRARY_VERSION 2
+#define SHADER_LIBRARY_CODE_ALIGNMENT 16
+#define SHADER_PERMUTATION_NO_PART UINT32_MAX
+
+struct ShaderLibraryHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t DataSizeInBytes;
+    uint32_t ShaderCount;
+    uint32_t FunctionCount;
+    uint32_t FunctionHashTableSize;
+    uint32_t PermutationCount;
+    uint32_t AxisCount;
+    uint32_t AxisValueCount;
+    uint32_t ShadersOffset;
+    uint32_t FunctionsOffset;
+    uint32_t FunctionHashTableOffset;
+    uint32_t PermutationTableOffset;
+    uint32_t AxesOffset;
+    uint32_t AxisValuesOffset;
+};
+
+struct ShaderLibraryShaderEntry
+{
+    uint32_t ShaderType;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t MetadataOffset;
+    uint32_t MetadataCount;
+    uint32_t CodeOffset;
+    uint32_t CodeSizeInBytes;
+    uint32_t Reserved;
+};
+
+struct ShaderLibraryFunctionEntry
+{
+    uint32_t ShaderType;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t Reserved;
+};
+
+// NOTE: The shaders are indexed by function so the index found in the function hash table can be used
+// directly. A function that is not present in the permutation has an empty shader code.
+struct ShaderLibrary
+{
+    ReadOnlySpan<Shader> Shaders;
+    ReadOnlySpan<uint32_t> FunctionHashTable;
+};
+
+uint64_t ComputeShaderFunctionHash(ShaderType shaderType, ReadOnlySpan<char> name);
+ShaderLibrary ReadShaders(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data, uint32_t permutationIndex = 0);
+
+// NOTE: Returns the size of a memory arena that can hold a copy of the data and the shaders read from it. The extra size
+// is reserved for each function for the backend data stored next to the shaders.
+size_t GetShaderLibraryMemorySize(ReadOnlySpan<uint8_t> data, size_t extraSizePerFunction = 0);
+int32_t FindShaderIndex(const ShaderLibrary* shaderLibrary, ShaderType shaderType, const char* function);
@@ -0,0 +1,32 @@
+#include "SwapChainTiming.h"
+#include "SystemFunctions.h"
+
+uint32_t ComputeSwapChainVSyncInterval(uint32_t refreshRate, uint32_t targetFPS)
+{
+    refreshRate = SystemMax(refreshRate, 1u);
+    targetFPS = SystemMin(SystemMax(targetFPS, 1u), refreshRate);
+
+    return (uint32_t)SystemMax(SystemRound((double)refreshRate / targetFPS), 1.0);
+}
+
+bool IsSwapChainUpdateSkipped(uint64_t previousUpdateTimestamp, uint64_t currentTimestamp, uint32_t vsyncInterval, uint64_t refreshIntervalTicks)
+{
+    // NOTE: When the target FPS is lower than the refresh rate we skip the vblanks in between.
+    // We keep half a refresh interval of margin so that jitter on the callback doesn't make us miss the target vblank.
+    if (previousUpdateTimestamp == 0 || vsyncInterval <= 1 || currentTimestamp < previousUpdateTimestamp)
+    {
+        return false;
+    }
+
+    return currentTimestamp - previousUpdateTimestamp < vsyncInterval * refreshIntervalTicks - refreshIntervalTicks / 2;
+}
+
+bool IsSwapChainUpdateLate(uint64_t previousUpdateTimestamp, uint64_t currentTimestamp, uint32_t vsyncInterval, uint64_t refreshIntervalTicks)
+{
+    if (currentTimestamp < previousUpdateTimestamp)
+    {
+        return false;
+    }
+
+    return currentTimestamp - previousUpdateTimestamp >= (vsyncInterval + SWAPCHAIN_UPDATE_TIMEOUT_REFRESH_INTERVALS) * refreshIntervalTicks;
+}
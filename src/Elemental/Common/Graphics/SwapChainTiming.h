@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Elemental.h"
+
+// NOTE: Number of refresh intervals that we wait after the expected update before we stop waiting for
+// the presentation engine (for example the Wayland frame callback) and run the update ourselves.
+#define SWAPCHAIN_UPDATE_TIMEOUT_REFRESH_INTERVALS 2u
+
+uint32_t ComputeSwapChainVSyncInterval(uint32_t refreshRate, uint32_t targetFPS);
+bool IsSwapChainUpdateSkipped(uint64_t previousUpdateTimestamp, uint64_t currentTimestamp, uint32_t vsyncInterval, uint64_t refreshIntervalTicks);
+bool IsSwapChainUpdateLate(uint64_t previousUpdateTimestamp, uint64_t currentTimestamp, uint32_t vsyncInterval, uint64_t refreshIntervalTicks);
@@ -15,6 +15,7 @@
 
 #define VULKAN_MAX_SWAPCHAIN_BUFFERS 3
 #define VULKAN_MAX_SWAPCHAINS 10u
+#define VULKAN_PRESENT_WAIT_TIMEOUT 1000000000u
 
 #define VULKAN_MAX_LIBRARIES UINT16_MAX
 #define VULKAN_MAX_PIPELINESTATES UINT16_MAX
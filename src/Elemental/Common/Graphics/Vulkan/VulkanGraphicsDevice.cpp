@@ -1,5 +1,6 @@
 #include "VulkanGraphicsDevice.h"
 #include "VulkanConfig.h"
+#include "Graphics/ResourceDeleteQueue.h"
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemLogging.h"
@@ -639,12 +640,22 @@ ElemGraphicsDevice VulkanCreateGraphicsDevice(const ElemGraphicsDeviceOptions* o
     createInfo.ppEnabledExtensionNames = extensions;
     createInfo.enabledExtensionCount = ARRAYSIZE(extensions);
 
+    // NOTE: Sparse textures are bound on the render queue so it needs the sparse binding capability. When it is
+    // not available, the sparse textures use a fallback that commits the whole texture.
+    VkPhysicalDeviceFeatures supportedFeatures;
+    vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+
+    auto supportsSparseResidency = supportedFeatures.sparseBinding && supportedFeatures.sparseResidencyImage2D && 
+                                   (queueFamilies[renderCommandQueueIndex].queueFlags & VK_QUEUE_SPARSE_BINDING_BIT);
+
     VkPhysicalDeviceFeatures2 features = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2 };
     features.features.shaderInt16 = true;
     features.features.shaderInt64 = true;
     features.features.pipelineStatisticsQuery = true;
     features.features.fillModeNonSolid = true;
     features.features.samplerAnisotropy = true;
+    features.features.sparseBinding = supportsSparseResidency;
+    features.features.sparseResidencyImage2D = supportsSparseResidency;
 
     VkPhysicalDeviceVulkan12Features features12 = { VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES };
     features12.timelineSemaphore = true;
@@ -717,7 +728,8 @@ ElemGraphicsDevice VulkanCreateGraphicsDevice(const ElemGraphicsDeviceOptions* o
         .GpuMemoryTypeIndex = (uint32_t)gpuMemoryTypeIndex,
         .GpuUploadMemoryTypeIndex = (uint32_t)gpuUploadMemoryTypeIndex,
         .ReadBackMemoryTypeIndex = (uint32_t)readBackMemoryTypeIndex,
-        .UploadMemoryTypeIndex = (uint32_t)uploadMemoryTypeIndex
+        .UploadMemoryTypeIndex = (uint32_t)uploadMemoryTypeIndex,
+        .SupportsSparseResidency = (bool)supportsSparseResidency
     });
 
     CreateVulkanPipelineLayout(handle);
@@ -738,6 +750,8 @@ void VulkanFreeGraphicsDevice(ElemGraphicsDevice graphicsDevice)
 {
     SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
 
+    FreeResourceDeleteQueueBackgroundThread();
+
     auto graphicsDeviceData = GetVulkanGraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
 
@@ -28,6 +28,7 @@ struct VulkanGraphicsDeviceData
     VkPipelineLayout PipelineLayout;
     uint64_t CommandAllocationGeneration;
     uint64_t UploadBufferGeneration;
+    uint64_t FrameIndex;
     VulkanDescriptorHeap ResourceDescriptorHeap;
     VulkanDescriptorHeap SamplerDescriptorHeap;
     Span<UploadBufferDevicePool<VulkanUploadBuffer>*> UploadBufferPools;
@@ -49,6 +50,7 @@ struct VulkanGraphicsDeviceDataFull
     uint32_t GpuUploadMemoryTypeIndex;
     uint32_t ReadBackMemoryTypeIndex;
     uint32_t UploadMemoryTypeIndex;
+    bool SupportsSparseResidency;
     VkDescriptorSetLayout ResourceDescriptorSetLayout;
     VkDescriptorSetLayout SamplerDescriptorSetLayout;
 };
@@ -8,6 +8,7 @@
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
+#include "SystemPlatformFunctions.h"
 
 SystemDataPool<VulkanGraphicsHeapData, SystemDataPoolDefaultFull> vulkanGraphicsHeapPool;
 SystemDataPool<VulkanGraphicsResourceData, VulkanGraphicsResourceDataFull> vulkanGraphicsResourcePool;
@@ -76,6 +77,27 @@ VkFormat ConvertToVulkanTextureFormat(ElemGraphicsFormat format)
         case ElemGraphicsFormat_BC7_SRGB:
             return VK_FORMAT_BC7_SRGB_BLOCK;
 
+        case ElemGraphicsFormat_BC1:
+            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+
+        case ElemGraphicsFormat_BC1_SRGB:
+            return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+
+        case ElemGraphicsFormat_BC3:
+            return VK_FORMAT_BC3_UNORM_BLOCK;
+
+        case ElemGraphicsFormat_BC3_SRGB:
+            return VK_FORMAT_BC3_SRGB_BLOCK;
+
+        case ElemGraphicsFormat_BC4:
+            return VK_FORMAT_BC4_UNORM_BLOCK;
+
+        case ElemGraphicsFormat_BC5:
+            return VK_FORMAT_BC5_UNORM_BLOCK;
+
+        case ElemGraphicsFormat_BC6H:
+            return VK_FORMAT_BC6H_UFLOAT_BLOCK;
+
         case ElemGraphicsFormat_Raw:
             return VK_FORMAT_UNDEFINED;
     }
@@ -211,7 +233,7 @@ ElemGraphicsResource CreateVulkanTextureFromResource(ElemGraphicsDevice graphics
     return handle;
 }
 
-VkImage CreateVulkanTexture(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+VkImage CreateVulkanTexture(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo, bool isSparse)
 {
     SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
     SystemAssert(resourceInfo);
@@ -220,6 +242,7 @@ VkImage CreateVulkanTexture(ElemGraphicsDevice graphicsDevice, const ElemGraphic
     SystemAssert(graphicsDeviceData);
 
     VkImageCreateInfo createInfo = { VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO };
+    createInfo.flags = isSparse ? VK_IMAGE_CREATE_SPARSE_BINDING_BIT | VK_IMAGE_CREATE_SPARSE_RESIDENCY_BIT : 0;
     createInfo.imageType = VK_IMAGE_TYPE_2D;
     createInfo.format = ConvertToVulkanTextureFormat(resourceInfo->Format);
     createInfo.extent.width = resourceInfo->Width;
@@ -400,7 +423,7 @@ ElemGraphicsResourceInfo VulkanCreateTexture2DResourceInfo(ElemGraphicsDevice gr
         resourceInfo.DebugName = options->DebugName;
     }
 
-    auto texture = CreateVulkanTexture(graphicsDevice, &resourceInfo);
+    auto texture = CreateVulkanTexture(graphicsDevice, &resourceInfo, false);
 
     VkMemoryRequirements memoryRequirements = {};
     vkGetImageMemoryRequirements(graphicsDeviceData->Device, texture, &memoryRequirements);
@@ -456,7 +479,13 @@ ElemGraphicsResource VulkanCreateGraphicsResource(ElemGraphicsHeap graphicsHeap,
             return ELEM_HANDLE_NULL;
         }
 
-        auto texture = CreateVulkanTexture(graphicsHeapData->GraphicsDevice, resourceInfo);
+        if (resourceInfo->Usage != ElemGraphicsResourceUsage_Read && GetGraphicsFormatBlockSizeInBytes(resourceInfo->Format) > 0)
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Texture2D with a block compressed format should only use the Read usage.");
+            return ELEM_HANDLE_NULL;
+        }
+
+        auto texture = CreateVulkanTexture(graphicsHeapData->GraphicsDevice, resourceInfo, false);
         AssertIfFailed(vkBindImageMemory(graphicsDeviceData->Device, texture, graphicsHeapData->DeviceObject, graphicsHeapOffset));
 
         return CreateVulkanTextureFromResource(graphicsHeapData->GraphicsDevice, texture, resourceInfo, false);
@@ -570,6 +599,318 @@ ElemGraphicsResourceInfo VulkanGetGraphicsResourceInfo(ElemGraphicsResource reso
     };
 }
 
+// NOTE: A device that supports sparse residency doesn't support it for all the formats and usages.
+bool CheckVulkanSparseTextureSupport(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+{
+    auto graphicsDeviceDataFull = GetVulkanGraphicsDeviceDataFull(graphicsDevice);
+    SystemAssert(graphicsDeviceDataFull);
+
+    if (!graphicsDeviceDataFull->SupportsSparseResidency)
+    {
+        return false;
+    }
+
+    uint32_t propertyCount = 0;
+    vkGetPhysicalDeviceSparseImageFormatProperties(graphicsDeviceDataFull->PhysicalDevice, 
+                                                   ConvertToVulkanTextureFormat(resourceInfo->Format), 
+                                                   VK_IMAGE_TYPE_2D, 
+                                                   VK_SAMPLE_COUNT_1_BIT, 
+                                                   ConvertToVulkanImageUsageFlags(resourceInfo->Usage), 
+                                                   VK_IMAGE_TILING_OPTIMAL, 
+                                                   &propertyCount, 
+                                                   nullptr);
+
+    return propertyCount > 0;
+}
+
+ElemGraphicsResource VulkanCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+{
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+
+    SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
+    SystemAssert(resourceInfo);
+
+    auto graphicsDeviceData = GetVulkanGraphicsDeviceData(graphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    if (!CheckSparseGraphicsResourceInfo(resourceInfo))
+    {
+        return ELEM_HANDLE_NULL;
+    }
+
+    auto isSoftwareFallback = !CheckVulkanSparseTextureSupport(graphicsDevice, resourceInfo);
+    auto texture = CreateVulkanTexture(graphicsDevice, resourceInfo, !isSoftwareFallback);
+
+    VkMemoryRequirements memoryRequirements = {};
+    vkGetImageMemoryRequirements(graphicsDeviceData->Device, texture, &memoryRequirements);
+
+    ElemGraphicsResourceTileInfo tileInfo = {};
+    uint64_t packedMipOffset = 0;
+
+    if (isSoftwareFallback)
+    {
+        // NOTE: Without sparse residency the image can only be bound once to a contiguous memory range so the whole
+        // texture is exposed as a single packed tile.
+        tileInfo =
+        {
+            .TileWidth = resourceInfo->Width,
+            .TileHeight = resourceInfo->Height,
+            .TileSizeInBytes = (uint32_t)SystemAlign(memoryRequirements.size, memoryRequirements.alignment),
+            .TileAlignmentInBytes = (uint32_t)memoryRequirements.alignment,
+            .PackedMipLevel = 0,
+            .PackedMipTileCount = 1,
+            .IsSoftwareFallback = true
+        };
+    }
+    else
+    {
+        uint32_t sparseRequirementCount = 0;
+        vkGetImageSparseMemoryRequirements(graphicsDeviceData->Device, texture, &sparseRequirementCount, nullptr);
+
+        auto sparseRequirements = SystemPushArray<VkSparseImageMemoryRequirements>(stackMemoryArena, sparseRequirementCount);
+        vkGetImageSparseMemoryRequirements(graphicsDeviceData->Device, texture, &sparseRequirementCount, sparseRequirements.Pointer);
+
+        VkSparseImageMemoryRequirements* colorRequirements = nullptr;
+
+        for (uint32_t i = 0; i < sparseRequirementCount; i++)
+        {
+            if (sparseRequirements[i].formatProperties.aspectMask & VK_IMAGE_ASPECT_COLOR_BIT)
+            {
+                colorRequirements = &sparseRequirements[i];
+                break;
+            }
+        }
+
+        if (!colorRequirements)
+        {
+            vkDestroyImage(graphicsDeviceData->Device, texture, nullptr);
+            SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse Texture2D format is not supported by the graphics device.");
+            return ELEM_HANDLE_NULL;
+        }
+
+        // NOTE: The sparse block size is the alignment of the sparse image memory requirements.
+        auto tileSizeInBytes = memoryRequirements.alignment;
+
+        tileInfo =
+        {
+            .TileWidth = colorRequirements->formatProperties.imageGranularity.width,
+            .TileHeight = colorRequirements->formatProperties.imageGranularity.height,
+            .TileSizeInBytes = (uint32_t)tileSizeInBytes,
+            .TileAlignmentInBytes = (uint32_t)tileSizeInBytes,
+            .PackedMipLevel = SystemMin(colorRequirements->imageMipTailFirstLod, resourceInfo->MipLevels),
+            .PackedMipTileCount = (uint32_t)((colorRequirements->imageMipTailSize + tileSizeInBytes - 1) / tileSizeInBytes),
+            .IsSoftwareFallback = false
+        };
+
+        packedMipOffset = colorRequirements->imageMipTailOffset;
+    }
+
+    auto handle = CreateVulkanTextureFromResource(graphicsDevice, texture, resourceInfo, false);
+
+    auto resourceDataFull = GetVulkanGraphicsResourceDataFull(handle);
+    SystemAssert(resourceDataFull);
+
+    resourceDataFull->IsSparse = true;
+    resourceDataFull->TileInfo = tileInfo;
+    resourceDataFull->PackedMipOffset = packedMipOffset;
+
+    return handle;
+}
+
+ElemGraphicsResourceTileInfo VulkanGetGraphicsResourceTileInfo(ElemGraphicsResource resource)
+{
+    SystemAssert(resource != ELEM_HANDLE_NULL);
+
+    auto resourceDataFull = GetVulkanGraphicsResourceDataFull(resource);
+
+    if (!resourceDataFull || !resourceDataFull->IsSparse)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Resource should be created with ElemCreateSparseGraphicsResource.");
+        return {};
+    }
+
+    return resourceDataFull->TileInfo;
+}
+
+ElemFence VulkanBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options)
+{
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+
+    SystemAssert(commandQueue != ELEM_HANDLE_NULL);
+    SystemAssert(resource != ELEM_HANDLE_NULL);
+
+    auto commandQueueData = GetVulkanCommandQueueData(commandQueue);
+    SystemAssert(commandQueueData);
+
+    auto resourceData = GetVulkanGraphicsResourceData(resource);
+    auto resourceDataFull = GetVulkanGraphicsResourceDataFull(resource);
+
+    if (!resourceData || !resourceDataFull || !resourceDataFull->IsSparse)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Resource should be created with ElemCreateSparseGraphicsResource.");
+        return {};
+    }
+
+    auto graphicsDeviceData = GetVulkanGraphicsDeviceData(resourceDataFull->GraphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    auto graphicsDeviceDataFull = GetVulkanGraphicsDeviceDataFull(resourceDataFull->GraphicsDevice);
+    SystemAssert(graphicsDeviceDataFull);
+
+    auto resourceInfo = VulkanGetGraphicsResourceInfo(resource);
+    auto tileInfo = &resourceDataFull->TileInfo;
+
+    for (uint32_t i = 0; i < bindings.Length; i++)
+    {
+        auto binding = &bindings.Items[i];
+        uint64_t graphicsHeapSizeInBytes = 0;
+
+        if (binding->GraphicsHeap != ELEM_HANDLE_NULL)
+        {
+            auto graphicsHeapData = GetVulkanGraphicsHeapData(binding->GraphicsHeap);
+            SystemAssert(graphicsHeapData);
+
+            graphicsHeapSizeInBytes = graphicsHeapData->SizeInBytes;
+        }
+
+        if (!CheckGraphicsResourceTileBinding(&resourceInfo, tileInfo, binding, graphicsHeapSizeInBytes))
+        {
+            return {};
+        }
+    }
+
+    if (tileInfo->IsSoftwareFallback)
+    {
+        // NOTE: The memory binding of a non sparse image is done on the CPU and can only happen once.
+        for (uint32_t i = 0; i < bindings.Length; i++)
+        {
+            auto binding = &bindings.Items[i];
+
+            if (binding->GraphicsHeap != ELEM_HANDLE_NULL && !resourceDataFull->IsFallbackMemoryBound)
+            {
+                auto graphicsHeapData = GetVulkanGraphicsHeapData(binding->GraphicsHeap);
+                AssertIfFailed(vkBindImageMemory(graphicsDeviceData->Device, resourceData->TextureDeviceObject, graphicsHeapData->DeviceObject, binding->GraphicsHeapOffset));
+
+                resourceDataFull->GraphicsHeap = binding->GraphicsHeap;
+                resourceDataFull->GraphicsHeapOffset = binding->GraphicsHeapOffset;
+                resourceDataFull->IsFallbackMemoryBound = true;
+            }
+        }
+
+        return CreateVulkanCommandQueueFence(commandQueue);
+    }
+
+    if (commandQueueData->QueueFamilyIndex != graphicsDeviceDataFull->RenderCommandQueueIndex)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse tiles should be bound with a graphics command queue.");
+        return {};
+    }
+
+    auto imageBinds = SystemPushArray<VkSparseImageMemoryBind>(stackMemoryArena, bindings.Length);
+    auto opaqueBinds = SystemPushArray<VkSparseMemoryBind>(stackMemoryArena, bindings.Length);
+    uint32_t imageBindCount = 0;
+    uint32_t opaqueBindCount = 0;
+
+    for (uint32_t i = 0; i < bindings.Length; i++)
+    {
+        auto binding = &bindings.Items[i];
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        uint64_t memoryOffset = 0;
+
+        if (binding->GraphicsHeap != ELEM_HANDLE_NULL)
+        {
+            memory = GetVulkanGraphicsHeapData(binding->GraphicsHeap)->DeviceObject;
+            memoryOffset = binding->GraphicsHeapOffset;
+        }
+
+        if (binding->MipLevel >= tileInfo->PackedMipLevel)
+        {
+            // NOTE: The packed mips are not addressable by tiles so they use an opaque binding.
+            opaqueBinds[opaqueBindCount++] =
+            {
+                .resourceOffset = resourceDataFull->PackedMipOffset,
+                .size = (uint64_t)tileInfo->PackedMipTileCount * tileInfo->TileSizeInBytes,
+                .memory = memory,
+                .memoryOffset = memoryOffset
+            };
+        }
+        else
+        {
+            auto mipWidth = SystemMax(resourceData->Width >> binding->MipLevel, 1u);
+            auto mipHeight = SystemMax(resourceData->Height >> binding->MipLevel, 1u);
+            auto offsetX = binding->TileX * tileInfo->TileWidth;
+            auto offsetY = binding->TileY * tileInfo->TileHeight;
+
+            // NOTE: The extent of the tiles on the edges of the mip is clamped to the mip size.
+            VkSparseImageMemoryBind imageBind = {};
+            imageBind.subresource = { VK_IMAGE_ASPECT_COLOR_BIT, binding->MipLevel, 0 };
+            imageBind.offset = { (int32_t)offsetX, (int32_t)offsetY, 0 };
+            imageBind.extent = { SystemMin(binding->TileCountX * tileInfo->TileWidth, mipWidth - offsetX), SystemMin(binding->TileCountY * tileInfo->TileHeight, mipHeight - offsetY), 1 };
+            imageBind.memory = memory;
+            imageBind.memoryOffset = memoryOffset;
+
+            imageBinds[imageBindCount++] = imageBind;
+        }
+    }
+
+    Span<VkSemaphore> waitSemaphores = {};
+    Span<uint64_t> waitSemaphoreValues = {};
+
+    if (options && options->FencesToWait.Length > 0)
+    {
+        waitSemaphores = SystemPushArray<VkSemaphore>(stackMemoryArena, options->FencesToWait.Length);
+        waitSemaphoreValues = SystemPushArray<uint64_t>(stackMemoryArena, options->FencesToWait.Length);
+
+        for (uint32_t i = 0; i < options->FencesToWait.Length; i++)
+        {
+            auto fenceToWait = options->FencesToWait.Items[i];
+
+            auto commandQueueToWaitData = GetVulkanCommandQueueData(fenceToWait.CommandQueue);
+            SystemAssert(commandQueueToWaitData);
+
+            waitSemaphores[i] = commandQueueToWaitData->Fence;
+            waitSemaphoreValues[i] = fenceToWait.FenceValue;
+        }
+    }
+
+    auto fenceValue = SystemAtomicAdd(commandQueueData->FenceValue, 1) + 1;
+
+    VkSparseImageMemoryBindInfo imageBindInfo = {};
+    imageBindInfo.image = resourceData->TextureDeviceObject;
+    imageBindInfo.bindCount = imageBindCount;
+    imageBindInfo.pBinds = imageBinds.Pointer;
+
+    VkSparseImageOpaqueMemoryBindInfo opaqueBindInfo = {};
+    opaqueBindInfo.image = resourceData->TextureDeviceObject;
+    opaqueBindInfo.bindCount = opaqueBindCount;
+    opaqueBindInfo.pBinds = opaqueBinds.Pointer;
+
+    VkTimelineSemaphoreSubmitInfo timelineInfo = { VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO };
+    timelineInfo.waitSemaphoreValueCount = waitSemaphoreValues.Length;
+    timelineInfo.pWaitSemaphoreValues = waitSemaphoreValues.Pointer;
+    timelineInfo.signalSemaphoreValueCount = 1;
+    timelineInfo.pSignalSemaphoreValues = &fenceValue;
+
+    VkBindSparseInfo bindSparseInfo = { VK_STRUCTURE_TYPE_BIND_SPARSE_INFO };
+    bindSparseInfo.pNext = &timelineInfo;
+    bindSparseInfo.waitSemaphoreCount = waitSemaphores.Length;
+    bindSparseInfo.pWaitSemaphores = waitSemaphores.Pointer;
+    bindSparseInfo.imageOpaqueBindCount = opaqueBindCount > 0 ? 1 : 0;
+    bindSparseInfo.pImageOpaqueBinds = &opaqueBindInfo;
+    bindSparseInfo.imageBindCount = imageBindCount > 0 ? 1 : 0;
+    bindSparseInfo.pImageBinds = &imageBindInfo;
+    bindSparseInfo.signalSemaphoreCount = 1;
+    bindSparseInfo.pSignalSemaphores = &commandQueueData->Fence;
+
+    AssertIfFailed(vkQueueBindSparse(commandQueueData->DeviceObject, 1, &bindSparseInfo, VK_NULL_HANDLE));
+
+    return
+    {
+        .CommandQueue = commandQueue,
+        .FenceValue = fenceValue
+    };
+}
+
 void VulkanUploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data)
 {
     SystemAssert(resource != ELEM_HANDLE_NULL);
@@ -825,6 +1166,18 @@ void VulkanCopyDataToGraphicsResource(ElemCommandList commandList, const ElemCop
     auto uploadBufferAlignment = 4u;
     auto uploadBufferSizeInBytes = sourceData.Length;
 
+    // NOTE: The buffer offset of a buffer to image copy must be a multiple of the texel block size and of 4.
+    if (resourceData->Type == ElemGraphicsResourceType_Texture2D)
+    {
+        auto elementSizeInBytes = GetGraphicsFormatElementSizeInBytes(resourceData->InternalFormat);
+
+        if (elementSizeInBytes > uploadBufferAlignment)
+        {
+            uploadBufferAlignment = elementSizeInBytes;
+            uploadBufferSizeInBytes = SystemAlign(uploadBufferSizeInBytes, elementSizeInBytes);
+        }
+    }
+
     auto uploadBuffer = GetVulkanUploadBuffer(commandListData->GraphicsDevice, uploadBufferAlignment, uploadBufferSizeInBytes);
     SystemAssert(uploadBuffer.Offset + sourceData.Length <= uploadBuffer.PoolItem->SizeInBytes);
 
@@ -1033,17 +1386,15 @@ void VulkanFreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor descrip
     vulkanResourceDescriptorInfos[descriptor].Resource = ELEM_HANDLE_NULL;
 }
 
-void VulkanProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
+uint32_t TrimVulkanUploadBufferPools(ElemGraphicsDevice graphicsDevice)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
 
-    ProcessResourceDeleteQueue();
-    SystemClearMemoryArena(vulkanReadBackMemoryArena);
-
     auto graphicsDeviceData = GetVulkanGraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
 
     graphicsDeviceData->UploadBufferGeneration++;
+    uint32_t trimmedCount = 0;
     
     for (uint32_t i = 0; i < graphicsDeviceData->UploadBufferPools.Length; i++)
     {
@@ -1066,9 +1417,58 @@ void VulkanProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
 
                 uploadBufferToDelete->CurrentOffset = 0;
                 uploadBufferToDelete->SizeInBytes = 0;
+                trimmedCount++;
             }
         }
     }
+
+    return trimmedCount;
+}
+
+void VulkanProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
+{
+    WaitForResourceDeleteQueueBackgroundProcessing();
+    ProcessResourceDeleteQueue();
+    SystemClearMemoryArena(vulkanReadBackMemoryArena);
+    TrimVulkanUploadBufferPools(graphicsDevice);
+}
+
+ElemGraphicsDeviceFrameInfo VulkanAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options)
+{
+    auto graphicsDeviceData = GetVulkanGraphicsDeviceData(graphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    auto ticksPerMilliseconds = (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds() / 1000.0;
+    auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    // NOTE: The previous background pass must be completed before touching the delete queue again.
+    auto deleteQueueInfo = WaitForResourceDeleteQueueBackgroundProcessing();
+
+    VulkanResetCommandAllocation(graphicsDevice);
+    SystemClearMemoryArena(vulkanReadBackMemoryArena);
+
+    auto trimStartTimestamp = SystemPlatformGetHighPerformanceCounter();
+    auto trimmedUploadBufferCount = TrimVulkanUploadBufferPools(graphicsDevice);
+    auto trimEndTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    if (options && options->ProcessDeleteQueueOnBackgroundThread)
+    {
+        ProcessResourceDeleteQueueInBackground();
+    }
+    else
+    {
+        deleteQueueInfo = ProcessResourceDeleteQueue();
+    }
+
+    return
+    {
+        .FrameIndex = graphicsDeviceData->FrameIndex++,
+        .UploadBufferTrimDurationInMilliseconds = (double)(trimEndTimestamp - trimStartTimestamp) / ticksPerMilliseconds,
+        .TrimmedUploadBufferCount = trimmedUploadBufferCount,
+        .DeleteQueueDurationInMilliseconds = deleteQueueInfo.DurationInMilliseconds,
+        .DeletedResourceCount = deleteQueueInfo.DeletedEntryCount,
+        .TotalDurationInMilliseconds = (double)(SystemPlatformGetHighPerformanceCounter() - startTimestamp) / ticksPerMilliseconds
+    };
 }
 
 ElemGraphicsSampler VulkanCreateGraphicsSampler(ElemGraphicsDevice graphicsDevice, const ElemGraphicsSamplerInfo* samplerInfo)
@@ -33,6 +33,10 @@ struct VulkanGraphicsResourceDataFull
     ElemGraphicsDevice GraphicsDevice;
     ElemGraphicsHeap GraphicsHeap;
     uint64_t GraphicsHeapOffset;
+    bool IsSparse;
+    ElemGraphicsResourceTileInfo TileInfo;
+    uint64_t PackedMipOffset;
+    bool IsFallbackMemoryBound;
 };
 
 struct VulkanUploadBuffer
@@ -66,6 +70,10 @@ ElemGraphicsResource VulkanCreateGraphicsResource(ElemGraphicsHeap graphicsHeap,
 void VulkanFreeGraphicsResource(ElemGraphicsResource resource, const ElemFreeGraphicsResourceOptions* options);
 ElemGraphicsResourceInfo VulkanGetGraphicsResourceInfo(ElemGraphicsResource resource);
 
+ElemGraphicsResource VulkanCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo);
+ElemGraphicsResourceTileInfo VulkanGetGraphicsResourceTileInfo(ElemGraphicsResource resource);
+ElemFence VulkanBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options);
+
 void VulkanUploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data);
 ElemDataSpan VulkanDownloadGraphicsBufferData(ElemGraphicsResource resource, const ElemDownloadGraphicsBufferDataOptions* options);
 void VulkanCopyDataToGraphicsResource(ElemCommandList commandList, const ElemCopyDataToGraphicsResourceParameters* parameters);
@@ -75,6 +83,7 @@ ElemGraphicsResourceDescriptorInfo VulkanGetGraphicsResourceDescriptorInfo(ElemG
 void VulkanFreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor descriptor, const ElemFreeGraphicsResourceDescriptorOptions* options);
 
 void VulkanProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice);
+ElemGraphicsDeviceFrameInfo VulkanAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options);
 
 void VulkanGraphicsResourceBarrier(ElemCommandList commandList, ElemGraphicsResourceDescriptor descriptor, const ElemGraphicsResourceBarrierOptions* options);
 
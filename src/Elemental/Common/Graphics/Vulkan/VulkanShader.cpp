@@ -173,25 +173,23 @@ VkPipelineShaderStageCreateInfo GetVulkanShaderFunctionStageCreateInfo(MemoryAre
     VkPipelineShaderStageCreateInfo result = {};
     result.stage = VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM;
 
-    for (uint32_t i = 0; i < shaderLibraryData->GraphicsShaders.Length; i++)
+    auto shaderIndex = FindShaderIndex(&shaderLibraryData->GraphicsShaders, shaderType, function);
+
+    if (shaderIndex != -1)
     {
-        auto shader = shaderLibraryData->GraphicsShaders[i];
+        auto shader = shaderLibraryData->GraphicsShaders.Shaders[shaderIndex];
 
-        if (shader.ShaderType == shaderType && SystemFindSubString(shader.Name, function) != -1)
-        {
-            auto moduleCreateInfo = SystemPushStruct<VkShaderModuleCreateInfo>(memoryArena);
-            moduleCreateInfo->sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-            moduleCreateInfo->pCode = (uint32_t*)shader.ShaderCode.Pointer;
-            moduleCreateInfo->codeSize = shader.ShaderCode.Length;
-
-            VkPipelineShaderStageCreateInfo stageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
-            stageCreateInfo.stage = ConvertShaderTypeToVulkan(shaderType);
-            stageCreateInfo.pName = function;
-            stageCreateInfo.pNext = moduleCreateInfo;
-
-            result = stageCreateInfo;
-            break;
-        }
+        auto moduleCreateInfo = SystemPushStruct<VkShaderModuleCreateInfo>(memoryArena);
+        moduleCreateInfo->sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+        moduleCreateInfo->pCode = (uint32_t*)shader.ShaderCode.Pointer;
+        moduleCreateInfo->codeSize = shader.ShaderCode.Length;
+
+        VkPipelineShaderStageCreateInfo stageCreateInfo = { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+        stageCreateInfo.stage = ConvertShaderTypeToVulkan(shaderType);
+        stageCreateInfo.pName = function;
+        stageCreateInfo.pNext = moduleCreateInfo;
+
+        result = stageCreateInfo;
     }
         
     if (result.stage == VK_SHADER_STAGE_FLAG_BITS_MAX_ENUM)
@@ -202,7 +200,7 @@ VkPipelineShaderStageCreateInfo GetVulkanShaderFunctionStageCreateInfo(MemoryAre
     return result;
 }
 
-ElemShaderLibrary VulkanCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData)
+ElemShaderLibrary VulkanCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex)
 {
     InitVulkanShaderMemory();
 
@@ -213,10 +211,16 @@ ElemShaderLibrary VulkanCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, E
     auto graphicsDeviceData = GetVulkanGraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
 
-    auto dataSpan = Span<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length); 
-    auto graphicsShaderData = ReadShaders(VulkanGraphicsMemoryArena, dataSpan);
+    // NOTE: The shaders point directly into the library data so it is copied because the caller can free it. The
+    // copy is stored in the memory arena of the library so it is released by VulkanFreeShaderLibrary.
+    auto libraryData = ReadOnlySpan<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length);
+    auto libraryMemoryArena = SystemAllocateMemoryArena(GetShaderLibraryMemorySize(libraryData));
+
+    auto dataSpan = SystemDuplicateBuffer<uint8_t>(libraryMemoryArena, libraryData); 
+    auto graphicsShaderData = ReadShaders(libraryMemoryArena, dataSpan, permutationIndex);
 
     auto handle = SystemAddDataPoolItem(vulkanShaderLibraryPool, {
+        .MemoryArena = libraryMemoryArena,
         .GraphicsShaders = graphicsShaderData
     }); 
 
@@ -229,7 +233,15 @@ ElemShaderLibrary VulkanCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, E
 
 void VulkanFreeShaderLibrary(ElemShaderLibrary shaderLibrary)
 {
-    // TODO: Free data
+    SystemAssert(shaderLibrary != ELEM_HANDLE_NULL);
+
+    auto shaderLibraryData = GetVulkanShaderLibraryData(shaderLibrary);
+    SystemAssert(shaderLibraryData);
+
+    // NOTE: The shader modules are created and destroyed when the pipeline states are compiled so the library
+    // data is not referenced by them.
+    SystemFreeMemoryArena(shaderLibraryData->MemoryArena);
+    SystemRemoveDataPoolItem(vulkanShaderLibraryPool, shaderLibrary);
 }
 
 ElemPipelineState VulkanCompileGraphicsPipelineState(ElemGraphicsDevice graphicsDevice, const ElemGraphicsPipelineStateParameters* parameters)
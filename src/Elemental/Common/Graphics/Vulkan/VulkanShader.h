@@ -8,7 +8,8 @@
 
 struct VulkanShaderLibraryData
 {
-    ReadOnlySpan<Shader> GraphicsShaders; // HACK: This should be temporary, in the future DX12 should only libs for all stages
+    MemoryArena MemoryArena;
+    ShaderLibrary GraphicsShaders; // HACK: This should be temporary, in the future DX12 should only libs for all stages
 };
 
 struct VulkanShaderLibraryDataFull
@@ -34,7 +35,7 @@ VulkanShaderLibraryDataFull* GetVulkanShaderLibraryDataFull(ElemShaderLibrary sh
 VulkanPipelineStateData* GetVulkanPipelineStateData(ElemPipelineState pipelineState);
 VulkanPipelineStateDataFull* GetVulkanPipelineStateDataFull(ElemPipelineState pipelineState);
 
-ElemShaderLibrary VulkanCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData);
+ElemShaderLibrary VulkanCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex);
 void VulkanFreeShaderLibrary(ElemShaderLibrary shaderLibrary);
 ElemPipelineState VulkanCompileGraphicsPipelineState(ElemGraphicsDevice graphicsDevice, const ElemGraphicsPipelineStateParameters* parameters);
 ElemPipelineState VulkanCompileComputePipelineState(ElemGraphicsDevice graphicsDevice, const ElemComputePipelineStateParameters* parameters);
@@ -3,10 +3,12 @@
 #include "VulkanGraphicsDevice.h"
 #include "VulkanCommandList.h"
 #include "VulkanResource.h"
+#include "Graphics/SwapChainTiming.h"
 #include "Inputs/Inputs.h"
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
+#include "SystemPlatformFunctions.h"
 
 #ifdef _WIN32
 #include "../Elemental/Microsoft/Win32Application.h"
@@ -190,33 +192,63 @@ void CheckVulkanAvailableSwapChain(ElemHandle handle)
     auto graphicsDeviceData = GetVulkanGraphicsDeviceData(swapChainData->GraphicsDevice);
     SystemAssert(graphicsDeviceData);
 
+    auto refreshRate = SystemMax(windowData->MonitorRefreshRate, 1u);
+    auto vsyncInterval = ComputeSwapChainVSyncInterval(refreshRate, swapChainData->TargetFPS);
+
+    auto ticksPerSecond = (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds();
+    auto refreshIntervalTicks = (uint64_t)(ticksPerSecond / refreshRate);
+    auto currentTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    if (IsSwapChainUpdateSkipped(swapChainData->PreviousUpdateTimestamp, currentTimestamp, vsyncInterval, refreshIntervalTicks))
+    {
+        return;
+    }
+
     if (swapChainData->PresentId > swapChainData->FrameLatency)
     {
-        // TODO: This is only needed on win32? Normally on wayland even if use an update handle
-        // We should be able to call this function
-        // BUG: On win32, it seems laggy maybe something is wrong here. (We get 144 fps but it seems laggy)
-        // It only happens on the first launch and for some reason if we go fullscreen it is fluid.
-        // Looks like a windowed issue where we miss the vsync
-        // The issue seems to be resolved for now... to monitor!
-        #ifdef _WIN32
-        //auto presentId = swapChainData->PresentId - swapChainData->FrameLatency;
-
-        //if (presentId < 10)
-            //SystemLogDebugMessage(ElemLogMessageCategory_Graphics, "PresentID: %d", presentId);
-
-        //if (vkWaitForPresentKHR(graphicsDeviceData->Device, swapChainData->DeviceObject, presentId, 0) != VK_SUCCESS)
+        // NOTE: Present IDs start at 1 and are incremented at each present so waiting for this ID
+        // ensure that we never have more than FrameLatency frames queued in the presentation engine.
+        auto waitPresentId = swapChainData->PresentId - swapChainData->FrameLatency;
+        auto waitResult = vkWaitForPresentKHR(graphicsDeviceData->Device, swapChainData->DeviceObject, waitPresentId, VULKAN_PRESENT_WAIT_TIMEOUT);
+
+        if (waitResult == VK_TIMEOUT)
         {
-            // BUG: There is still an error here, we need to investigate
-            // Sometimes when we resize it is good
-            //SystemLogWarningMessage(ElemLogMessageCategory_Graphics, "Cannot update the swapchain because there was an error waiting for the present ID %d.", presentId);
-         //   return;
+            SystemLogWarningMessage(ElemLogMessageCategory_Graphics, "Timeout while waiting for the present ID %u.", waitPresentId);
         }
-        #endif
+        else if (waitResult != VK_SUCCESS && waitResult != VK_SUBOPTIMAL_KHR && waitResult != VK_ERROR_OUT_OF_DATE_KHR)
+        {
+            SystemLogWarningMessage(ElemLogMessageCategory_Graphics, "Error while waiting for the present ID %u.", waitPresentId);
+        }
+
+        currentTimestamp = SystemPlatformGetHighPerformanceCounter();
+    }
+
+    // NOTE: Present wait returns when the frame was presented so the current timestamp is our best estimation
+    // of the last vblank. The frame that we will render now will be displayed after the frames still in flight.
+    auto measuredPresentTimestamp = currentTimestamp + swapChainData->FrameLatency * vsyncInterval * refreshIntervalTicks;
+    auto nextPresentTimestamp = measuredPresentTimestamp;
+    auto vsyncDelta = vsyncInterval;
+
+    if (swapChainData->PreviousTargetPresentationTimestamp > 0)
+    {
+        // NOTE: We snap the next present timestamp to the vblank grid so the cadence stays stable.
+        // The measured timestamp is used to re-anchor the grid so the errors don't accumulate.
+        auto elapsedTicks = measuredPresentTimestamp > swapChainData->PreviousTargetPresentationTimestamp ? measuredPresentTimestamp - swapChainData->PreviousTargetPresentationTimestamp : 0;
+        vsyncDelta = SystemMax((uint32_t)SystemRound((double)elapsedTicks / refreshIntervalTicks), vsyncInterval);
+        nextPresentTimestamp = swapChainData->PreviousTargetPresentationTimestamp + vsyncDelta * refreshIntervalTicks;
     }
-    
-    // TODO: Compute timing information
-    // TODO: If delta time is above a thresold, take the delta time based on target FPS
-    auto deltaTime = 1.0f / windowData->MonitorRefreshRate;
+
+    auto deltaTime = vsyncDelta * (1.0 / refreshRate);
+
+    if (vsyncDelta > vsyncInterval)
+    {
+        SystemLogWarningMessage(ElemLogMessageCategory_Graphics, "Missed %d VSync! Delta time is %f ms", vsyncDelta - vsyncInterval, deltaTime * 1000);
+    }
+
+    swapChainData->PreviousTargetPresentationTimestamp = nextPresentTimestamp;
+    swapChainData->PreviousUpdateTimestamp = currentTimestamp;
+
+    auto nextPresentTimestampInSeconds = (nextPresentTimestamp - swapChainData->CreationTimestamp) / ticksPerSecond;
 
     ElemWindowSize windowSize = ElemGetWindowRenderSize(swapChainData->Window);
 
@@ -240,12 +272,21 @@ void CheckVulkanAvailableSwapChain(ElemHandle handle)
         .SwapChainInfo = VulkanGetSwapChainInfo(handle),
         .BackBufferRenderTarget = backBuffer,
         .DeltaTimeInSeconds = deltaTime,
-        .NextPresentTimestampInSeconds = 1.0f,//nextPresentTimestampInSeconds
+        .NextPresentTimestampInSeconds = nextPresentTimestampInSeconds,
         .SizeChanged = sizeChanged
     };
-    
+
+    auto frameIndex = graphicsDeviceData->FrameIndex;
+
     swapChainData->UpdateHandler(&updateParameters, swapChainData->UpdatePayload);
     ResetInputsFrame();
+
+    // NOTE: The frame housekeeping is done after the present so it is not part of the present latency.
+    // If the application has advanced the frame itself during the update, we don't do it twice.
+    if (graphicsDeviceData->FrameIndex == frameIndex)
+    {
+        VulkanAdvanceGraphicsDeviceFrame(swapChainData->GraphicsDevice, nullptr);
+    }
 /*
     if (!swapChainData->PresentCalled)
     {
@@ -292,6 +333,36 @@ static void WaylandFrameCallback(void* data, wl_callback* callback, uint32_t tim
 
 static wl_callback_listener frame_listener = { WaylandFrameCallback };
 
+void CheckVulkanLateSwapChain(ElemHandle handle)
+{
+    auto swapChainData = GetVulkanSwapChainData(handle);
+
+    if (!swapChainData)
+    {
+        return;
+    }
+
+    auto windowData = GetWaylandWindowData(swapChainData->Window);
+
+    if (!windowData || windowData->IsClosed)
+    {
+        return;
+    }
+
+    auto refreshRate = SystemMax(windowData->MonitorRefreshRate, 1u);
+    auto vsyncInterval = ComputeSwapChainVSyncInterval(refreshRate, swapChainData->TargetFPS);
+    auto refreshIntervalTicks = (uint64_t)((double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds() / refreshRate);
+    auto previousUpdateTimestamp = swapChainData->PreviousUpdateTimestamp > 0 ? swapChainData->PreviousUpdateTimestamp : swapChainData->CreationTimestamp;
+
+    // NOTE: The compositor can withhold the frame callbacks, for example when the surface is hidden or when
+    // we skipped a frame and committed without a new buffer. In that case we run the update from the run loop
+    // so the application doesn't stall. The pending frame callback takes over again when it is sent.
+    if (IsSwapChainUpdateLate(previousUpdateTimestamp, SystemPlatformGetHighPerformanceCounter(), vsyncInterval, refreshIntervalTicks))
+    {
+        CheckVulkanAvailableSwapChain(handle);
+    }
+}
+
 void RegisterWaylandFrameCallback(WaylandCallbackParameters* parameters)
 {
     auto callback = wl_surface_frame(parameters->WaylandSurface);
@@ -407,9 +478,7 @@ ElemSwapChain VulkanCreateSwapChain(ElemCommandQueue commandQueue, ElemWindow wi
     VkFenceCreateInfo fenceCreateInfo = { VK_STRUCTURE_TYPE_FENCE_CREATE_INFO };
     AssertIfFailed(vkCreateFence(graphicsDeviceData->Device, &fenceCreateInfo, 0, &acquireFence ));
 
-    uint64_t creationTimestamp = 0;
-    // TODO: Put that in a system function
-    //QueryPerformanceCounter(&creationTimestamp);
+    auto creationTimestamp = SystemPlatformGetHighPerformanceCounter();
 
     auto handle = SystemAddDataPoolItem(vulkanSwapChainPool, {
         .DeviceObject = swapChain,
@@ -421,14 +490,15 @@ ElemSwapChain VulkanCreateSwapChain(ElemCommandQueue commandQueue, ElemWindow wi
         .UpdateHandler = updateHandler,
         .UpdatePayload = updatePayload,
         .CreationTimestamp = creationTimestamp,
-        .PreviousTargetPresentationTimestamp = {},
+        .PreviousTargetPresentationTimestamp = 0,
+        .PreviousUpdateTimestamp = 0,
         .Width = width,
         .Height = height,
         .AspectRatio = (float)width / height,
         .UIScale = windowRenderSize.UIScale,
         .Format = ElemGraphicsFormat_B8G8R8A8_SRGB, // TODO: change that
         .PresentId = 1,
-        .FrameLatency = frameLatency,
+        .FrameLatency = SystemMin(frameLatency, VULKAN_MAX_SWAPCHAIN_BUFFERS - 1u),
         .TargetFPS = targetFPS
     });
 
@@ -443,6 +513,7 @@ ElemSwapChain VulkanCreateSwapChain(ElemCommandQueue commandQueue, ElemWindow wi
     AddWin32RunLoopHandler(CheckVulkanAvailableSwapChain, handle);
     #elif __linux__
     AddWaylandInitHandler(CheckVulkanAvailableSwapChain, handle);
+    AddWaylandRunLoopHandler(CheckVulkanLateSwapChain, handle);
 
     auto waylandCallbackParameters = SystemPushStruct<WaylandCallbackParameters>(VulkanGraphicsMemoryArena);
     waylandCallbackParameters->SwapChain = handle;
@@ -504,6 +575,25 @@ ElemSwapChainInfo VulkanGetSwapChainInfo(ElemSwapChain swapChain)
 
 void VulkanSetSwapChainTiming(ElemSwapChain swapChain, uint32_t frameLatency, uint32_t targetFPS)
 {
+    SystemLogDebugMessage(ElemLogMessageCategory_Graphics, "Set Swapchain timing: FrameLatency: %d, TargetFPS: %d.", frameLatency, targetFPS);
+
+    SystemAssert(swapChain != ELEM_HANDLE_NULL);
+
+    auto swapChainData = GetVulkanSwapChainData(swapChain);
+    SystemAssert(swapChainData);
+
+    #ifdef _WIN32
+    auto windowData = GetWin32WindowData(swapChainData->Window);
+    #elif __linux__
+    auto windowData = GetWaylandWindowData(swapChainData->Window);
+    #endif
+
+    SystemAssert(windowData);
+
+    // NOTE: The swapchain has a fixed number of images so we need to keep at least one of them
+    // available for acquiring the next back buffer.
+    swapChainData->FrameLatency = SystemMin(SystemMax(frameLatency, 1u), VULKAN_MAX_SWAPCHAIN_BUFFERS - 1u);
+    swapChainData->TargetFPS = targetFPS != 0 ? targetFPS : windowData->MonitorRefreshRate;
 }
 
 void VulkanPresentSwapChain(ElemSwapChain swapChain)
@@ -519,6 +609,7 @@ void VulkanPresentSwapChain(ElemSwapChain swapChain)
     auto commandQueueData = GetVulkanCommandQueueData(swapChainData->CommandQueue);
     SystemAssert(commandQueueData);
 
+    swapChainData->PresentCalled = true;
     auto presentId = swapChainData->PresentId++;
 
     VkPresentIdKHR presentIdInfo = { VK_STRUCTURE_TYPE_PRESENT_ID_KHR };
@@ -534,8 +625,5 @@ void VulkanPresentSwapChain(ElemSwapChain swapChain)
     presentInfo.pNext = &presentIdInfo;
 
     AssertIfFailed(vkQueuePresentKHR(commandQueueData->DeviceObject, &presentInfo));
-    
-    VulkanResetCommandAllocation(swapChainData->GraphicsDevice);
-    VulkanProcessGraphicsResourceDeleteQueue(swapChainData->GraphicsDevice);
 }
 
@@ -24,6 +24,7 @@ struct VulkanSwapChainData
     void* UpdatePayload;
     uint64_t CreationTimestamp;
     uint64_t PreviousTargetPresentationTimestamp;
+    uint64_t PreviousUpdateTimestamp;
     uint32_t Width;
     uint32_t Height;
     float AspectRatio;
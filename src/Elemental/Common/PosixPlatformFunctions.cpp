@@ -8,6 +8,7 @@
 
 #define MAX_PATH 255
 #define MAX_THREADS 64  // Maximum number of threads
+#define MAX_SIGNALS 64  // Maximum number of signals
 
 enum ThreadStatus
 {
@@ -25,6 +26,17 @@ struct ThreadInfo
 static ThreadInfo threadArray[MAX_THREADS];
 static bool isInitialized = false;
 
+struct SignalInfo
+{
+    pthread_mutex_t mutex;
+    pthread_cond_t condition;
+    bool isSet;
+    bool isUsed;
+};
+
+static SignalInfo signalArray[MAX_SIGNALS];
+static pthread_mutex_t signalArrayMutex = PTHREAD_MUTEX_INITIALIZER;
+
 SystemPlatformAllocationInfos systemPlatformAllocationInfos;
 
 SystemPlatformEnvironment* SystemPlatformGetEnvironment(MemoryArena memoryArena)
@@ -74,6 +86,12 @@ size_t SystemPlatformGetPageSize()
     return sysconf(_SC_PAGESIZE);
 }
 
+uint32_t SystemPlatformGetProcessorCount()
+{
+    auto processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+    return processorCount > 0 ? (uint32_t)processorCount : 1;
+}
+
 SystemPlatformAllocationInfos SystemPlatformGetAllocationInfos()
 {
     return systemPlatformAllocationInfos;
@@ -134,7 +152,7 @@ size_t SystemPlatformFileGetSizeInBytes(ReadOnlySpan<char> path)
 
 void SystemPlatformFileWriteBytes(ReadOnlySpan<char> path, ReadOnlySpan<uint8_t> data)
 {
-    auto fileHandle = open(path.Pointer, O_WRONLY | O_CREAT, 0644);
+    auto fileHandle = open(path.Pointer, O_WRONLY | O_CREAT | O_TRUNC, 0644);
 
     if (fileHandle < 0) 
     {
@@ -178,6 +196,60 @@ void SystemPlatformFileDelete(ReadOnlySpan<char> path)
     }
 }
 
+bool SystemPlatformFileMove(ReadOnlySpan<char> sourcePath, ReadOnlySpan<char> destinationPath)
+{
+    if (rename(sourcePath.Pointer, destinationPath.Pointer) != 0) 
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot move file %s to %s.", sourcePath.Pointer, destinationPath.Pointer);
+        return false;
+    }
+
+    return true;
+}
+
+ReadOnlySpan<uint8_t> SystemPlatformFileMap(ReadOnlySpan<char> path, bool sequentialAccess, void** platformHandle)
+{
+    *platformHandle = nullptr;
+    auto fileHandle = open(path.Pointer, O_RDONLY);
+
+    if (fileHandle < 0) 
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot open file %s for mapping.", path.Pointer);
+        return {};
+    }
+
+    struct stat buffer;
+
+    if (fstat(fileHandle, &buffer) != 0 || buffer.st_size == 0)
+    {
+        close(fileHandle);
+        return {};
+    }
+
+    auto pointer = mmap(nullptr, buffer.st_size, PROT_READ, MAP_PRIVATE, fileHandle, 0);
+
+    // NOTE: The mapping keeps a reference to the file so we can close the descriptor now.
+    close(fileHandle);
+
+    if (pointer == MAP_FAILED)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot map file %s.", path.Pointer);
+        return {};
+    }
+
+    if (sequentialAccess)
+    {
+        madvise(pointer, buffer.st_size, MADV_SEQUENTIAL);
+    }
+
+    return ReadOnlySpan<uint8_t>((uint8_t*)pointer, buffer.st_size);
+}
+
+void SystemPlatformFileUnmap(ReadOnlySpan<uint8_t> data, void* platformHandle)
+{
+    munmap((void*)data.Pointer, data.Length);
+}
+
 ReadOnlySpan<char> SystemPlatformExecuteProcess(MemoryArena memoryArena, ReadOnlySpan<char> command)
 {
     // TODO: To Review
@@ -333,3 +405,80 @@ void SystemPlatformFreeThread(void* thread)
         threadInfo->status = THREAD_STATUS_FINISHED;
     }
 }
+
+void* SystemPlatformCreateSignal()
+{
+    pthread_mutex_lock(&signalArrayMutex);
+
+    SignalInfo* signalInfo = nullptr;
+
+    for (int32_t i = 0; i < MAX_SIGNALS; i++) 
+    {
+        if (!signalArray[i].isUsed) 
+        {
+            signalInfo = &signalArray[i];
+            signalInfo->isUsed = true;
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&signalArrayMutex);
+
+    if (!signalInfo)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Maximum signal limit reached");
+        return nullptr;
+    }
+
+    pthread_mutex_init(&signalInfo->mutex, NULL);
+    pthread_cond_init(&signalInfo->condition, NULL);
+    signalInfo->isSet = false;
+
+    return (void*)signalInfo;
+}
+
+void SystemPlatformWaitSignal(void* signal)
+{
+    auto signalInfo = (SignalInfo*)signal;
+
+    if (signalInfo && signalInfo->isUsed)
+    {
+        pthread_mutex_lock(&signalInfo->mutex);
+
+        while (!signalInfo->isSet)
+        {
+            pthread_cond_wait(&signalInfo->condition, &signalInfo->mutex);
+        }
+
+        signalInfo->isSet = false;
+        pthread_mutex_unlock(&signalInfo->mutex);
+    }
+}
+
+void SystemPlatformSetSignal(void* signal)
+{
+    auto signalInfo = (SignalInfo*)signal;
+
+    if (signalInfo && signalInfo->isUsed)
+    {
+        pthread_mutex_lock(&signalInfo->mutex);
+        signalInfo->isSet = true;
+        pthread_cond_signal(&signalInfo->condition);
+        pthread_mutex_unlock(&signalInfo->mutex);
+    }
+}
+
+void SystemPlatformFreeSignal(void* signal)
+{
+    auto signalInfo = (SignalInfo*)signal;
+
+    if (signalInfo && signalInfo->isUsed)
+    {
+        pthread_cond_destroy(&signalInfo->condition);
+        pthread_mutex_destroy(&signalInfo->mutex);
+
+        pthread_mutex_lock(&signalArrayMutex);
+        signalInfo->isUsed = false;
+        pthread_mutex_unlock(&signalArrayMutex);
+    }
+}
@@ -0,0 +1,167 @@
+#include "../Elemental.h"
+#include "SystemDataPool.h"
+#include "SystemFunctions.h"
+#include "SystemLogging.h"
+#include "SystemMemory.h"
+
+// NOTE: The layout must match the writer in ElementalTools (SceneLoading/SceneContainer.cpp)
+#define SCENE_CONTAINER_VERSION 1
+#define SCENE_CONTAINER_MAX_CONTAINERS 64
+
+struct SceneContainerHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t SectionCount;
+    uint32_t SectionAlignment;
+    uint32_t Reserved;
+    uint64_t SizeInBytes;
+};
+
+struct SceneContainerTableEntry
+{
+    uint32_t Id;
+    uint32_t ElementSize;
+    uint32_t ElementCount;
+    uint32_t Reserved;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+struct SceneContainerData
+{
+    SystemFileMapping FileMapping;
+    uint32_t Version;
+    ReadOnlySpan<ElemSceneContainerSection> Sections;
+};
+
+MemoryArena SceneContainerMemoryArena;
+SystemDataPool<SceneContainerData, SystemDataPoolDefaultFull> sceneContainerDataPool;
+
+void InitSceneContainerMemory()
+{
+    if (SceneContainerMemoryArena.Storage == nullptr)
+    {
+        SceneContainerMemoryArena = SystemAllocateMemoryArena();
+        sceneContainerDataPool = SystemCreateDataPool<SceneContainerData>(SceneContainerMemoryArena, SCENE_CONTAINER_MAX_CONTAINERS);
+    }
+}
+
+SceneContainerData* GetSceneContainerData(ElemSceneContainer sceneContainer)
+{
+    if (sceneContainer == ELEM_HANDLE_NULL)
+    {
+        return nullptr;
+    }
+
+    return SystemGetDataPoolItem(sceneContainerDataPool, sceneContainer);
+}
+
+ElemAPI ElemSceneContainer ElemOpenSceneContainer(const char* path)
+{
+    InitSceneContainerMemory();
+
+    auto fileMapping = SystemFileMap(path, false);
+    auto data = fileMapping.Data;
+
+    if (data.Length < sizeof(SceneContainerHeader))
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot open scene container '%s'.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    // NOTE: The header and the table of contents are used in place, nothing is copied from the mapping.
+    auto header = (const SceneContainerHeader*)data.Pointer;
+
+    if (SystemFindSubString(ReadOnlySpan<char>(header->FileId, sizeof(header->FileId)), "ELEMSCNE") != 0 || header->Version != SCENE_CONTAINER_VERSION)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Scene container '%s' has a wrong format or version.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    auto tableOfContentsSize = sizeof(SceneContainerHeader) + (size_t)header->SectionCount * sizeof(SceneContainerTableEntry);
+
+    if (header->SizeInBytes > data.Length || tableOfContentsSize > data.Length)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Scene container '%s' is truncated.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    auto tableEntries = (const SceneContainerTableEntry*)(data.Pointer + sizeof(SceneContainerHeader));
+
+    // TODO: Reuse the memory of the closed containers
+    auto sections = SystemPushArray<ElemSceneContainerSection>(SceneContainerMemoryArena, header->SectionCount);
+
+    for (uint32_t i = 0; i < header->SectionCount; i++)
+    {
+        auto tableEntry = &tableEntries[i];
+
+        // NOTE: The checks are written so that the values read from the file cannot overflow.
+        auto elementSize = tableEntry->ElementSize > 0 ? (uint64_t)tableEntry->ElementSize : 1;
+
+        if (tableEntry->Offset > data.Length || 
+            tableEntry->SizeInBytes > data.Length - tableEntry->Offset || 
+            tableEntry->SizeInBytes > UINT32_MAX || 
+            elementSize * tableEntry->ElementCount != tableEntry->SizeInBytes)
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Application, "Scene container '%s' has an invalid section.", path);
+            SystemFileUnmap(fileMapping);
+            return ELEM_HANDLE_NULL;
+        }
+
+        sections[i] =
+        {
+            .Id = tableEntry->Id,
+            .ElementSize = tableEntry->ElementSize,
+            .ElementCount = tableEntry->ElementCount,
+            .Data = { .Items = (uint8_t*)data.Pointer + tableEntry->Offset, .Length = (uint32_t)tableEntry->SizeInBytes }
+        };
+    }
+
+    return SystemAddDataPoolItem(sceneContainerDataPool, 
+    {
+        .FileMapping = fileMapping,
+        .Version = header->Version,
+        .Sections = sections
+    });
+}
+
+ElemAPI void ElemCloseSceneContainer(ElemSceneContainer sceneContainer)
+{
+    auto sceneContainerData = GetSceneContainerData(sceneContainer);
+    SystemAssert(sceneContainerData);
+
+    SystemFileUnmap(sceneContainerData->FileMapping);
+    SystemRemoveDataPoolItem(sceneContainerDataPool, sceneContainer);
+}
+
+ElemAPI ElemSceneContainerInfo ElemGetSceneContainerInfo(ElemSceneContainer sceneContainer)
+{
+    auto sceneContainerData = GetSceneContainerData(sceneContainer);
+    SystemAssert(sceneContainerData);
+
+    return
+    {
+        .Version = sceneContainerData->Version,
+        .Sections = { .Items = (ElemSceneContainerSection*)sceneContainerData->Sections.Pointer, .Length = (uint32_t)sceneContainerData->Sections.Length }
+    };
+}
+
+ElemAPI ElemSceneContainerSection ElemGetSceneContainerSection(ElemSceneContainer sceneContainer, uint32_t sectionId)
+{
+    auto sceneContainerData = GetSceneContainerData(sceneContainer);
+    SystemAssert(sceneContainerData);
+
+    for (uint32_t i = 0; i < sceneContainerData->Sections.Length; i++)
+    {
+        if (sceneContainerData->Sections[i].Id == sectionId)
+        {
+            return sceneContainerData->Sections[i];
+        }
+    }
+
+    return { .Id = sectionId };
+}
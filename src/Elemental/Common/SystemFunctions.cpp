@@ -510,6 +510,27 @@ void SystemFileDelete(ReadOnlySpan<char> path)
     SystemPlatformFileDelete(path);
 }
 
+bool SystemFileMove(ReadOnlySpan<char> sourcePath, ReadOnlySpan<char> destinationPath)
+{
+    return SystemPlatformFileMove(sourcePath, destinationPath);
+}
+
+SystemFileMapping SystemFileMap(ReadOnlySpan<char> path, bool sequentialAccess)
+{
+    SystemFileMapping result = {};
+    result.Data = SystemPlatformFileMap(path, sequentialAccess, &result.PlatformHandle);
+
+    return result;
+}
+
+void SystemFileUnmap(SystemFileMapping fileMapping)
+{
+    if (fileMapping.Data.Length > 0)
+    {
+        SystemPlatformFileUnmap(fileMapping.Data, fileMapping.PlatformHandle);
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------
 // Library / process functions
 //---------------------------------------------------------------------------------------------------------------
@@ -557,3 +578,23 @@ void SystemFreeThread(SystemThread thread)
 {
     SystemPlatformFreeThread(thread.Handle);
 }
+
+SystemSignal SystemCreateSignal()
+{
+    return { SystemPlatformCreateSignal() };
+}
+
+void SystemWaitSignal(SystemSignal signal)
+{
+    SystemPlatformWaitSignal(signal.Handle);
+}
+
+void SystemSetSignal(SystemSignal signal)
+{
+    SystemPlatformSetSignal(signal.Handle);
+}
+
+void SystemFreeSignal(SystemSignal signal)
+{
+    SystemPlatformFreeSignal(signal.Handle);
+}
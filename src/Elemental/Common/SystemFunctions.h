@@ -255,6 +255,38 @@ Span<uint8_t> SystemFileReadBytes(MemoryArena memoryArena, ReadOnlySpan<char> pa
  */
 void SystemFileDelete(ReadOnlySpan<char> path);
 
+/**
+ * Moves a file to the destination path, replacing the destination file if it exists.
+ *
+ * @param sourcePath The path to the file to be moved.
+ * @param destinationPath The new path of the file.
+ * @return True if the file was moved; otherwise, false.
+ */
+bool SystemFileMove(ReadOnlySpan<char> sourcePath, ReadOnlySpan<char> destinationPath);
+
+struct SystemFileMapping
+{
+    ReadOnlySpan<uint8_t> Data;
+    void* PlatformHandle;
+};
+
+/**
+ * Maps a file in read only mode. The OS loads the pages on demand so the data is never copied
+ * into an intermediate buffer.
+ *
+ * @param path The path to the file.
+ * @param sequentialAccess Hint that the file will be read from start to end.
+ * @return The file mapping. Its data span is empty if the file cannot be mapped.
+ */
+SystemFileMapping SystemFileMap(ReadOnlySpan<char> path, bool sequentialAccess);
+
+/**
+ * Unmaps a file previously mapped with SystemFileMap.
+ *
+ * @param fileMapping The file mapping to release.
+ */
+void SystemFileUnmap(SystemFileMapping fileMapping);
+
 
 //---------------------------------------------------------------------------------------------------------------
 // Library / Process Functions
@@ -314,6 +346,14 @@ struct SystemThread
     void* Handle;
 };
 
+/**
+ * Represents a system signal handle.
+ */
+struct SystemSignal
+{
+    void* Handle;
+};
+
 /**
  * Atomically replaces the value of a variable if it matches the expected value.
  *
@@ -410,3 +450,31 @@ void SystemYieldThread();
  */
 void SystemFreeThread(SystemThread thread);
 
+/**
+ * Creates an auto reset signal. A thread waiting on the signal is woken up when another thread sets it.
+ *
+ * @return A SystemSignal structure representing the created signal.
+ */
+SystemSignal SystemCreateSignal();
+
+/**
+ * Blocks the calling thread until the signal is set. The signal is reset when the wait returns.
+ *
+ * @param signal The signal to wait for.
+ */
+void SystemWaitSignal(SystemSignal signal);
+
+/**
+ * Sets the signal and wakes up one waiting thread.
+ *
+ * @param signal The signal to set.
+ */
+void SystemSetSignal(SystemSignal signal);
+
+/**
+ * Frees the resources associated with the specified signal.
+ *
+ * @param signal The signal to free. No thread should be waiting on it.
+ */
+void SystemFreeSignal(SystemSignal signal);
+
@@ -243,6 +243,24 @@ StackMemoryArena SystemGetStackMemoryArena()
     return result;
 }
 
+void SystemFreeStackMemoryArena()
+{
+    if (stackMemoryArenaStorage == nullptr)
+    {
+        return;
+    }
+
+    SystemAssert(stackMemoryArenaStorage->StackLevel == 0);
+
+    if (stackMemoryArenaStorage->StackExtraStorage.Storage != nullptr)
+    {
+        SystemFreeMemoryArena(stackMemoryArenaStorage->StackExtraStorage);
+    }
+
+    SystemFreeMemoryArena({ .Storage = stackMemoryArenaStorage });
+    stackMemoryArenaStorage = nullptr;
+}
+
 StackMemoryArena::~StackMemoryArena()
 {
     auto storage = Arena.Storage;
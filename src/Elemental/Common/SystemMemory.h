@@ -124,6 +124,11 @@ MemoryArenaAllocationInfos SystemGetMemoryArenaAllocationInfos(MemoryArena memor
  */
 StackMemoryArena SystemGetStackMemoryArena();
 
+/**
+ * Frees the StackMemoryArena of the calling thread. Worker threads must call it before exiting.
+ */
+void SystemFreeStackMemoryArena();
+
 /**
  * Allocates a block of memory in a MemoryArena.
  * @param memoryArena MemoryArena for the allocation.
@@ -64,6 +64,13 @@ uint64_t SystemPlatformGetHighPerformanceCounterFrequencyInSeconds();
  */
 size_t SystemPlatformGetPageSize();
 
+/**
+ * Retrieves the number of logical processors available on the system.
+ *
+ * @return The number of logical processors.
+ */
+uint32_t SystemPlatformGetProcessorCount();
+
 /**
  * Retrieves allocation information of the system platform.
  *
@@ -187,6 +194,33 @@ void SystemPlatformFileReadBytes(ReadOnlySpan<char> path, Span<uint8_t> data);
  */
 void SystemPlatformFileDelete(ReadOnlySpan<char> path);
 
+/**
+ * Moves a file, replacing the destination file if it exists.
+ *
+ * @param sourcePath A ReadOnlySpan<char> representing the path of the file to be moved.
+ * @param destinationPath A ReadOnlySpan<char> representing the new path of the file.
+ * @return True if the file was moved; otherwise, false.
+ */
+bool SystemPlatformFileMove(ReadOnlySpan<char> sourcePath, ReadOnlySpan<char> destinationPath);
+
+/**
+ * Maps a file in read only mode into the address space of the process.
+ *
+ * @param path A ReadOnlySpan<char> representing the path of the file to map.
+ * @param sequentialAccess Hint to the OS that the file will be read from start to end.
+ * @param platformHandle Receives the platform handle that must be passed to SystemPlatformFileUnmap.
+ * @return A ReadOnlySpan<uint8_t> pointing to the mapped data. The span is empty if the file cannot be mapped.
+ */
+ReadOnlySpan<uint8_t> SystemPlatformFileMap(ReadOnlySpan<char> path, bool sequentialAccess, void** platformHandle);
+
+/**
+ * Unmaps a file previously mapped with SystemPlatformFileMap.
+ *
+ * @param data A ReadOnlySpan<uint8_t> pointing to the mapped data.
+ * @param platformHandle The platform handle returned by SystemPlatformFileMap.
+ */
+void SystemPlatformFileUnmap(ReadOnlySpan<uint8_t> data, void* platformHandle);
+
 /**
  * Executes a process based on a command.
  *
@@ -251,3 +285,31 @@ void SystemPlatformYieldThread();
  * @param thread A pointer to the thread to free.
  */
 void SystemPlatformFreeThread(void* thread);
+
+/**
+ * Creates an auto reset signal used to wake up a waiting thread.
+ *
+ * @return A pointer to the created signal.
+ */
+void* SystemPlatformCreateSignal();
+
+/**
+ * Waits until a signal is set and then resets it.
+ *
+ * @param signal A pointer to the signal to wait for.
+ */
+void SystemPlatformWaitSignal(void* signal);
+
+/**
+ * Sets a signal so that one waiting thread is woken up.
+ *
+ * @param signal A pointer to the signal to set.
+ */
+void SystemPlatformSetSignal(void* signal);
+
+/**
+ * Frees a signal.
+ *
+ * @param signal A pointer to the signal to free.
+ */
+void SystemPlatformFreeSignal(void* signal);
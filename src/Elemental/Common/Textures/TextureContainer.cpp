@@ -0,0 +1,229 @@
+#include "../Elemental.h"
+#include "Graphics/Resource.h"
+#include "SystemDataPool.h"
+#include "SystemFunctions.h"
+#include "SystemLogging.h"
+#include "SystemMemory.h"
+
+// NOTE: The layout must match the writer in ElementalTools (Textures/TextureContainer.cpp)
+#define TEXTURE_CONTAINER_VERSION 1
+#define TEXTURE_CONTAINER_MAX_CONTAINERS 1024
+#define TEXTURE_CONTAINER_MAX_MIP_COUNT 32
+
+enum TextureContainerFormat
+{
+    TextureContainerFormat_Unknown = 0,
+    TextureContainerFormat_BC7 = 1,
+    TextureContainerFormat_BC1 = 2,
+    TextureContainerFormat_BC3 = 3,
+    TextureContainerFormat_BC4 = 4,
+    TextureContainerFormat_BC5 = 5,
+    TextureContainerFormat_BC6H = 6,
+    TextureContainerFormat_R32G32B32A32_FLOAT = 7
+};
+
+struct TextureContainerHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t Format;
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t MipCount;
+    uint32_t MipAlignment;
+    uint64_t SizeInBytes;
+};
+
+struct TextureContainerMipEntry
+{
+    uint32_t Width;
+    uint32_t Height;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+struct TextureContainerData
+{
+    SystemFileMapping FileMapping;
+    ElemTextureContainerInfo Info;
+    ReadOnlySpan<TextureContainerMipEntry> MipEntries;
+};
+
+MemoryArena TextureContainerMemoryArena;
+SystemDataPool<TextureContainerData, SystemDataPoolDefaultFull> textureContainerDataPool;
+
+void InitTextureContainerMemory()
+{
+    if (TextureContainerMemoryArena.Storage == nullptr)
+    {
+        TextureContainerMemoryArena = SystemAllocateMemoryArena();
+        textureContainerDataPool = SystemCreateDataPool<TextureContainerData>(TextureContainerMemoryArena, TEXTURE_CONTAINER_MAX_CONTAINERS);
+    }
+}
+
+TextureContainerData* GetTextureContainerData(ElemTextureContainer textureContainer)
+{
+    if (textureContainer == ELEM_HANDLE_NULL)
+    {
+        return nullptr;
+    }
+
+    return SystemGetDataPoolItem(textureContainerDataPool, textureContainer);
+}
+
+ElemGraphicsFormat ConvertTextureContainerFormat(uint32_t format)
+{
+    switch (format)
+    {
+        case TextureContainerFormat_BC7:
+            return ElemGraphicsFormat_BC7;
+
+        case TextureContainerFormat_BC1:
+            return ElemGraphicsFormat_BC1;
+
+        case TextureContainerFormat_BC3:
+            return ElemGraphicsFormat_BC3;
+
+        case TextureContainerFormat_BC4:
+            return ElemGraphicsFormat_BC4;
+
+        case TextureContainerFormat_BC5:
+            return ElemGraphicsFormat_BC5;
+
+        case TextureContainerFormat_BC6H:
+            return ElemGraphicsFormat_BC6H;
+
+        case TextureContainerFormat_R32G32B32A32_FLOAT:
+            return ElemGraphicsFormat_R32G32B32A32_FLOAT;
+
+        default:
+            return ElemGraphicsFormat_Raw;
+    }
+}
+
+uint64_t GetTextureContainerMipSizeInBytes(ElemGraphicsFormat format, uint32_t width, uint32_t height)
+{
+    auto blockSize = GetGraphicsFormatBlockSizeInBytes(format);
+
+    if (blockSize > 0)
+    {
+        return (uint64_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+    }
+
+    return (uint64_t)width * height * GetGraphicsFormatElementSizeInBytes(format);
+}
+
+ElemAPI ElemTextureContainer ElemOpenTextureContainer(const char* path)
+{
+    InitTextureContainerMemory();
+
+    auto fileMapping = SystemFileMap(path, false);
+    auto data = fileMapping.Data;
+
+    if (data.Length < sizeof(TextureContainerHeader))
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot open texture container '%s'.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    // NOTE: The header and the mip table are used in place, the mip data is only read when it is accessed.
+    auto header = (const TextureContainerHeader*)data.Pointer;
+
+    if (memcmp(header->FileId, "ELEMTEXC", sizeof(header->FileId)) != 0 || header->Version != TEXTURE_CONTAINER_VERSION)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Texture container '%s' has a wrong format or version.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    auto format = ConvertTextureContainerFormat(header->Format);
+    auto mipTableSize = sizeof(TextureContainerHeader) + (size_t)header->MipCount * sizeof(TextureContainerMipEntry);
+
+    if (format == ElemGraphicsFormat_Raw || header->Width == 0 || header->Height == 0 || header->MipCount == 0 || header->MipCount > TEXTURE_CONTAINER_MAX_MIP_COUNT ||
+        header->MipAlignment == 0 || (header->MipAlignment & (header->MipAlignment - 1)) != 0)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Texture container '%s' has an invalid format.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    if (header->SizeInBytes > data.Length || mipTableSize > data.Length)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Texture container '%s' is truncated.", path);
+        SystemFileUnmap(fileMapping);
+        return ELEM_HANDLE_NULL;
+    }
+
+    auto mipEntries = ReadOnlySpan<TextureContainerMipEntry>((TextureContainerMipEntry*)(data.Pointer + sizeof(TextureContainerHeader)), header->MipCount);
+
+    // NOTE: The mips are stored after the mip table and the mips that are at least as big as the alignment start
+    // on an aligned offset.
+    for (uint32_t i = 0; i < mipEntries.Length; i++)
+    {
+        auto mipEntry = &mipEntries[i];
+
+        if (mipEntry->Offset < mipTableSize || mipEntry->Offset > data.Length || mipEntry->SizeInBytes > data.Length - mipEntry->Offset || mipEntry->SizeInBytes > UINT32_MAX ||
+            mipEntry->Width != SystemMax(header->Width >> i, 1u) || mipEntry->Height != SystemMax(header->Height >> i, 1u) ||
+            mipEntry->SizeInBytes != GetTextureContainerMipSizeInBytes(format, mipEntry->Width, mipEntry->Height) ||
+            (mipEntry->SizeInBytes >= header->MipAlignment && (mipEntry->Offset & (header->MipAlignment - 1)) != 0))
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Application, "Texture container '%s' has an invalid mip.", path);
+            SystemFileUnmap(fileMapping);
+            return ELEM_HANDLE_NULL;
+        }
+    }
+
+    return SystemAddDataPoolItem(textureContainerDataPool, 
+    {
+        .FileMapping = fileMapping,
+        .Info = 
+        {
+            .Format = format,
+            .Width = header->Width,
+            .Height = header->Height,
+            .MipLevels = header->MipCount,
+            .MipAlignment = header->MipAlignment
+        },
+        .MipEntries = mipEntries
+    });
+}
+
+ElemAPI void ElemCloseTextureContainer(ElemTextureContainer textureContainer)
+{
+    auto textureContainerData = GetTextureContainerData(textureContainer);
+    SystemAssert(textureContainerData);
+
+    SystemFileUnmap(textureContainerData->FileMapping);
+    SystemRemoveDataPoolItem(textureContainerDataPool, textureContainer);
+}
+
+ElemAPI ElemTextureContainerInfo ElemGetTextureContainerInfo(ElemTextureContainer textureContainer)
+{
+    auto textureContainerData = GetTextureContainerData(textureContainer);
+    SystemAssert(textureContainerData);
+
+    return textureContainerData->Info;
+}
+
+ElemAPI ElemTextureContainerMip ElemGetTextureContainerMip(ElemTextureContainer textureContainer, uint32_t mipLevel)
+{
+    auto textureContainerData = GetTextureContainerData(textureContainer);
+    SystemAssert(textureContainerData);
+
+    if (mipLevel >= textureContainerData->MipEntries.Length)
+    {
+        return { .MipLevel = mipLevel };
+    }
+
+    auto mipEntry = &textureContainerData->MipEntries[mipLevel];
+
+    return
+    {
+        .MipLevel = mipLevel,
+        .Width = mipEntry->Width,
+        .Height = mipEntry->Height,
+        .FileOffset = mipEntry->Offset,
+        .Data = { .Items = (uint8_t*)textureContainerData->FileMapping.Data.Pointer + mipEntry->Offset, .Length = (uint32_t)mipEntry->SizeInBytes }
+    };
+}
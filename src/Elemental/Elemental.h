@@ -400,7 +400,14 @@ typedef enum
     ElemGraphicsFormat_R32G32B32A32_FLOAT,
     ElemGraphicsFormat_D32_FLOAT, 
     ElemGraphicsFormat_BC7,
-    ElemGraphicsFormat_BC7_SRGB 
+    ElemGraphicsFormat_BC7_SRGB,
+    ElemGraphicsFormat_BC1,
+    ElemGraphicsFormat_BC1_SRGB,
+    ElemGraphicsFormat_BC3,
+    ElemGraphicsFormat_BC3_SRGB,
+    ElemGraphicsFormat_BC4,
+    ElemGraphicsFormat_BC5,
+    ElemGraphicsFormat_BC6H
 } ElemGraphicsFormat;
 
 typedef enum
@@ -804,6 +811,70 @@ typedef struct
     ElemFenceSpan FencesToWait;
 } ElemFreeGraphicsResourceOptions;
 
+/**
+ * Tile layout of a sparse texture.
+ */
+typedef struct
+{
+    // Width of a tile in texels.
+    uint32_t TileWidth;
+    // Height of a tile in texels.
+    uint32_t TileHeight;
+    // Size of a tile in bytes. Each bound tile uses this size in the graphics heap.
+    uint32_t TileSizeInBytes;
+    // Alignment of the heap offsets passed to ElemBindGraphicsResourceTiles. Equals to the tile size except for
+    // the software fallback that uses the alignment of the texture memory requirements.
+    uint32_t TileAlignmentInBytes;
+    // First mip level of the packed mips. The packed mips can only be bound all together.
+    uint32_t PackedMipLevel;
+    // Number of tiles used by the packed mips.
+    uint32_t PackedMipTileCount;
+    // True when the device doesn't support sparse residency. All the mips are packed and the whole texture
+    // is committed when they are bound.
+    bool IsSoftwareFallback;
+} ElemGraphicsResourceTileInfo;
+
+/**
+ * Describes a region of tiles of a sparse texture to bind to a graphics heap.
+ */
+typedef struct
+{
+    // Mip level of the tiles. All the mips starting at PackedMipLevel are bound together.
+    uint32_t MipLevel;
+    // Horizontal index of the first tile. Ignored for the packed mips.
+    uint32_t TileX;
+    // Vertical index of the first tile. Ignored for the packed mips.
+    uint32_t TileY;
+    // Number of tiles in the horizontal direction. Ignored for the packed mips.
+    uint32_t TileCountX;
+    // Number of tiles in the vertical direction. Ignored for the packed mips.
+    uint32_t TileCountY;
+    // Graphics heap that provides the memory of the tiles. ELEM_HANDLE_NULL unbinds the tiles.
+    ElemGraphicsHeap GraphicsHeap;
+    // Offset of the first tile in the graphics heap. The tiles of the region are contiguous in the heap.
+    uint64_t GraphicsHeapOffset;
+} ElemGraphicsResourceTileBinding;
+
+/**
+ * Represents a collection of tile bindings.
+ */
+typedef struct
+{
+    // Pointer to an array of ElemGraphicsResourceTileBinding.
+    ElemGraphicsResourceTileBinding* Items;
+    // Number of items in the array.
+    uint32_t Length;
+} ElemGraphicsResourceTileBindingSpan;
+
+/**
+ * Options for binding the tiles of a sparse texture.
+ */
+typedef struct
+{
+    // Fences that the binding should wait on before starting.
+    ElemFenceSpan FencesToWait;
+} ElemBindGraphicsResourceTilesOptions;
+
 // TODO: Here, we could add options to support StructuredBuffer (we need a different stride for that)
 typedef struct
 {
@@ -852,6 +923,28 @@ typedef struct
     uint32_t SizeInBytes;
 } ElemDownloadGraphicsBufferDataOptions;
 
+typedef struct
+{
+    // If true, the resource delete queue is processed on a background thread. The work is joined on the next advance call.
+    bool ProcessDeleteQueueOnBackgroundThread;
+} ElemAdvanceGraphicsDeviceFrameOptions;
+
+typedef struct
+{
+    // Index of the frame that was just ended.
+    uint64_t FrameIndex;
+    // Time spent trimming the upload buffers that were not used for a while.
+    double UploadBufferTrimDurationInMilliseconds;
+    // Number of upload buffers released by the trim pass.
+    uint32_t TrimmedUploadBufferCount;
+    // Time spent processing the resource delete queue. When processed in the background, this is the duration of the previous pass.
+    double DeleteQueueDurationInMilliseconds;
+    // Number of resources freed by the delete queue pass. When processed in the background, this is the count of the previous pass.
+    uint32_t DeletedResourceCount;
+    // Total time spent on the calling thread.
+    double TotalDurationInMilliseconds;
+} ElemGraphicsDeviceFrameInfo;
+
 typedef enum
 {
     ElemCopyDataSourceType_Memory = 0,
@@ -1168,6 +1261,33 @@ ElemAPI ElemGraphicsResource ElemCreateGraphicsResource(ElemGraphicsHeap graphic
 ElemAPI void ElemFreeGraphicsResource(ElemGraphicsResource resource, const ElemFreeGraphicsResourceOptions* options);
 ElemAPI ElemGraphicsResourceInfo ElemGetGraphicsResourceInfo(ElemGraphicsResource resource);
 
+/**
+ * Creates a Texture2D that only reserves its address space. The memory is bound per tile with ElemBindGraphicsResourceTiles.
+ * When the device doesn't support sparse residency, the resource descriptors must be created after the packed mips are bound.
+ * @param graphicsDevice The graphics device used to create the texture.
+ * @param resourceInfo The texture description, usually created with ElemCreateTexture2DResourceInfo. Only the Read and Write usages are supported.
+ * @return A handle to the sparse texture.
+ */
+ElemAPI ElemGraphicsResource ElemCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo);
+
+/**
+ * Retrieves the tile layout of a sparse texture.
+ * @param resource The sparse texture to query.
+ * @return The tile shape, the tile size and the packed mips information.
+ */
+ElemAPI ElemGraphicsResourceTileInfo ElemGetGraphicsResourceTileInfo(ElemGraphicsResource resource);
+
+/**
+ * Binds or unbinds regions of tiles of a sparse texture on the GPU timeline of a command queue.
+ * With the software fallback, the memory stays committed until the resource is freed.
+ * @param commandQueue The command queue that performs the binding. On Vulkan, it must be a graphics command queue.
+ * @param resource The sparse texture.
+ * @param bindings The tile regions to bind.
+ * @param options Additional options like the fences to wait on.
+ * @return A fence that is signaled when the binding is done.
+ */
+ElemAPI ElemFence ElemBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options);
+
 // TODO: uint64_t for offset?
 ElemAPI void ElemUploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data);
 ElemAPI ElemDataSpan ElemDownloadGraphicsBufferData(ElemGraphicsResource resource, const ElemDownloadGraphicsBufferDataOptions* options);
@@ -1179,6 +1299,16 @@ ElemAPI void ElemFreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor d
 
 ElemAPI void ElemProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice);
 
+/**
+ * Ends the current frame of a graphics device. Resets the command allocations, releases the read back data,
+ * trims the unused upload buffers and processes the resource delete queue.
+ * Swap chains call it automatically after the update handler if the application didn't call it during the update.
+ * @param graphicsDevice The graphics device to advance.
+ * @param options Additional options for the frame advance.
+ * @return Timings and statistics of the housekeeping work.
+ */
+ElemAPI ElemGraphicsDeviceFrameInfo ElemAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options);
+
 ElemAPI ElemGraphicsSampler ElemCreateGraphicsSampler(ElemGraphicsDevice graphicsDevice, const ElemGraphicsSamplerInfo* samplerInfo);
 ElemAPI ElemGraphicsSamplerInfo ElemGetGraphicsSamplerInfo(ElemGraphicsSampler sampler);
 ElemAPI void ElemFreeGraphicsSampler(ElemGraphicsSampler sampler, const ElemFreeGraphicsSamplerOptions* options);
@@ -1191,6 +1321,16 @@ ElemAPI void ElemFreeGraphicsSampler(ElemGraphicsSampler sampler, const ElemFree
  */
 ElemAPI ElemShaderLibrary ElemCreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData);
 
+/**
+ * Creates a shader library that contains the shaders of one permutation of a library compiled with permutations.
+ * ElemCreateShaderLibrary uses the first permutation.
+ * @param graphicsDevice The device on which to create the shader library.
+ * @param shaderLibraryData The binary data containing the shaders of all the permutations.
+ * @param permutationIndex The index of the permutation computed from the value index of each permutation axis.
+ * @return A handle to the newly created shader library.
+ */
+ElemAPI ElemShaderLibrary ElemCreateShaderLibraryPermutation(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex);
+
 /**
  * Releases resources associated with a shader library.
  * @param shaderLibrary The shader library to free.
@@ -1503,6 +1643,147 @@ typedef struct
 ElemAPI ElemInputDeviceInfo ElemGetInputDeviceInfo(ElemInputDevice inputDevice);
 ElemAPI ElemInputStream ElemGetInputStream(void);
 
+//--------------------------------------------------------------------------------
+// ##Module_Scenes##
+//--------------------------------------------------------------------------------
+
+/**
+ * Handle that represents a memory mapped scene container.
+ */
+typedef ElemHandle ElemSceneContainer;
+
+/**
+ * Section of a scene container. The data points directly into the file mapping.
+ */
+typedef struct
+{
+    // Identifier of the section.
+    uint32_t Id;
+    // Size of one element of the section. 0 for raw data.
+    uint32_t ElementSize;
+    // Number of elements of the section. Equals to the data length for raw data.
+    uint32_t ElementCount;
+    // Data of the section. Empty if the section doesn't exist.
+    ElemDataSpan Data;
+} ElemSceneContainerSection;
+
+typedef struct
+{
+    ElemSceneContainerSection* Items;
+    uint32_t Length;
+} ElemSceneContainerSectionSpan;
+
+typedef struct
+{
+    // Version of the container format.
+    uint32_t Version;
+    // Sections in the order of the table of contents.
+    ElemSceneContainerSectionSpan Sections;
+} ElemSceneContainerInfo;
+
+/**
+ * Opens a scene container built with ElemBuildSceneContainer. The file is memory mapped and the header is validated
+ * but the sections are not read. The pages are loaded by the OS on first access.
+ *
+ * @param path Path of the container file.
+ * @return The scene container handle or ELEM_HANDLE_NULL if the file is not a valid container.
+ */
+ElemAPI ElemSceneContainer ElemOpenSceneContainer(const char* path);
+
+/**
+ * Closes a scene container and releases the file mapping. Spans returned for this container are not valid anymore.
+ *
+ * @param sceneContainer The scene container to close.
+ */
+ElemAPI void ElemCloseSceneContainer(ElemSceneContainer sceneContainer);
+
+/**
+ * Retrieves the information of a scene container.
+ *
+ * @param sceneContainer The scene container.
+ * @return The version and the sections of the container.
+ */
+ElemAPI ElemSceneContainerInfo ElemGetSceneContainerInfo(ElemSceneContainer sceneContainer);
+
+/**
+ * Retrieves a section of a scene container by its identifier.
+ *
+ * @param sceneContainer The scene container.
+ * @param sectionId Identifier of the section.
+ * @return The section. Its data is empty if the section doesn't exist.
+ */
+ElemAPI ElemSceneContainerSection ElemGetSceneContainerSection(ElemSceneContainer sceneContainer, uint32_t sectionId);
+
+//--------------------------------------------------------------------------------
+// ##Module_Textures##
+//--------------------------------------------------------------------------------
+
+/**
+ * Handle that represents a memory mapped texture container.
+ */
+typedef ElemHandle ElemTextureContainer;
+
+typedef struct
+{
+    // Format of the texture. The sRGB variant must be selected by the caller when needed.
+    ElemGraphicsFormat Format;
+    // Width of the first mip.
+    uint32_t Width;
+    // Height of the first mip.
+    uint32_t Height;
+    uint32_t MipLevels;
+    // Alignment in bytes of the mips that are bigger than the alignment.
+    uint32_t MipAlignment;
+} ElemTextureContainerInfo;
+
+/**
+ * Mip of a texture container. The data points directly into the file mapping.
+ */
+typedef struct
+{
+    uint32_t MipLevel;
+    uint32_t Width;
+    uint32_t Height;
+    // Offset of the mip data in the file. The data is aligned to MipAlignment when it is bigger than the alignment.
+    uint64_t FileOffset;
+    // Data of the mip. Empty if the mip doesn't exist.
+    ElemDataSpan Data;
+} ElemTextureContainerMip;
+
+/**
+ * Opens a texture container built with ElemBuildTextureContainer. The file is memory mapped and the header is validated
+ * but the mips are not read. The pages of a mip are loaded by the OS when its data is accessed so the lowest mips can be
+ * uploaded first and the higher mips requested later.
+ *
+ * @param path Path of the container file.
+ * @return The texture container handle or ELEM_HANDLE_NULL if the file is not a valid container.
+ */
+ElemAPI ElemTextureContainer ElemOpenTextureContainer(const char* path);
+
+/**
+ * Closes a texture container and releases the file mapping. Mips returned for this container are not valid anymore.
+ *
+ * @param textureContainer The texture container to close.
+ */
+ElemAPI void ElemCloseTextureContainer(ElemTextureContainer textureContainer);
+
+/**
+ * Retrieves the information of a texture container.
+ *
+ * @param textureContainer The texture container.
+ * @return The format, the size and the mip count of the texture.
+ */
+ElemAPI ElemTextureContainerInfo ElemGetTextureContainerInfo(ElemTextureContainer textureContainer);
+
+/**
+ * Retrieves a mip of a texture container. The data can be passed to ElemCopyDataToGraphicsResource.
+ *
+ * @param textureContainer The texture container.
+ * @param mipLevel Mip level to retrieve. 0 is the biggest mip.
+ * @return The mip. Its data is empty if the mip doesn't exist.
+ */
+ElemAPI ElemTextureContainerMip ElemGetTextureContainerMip(ElemTextureContainer textureContainer, uint32_t mipLevel);
+
 #ifdef UseLoader
 #ifndef ElementalLoader
 #include "ElementalLoader.c"
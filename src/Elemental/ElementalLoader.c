@@ -61,6 +61,9 @@ typedef struct ElementalFunctions
     ElemGraphicsResource (*ElemCreateGraphicsResource)(ElemGraphicsHeap, uint64_t, ElemGraphicsResourceInfo const *);
     void (*ElemFreeGraphicsResource)(ElemGraphicsResource, ElemFreeGraphicsResourceOptions const *);
     ElemGraphicsResourceInfo (*ElemGetGraphicsResourceInfo)(ElemGraphicsResource);
+    ElemGraphicsResource (*ElemCreateSparseGraphicsResource)(ElemGraphicsDevice, const ElemGraphicsResourceInfo*);
+    ElemGraphicsResourceTileInfo (*ElemGetGraphicsResourceTileInfo)(ElemGraphicsResource);
+    ElemFence (*ElemBindGraphicsResourceTiles)(ElemCommandQueue, ElemGraphicsResource, ElemGraphicsResourceTileBindingSpan, const ElemBindGraphicsResourceTilesOptions*);
     void (*ElemUploadGraphicsBufferData)(ElemGraphicsResource, unsigned int, ElemDataSpan);
     ElemDataSpan (*ElemDownloadGraphicsBufferData)(ElemGraphicsResource, ElemDownloadGraphicsBufferDataOptions const *);
     void (*ElemCopyDataToGraphicsResource)(ElemCommandList, ElemCopyDataToGraphicsResourceParameters const *);
@@ -68,10 +71,12 @@ typedef struct ElementalFunctions
     ElemGraphicsResourceDescriptorInfo (*ElemGetGraphicsResourceDescriptorInfo)(ElemGraphicsResourceDescriptor);
     void (*ElemFreeGraphicsResourceDescriptor)(ElemGraphicsResourceDescriptor, ElemFreeGraphicsResourceDescriptorOptions const *);
     void (*ElemProcessGraphicsResourceDeleteQueue)(ElemGraphicsDevice);
+    ElemGraphicsDeviceFrameInfo (*ElemAdvanceGraphicsDeviceFrame)(ElemGraphicsDevice, ElemAdvanceGraphicsDeviceFrameOptions const *);
     ElemGraphicsSampler (*ElemCreateGraphicsSampler)(ElemGraphicsDevice, ElemGraphicsSamplerInfo const *);
     ElemGraphicsSamplerInfo (*ElemGetGraphicsSamplerInfo)(ElemGraphicsSampler);
     void (*ElemFreeGraphicsSampler)(ElemGraphicsSampler, ElemFreeGraphicsSamplerOptions const *);
     ElemShaderLibrary (*ElemCreateShaderLibrary)(ElemGraphicsDevice, ElemDataSpan);
+    ElemShaderLibrary (*ElemCreateShaderLibraryPermutation)(ElemGraphicsDevice, ElemDataSpan, uint32_t);
     void (*ElemFreeShaderLibrary)(ElemShaderLibrary);
     ElemPipelineState (*ElemCompileGraphicsPipelineState)(ElemGraphicsDevice, ElemGraphicsPipelineStateParameters const *);
     ElemPipelineState (*ElemCompileComputePipelineState)(ElemGraphicsDevice, ElemComputePipelineStateParameters const *);
@@ -89,6 +94,14 @@ typedef struct ElementalFunctions
     void (*ElemDispatchMesh)(ElemCommandList, unsigned int, unsigned int, unsigned int);
     ElemInputDeviceInfo (*ElemGetInputDeviceInfo)(ElemInputDevice);
     ElemInputStream (*ElemGetInputStream)(void);
+    ElemSceneContainer (*ElemOpenSceneContainer)(char const *);
+    void (*ElemCloseSceneContainer)(ElemSceneContainer);
+    ElemSceneContainerInfo (*ElemGetSceneContainerInfo)(ElemSceneContainer);
+    ElemSceneContainerSection (*ElemGetSceneContainerSection)(ElemSceneContainer, unsigned int);
+    ElemTextureContainer (*ElemOpenTextureContainer)(const char*);
+    void (*ElemCloseTextureContainer)(ElemTextureContainer);
+    ElemTextureContainerInfo (*ElemGetTextureContainerInfo)(ElemTextureContainer);
+    ElemTextureContainerMip (*ElemGetTextureContainerMip)(ElemTextureContainer, uint32_t);
     
 } ElementalFunctions;
 
@@ -179,6 +192,9 @@ static bool LoadElementalFunctionPointers(void)
     listElementalFunctions.ElemCreateGraphicsResource = (ElemGraphicsResource (*)(ElemGraphicsHeap, uint64_t, ElemGraphicsResourceInfo const *))GetElementalFunctionPointer("ElemCreateGraphicsResource");
     listElementalFunctions.ElemFreeGraphicsResource = (void (*)(ElemGraphicsResource, ElemFreeGraphicsResourceOptions const *))GetElementalFunctionPointer("ElemFreeGraphicsResource");
     listElementalFunctions.ElemGetGraphicsResourceInfo = (ElemGraphicsResourceInfo (*)(ElemGraphicsResource))GetElementalFunctionPointer("ElemGetGraphicsResourceInfo");
+    listElementalFunctions.ElemCreateSparseGraphicsResource = (ElemGraphicsResource (*)(ElemGraphicsDevice, const ElemGraphicsResourceInfo*))GetElementalFunctionPointer("ElemCreateSparseGraphicsResource");
+    listElementalFunctions.ElemGetGraphicsResourceTileInfo = (ElemGraphicsResourceTileInfo (*)(ElemGraphicsResource))GetElementalFunctionPointer("ElemGetGraphicsResourceTileInfo");
+    listElementalFunctions.ElemBindGraphicsResourceTiles = (ElemFence (*)(ElemCommandQueue, ElemGraphicsResource, ElemGraphicsResourceTileBindingSpan, const ElemBindGraphicsResourceTilesOptions*))GetElementalFunctionPointer("ElemBindGraphicsResourceTiles");
     listElementalFunctions.ElemUploadGraphicsBufferData = (void (*)(ElemGraphicsResource, unsigned int, ElemDataSpan))GetElementalFunctionPointer("ElemUploadGraphicsBufferData");
     listElementalFunctions.ElemDownloadGraphicsBufferData = (ElemDataSpan (*)(ElemGraphicsResource, ElemDownloadGraphicsBufferDataOptions const *))GetElementalFunctionPointer("ElemDownloadGraphicsBufferData");
     listElementalFunctions.ElemCopyDataToGraphicsResource = (void (*)(ElemCommandList, ElemCopyDataToGraphicsResourceParameters const *))GetElementalFunctionPointer("ElemCopyDataToGraphicsResource");
@@ -186,10 +202,12 @@ static bool LoadElementalFunctionPointers(void)
     listElementalFunctions.ElemGetGraphicsResourceDescriptorInfo = (ElemGraphicsResourceDescriptorInfo (*)(ElemGraphicsResourceDescriptor))GetElementalFunctionPointer("ElemGetGraphicsResourceDescriptorInfo");
     listElementalFunctions.ElemFreeGraphicsResourceDescriptor = (void (*)(ElemGraphicsResourceDescriptor, ElemFreeGraphicsResourceDescriptorOptions const *))GetElementalFunctionPointer("ElemFreeGraphicsResourceDescriptor");
     listElementalFunctions.ElemProcessGraphicsResourceDeleteQueue = (void (*)(ElemGraphicsDevice))GetElementalFunctionPointer("ElemProcessGraphicsResourceDeleteQueue");
+    listElementalFunctions.ElemAdvanceGraphicsDeviceFrame = (ElemGraphicsDeviceFrameInfo (*)(ElemGraphicsDevice, ElemAdvanceGraphicsDeviceFrameOptions const *))GetElementalFunctionPointer("ElemAdvanceGraphicsDeviceFrame");
     listElementalFunctions.ElemCreateGraphicsSampler = (ElemGraphicsSampler (*)(ElemGraphicsDevice, ElemGraphicsSamplerInfo const *))GetElementalFunctionPointer("ElemCreateGraphicsSampler");
     listElementalFunctions.ElemGetGraphicsSamplerInfo = (ElemGraphicsSamplerInfo (*)(ElemGraphicsSampler))GetElementalFunctionPointer("ElemGetGraphicsSamplerInfo");
     listElementalFunctions.ElemFreeGraphicsSampler = (void (*)(ElemGraphicsSampler, ElemFreeGraphicsSamplerOptions const *))GetElementalFunctionPointer("ElemFreeGraphicsSampler");
     listElementalFunctions.ElemCreateShaderLibrary = (ElemShaderLibrary (*)(ElemGraphicsDevice, ElemDataSpan))GetElementalFunctionPointer("ElemCreateShaderLibrary");
+    listElementalFunctions.ElemCreateShaderLibraryPermutation = (ElemShaderLibrary (*)(ElemGraphicsDevice, ElemDataSpan, uint32_t))GetElementalFunctionPointer("ElemCreateShaderLibraryPermutation");
     listElementalFunctions.ElemFreeShaderLibrary = (void (*)(ElemShaderLibrary))GetElementalFunctionPointer("ElemFreeShaderLibrary");
     listElementalFunctions.ElemCompileGraphicsPipelineState = (ElemPipelineState (*)(ElemGraphicsDevice, ElemGraphicsPipelineStateParameters const *))GetElementalFunctionPointer("ElemCompileGraphicsPipelineState");
     listElementalFunctions.ElemCompileComputePipelineState = (ElemPipelineState (*)(ElemGraphicsDevice, ElemComputePipelineStateParameters const *))GetElementalFunctionPointer("ElemCompileComputePipelineState");
@@ -207,6 +225,14 @@ static bool LoadElementalFunctionPointers(void)
     listElementalFunctions.ElemDispatchMesh = (void (*)(ElemCommandList, unsigned int, unsigned int, unsigned int))GetElementalFunctionPointer("ElemDispatchMesh");
     listElementalFunctions.ElemGetInputDeviceInfo = (ElemInputDeviceInfo (*)(ElemInputDevice))GetElementalFunctionPointer("ElemGetInputDeviceInfo");
     listElementalFunctions.ElemGetInputStream = (ElemInputStream (*)(void))GetElementalFunctionPointer("ElemGetInputStream");
+    listElementalFunctions.ElemOpenSceneContainer = (ElemSceneContainer (*)(char const *))GetElementalFunctionPointer("ElemOpenSceneContainer");
+    listElementalFunctions.ElemCloseSceneContainer = (void (*)(ElemSceneContainer))GetElementalFunctionPointer("ElemCloseSceneContainer");
+    listElementalFunctions.ElemGetSceneContainerInfo = (ElemSceneContainerInfo (*)(ElemSceneContainer))GetElementalFunctionPointer("ElemGetSceneContainerInfo");
+    listElementalFunctions.ElemGetSceneContainerSection = (ElemSceneContainerSection (*)(ElemSceneContainer, unsigned int))GetElementalFunctionPointer("ElemGetSceneContainerSection");
+    listElementalFunctions.ElemOpenTextureContainer = (ElemTextureContainer (*)(const char*))GetElementalFunctionPointer("ElemOpenTextureContainer");
+    listElementalFunctions.ElemCloseTextureContainer = (void (*)(ElemTextureContainer))GetElementalFunctionPointer("ElemCloseTextureContainer");
+    listElementalFunctions.ElemGetTextureContainerInfo = (ElemTextureContainerInfo (*)(ElemTextureContainer))GetElementalFunctionPointer("ElemGetTextureContainerInfo");
+    listElementalFunctions.ElemGetTextureContainerMip = (ElemTextureContainerMip (*)(ElemTextureContainer, uint32_t))GetElementalFunctionPointer("ElemGetTextureContainerMip");
     
 
     functionPointersLoadedElemental = 1;
@@ -1226,6 +1252,99 @@ static inline ElemGraphicsResourceInfo ElemGetGraphicsResourceInfo(ElemGraphicsR
     return listElementalFunctions.ElemGetGraphicsResourceInfo(resource);
 }
 
+static inline ElemGraphicsResource ElemCreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemGraphicsResource result = {};
+        #else
+        ElemGraphicsResource result = (ElemGraphicsResource){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemCreateSparseGraphicsResource) 
+    {
+        assert(listElementalFunctions.ElemCreateSparseGraphicsResource);
+
+        #ifdef __cplusplus
+        ElemGraphicsResource result = {};
+        #else
+        ElemGraphicsResource result = (ElemGraphicsResource){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemCreateSparseGraphicsResource(graphicsDevice, resourceInfo);
+}
+
+static inline ElemGraphicsResourceTileInfo ElemGetGraphicsResourceTileInfo(ElemGraphicsResource resource)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemGraphicsResourceTileInfo result = {};
+        #else
+        ElemGraphicsResourceTileInfo result = (ElemGraphicsResourceTileInfo){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemGetGraphicsResourceTileInfo) 
+    {
+        assert(listElementalFunctions.ElemGetGraphicsResourceTileInfo);
+
+        #ifdef __cplusplus
+        ElemGraphicsResourceTileInfo result = {};
+        #else
+        ElemGraphicsResourceTileInfo result = (ElemGraphicsResourceTileInfo){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemGetGraphicsResourceTileInfo(resource);
+}
+
+static inline ElemFence ElemBindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemFence result = {};
+        #else
+        ElemFence result = (ElemFence){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemBindGraphicsResourceTiles) 
+    {
+        assert(listElementalFunctions.ElemBindGraphicsResourceTiles);
+
+        #ifdef __cplusplus
+        ElemFence result = {};
+        #else
+        ElemFence result = (ElemFence){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemBindGraphicsResourceTiles(commandQueue, resource, bindings, options);
+}
+
 static inline void ElemUploadGraphicsBufferData(ElemGraphicsResource resource, unsigned int offset, ElemDataSpan data)
 {
     if (!LoadElementalFunctionPointers()) 
@@ -1387,6 +1506,37 @@ static inline void ElemProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice gra
     listElementalFunctions.ElemProcessGraphicsResourceDeleteQueue(graphicsDevice);
 }
 
+static inline ElemGraphicsDeviceFrameInfo ElemAdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, ElemAdvanceGraphicsDeviceFrameOptions const * options)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemGraphicsDeviceFrameInfo result = {};
+        #else
+        ElemGraphicsDeviceFrameInfo result = (ElemGraphicsDeviceFrameInfo){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemAdvanceGraphicsDeviceFrame) 
+    {
+        assert(listElementalFunctions.ElemAdvanceGraphicsDeviceFrame);
+
+        #ifdef __cplusplus
+        ElemGraphicsDeviceFrameInfo result = {};
+        #else
+        ElemGraphicsDeviceFrameInfo result = (ElemGraphicsDeviceFrameInfo){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemAdvanceGraphicsDeviceFrame(graphicsDevice, options);
+}
+
 static inline ElemGraphicsSampler ElemCreateGraphicsSampler(ElemGraphicsDevice graphicsDevice, ElemGraphicsSamplerInfo const * samplerInfo)
 {
     if (!LoadElementalFunctionPointers()) 
@@ -1497,6 +1647,37 @@ static inline ElemShaderLibrary ElemCreateShaderLibrary(ElemGraphicsDevice graph
     return listElementalFunctions.ElemCreateShaderLibrary(graphicsDevice, shaderLibraryData);
 }
 
+static inline ElemShaderLibrary ElemCreateShaderLibraryPermutation(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemShaderLibrary result = {};
+        #else
+        ElemShaderLibrary result = (ElemShaderLibrary){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemCreateShaderLibraryPermutation) 
+    {
+        assert(listElementalFunctions.ElemCreateShaderLibraryPermutation);
+
+        #ifdef __cplusplus
+        ElemShaderLibrary result = {};
+        #else
+        ElemShaderLibrary result = (ElemShaderLibrary){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemCreateShaderLibraryPermutation(graphicsDevice, shaderLibraryData, permutationIndex);
+}
+
 static inline void ElemFreeShaderLibrary(ElemShaderLibrary shaderLibrary)
 {
     if (!LoadElementalFunctionPointers()) 
@@ -1841,3 +2022,223 @@ static inline ElemInputStream ElemGetInputStream(void)
 
     return listElementalFunctions.ElemGetInputStream();
 }
+
+static inline ElemSceneContainer ElemOpenSceneContainer(const char* path)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemSceneContainer result = {};
+        #else
+        ElemSceneContainer result = (ElemSceneContainer){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemOpenSceneContainer) 
+    {
+        assert(listElementalFunctions.ElemOpenSceneContainer);
+
+        #ifdef __cplusplus
+        ElemSceneContainer result = {};
+        #else
+        ElemSceneContainer result = (ElemSceneContainer){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemOpenSceneContainer(path);
+}
+
+static inline void ElemCloseSceneContainer(ElemSceneContainer sceneContainer)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+        return;
+    }
+
+    if (!listElementalFunctions.ElemCloseSceneContainer) 
+    {
+        assert(listElementalFunctions.ElemCloseSceneContainer);
+        return;
+    }
+
+    listElementalFunctions.ElemCloseSceneContainer(sceneContainer);
+}
+
+static inline ElemSceneContainerInfo ElemGetSceneContainerInfo(ElemSceneContainer sceneContainer)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemSceneContainerInfo result = {};
+        #else
+        ElemSceneContainerInfo result = (ElemSceneContainerInfo){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemGetSceneContainerInfo) 
+    {
+        assert(listElementalFunctions.ElemGetSceneContainerInfo);
+
+        #ifdef __cplusplus
+        ElemSceneContainerInfo result = {};
+        #else
+        ElemSceneContainerInfo result = (ElemSceneContainerInfo){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemGetSceneContainerInfo(sceneContainer);
+}
+
+static inline ElemSceneContainerSection ElemGetSceneContainerSection(ElemSceneContainer sceneContainer, uint32_t sectionId)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemSceneContainerSection result = {};
+        #else
+        ElemSceneContainerSection result = (ElemSceneContainerSection){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemGetSceneContainerSection) 
+    {
+        assert(listElementalFunctions.ElemGetSceneContainerSection);
+
+        #ifdef __cplusplus
+        ElemSceneContainerSection result = {};
+        #else
+        ElemSceneContainerSection result = (ElemSceneContainerSection){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemGetSceneContainerSection(sceneContainer, sectionId);
+}
+
+static inline ElemTextureContainer ElemOpenTextureContainer(const char* path)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemTextureContainer result = {};
+        #else
+        ElemTextureContainer result = (ElemTextureContainer){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemOpenTextureContainer) 
+    {
+        assert(listElementalFunctions.ElemOpenTextureContainer);
+
+        #ifdef __cplusplus
+        ElemTextureContainer result = {};
+        #else
+        ElemTextureContainer result = (ElemTextureContainer){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemOpenTextureContainer(path);
+}
+
+static inline void ElemCloseTextureContainer(ElemTextureContainer textureContainer)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+        return;
+    }
+
+    if (!listElementalFunctions.ElemCloseTextureContainer) 
+    {
+        assert(listElementalFunctions.ElemCloseTextureContainer);
+        return;
+    }
+
+    listElementalFunctions.ElemCloseTextureContainer(textureContainer);
+}
+
+static inline ElemTextureContainerInfo ElemGetTextureContainerInfo(ElemTextureContainer textureContainer)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemTextureContainerInfo result = {};
+        #else
+        ElemTextureContainerInfo result = (ElemTextureContainerInfo){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemGetTextureContainerInfo) 
+    {
+        assert(listElementalFunctions.ElemGetTextureContainerInfo);
+
+        #ifdef __cplusplus
+        ElemTextureContainerInfo result = {};
+        #else
+        ElemTextureContainerInfo result = (ElemTextureContainerInfo){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemGetTextureContainerInfo(textureContainer);
+}
+
+static inline ElemTextureContainerMip ElemGetTextureContainerMip(ElemTextureContainer textureContainer, uint32_t mipLevel)
+{
+    if (!LoadElementalFunctionPointers()) 
+    {
+        assert(libraryElemental);
+
+        #ifdef __cplusplus
+        ElemTextureContainerMip result = {};
+        #else
+        ElemTextureContainerMip result = (ElemTextureContainerMip){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalFunctions.ElemGetTextureContainerMip) 
+    {
+        assert(listElementalFunctions.ElemGetTextureContainerMip);
+
+        #ifdef __cplusplus
+        ElemTextureContainerMip result = {};
+        #else
+        ElemTextureContainerMip result = (ElemTextureContainerMip){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalFunctions.ElemGetTextureContainerMip(textureContainer, mipLevel);
+}
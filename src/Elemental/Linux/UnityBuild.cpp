@@ -24,6 +24,7 @@
 #include "Graphics/GraphicsDevice.cpp"
 #include "Graphics/CommandList.cpp"
 #include "Graphics/SwapChain.cpp"
+#include "Graphics/SwapChainTiming.cpp"
 #include "Graphics/Resource.cpp"
 #include "Graphics/Shader.cpp"
 #include "Graphics/Rendering.cpp"
@@ -32,6 +33,9 @@
 #include "Inputs/Inputs.cpp"
 #include "Inputs/HidDevices.cpp"
 
+#include "Scenes/SceneContainer.cpp"
+#include "Textures/TextureContainer.cpp"
+
 #include "PosixPlatformFunctions.cpp"
 #include "SystemPlatformFunctions.cpp"
 #include "SystemLogging.cpp"
@@ -7,10 +7,17 @@
 #include "SystemPlatformFunctions.h"
 
 #define WAYLAND_MAX_INITHANDLER 10u
+#define WAYLAND_MAX_RUNLOOP 10u
+
+// NOTE: The run loop wakes up at least at this interval so the run loop handlers can run
+// even when the compositor doesn't send any event.
+#define WAYLAND_RUNLOOP_TIMEOUT_IN_MS 4
 
 MemoryArena ApplicationMemoryArena;
 Span<WaylandInitHandler> WaylandInitHandlers;
 uint32_t WaylandCurrentInitIndex;
+Span<WaylandRunLoopHandler> WaylandRunLoopHandlers;
+uint32_t WaylandCurrentRunLoopIndex;
 
 uint64_t WaylandPerformanceCounterStart;
 uint64_t WaylandPerformanceCounterFrequencyInSeconds;
@@ -63,6 +70,7 @@ void InitWaylandApplicationMemory()
     {
         ApplicationMemoryArena = SystemAllocateMemoryArena();
         WaylandInitHandlers = SystemPushArray<WaylandInitHandler>(ApplicationMemoryArena, WAYLAND_MAX_INITHANDLER);
+        WaylandRunLoopHandlers = SystemPushArray<WaylandRunLoopHandler>(ApplicationMemoryArena, WAYLAND_MAX_RUNLOOP);
 
         SystemLogDebugMessage(ElemLogMessageCategory_Application, "Init OK.");
 
@@ -85,6 +93,16 @@ void AddWaylandInitHandler(WaylandInitHandlerPtr handler, ElemHandle handle)
     };
 }
 
+void AddWaylandRunLoopHandler(WaylandRunLoopHandlerPtr handler, ElemHandle handle)
+{
+    WaylandRunLoopHandlers[WaylandCurrentRunLoopIndex++] = 
+    {
+        .Function = handler,
+        .Handle = handle,
+        .NextIndex = 0
+    };
+}
+
 void WaylandOutputModeHandler(void* data, wl_output* output, uint32_t flags, int width, int height, int refresh)
 {
     if (flags & WL_OUTPUT_MODE_CURRENT) 
@@ -187,8 +205,13 @@ ElemAPI int32_t ElemRunApplication(const ElemRunApplicationParameters* parameter
         handler.Function(handler.Handle);
     }
     
-    while (libdecor_dispatch(WaylandLibdecor, -1) != -1 && waylandApplicationCanRun)
+    while (libdecor_dispatch(WaylandLibdecor, WAYLAND_RUNLOOP_TIMEOUT_IN_MS) != -1 && waylandApplicationCanRun)
     {
+        for (uint32_t i = 0; i < WaylandCurrentRunLoopIndex && waylandApplicationCanRun; i++)
+        {
+            auto handler = WaylandRunLoopHandlers[i];
+            handler.Function(handler.Handle);
+        }
     }
     
     if (parameters->FreeHandler)
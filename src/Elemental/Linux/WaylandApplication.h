@@ -12,6 +12,15 @@ struct WaylandInitHandler
     uint32_t NextIndex;
 };
 
+typedef void (*WaylandRunLoopHandlerPtr)(ElemHandle handle);
+
+struct WaylandRunLoopHandler
+{
+    WaylandRunLoopHandlerPtr Function;
+    ElemHandle Handle;
+    uint32_t NextIndex;
+};
+
 extern MemoryArena ApplicationMemoryArena;
 extern wl_display* WaylandDisplay;
 extern wl_output* WaylandOutput;
@@ -25,6 +34,7 @@ extern uint64_t WaylandPerformanceCounterFrequencyInSeconds;
 
 void AddWaylandInitHandler(WaylandInitHandler handler);
 void RemoveWaylandInitHandler(WaylandInitHandler handler) {}
+void AddWaylandRunLoopHandler(WaylandRunLoopHandler handler);
 void WaylandSetDefaultCursor(wl_pointer* pointer, uint32_t serial);
 
 void WaylandOutputGeometryHandler(void* data, wl_output* output, int x, int y, int physical_width, int physical_height, int subpixel, const char* make, const char* model, int transform) {}
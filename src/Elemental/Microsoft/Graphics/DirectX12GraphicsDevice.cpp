@@ -1,5 +1,6 @@
 #include "DirectX12GraphicsDevice.h"
 #include "DirectX12Config.h"
+#include "Graphics/ResourceDeleteQueue.h"
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemLogging.h"
@@ -465,6 +466,8 @@ void DirectX12FreeGraphicsDevice(ElemGraphicsDevice graphicsDevice)
 {
     SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
 
+    FreeResourceDeleteQueueBackgroundThread();
+
     auto graphicsDeviceData = GetDirectX12GraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
 
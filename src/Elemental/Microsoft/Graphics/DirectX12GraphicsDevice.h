@@ -17,6 +17,7 @@ struct DirectX12GraphicsDeviceData
     ComPtr<ID3D12RootSignature> RootSignature;
     uint64_t CommandAllocationGeneration;
     uint64_t UploadBufferGeneration;
+    uint64_t FrameIndex;
     DirectX12DescriptorHeap ResourceDescriptorHeap;
     DirectX12DescriptorHeap SamplerDescriptorHeap;
     DirectX12DescriptorHeap RTVDescriptorHeap;
@@ -8,6 +8,7 @@
 #include "SystemDataPool.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
+#include "SystemPlatformFunctions.h"
 
 SystemDataPool<DirectX12GraphicsHeapData, DirectX12GraphicsHeapDataFull> directX12GraphicsHeapPool;
 SystemDataPool<DirectX12GraphicsResourceData, DirectX12GraphicsResourceDataFull> directX12GraphicsResourcePool;
@@ -199,6 +200,27 @@ DXGI_FORMAT ConvertToDirectX12TextureFormat(ElemGraphicsFormat format)
         case ElemGraphicsFormat_BC7_SRGB:
             return DXGI_FORMAT_BC7_UNORM_SRGB;
 
+        case ElemGraphicsFormat_BC1:
+            return DXGI_FORMAT_BC1_UNORM;
+
+        case ElemGraphicsFormat_BC1_SRGB:
+            return DXGI_FORMAT_BC1_UNORM_SRGB;
+
+        case ElemGraphicsFormat_BC3:
+            return DXGI_FORMAT_BC3_UNORM;
+
+        case ElemGraphicsFormat_BC3_SRGB:
+            return DXGI_FORMAT_BC3_UNORM_SRGB;
+
+        case ElemGraphicsFormat_BC4:
+            return DXGI_FORMAT_BC4_UNORM;
+
+        case ElemGraphicsFormat_BC5:
+            return DXGI_FORMAT_BC5_UNORM;
+
+        case ElemGraphicsFormat_BC6H:
+            return DXGI_FORMAT_BC6H_UF16;
+
         case ElemGraphicsFormat_Raw:
             return DXGI_FORMAT_UNKNOWN;
     }
@@ -229,6 +251,27 @@ ElemGraphicsFormat ConvertFromDirectX12TextureFormat(DXGI_FORMAT format)
         case DXGI_FORMAT_BC7_UNORM_SRGB:
             return ElemGraphicsFormat_BC7_SRGB;
 
+        case DXGI_FORMAT_BC1_UNORM:
+            return ElemGraphicsFormat_BC1;
+
+        case DXGI_FORMAT_BC1_UNORM_SRGB:
+            return ElemGraphicsFormat_BC1_SRGB;
+
+        case DXGI_FORMAT_BC3_UNORM:
+            return ElemGraphicsFormat_BC3;
+
+        case DXGI_FORMAT_BC3_UNORM_SRGB:
+            return ElemGraphicsFormat_BC3_SRGB;
+
+        case DXGI_FORMAT_BC4_UNORM:
+            return ElemGraphicsFormat_BC4;
+
+        case DXGI_FORMAT_BC5_UNORM:
+            return ElemGraphicsFormat_BC5;
+
+        case DXGI_FORMAT_BC6H_UF16:
+            return ElemGraphicsFormat_BC6H;
+
         default:
             return ElemGraphicsFormat_Raw;
     }
@@ -499,6 +542,12 @@ ElemGraphicsResource DirectX12CreateGraphicsResource(ElemGraphicsHeap graphicsHe
             return ELEM_HANDLE_NULL;
         }
 
+        if (resourceInfo->Usage != ElemGraphicsResourceUsage_Read && GetGraphicsFormatBlockSizeInBytes(resourceInfo->Format) > 0)
+        {
+            SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Texture2D with a block compressed format should only use the Read usage.");
+            return ELEM_HANDLE_NULL;
+        }
+
         resourceDescription = CreateDirectX12TextureDescription(resourceInfo);
     }
     else
@@ -596,6 +645,210 @@ ElemGraphicsResourceInfo DirectX12GetGraphicsResourceInfo(ElemGraphicsResource r
     };
 }
 
+ElemGraphicsResource DirectX12CreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo)
+{
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+
+    SystemAssert(graphicsDevice != ELEM_HANDLE_NULL);
+    SystemAssert(resourceInfo);
+
+    auto graphicsDeviceData = GetDirectX12GraphicsDeviceData(graphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    if (!CheckSparseGraphicsResourceInfo(resourceInfo))
+    {
+        return ELEM_HANDLE_NULL;
+    }
+
+    // NOTE: The devices that pass the compatibility checks support at least the tier 2 of tiled resources so
+    // there is no software fallback on DirectX12.
+    D3D12_FEATURE_DATA_D3D12_OPTIONS deviceOptions = {};
+    AssertIfFailed(graphicsDeviceData->Device->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS, &deviceOptions, sizeof(deviceOptions)));
+
+    if (deviceOptions.TiledResourcesTier == D3D12_TILED_RESOURCES_TIER_NOT_SUPPORTED)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Sparse resources are not supported by the graphics device.");
+        return ELEM_HANDLE_NULL;
+    }
+
+    auto textureDescription = CreateDirectX12TextureDescription(resourceInfo);
+
+    D3D12_RESOURCE_DESC resourceDescription =
+    {
+        .Dimension = textureDescription.Dimension,
+        .Alignment = textureDescription.Alignment,
+        .Width = textureDescription.Width,
+        .Height = textureDescription.Height,
+        .DepthOrArraySize = textureDescription.DepthOrArraySize,
+        .MipLevels = textureDescription.MipLevels,
+        .Format = textureDescription.Format,
+        .SampleDesc = textureDescription.SampleDesc,
+        .Layout = D3D12_TEXTURE_LAYOUT_64KB_UNDEFINED_SWIZZLE,
+        .Flags = textureDescription.Flags
+    };
+
+    ComPtr<ID3D12Resource> resource;
+    AssertIfFailedReturnNullHandle(graphicsDeviceData->Device->CreateReservedResource2(&resourceDescription, 
+                                                                                      D3D12_BARRIER_LAYOUT_COMMON, 
+                                                                                      nullptr, 
+                                                                                      nullptr, 
+                                                                                      0, 
+                                                                                      nullptr, 
+                                                                                      IID_PPV_ARGS(resource.GetAddressOf())));
+
+    if (DirectX12DebugLayerEnabled && resourceInfo->DebugName)
+    {
+        resource->SetName(SystemConvertUtf8ToWideChar(stackMemoryArena, resourceInfo->DebugName).Pointer);
+    }
+
+    UINT tileCount = 0;
+    D3D12_PACKED_MIP_INFO packedMipInfo = {};
+    D3D12_TILE_SHAPE tileShape = {};
+    UINT subresourceTilingCount = 0;
+
+    graphicsDeviceData->Device->GetResourceTiling(resource.Get(), &tileCount, &packedMipInfo, &tileShape, &subresourceTilingCount, 0, nullptr);
+
+    auto handle = CreateDirectX12GraphicsResourceFromResource(graphicsDevice, ElemGraphicsResourceType_Texture2D, ELEM_HANDLE_NULL, resource, false);
+
+    auto resourceDataFull = GetDirectX12GraphicsResourceDataFull(handle);
+    SystemAssert(resourceDataFull);
+
+    resourceDataFull->IsSparse = true;
+    resourceDataFull->TileInfo =
+    {
+        .TileWidth = tileShape.WidthInTexels,
+        .TileHeight = tileShape.HeightInTexels,
+        .TileSizeInBytes = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES,
+        .TileAlignmentInBytes = D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES,
+        .PackedMipLevel = packedMipInfo.NumStandardMips,
+        .PackedMipTileCount = packedMipInfo.NumTilesForPackedMips,
+        .IsSoftwareFallback = false
+    };
+
+    return handle;
+}
+
+ElemGraphicsResourceTileInfo DirectX12GetGraphicsResourceTileInfo(ElemGraphicsResource resource)
+{
+    SystemAssert(resource != ELEM_HANDLE_NULL);
+
+    auto resourceDataFull = GetDirectX12GraphicsResourceDataFull(resource);
+
+    if (!resourceDataFull || !resourceDataFull->IsSparse)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Resource should be created with ElemCreateSparseGraphicsResource.");
+        return {};
+    }
+
+    return resourceDataFull->TileInfo;
+}
+
+ElemFence DirectX12BindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options)
+{
+    SystemAssert(commandQueue != ELEM_HANDLE_NULL);
+    SystemAssert(resource != ELEM_HANDLE_NULL);
+
+    auto commandQueueData = GetDirectX12CommandQueueData(commandQueue);
+    SystemAssert(commandQueueData);
+
+    auto resourceData = GetDirectX12GraphicsResourceData(resource);
+    auto resourceDataFull = GetDirectX12GraphicsResourceDataFull(resource);
+
+    if (!resourceData || !resourceDataFull || !resourceDataFull->IsSparse)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Graphics, "Resource should be created with ElemCreateSparseGraphicsResource.");
+        return {};
+    }
+
+    auto resourceInfo = DirectX12GetGraphicsResourceInfo(resource);
+    auto tileInfo = &resourceDataFull->TileInfo;
+
+    for (uint32_t i = 0; i < bindings.Length; i++)
+    {
+        auto binding = &bindings.Items[i];
+        uint64_t graphicsHeapSizeInBytes = 0;
+
+        if (binding->GraphicsHeap != ELEM_HANDLE_NULL)
+        {
+            auto graphicsHeapData = GetDirectX12GraphicsHeapData(binding->GraphicsHeap);
+            SystemAssert(graphicsHeapData);
+
+            graphicsHeapSizeInBytes = graphicsHeapData->SizeInBytes;
+        }
+
+        if (!CheckGraphicsResourceTileBinding(&resourceInfo, tileInfo, binding, graphicsHeapSizeInBytes))
+        {
+            return {};
+        }
+    }
+
+    if (options && options->FencesToWait.Length > 0)
+    {
+        for (uint32_t i = 0; i < options->FencesToWait.Length; i++)
+        {
+            auto fenceToWait = options->FencesToWait.Items[i];
+
+            auto commandQueueToWaitDataFull = GetDirectX12CommandQueueDataFull(fenceToWait.CommandQueue);
+            SystemAssert(commandQueueToWaitDataFull);
+
+            AssertIfFailed(commandQueueData->DeviceObject->Wait(commandQueueToWaitDataFull->Fence.Get(), fenceToWait.FenceValue));
+        }
+    }
+
+    // NOTE: The tile mappings use only one heap per call so each binding is submitted separately.
+    for (uint32_t i = 0; i < bindings.Length; i++)
+    {
+        auto binding = &bindings.Items[i];
+
+        D3D12_TILED_RESOURCE_COORDINATE regionCoordinate = {};
+        D3D12_TILE_REGION_SIZE regionSize = {};
+
+        if (binding->MipLevel >= tileInfo->PackedMipLevel)
+        {
+            regionCoordinate.Subresource = tileInfo->PackedMipLevel;
+            regionSize.NumTiles = tileInfo->PackedMipTileCount;
+            regionSize.UseBox = false;
+        }
+        else
+        {
+            regionCoordinate.X = binding->TileX;
+            regionCoordinate.Y = binding->TileY;
+            regionCoordinate.Subresource = binding->MipLevel;
+
+            regionSize.NumTiles = binding->TileCountX * binding->TileCountY;
+            regionSize.UseBox = true;
+            regionSize.Width = binding->TileCountX;
+            regionSize.Height = (uint16_t)binding->TileCountY;
+            regionSize.Depth = 1;
+        }
+
+        ID3D12Heap* heap = nullptr;
+        D3D12_TILE_RANGE_FLAGS rangeFlags = D3D12_TILE_RANGE_FLAG_NULL;
+        UINT heapRangeStartOffset = 0;
+        UINT rangeTileCount = regionSize.NumTiles;
+
+        if (binding->GraphicsHeap != ELEM_HANDLE_NULL)
+        {
+            heap = GetDirectX12GraphicsHeapData(binding->GraphicsHeap)->DeviceObject.Get();
+            rangeFlags = D3D12_TILE_RANGE_FLAG_NONE;
+            heapRangeStartOffset = (UINT)(binding->GraphicsHeapOffset / D3D12_TILED_RESOURCE_TILE_SIZE_IN_BYTES);
+        }
+
+        commandQueueData->DeviceObject->UpdateTileMappings(resourceData->DeviceObject.Get(), 
+                                                           1, 
+                                                           &regionCoordinate, 
+                                                           &regionSize, 
+                                                           heap, 
+                                                           1, 
+                                                           &rangeFlags, 
+                                                           &heapRangeStartOffset, 
+                                                           &rangeTileCount, 
+                                                           D3D12_TILE_MAPPING_FLAG_NONE);
+    }
+
+    return CreateDirectX12CommandQueueFence(commandQueue);
+}
+
 void DirectX12UploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data)
 {
     SystemAssert(resource != ELEM_HANDLE_NULL);
@@ -1012,17 +1265,15 @@ void DirectX12FreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor desc
     directX12ResourceDescriptorInfos[descriptor].Resource = ELEM_HANDLE_NULL;
 }
 
-void DirectX12ProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
+uint32_t TrimDirectX12UploadBufferPools(ElemGraphicsDevice graphicsDevice)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
 
-    ProcessResourceDeleteQueue();
-    SystemClearMemoryArena(directX12ReadBackMemoryArena);
-    
     auto graphicsDeviceData = GetDirectX12GraphicsDeviceData(graphicsDevice);
     SystemAssert(graphicsDeviceData);
 
     graphicsDeviceData->UploadBufferGeneration++;
+    uint32_t trimmedCount = 0;
     
     for (uint32_t i = 0; i < graphicsDeviceData->UploadBufferPools.Length; i++)
     {
@@ -1041,9 +1292,58 @@ void DirectX12ProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevi
                 uploadBufferToDelete->Buffer.Reset();
                 uploadBufferToDelete->CurrentOffset = 0;
                 uploadBufferToDelete->SizeInBytes = 0;
+                trimmedCount++;
             }
         }
     }
+
+    return trimmedCount;
+}
+
+void DirectX12ProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice)
+{
+    WaitForResourceDeleteQueueBackgroundProcessing();
+    ProcessResourceDeleteQueue();
+    SystemClearMemoryArena(directX12ReadBackMemoryArena);
+    TrimDirectX12UploadBufferPools(graphicsDevice);
+}
+
+ElemGraphicsDeviceFrameInfo DirectX12AdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options)
+{
+    auto graphicsDeviceData = GetDirectX12GraphicsDeviceData(graphicsDevice);
+    SystemAssert(graphicsDeviceData);
+
+    auto ticksPerMilliseconds = (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds() / 1000.0;
+    auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    // NOTE: The previous background pass must be completed before touching the delete queue again.
+    auto deleteQueueInfo = WaitForResourceDeleteQueueBackgroundProcessing();
+
+    DirectX12ResetCommandAllocation(graphicsDevice);
+    SystemClearMemoryArena(directX12ReadBackMemoryArena);
+
+    auto trimStartTimestamp = SystemPlatformGetHighPerformanceCounter();
+    auto trimmedUploadBufferCount = TrimDirectX12UploadBufferPools(graphicsDevice);
+    auto trimEndTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    if (options && options->ProcessDeleteQueueOnBackgroundThread)
+    {
+        ProcessResourceDeleteQueueInBackground();
+    }
+    else
+    {
+        deleteQueueInfo = ProcessResourceDeleteQueue();
+    }
+
+    return
+    {
+        .FrameIndex = graphicsDeviceData->FrameIndex++,
+        .UploadBufferTrimDurationInMilliseconds = (double)(trimEndTimestamp - trimStartTimestamp) / ticksPerMilliseconds,
+        .TrimmedUploadBufferCount = trimmedUploadBufferCount,
+        .DeleteQueueDurationInMilliseconds = deleteQueueInfo.DurationInMilliseconds,
+        .DeletedResourceCount = deleteQueueInfo.DeletedEntryCount,
+        .TotalDurationInMilliseconds = (double)(SystemPlatformGetHighPerformanceCounter() - startTimestamp) / ticksPerMilliseconds
+    };
 }
 
 ElemGraphicsSampler DirectX12CreateGraphicsSampler(ElemGraphicsDevice graphicsDevice, const ElemGraphicsSamplerInfo* samplerInfo)
@@ -46,6 +46,8 @@ struct DirectX12GraphicsResourceData
 struct DirectX12GraphicsResourceDataFull
 {
     ElemGraphicsDevice GraphicsDevice;
+    bool IsSparse;
+    ElemGraphicsResourceTileInfo TileInfo;
 };
 
 DirectX12GraphicsHeapData* GetDirectX12GraphicsHeapData(ElemGraphicsHeap graphicsHeap);
@@ -68,6 +70,10 @@ ElemGraphicsResource DirectX12CreateGraphicsResource(ElemGraphicsHeap graphicsHe
 void DirectX12FreeGraphicsResource(ElemGraphicsResource resource, const ElemFreeGraphicsResourceOptions* options);
 ElemGraphicsResourceInfo DirectX12GetGraphicsResourceInfo(ElemGraphicsResource resource);
 
+ElemGraphicsResource DirectX12CreateSparseGraphicsResource(ElemGraphicsDevice graphicsDevice, const ElemGraphicsResourceInfo* resourceInfo);
+ElemGraphicsResourceTileInfo DirectX12GetGraphicsResourceTileInfo(ElemGraphicsResource resource);
+ElemFence DirectX12BindGraphicsResourceTiles(ElemCommandQueue commandQueue, ElemGraphicsResource resource, ElemGraphicsResourceTileBindingSpan bindings, const ElemBindGraphicsResourceTilesOptions* options);
+
 void DirectX12UploadGraphicsBufferData(ElemGraphicsResource resource, uint32_t offset, ElemDataSpan data);
 ElemDataSpan DirectX12DownloadGraphicsBufferData(ElemGraphicsResource resource, const ElemDownloadGraphicsBufferDataOptions* options);
 void DirectX12CopyDataToGraphicsResource(ElemCommandList commandList, const ElemCopyDataToGraphicsResourceParameters* parameters);
@@ -77,6 +83,7 @@ ElemGraphicsResourceDescriptorInfo DirectX12GetGraphicsResourceDescriptorInfo(El
 void DirectX12FreeGraphicsResourceDescriptor(ElemGraphicsResourceDescriptor descriptor, const ElemFreeGraphicsResourceDescriptorOptions* options);
 
 void DirectX12ProcessGraphicsResourceDeleteQueue(ElemGraphicsDevice graphicsDevice);
+ElemGraphicsDeviceFrameInfo DirectX12AdvanceGraphicsDeviceFrame(ElemGraphicsDevice graphicsDevice, const ElemAdvanceGraphicsDeviceFrameOptions* options);
 
 void DirectX12GraphicsResourceBarrier(ElemCommandList commandList, ElemGraphicsResourceDescriptor descriptor, const ElemGraphicsResourceBarrierOptions* options);
 
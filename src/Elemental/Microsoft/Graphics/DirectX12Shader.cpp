@@ -73,16 +73,12 @@ D3D12_SHADER_BYTECODE GetDirectX12ShaderFunctionByteCode(DirectX12ShaderLibraryD
     SystemAssert(function);
     D3D12_SHADER_BYTECODE result = {};
 
-    for (uint32_t i = 0; i < shaderLibraryData->GraphicsShaders.Length; i++)
-    {
-        auto shader = shaderLibraryData->GraphicsShaders[i];
+    auto shaderIndex = FindShaderIndex(&shaderLibraryData->GraphicsShaders, shaderType, function);
 
-        if (shader.ShaderType == shaderType && SystemFindSubString(shader.Name, function) != -1)
-        {
-            auto byteCodeData = D3D12_SHADER_BYTECODE { .pShaderBytecode = shader.ShaderCode.Pointer, .BytecodeLength = shader.ShaderCode.Length };
-            result = byteCodeData;
-            break;
-        }
+    if (shaderIndex != -1)
+    {
+        auto shader = shaderLibraryData->GraphicsShaders.Shaders[shaderIndex];
+        result = { .pShaderBytecode = shader.ShaderCode.Pointer, .BytecodeLength = shader.ShaderCode.Length };
     }
         
     if (!result.pShaderBytecode)
@@ -180,17 +176,21 @@ D3D12_BLEND ConvertToDirectX12Blend(ElemGraphicsBlendFactor blendFactor)
     }
 }
 
-ElemShaderLibrary DirectX12CreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData)
+ElemShaderLibrary DirectX12CreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex)
 {
     InitDirectX12ShaderMemory();
 
     D3D12_SHADER_BYTECODE directX12LibraryData = {};
-    ReadOnlySpan<Shader> graphicsShaderData = {};
+    ShaderLibrary graphicsShaderData = {};
+
+    // NOTE: The shaders point directly into the library data so it is copied because the caller can free it. The
+    // copy is stored in the memory arena of the library so it is released by DirectX12FreeShaderLibrary.
+    auto libraryData = ReadOnlySpan<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length);
+    auto libraryMemoryArena = SystemAllocateMemoryArena(GetShaderLibraryMemorySize(libraryData));
 
     if (CheckDirectX12ShaderDataHeader(shaderLibraryData, "DXBC"))
     {
-        auto dest = SystemPushArray<uint8_t>(DirectX12MemoryArena, shaderLibraryData.Length);
-        SystemCopyBuffer(dest, ReadOnlySpan<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length));
+        auto dest = SystemDuplicateBuffer<uint8_t>(libraryMemoryArena, libraryData);
 
         directX12LibraryData =
         {
@@ -200,11 +200,12 @@ ElemShaderLibrary DirectX12CreateShaderLibrary(ElemGraphicsDevice graphicsDevice
     }
     else 
     {
-        auto dataSpan = Span<uint8_t>(shaderLibraryData.Items, shaderLibraryData.Length); 
-        graphicsShaderData = ReadShaders(DirectX12MemoryArena, dataSpan);
+        auto dataSpan = SystemDuplicateBuffer<uint8_t>(libraryMemoryArena, libraryData); 
+        graphicsShaderData = ReadShaders(libraryMemoryArena, dataSpan, permutationIndex);
     }
 
     auto handle = SystemAddDataPoolItem(directX12ShaderLibraryPool, {
+        .MemoryArena = libraryMemoryArena,
         .ShaderLibraryData = directX12LibraryData,
         .GraphicsShaders = graphicsShaderData
     }); 
@@ -214,7 +215,14 @@ ElemShaderLibrary DirectX12CreateShaderLibrary(ElemGraphicsDevice graphicsDevice
 
 void DirectX12FreeShaderLibrary(ElemShaderLibrary shaderLibrary)
 {
-    // TODO: Free data
+    SystemAssert(shaderLibrary != ELEM_HANDLE_NULL);
+
+    auto shaderLibraryData = GetDirectX12ShaderLibraryData(shaderLibrary);
+    SystemAssert(shaderLibraryData);
+
+    // NOTE: The pipeline states keep their own copy of the bytecode so the library data is not referenced by them.
+    SystemFreeMemoryArena(shaderLibraryData->MemoryArena);
+    SystemRemoveDataPoolItem(directX12ShaderLibraryPool, shaderLibrary);
 }
 
 ComPtr<ID3D12PipelineState> CreateDirectX12OldPSO(ElemGraphicsDevice graphicsDevice, const ElemGraphicsPipelineStateParameters* parameters)
@@ -368,7 +376,7 @@ ElemPipelineState DirectX12CompileGraphicsPipelineState(ElemGraphicsDevice graph
     }
     else
     { 
-        for (uint32_t i = 0; i < shaderLibraryData->GraphicsShaders.Length; i++)
+        for (uint32_t i = 0; i < shaderLibraryData->GraphicsShaders.Shaders.Length; i++)
         {
             //D3D12_DXIL_LIBRARY_DESC desc = { .DXILLibrary = shaderLibraryData->GraphicsShaders[i] };
             //dxilLibraries[dxilLibrariesIndex++] = desc;
@@ -7,8 +7,9 @@
 
 struct DirectX12ShaderLibraryData
 {
+    MemoryArena MemoryArena;
     D3D12_SHADER_BYTECODE ShaderLibraryData;
-    ReadOnlySpan<Shader> GraphicsShaders; // HACK: This should be temporary, in the future DX12 should only libs for all stages
+    ShaderLibrary GraphicsShaders; // HACK: This should be temporary, in the future DX12 should only libs for all stages
 };
 
 struct DirectX12PipelineStateData
@@ -28,7 +29,7 @@ DirectX12ShaderLibraryData* GetDirectX12ShaderLibraryData(ElemShaderLibrary shad
 DirectX12PipelineStateData* GetDirectX12PipelineStateData(ElemPipelineState pipelineState);
 DirectX12PipelineStateDataFull* GetDirectX12PipelineStateDataFull(ElemPipelineState pipelineState);
 
-ElemShaderLibrary DirectX12CreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData);
+ElemShaderLibrary DirectX12CreateShaderLibrary(ElemGraphicsDevice graphicsDevice, ElemDataSpan shaderLibraryData, uint32_t permutationIndex);
 void DirectX12FreeShaderLibrary(ElemShaderLibrary shaderLibrary);
 ElemPipelineState DirectX12CompileGraphicsPipelineState(ElemGraphicsDevice graphicsDevice, const ElemGraphicsPipelineStateParameters* parameters);
 ElemPipelineState DirectX12CompileComputePipelineState(ElemGraphicsDevice graphicsDevice, const ElemComputePipelineStateParameters* parameters);
@@ -105,6 +105,9 @@ void CheckDirectX12AvailableSwapChain(ElemHandle handle)
     auto swapChainData = GetDirectX12SwapChainData(handle);
     SystemAssert(swapChainData);
 
+    auto swapChainDataFull = GetDirectX12SwapChainDataFull(handle);
+    SystemAssert(swapChainDataFull);
+
     auto windowData = GetWin32WindowData(swapChainData->Window);
     SystemAssert(windowData);
 
@@ -233,6 +236,11 @@ void CheckDirectX12AvailableSwapChain(ElemHandle handle)
             .SizeChanged = sizeChanged
         };
         
+        auto graphicsDeviceData = GetDirectX12GraphicsDeviceData(swapChainDataFull->GraphicsDevice);
+        SystemAssert(graphicsDeviceData);
+
+        auto frameIndex = graphicsDeviceData->FrameIndex;
+
         swapChainData->UpdateHandler(&updateParameters, swapChainData->UpdatePayload);
         ResetInputsFrame();
 
@@ -242,6 +250,13 @@ void CheckDirectX12AvailableSwapChain(ElemHandle handle)
             DirectX12PresentSwapChain(handle);
         }
 
+        // NOTE: The frame housekeeping is done after the present so it is not part of the present latency.
+        // If the application has advanced the frame itself during the update, we don't do it twice.
+        if (graphicsDeviceData->FrameIndex == frameIndex)
+        {
+            DirectX12AdvanceGraphicsDeviceFrame(swapChainDataFull->GraphicsDevice, nullptr);
+        }
+
         #if ENABLE_TEARING
         LARGE_INTEGER currentCounter;
         QueryPerformanceCounter(&currentCounter);
@@ -475,7 +490,5 @@ void DirectX12PresentSwapChain(ElemSwapChain swapChain)
     #else
     AssertIfFailed(swapChainData->DeviceObject->Present(1, 0));
     #endif
-    
-    DirectX12ResetCommandAllocation(swapChainDataFull->GraphicsDevice);
-    DirectX12ProcessGraphicsResourceDeleteQueue(swapChainDataFull->GraphicsDevice);
+
 }
@@ -61,6 +61,14 @@ size_t SystemPlatformGetPageSize()
     return systemInfo.dwAllocationGranularity;
 }
 
+uint32_t SystemPlatformGetProcessorCount()
+{
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+
+    return systemInfo.dwNumberOfProcessors;
+}
+
 SystemPlatformAllocationInfos SystemPlatformGetAllocationInfos()
 {
     return systemPlatformAllocationInfos;
@@ -193,6 +201,78 @@ void SystemPlatformFileDelete(ReadOnlySpan<char> path)
     }
 }
 
+bool SystemPlatformFileMove(ReadOnlySpan<char> sourcePath, ReadOnlySpan<char> destinationPath)
+{
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto sourcePathWide = SystemConvertUtf8ToWideChar(stackMemoryArena, sourcePath);
+    auto destinationPathWide = SystemConvertUtf8ToWideChar(stackMemoryArena, destinationPath);
+
+    if (!MoveFileEx(sourcePathWide.Pointer, destinationPathWide.Pointer, MOVEFILE_REPLACE_EXISTING))
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot move file %s to %s. (Error code: %d)", sourcePath.Pointer, destinationPath.Pointer, (int32_t)GetLastError());
+        return false;
+    }
+
+    return true;
+}
+
+ReadOnlySpan<uint8_t> SystemPlatformFileMap(ReadOnlySpan<char> path, bool sequentialAccess, void** platformHandle)
+{
+    *platformHandle = nullptr;
+
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto pathWide = SystemConvertUtf8ToWideChar(stackMemoryArena, path);
+
+    auto fileHandle = CreateFile(pathWide.Pointer, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, sequentialAccess ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+
+    if (fileHandle == INVALID_HANDLE_VALUE) 
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot open file %s for mapping. (Error code: %d)", path.Pointer, (int32_t)GetLastError());
+        return {};
+    }
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(fileHandle);
+        return {};
+    }
+
+    auto mappingHandle = CreateFileMapping(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    // NOTE: The mapping object keeps a reference to the file so we can close the file handle now.
+    CloseHandle(fileHandle);
+
+    if (mappingHandle == nullptr)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot map file %s. (Error code: %d)", path.Pointer, (int32_t)GetLastError());
+        return {};
+    }
+
+    auto pointer = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+
+    if (pointer == nullptr)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot map file %s. (Error code: %d)", path.Pointer, (int32_t)GetLastError());
+        CloseHandle(mappingHandle);
+        return {};
+    }
+
+    *platformHandle = mappingHandle;
+    return ReadOnlySpan<uint8_t>((uint8_t*)pointer, (size_t)fileSize.QuadPart);
+}
+
+void SystemPlatformFileUnmap(ReadOnlySpan<uint8_t> data, void* platformHandle)
+{
+    UnmapViewOfFile(data.Pointer);
+
+    if (platformHandle)
+    {
+        CloseHandle((HANDLE)platformHandle);
+    }
+}
+
 ReadOnlySpan<char> SystemPlatformExecuteProcess(MemoryArena memoryArena, ReadOnlySpan<char> command)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
@@ -300,3 +380,42 @@ void SystemPlatformFreeThread(void* thread)
 {
     CloseHandle(thread);
 }
+
+void* SystemPlatformCreateSignal()
+{
+    auto eventHandle = CreateEvent(nullptr, false, false, nullptr);
+
+    if (eventHandle == nullptr)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Cannot create signal (Error code: %d)", (int32_t)GetLastError());
+        return nullptr;
+    }
+
+    return eventHandle;
+}
+
+void SystemPlatformWaitSignal(void* signal)
+{
+    if (signal == nullptr)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Invalid signal handle provided.");
+        return;
+    }
+
+    DWORD waitResult = WaitForSingleObject(signal, INFINITE);
+
+    if (waitResult != WAIT_OBJECT_0)
+    {
+        SystemLogErrorMessage(ElemLogMessageCategory_Application, "Failed to wait on signal (Error code: %d)", (int32_t)GetLastError());
+    }
+}
+
+void SystemPlatformSetSignal(void* signal)
+{
+    SetEvent(signal);
+}
+
+void SystemPlatformFreeSignal(void* signal)
+{
+    CloseHandle(signal);
+}
@@ -30,6 +30,7 @@
 #include "Graphics/GraphicsDevice.cpp"
 #include "Graphics/CommandList.cpp"
 #include "Graphics/SwapChain.cpp"
+#include "Graphics/SwapChainTiming.cpp"
 #include "Graphics/Resource.cpp"
 #include "Graphics/Shader.cpp"
 #include "Graphics/Rendering.cpp"
@@ -38,6 +39,9 @@
 #include "Inputs/Inputs.cpp"
 #include "Inputs/HidDevices.cpp"
 
+#include "Scenes/SceneContainer.cpp"
+#include "Textures/TextureContainer.cpp"
+
 #include "SystemPlatformFunctions.cpp"
 #include "SystemLogging.cpp"
 #include "SystemMemory.cpp"
@@ -36,6 +36,8 @@
 #define UseToolsLoader
 #endif
 
+#define ELEM_TOOLS_VERSION_LABEL "1.0.0-dev5"
+
 //------------------------------------------------------------------------
 // Module: Elemental Tools
 //------------------------------------------------------------------------
@@ -155,18 +157,39 @@ typedef struct
     ElemToolsVector3 MaxPoint;
 } ElemToolsBoundingBox;
 
+typedef enum
+{
+    // float3 position, float3 normal, float4 tangent, float2 texture coordinates. (48 bytes)
+    ElemVertexFormat_Float32 = 0,
+    // unorm16x4 position relative to the position bounds, snorm16x2 octahedral normal, snorm16x2 octahedral tangent,
+    // half2 texture coordinates. The W component of the position is the tangent handedness (0: -1, 1: 1). (20 bytes)
+    ElemVertexFormat_CompactUnorm16 = 1,
+    // Same as CompactUnorm16 but the position is stored as half3 in mesh space. The W component of the position
+    // is the tangent handedness (-1 or 1). (20 bytes)
+    ElemVertexFormat_CompactHalf = 2
+} ElemVertexFormat;
+
 typedef struct
 {
     ElemToolsDataSpan Data;
     uint32_t VertexSize;
     uint32_t VertexCount;
-    // TODO: Add vertex description structure
+    ElemVertexFormat Format;
+    // Range used to dequantize the positions of the CompactUnorm16 format.
+    ElemToolsBoundingBox PositionBounds;
 } ElemVertexBuffer;
 
 typedef ElemToolsDataSpan (*ElemToolsLoadFileHandlerPtr)(const char* path);
 
 ElemToolsAPI void ElemToolsConfigureFileIO(ElemToolsLoadFileHandlerPtr loadFileHandler);
 
+// Computes a 64 bits content hash of the data (xxHash). The seed can be used to chain several hashes together
+// so it can serve as a key for content addressed caches.
+ElemToolsAPI uint64_t ElemToolsComputeDataHash(ElemToolsDataSpan data, uint64_t seed);
+
+// Returns the version label of the loaded library. Caches that store tools output can use it in their keys.
+ElemToolsAPI const char* ElemToolsGetVersionLabel(void);
+
 
 //------------------------------------------------------------------------
 // Module: Shaders
@@ -194,6 +217,23 @@ typedef enum
     ElemShaderLanguage_MetalIR = 6
 } ElemShaderLanguage;
 
+/**
+ * Represents a preprocessor define passed to the shader compiler.
+ */
+typedef struct
+{
+    // Name of the define.
+    const char* Name;
+    // Value of the define. The define is set to 1 when null.
+    const char* Value;
+} ElemShaderDefine;
+
+typedef struct
+{
+    ElemShaderDefine* Items;
+    uint32_t Length;
+} ElemShaderDefineSpan;
+
 /**
  * Configuration options for compiling shaders.
  */
@@ -201,6 +241,11 @@ typedef struct
 {
     // If true, compile shaders in debug mode to provide more information.
     bool DebugMode;
+    // Preprocessor defines added to the compilation of all the shaders of the library.
+    ElemShaderDefineSpan Defines;
+    // Existing directory used to cache the compiled shaders. The key includes the preprocessed source so a
+    // change in an included file is detected. No cache is used when null.
+    const char* CacheDirectory;
 
     // TODO: Add the ability to add an override for shader language
     // TODO: Add the ability to choose Matrix packing options (default to row major for now?)
@@ -220,6 +265,61 @@ typedef struct
     bool HasErrors;
 } ElemShaderCompilationResult;
 
+/**
+ * Represents a shader library to compile with ElemCompileShaderLibraries.
+ */
+typedef struct
+{
+    // Path of the shader source file.
+    const char* Path;
+} ElemCompileShaderLibraryEntry;
+
+typedef struct
+{
+    ElemCompileShaderLibraryEntry* Items;
+    uint32_t Length;
+} ElemCompileShaderLibraryEntrySpan;
+
+typedef struct
+{
+    ElemShaderCompilationResult* Items;
+    uint32_t Length;
+} ElemShaderCompilationResultSpan;
+
+/**
+ * Represents the result of the compilation of several shader libraries.
+ */
+typedef struct
+{
+    // Compilation result of each entry, in the entries order.
+    ElemShaderCompilationResultSpan Results;
+    // True if at least one of the libraries has compilation errors.
+    bool HasErrors;
+} ElemCompileShaderLibrariesResult;
+
+typedef struct
+{
+    const char** Items;
+    uint32_t Length;
+} ElemShaderDefineValueSpan;
+
+/**
+ * Represents a define that varies between the permutations of a shader library.
+ */
+typedef struct
+{
+    // Name of the define.
+    const char* Name;
+    // Values taken by the define, each permutation uses one of them.
+    ElemShaderDefineValueSpan Values;
+} ElemShaderPermutationAxis;
+
+typedef struct
+{
+    ElemShaderPermutationAxis* Items;
+    uint32_t Length;
+} ElemShaderPermutationAxisSpan;
+
 /**
  * Determines if a shader can be compiled for a specific graphics API and platform.
  * @param shaderLanguage The language of the shader to be compiled.
@@ -240,6 +340,31 @@ ElemToolsAPI bool ElemCanCompileShader(ElemShaderLanguage shaderLanguage, ElemTo
 // TODO: Put graphics api and platform into options (default to current one)
 ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, const ElemCompileShaderOptions* options);
 
+/**
+ * Compiles several shader libraries at the same time on all the cores.
+ * @param graphicsApi The graphics API for which to compile the shader libraries.
+ * @param platform The platform for which to compile the shader libraries.
+ * @param entries The shader libraries to compile.
+ * @param options Compilation options shared by all the libraries.
+ * @return The result of each compilation, valid until the next call.
+ */
+ElemToolsAPI ElemCompileShaderLibrariesResult ElemCompileShaderLibraries(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, ElemCompileShaderLibraryEntrySpan entries, const ElemCompileShaderOptions* options);
+
+/**
+ * Compiles all the permutations of a shader library and stores them in one library. Each permutation is
+ * compiled with one value of every axis, and the identical shaders are only stored once.
+ * The permutation index used at runtime is computed by adding valueIndex * stride for each axis, where the
+ * stride of the first axis is 1 and the stride of the next axes is the product of the value counts of the
+ * previous axes.
+ * @param graphicsApi The graphics API for which to compile the shader library.
+ * @param platform The platform for which to compile the shader library.
+ * @param path The path of the shader source file.
+ * @param axes The defines that vary between the permutations.
+ * @param options Compilation options shared by all the permutations.
+ * @return The result of the compilation, including the library with all the permutations and messages.
+ */
+ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderPermutations(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, ElemShaderPermutationAxisSpan axes, const ElemCompileShaderOptions* options);
+
 // TODO: Can we compile multiple source files into one library?
 
 
@@ -266,6 +391,14 @@ typedef enum
     ElemSceneNodeType_Mesh = 1
 } ElemSceneNodeType;
 
+typedef enum
+{
+    // MikkTSpace compatible tangents.
+    ElemSceneTangentMode_MikkTSpace = 0,
+    // Faster tangents computed in batches. The result can differ slightly from MikkTSpace on curved surfaces.
+    ElemSceneTangentMode_Fast = 1
+} ElemSceneTangentMode;
+
 typedef struct
 {
     ElemSceneCoordinateSystem CoordinateSystem;
@@ -273,10 +406,10 @@ typedef struct
     float Scaling;
     ElemToolsVector3 Rotation;
     ElemToolsVector3 Translation;
-    // TODO: Don't add options for the format here but in the builder instead
-    // we still want the same format mechanism but hardcoded 
-
-    // TODO: Add options to specify the vertex format wanted
+    // Vertex format of the mesh primitives. Quantized formats use the primitive bounding box as position bounds.
+    ElemVertexFormat VertexFormat;
+    // Method used to generate the tangents when the source scene doesn't contain them. Default: MikkTSpace.
+    ElemSceneTangentMode TangentMode;
 } ElemLoadSceneOptions;
 
 typedef struct
@@ -354,17 +487,67 @@ typedef struct
 
 ElemToolsAPI ElemLoadSceneResult ElemLoadScene(const char* path, const ElemLoadSceneOptions* options);
 
+typedef struct
+{
+    // Unique identifier of the section. (Four character code for example)
+    uint32_t Id;
+    // Size of one element of the section. 0 for raw data.
+    uint32_t ElementSize;
+    ElemToolsDataSpan Data;
+} ElemSceneContainerSectionData;
+
+typedef struct
+{
+    ElemSceneContainerSectionData* Items;
+    uint32_t Length;
+} ElemSceneContainerSectionDataSpan;
+
+typedef struct
+{
+    // Alignment in bytes of the sections. Must be a power of 2. Default: 64.
+    uint32_t SectionAlignment;
+} ElemBuildSceneContainerOptions;
+
+typedef struct
+{
+    ElemToolsDataSpan Data;
+    ElemToolsMessageSpan Messages;
+    bool HasErrors;
+} ElemBuildSceneContainerResult;
+
+// Builds a versioned scene container. The container starts with a header and a table of contents followed by the
+// aligned sections. It is designed to be memory mapped and read without parsing with ElemOpenSceneContainer.
+ElemToolsAPI ElemBuildSceneContainerResult ElemBuildSceneContainer(ElemSceneContainerSectionDataSpan sections, const ElemBuildSceneContainerOptions* options);
+
 
 //------------------------------------------------------------------------
 // Module: Meshes
 //------------------------------------------------------------------------
 
 // TODO: Allow to specify the offset of the vertex position? (For now we assume vertex position is at offset 0)
+typedef enum
+{
+    // Greedy builder that favors connectivity and cone culling efficiency. (meshopt_buildMeshlets)
+    ElemMeshletBuilderMode_Greedy = 0,
+    // Spatial builder that favors tight clusters, better suited for ray tracing. (meshopt_buildMeshletsSpatial)
+    ElemMeshletBuilderMode_Spatial = 1
+} ElemMeshletBuilderMode;
+
 typedef struct
 {
     // TODO: Allow bypass mesh format
     // TODO: Allow customize index packing
-    uint32_t Reserved;
+    // Maximum vertex count per meshlet (3 to 255). Default: 64.
+    uint8_t MeshletMaxVertexCount;
+    // Maximum triangle count per meshlet (1 to 255). Default: 64.
+    uint8_t MeshletMaxTriangleCount;
+    ElemMeshletBuilderMode BuilderMode;
+    // Use ConeWeight and FillWeight as given, even when they are 0. Otherwise a weight of 0 means the default value.
+    bool UseExplicitWeights;
+    // Weight of the cone culling efficiency for the greedy builder (0 to 1). Default: 0.5.
+    float ConeWeight;
+    // Weight of the meshlet fill ratio for the spatial builder (0 to 1). Default: 0.5.
+    float FillWeight;
 } ElemBuildMeshletsOptions;
 
 typedef struct
@@ -382,21 +565,196 @@ typedef struct
     uint32_t Length;
 } ElemMeshletSpan;
 
+typedef struct
+{
+    ElemToolsVector3 SphereCenter;
+    float SphereRadius;
+    ElemToolsBoundingBox BoundingBox;
+    // Backface culling cone. The meshlet can be culled if dot(normalize(ConeApex - cameraPosition), ConeAxis) >= ConeCutoff.
+    // A cutoff of 1 means that the cone is degenerate and cannot be used for culling.
+    ElemToolsVector3 ConeApex;
+    ElemToolsVector3 ConeAxis;
+    float ConeCutoff;
+} ElemMeshletBounds;
+
+typedef struct
+{
+    ElemMeshletBounds* Items;
+    uint32_t Length;
+} ElemMeshletBoundsSpan;
+
+// Quantized version of the bounds suitable for GPU culling. (12 bytes)
+// The sphere is stored as half4 (conservative radius) and the cone as snorm8x4 (axis, cutoff).
+// The meshlet can be culled if dot(center - cameraPosition, axis) >= cutoff * length(center - cameraPosition) + radius.
+typedef struct
+{
+    uint16_t SphereCenter[3];
+    uint16_t SphereRadius;
+    int8_t ConeAxis[3];
+    int8_t ConeCutoff;
+} ElemMeshletCompactBounds;
+
+typedef struct
+{
+    ElemMeshletCompactBounds* Items;
+    uint32_t Length;
+} ElemMeshletCompactBoundsSpan;
+
+// LOD information of a meshlet. A meshlet must be rendered if its own error is acceptable and its parent error is not.
+// The errors are expressed in mesh units and must be projected using the bounding spheres.
+typedef struct
+{
+    ElemToolsVector3 SelfSphereCenter;
+    float SelfSphereRadius;
+    float SelfError;
+    ElemToolsVector3 ParentSphereCenter;
+    float ParentSphereRadius;
+    // FLT_MAX for the root meshlets.
+    float ParentError;
+    uint32_t LodLevel;
+} ElemMeshletLodInfo;
+
+typedef struct
+{
+    ElemMeshletLodInfo* Items;
+    uint32_t Length;
+} ElemMeshletLodInfoSpan;
+
 typedef struct
 {
     uint8_t MeshletMaxVertexCount;
     uint8_t MeshletMaxTriangleCount;
     ElemVertexBuffer VertexBuffer;
     ElemMeshletSpan Meshlets;
+    ElemMeshletBoundsSpan MeshletBounds;
+    ElemMeshletCompactBoundsSpan MeshletCompactBounds;
     ElemUInt32Span MeshletVertexIndexBuffer;
     ElemUInt32Span MeshletTriangleIndexBuffer;
+    // Average ratio of the used vertices and triangles compared to the meshlet maximums.
+    float AverageVertexFillRatio;
+    float AverageTriangleFillRatio;
+    // Only filled by ElemBuildMeshletLodHierarchy. (One entry per meshlet)
+    ElemMeshletLodInfoSpan MeshletLods;
+    uint32_t LodLevelCount;
     ElemToolsMessageSpan Messages;
     bool HasErrors;
 } ElemBuildMeshletResult;
 
+typedef struct
+{
+    ElemBuildMeshletsOptions MeshletOptions;
+    // Number of meshlets that are grouped and simplified together. Default: 8.
+    uint32_t GroupSize;
+    // Default: 16.
+    uint32_t MaxLodLevelCount;
+} ElemBuildMeshletLodHierarchyOptions;
+
 ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemBuildMeshletsOptions* options);
 
-// TODO: Do an optimize mesh function that can be used to optimize a normal mesh (for Raytracing for example)
+// Builds a hierarchy of meshlets (cluster DAG). Meshlets are grouped, simplified with locked group borders and re-clustered
+// until the mesh cannot be simplified anymore. The meshlets of all LOD levels are returned in the same buffers.
+ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshletLodHierarchy(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemBuildMeshletLodHierarchyOptions* options);
+
+// Meshlet that references the encoded streams. (16 bytes)
+// Vertex index i of the meshlet is BaseVertex + the VertexIndexSize bytes value stored at VertexIndexOffset + i * VertexIndexSize.
+// Triangle i is stored as 3 bytes at TriangleOffset + i * 3. Offsets are in bytes and aligned on 4 bytes.
+typedef struct
+{
+    uint32_t BaseVertex;
+    uint32_t VertexIndexOffset;
+    uint32_t TriangleOffset;
+    uint8_t VertexIndexCount;
+    uint8_t TriangleCount;
+    // Size in bytes of the local vertex indices (1, 2 or 4).
+    uint8_t VertexIndexSize;
+    uint8_t Reserved;
+} ElemEncodedMeshlet;
+
+typedef struct
+{
+    ElemEncodedMeshlet* Items;
+    uint32_t Length;
+} ElemEncodedMeshletSpan;
+
+typedef struct
+{
+    // Compress the streams with the meshoptimizer codecs for storage. The data must be decoded with ElemDecodeMeshlets before use.
+    bool CompressStreams;
+} ElemEncodeMeshletsOptions;
+
+typedef struct
+{
+    // Limits of the source meshlets. The decoder rejects the meshlets that exceed them.
+    uint8_t MeshletMaxVertexCount;
+    uint8_t MeshletMaxTriangleCount;
+    ElemEncodedMeshletSpan Meshlets;
+    ElemToolsDataSpan VertexBuffer;
+    ElemToolsDataSpan MeshletVertexIndexBuffer;
+    ElemToolsDataSpan MeshletTriangleIndexBuffer;
+    uint32_t VertexSize;
+    uint32_t VertexCount;
+    // Sizes in bytes of the decoded streams.
+    uint32_t DecodedMeshletVertexIndexBufferSize;
+    uint32_t DecodedMeshletTriangleIndexBufferSize;
+    bool IsCompressed;
+    ElemToolsMessageSpan Messages;
+    bool HasErrors;
+} ElemEncodeMeshletsResult;
+
+// Encodes the meshlet streams with 8/16-bit local vertex indices and 3 bytes per triangle.
+ElemToolsAPI ElemEncodeMeshletsResult ElemEncodeMeshlets(const ElemBuildMeshletResult* meshletResult, const ElemEncodeMeshletsOptions* options);
+
+// Decompresses the streams of a compressed encoding and validates the meshlet ranges against the decoded streams.
+ElemToolsAPI ElemEncodeMeshletsResult ElemDecodeMeshlets(const ElemEncodeMeshletsResult* encodedResult);
+
+typedef struct
+{
+    // Maximum overdraw degradation allowed to improve the vertex cache efficiency. Default: 1.05.
+    float OverdrawThreshold;
+} ElemOptimizeMeshOptions;
+
+typedef struct
+{
+    // Number of indices to reach. When 0, TargetIndexRatio is used.
+    uint32_t TargetIndexCount;
+    // Ratio of the source index count to reach (0 to 1). Default: 0.5.
+    float TargetIndexRatio;
+    // Use TargetError, NormalWeight and TextureCoordinatesWeight as given, even when they are 0. Otherwise a value of 0 means the default value.
+    bool UseExplicitValues;
+    // Maximum error relative to the mesh extents (0 to 1). The simplification stops before the target if it is reached. Default: 0.01.
+    float TargetError;
+    // Take the normals and texture coordinates into account. Only supported by the Float32 vertex format.
+    bool UseAttributes;
+    // Default: 1.0.
+    float NormalWeight;
+    // Default: 1.0.
+    float TextureCoordinatesWeight;
+    // Don't move the vertices on the borders of the mesh so it can be stitched with other meshes.
+    bool LockBorders;
+    // Only output the simplified indices. They reference the source vertex buffer, which is returned as is in the result.
+    bool KeepVertexBuffer;
+} ElemSimplifyMeshOptions;
+
+typedef struct
+{
+    ElemVertexBuffer VertexBuffer;
+    ElemUInt32Span IndexBuffer;
+    // Only filled by ElemSimplifyMesh. Error relative to the mesh extents.
+    float SimplifyError;
+    // Only filled by ElemSimplifyMesh. Error in mesh units.
+    float SimplifyAbsoluteError;
+    ElemToolsMessageSpan Messages;
+    bool HasErrors;
+} ElemMeshResult;
+
+// Optimizes a mesh for the vertex cache, overdraw and vertex fetch. The duplicated vertices are removed.
+// Can be used for meshes that are not rendered with meshlets. (Raytracing acceleration structures for example)
+ElemToolsAPI ElemMeshResult ElemOptimizeMesh(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemOptimizeMeshOptions* options);
+
+// Simplifies a mesh to the target index count or error. The result is optimized like ElemOptimizeMesh and is valid until the next call.
+// To build an index buffer LOD chain, use KeepVertexBuffer so every level references the source vertex buffer,
+// and copy each index buffer before the next call.
+ElemToolsAPI ElemMeshResult ElemSimplifyMesh(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemSimplifyMeshOptions* options);
 
 //------------------------------------------------------------------------
 // Module: Textures
@@ -406,7 +764,15 @@ typedef enum
 {
     ElemToolsGraphicsFormat_Unknown,
     ElemToolsGraphicsFormat_R8G8B8A8,
-    ElemToolsGraphicsFormat_BC7
+    ElemToolsGraphicsFormat_BC7,
+    ElemToolsGraphicsFormat_BC1,
+    ElemToolsGraphicsFormat_BC3,
+    ElemToolsGraphicsFormat_BC4,
+    ElemToolsGraphicsFormat_BC5,
+    // Unsigned HDR format, negative values are clamped to 0.
+    ElemToolsGraphicsFormat_BC6H,
+    // Linear float format used for HDR source images.
+    ElemToolsGraphicsFormat_R32G32B32A32_FLOAT
 } ElemToolsGraphicsFormat;
 
 typedef enum
@@ -416,8 +782,16 @@ typedef enum
     ElemLoadTextureFileFormat_Jpg = 2,
     ElemLoadTextureFileFormat_Png = 3,
     ElemLoadTextureFileFormat_Dds = 4,
+    ElemLoadTextureFileFormat_Hdr = 5,
 } ElemLoadTextureFileFormat;
 
+typedef enum
+{
+    ElemToolsTextureType_Texture2D,
+    ElemToolsTextureType_Texture3D,
+    ElemToolsTextureType_TextureCube
+} ElemToolsTextureType;
+
 typedef struct
 {
     uint32_t Width;
@@ -440,8 +814,16 @@ typedef struct
 {
     ElemLoadTextureFileFormat FileFormat;
     ElemToolsGraphicsFormat Format;
+    ElemToolsTextureType Type;
     uint32_t Width;
     uint32_t Height;
+    // Number of slices of the first mip of 3D textures. 1 for the other types.
+    uint32_t Depth;
+    // Number of 2D slices. Cubemaps have 6 slices per cube ordered +X, -X, +Y, -Y, +Z, -Z.
+    uint32_t ArraySize;
+    uint32_t MipLevelCount;
+    // Contains MipLevelCount entries for each slice, slice after slice. The mips of 3D textures contain all
+    // their depth slices. DDS mip data points directly into the mapped file and is valid until the next call.
     ElemTextureMipDataSpan MipData;
     ElemToolsMessageSpan Messages;
     bool HasErrors;
@@ -462,7 +844,8 @@ typedef struct
 
 typedef struct
 {
-    uint32_t Reserved;
+    // Format of the mip data to compress. R8G8B8A8 or R32G32B32A32_FLOAT. Default: R8G8B8A8.
+    ElemToolsGraphicsFormat SourceFormat;
 } ElemCompressTextureMipDataOptions;
 
 typedef struct
@@ -473,10 +856,78 @@ typedef struct
     bool HasErrors;
 } ElemCompressTextureMipDataResult;
 
+typedef struct
+{
+    const char* Path;
+    // Format of the built texture. Textures that are already compressed are not converted. Default: BC7.
+    ElemToolsGraphicsFormat Format;
+} ElemBuildTextureEntry;
+
+typedef struct
+{
+    ElemBuildTextureEntry* Items;
+    uint32_t Length;
+} ElemBuildTextureEntrySpan;
+
+typedef struct
+{
+    // Index of the texture in the entries passed to ElemBuildTextures.
+    uint32_t Index;
+    ElemToolsGraphicsFormat Format;
+    uint32_t Width;
+    uint32_t Height;
+    ElemTextureMipDataSpan MipData;
+    ElemToolsMessageSpan Messages;
+    bool HasErrors;
+} ElemBuildTextureResult;
+
+// Called on the calling thread of ElemBuildTextures, in the order of the entries. The data of the result
+// is only valid during the call.
+typedef void (*ElemBuildTextureHandlerPtr)(const ElemBuildTextureResult* result, void* payload);
+
+typedef struct
+{
+    // Maximum number of textures processed at the same time. This bounds the memory usage because the
+    // working memory is released after each batch. Default: 16.
+    uint32_t MaxTextureCountInFlight;
+    ElemBuildTextureHandlerPtr BuildTextureHandler;
+    void* BuildTextureHandlerPayload;
+} ElemBuildTexturesOptions;
+
+typedef struct
+{
+    uint32_t BuiltTextureCount;
+    // Contains the throughput of each stage (load, mip generation and compression).
+    ElemToolsMessageSpan Messages;
+    bool HasErrors;
+} ElemBuildTexturesResult;
+
+typedef struct
+{
+    // Alignment in bytes of the mips so they can be read directly from the file. The mips smaller than the
+    // alignment are packed together. Must be a power of 2. Default: 4096.
+    uint32_t MipAlignment;
+} ElemBuildTextureContainerOptions;
+
+typedef struct
+{
+    ElemToolsDataSpan Data;
+    ElemToolsMessageSpan Messages;
+    bool HasErrors;
+} ElemBuildTextureContainerResult;
+
 ElemToolsAPI ElemLoadTextureResult ElemLoadTexture(const char* path, const ElemLoadTextureOptions* options);
 ElemToolsAPI ElemGenerateTextureMipDataResult ElemGenerateTextureMipData(ElemToolsGraphicsFormat format, const ElemTextureMipData* baseMip, const ElemGenerateTextureMipDataOptions* options);
 ElemToolsAPI ElemCompressTextureMipDataResult ElemCompressTextureMipData(ElemToolsGraphicsFormat format, const ElemTextureMipData* mipData, const ElemCompressTextureMipDataOptions* options);
 
+// Loads, generates the mips and compresses a list of textures. The work of all the textures of a batch
+// is split in per texture and per mip jobs that run on all the cores.
+ElemToolsAPI ElemBuildTexturesResult ElemBuildTextures(ElemBuildTextureEntrySpan entries, const ElemBuildTexturesOptions* options);
+
+// Builds a versioned texture container that can be read mip by mip with ElemOpenTextureContainer. Supports the
+// block compressed formats and R32G32B32A32_FLOAT. mipData must start with the biggest mip.
+ElemToolsAPI ElemBuildTextureContainerResult ElemBuildTextureContainer(ElemToolsGraphicsFormat format, ElemTextureMipDataSpan mipData, const ElemBuildTextureContainerOptions* options);
+
 #ifdef UseToolsLoader
 #ifndef ElementalToolsLoader
 #include "ElementalToolsLoader.c"
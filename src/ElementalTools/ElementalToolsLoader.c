@@ -24,13 +24,25 @@ static int functionPointersLoadedElementalTools = 0;
 typedef struct ElementalToolsFunctions 
 {
     void (*ElemToolsConfigureFileIO)(ElemToolsLoadFileHandlerPtr);
+    uint64_t (*ElemToolsComputeDataHash)(ElemToolsDataSpan, uint64_t);
+    char const * (*ElemToolsGetVersionLabel)(void);
     bool (*ElemCanCompileShader)(ElemShaderLanguage, ElemToolsGraphicsApi, ElemToolsPlatform);
     ElemShaderCompilationResult (*ElemCompileShaderLibrary)(ElemToolsGraphicsApi, ElemToolsPlatform, char const *, ElemCompileShaderOptions const *);
+    ElemCompileShaderLibrariesResult (*ElemCompileShaderLibraries)(ElemToolsGraphicsApi, ElemToolsPlatform, ElemCompileShaderLibraryEntrySpan, ElemCompileShaderOptions const *);
+    ElemShaderCompilationResult (*ElemCompileShaderPermutations)(ElemToolsGraphicsApi, ElemToolsPlatform, const char*, ElemShaderPermutationAxisSpan, const ElemCompileShaderOptions*);
     ElemLoadSceneResult (*ElemLoadScene)(char const *, ElemLoadSceneOptions const *);
+    ElemBuildSceneContainerResult (*ElemBuildSceneContainer)(ElemSceneContainerSectionDataSpan, const ElemBuildSceneContainerOptions*);
     ElemBuildMeshletResult (*ElemBuildMeshlets)(ElemVertexBuffer, ElemUInt32Span, ElemBuildMeshletsOptions const *);
+    ElemBuildMeshletResult (*ElemBuildMeshletLodHierarchy)(ElemVertexBuffer, ElemUInt32Span, ElemBuildMeshletLodHierarchyOptions const *);
+    ElemEncodeMeshletsResult (*ElemEncodeMeshlets)(ElemBuildMeshletResult const *, ElemEncodeMeshletsOptions const *);
+    ElemEncodeMeshletsResult (*ElemDecodeMeshlets)(ElemEncodeMeshletsResult const *);
+    ElemMeshResult (*ElemOptimizeMesh)(ElemVertexBuffer, ElemUInt32Span, const ElemOptimizeMeshOptions*);
+    ElemMeshResult (*ElemSimplifyMesh)(ElemVertexBuffer, ElemUInt32Span, const ElemSimplifyMeshOptions*);
     ElemLoadTextureResult (*ElemLoadTexture)(char const *, ElemLoadTextureOptions const *);
     ElemGenerateTextureMipDataResult (*ElemGenerateTextureMipData)(ElemToolsGraphicsFormat, ElemTextureMipData const *, ElemGenerateTextureMipDataOptions const *);
     ElemCompressTextureMipDataResult (*ElemCompressTextureMipData)(ElemToolsGraphicsFormat, ElemTextureMipData const *, ElemCompressTextureMipDataOptions const *);
+    ElemBuildTexturesResult (*ElemBuildTextures)(ElemBuildTextureEntrySpan, const ElemBuildTexturesOptions*);
+    ElemBuildTextureContainerResult (*ElemBuildTextureContainer)(ElemToolsGraphicsFormat, ElemTextureMipDataSpan, const ElemBuildTextureContainerOptions*);
     
 } ElementalToolsFunctions;
 
@@ -84,13 +96,25 @@ static bool LoadElementalToolsFunctionPointers(void)
     }
 
     listElementalToolsFunctions.ElemToolsConfigureFileIO = (void (*)(ElemToolsLoadFileHandlerPtr))GetElementalToolsFunctionPointer("ElemToolsConfigureFileIO");
+    listElementalToolsFunctions.ElemToolsComputeDataHash = (uint64_t (*)(ElemToolsDataSpan, uint64_t))GetElementalToolsFunctionPointer("ElemToolsComputeDataHash");
+    listElementalToolsFunctions.ElemToolsGetVersionLabel = (char const * (*)(void))GetElementalToolsFunctionPointer("ElemToolsGetVersionLabel");
     listElementalToolsFunctions.ElemCanCompileShader = (bool (*)(ElemShaderLanguage, ElemToolsGraphicsApi, ElemToolsPlatform))GetElementalToolsFunctionPointer("ElemCanCompileShader");
     listElementalToolsFunctions.ElemCompileShaderLibrary = (ElemShaderCompilationResult (*)(ElemToolsGraphicsApi, ElemToolsPlatform, char const *, ElemCompileShaderOptions const *))GetElementalToolsFunctionPointer("ElemCompileShaderLibrary");
+    listElementalToolsFunctions.ElemCompileShaderLibraries = (ElemCompileShaderLibrariesResult (*)(ElemToolsGraphicsApi, ElemToolsPlatform, ElemCompileShaderLibraryEntrySpan, ElemCompileShaderOptions const *))GetElementalToolsFunctionPointer("ElemCompileShaderLibraries");
+    listElementalToolsFunctions.ElemCompileShaderPermutations = (ElemShaderCompilationResult (*)(ElemToolsGraphicsApi, ElemToolsPlatform, const char*, ElemShaderPermutationAxisSpan, const ElemCompileShaderOptions*))GetElementalToolsFunctionPointer("ElemCompileShaderPermutations");
     listElementalToolsFunctions.ElemLoadScene = (ElemLoadSceneResult (*)(char const *, ElemLoadSceneOptions const *))GetElementalToolsFunctionPointer("ElemLoadScene");
+    listElementalToolsFunctions.ElemBuildSceneContainer = (ElemBuildSceneContainerResult (*)(ElemSceneContainerSectionDataSpan, const ElemBuildSceneContainerOptions*))GetElementalToolsFunctionPointer("ElemBuildSceneContainer");
     listElementalToolsFunctions.ElemBuildMeshlets = (ElemBuildMeshletResult (*)(ElemVertexBuffer, ElemUInt32Span, ElemBuildMeshletsOptions const *))GetElementalToolsFunctionPointer("ElemBuildMeshlets");
+    listElementalToolsFunctions.ElemBuildMeshletLodHierarchy = (ElemBuildMeshletResult (*)(ElemVertexBuffer, ElemUInt32Span, ElemBuildMeshletLodHierarchyOptions const *))GetElementalToolsFunctionPointer("ElemBuildMeshletLodHierarchy");
+    listElementalToolsFunctions.ElemEncodeMeshlets = (ElemEncodeMeshletsResult (*)(ElemBuildMeshletResult const *, ElemEncodeMeshletsOptions const *))GetElementalToolsFunctionPointer("ElemEncodeMeshlets");
+    listElementalToolsFunctions.ElemDecodeMeshlets = (ElemEncodeMeshletsResult (*)(ElemEncodeMeshletsResult const *))GetElementalToolsFunctionPointer("ElemDecodeMeshlets");
+    listElementalToolsFunctions.ElemOptimizeMesh = (ElemMeshResult (*)(ElemVertexBuffer, ElemUInt32Span, const ElemOptimizeMeshOptions*))GetElementalToolsFunctionPointer("ElemOptimizeMesh");
+    listElementalToolsFunctions.ElemSimplifyMesh = (ElemMeshResult (*)(ElemVertexBuffer, ElemUInt32Span, const ElemSimplifyMeshOptions*))GetElementalToolsFunctionPointer("ElemSimplifyMesh");
     listElementalToolsFunctions.ElemLoadTexture = (ElemLoadTextureResult (*)(char const *, ElemLoadTextureOptions const *))GetElementalToolsFunctionPointer("ElemLoadTexture");
     listElementalToolsFunctions.ElemGenerateTextureMipData = (ElemGenerateTextureMipDataResult (*)(ElemToolsGraphicsFormat, ElemTextureMipData const *, ElemGenerateTextureMipDataOptions const *))GetElementalToolsFunctionPointer("ElemGenerateTextureMipData");
     listElementalToolsFunctions.ElemCompressTextureMipData = (ElemCompressTextureMipDataResult (*)(ElemToolsGraphicsFormat, ElemTextureMipData const *, ElemCompressTextureMipDataOptions const *))GetElementalToolsFunctionPointer("ElemCompressTextureMipData");
+    listElementalToolsFunctions.ElemBuildTextures = (ElemBuildTexturesResult (*)(ElemBuildTextureEntrySpan, const ElemBuildTexturesOptions*))GetElementalToolsFunctionPointer("ElemBuildTextures");
+    listElementalToolsFunctions.ElemBuildTextureContainer = (ElemBuildTextureContainerResult (*)(ElemToolsGraphicsFormat, ElemTextureMipDataSpan, const ElemBuildTextureContainerOptions*))GetElementalToolsFunctionPointer("ElemBuildTextureContainer");
     
 
     functionPointersLoadedElementalTools = 1;
@@ -114,6 +138,40 @@ static inline void ElemToolsConfigureFileIO(ElemToolsLoadFileHandlerPtr loadFile
     listElementalToolsFunctions.ElemToolsConfigureFileIO(loadFileHandler);
 }
 
+static inline uint64_t ElemToolsComputeDataHash(ElemToolsDataSpan data, uint64_t seed)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+        return 0;
+    }
+
+    if (!listElementalToolsFunctions.ElemToolsComputeDataHash) 
+    {
+        assert(listElementalToolsFunctions.ElemToolsComputeDataHash);
+        return 0;
+    }
+
+    return listElementalToolsFunctions.ElemToolsComputeDataHash(data, seed);
+}
+
+static inline char const * ElemToolsGetVersionLabel(void)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+        return NULL;
+    }
+
+    if (!listElementalToolsFunctions.ElemToolsGetVersionLabel) 
+    {
+        assert(listElementalToolsFunctions.ElemToolsGetVersionLabel);
+        return NULL;
+    }
+
+    return listElementalToolsFunctions.ElemToolsGetVersionLabel();
+}
+
 static inline bool ElemCanCompileShader(ElemShaderLanguage shaderLanguage, ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform)
 {
     if (!LoadElementalToolsFunctionPointers()) 
@@ -176,6 +234,68 @@ static inline ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGrap
     return listElementalToolsFunctions.ElemCompileShaderLibrary(graphicsApi, platform, path, options);
 }
 
+static inline ElemCompileShaderLibrariesResult ElemCompileShaderLibraries(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, ElemCompileShaderLibraryEntrySpan entries, ElemCompileShaderOptions const * options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemCompileShaderLibrariesResult result = {};
+        #else
+        ElemCompileShaderLibrariesResult result = (ElemCompileShaderLibrariesResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemCompileShaderLibraries) 
+    {
+        assert(listElementalToolsFunctions.ElemCompileShaderLibraries);
+
+        #ifdef __cplusplus
+        ElemCompileShaderLibrariesResult result = {};
+        #else
+        ElemCompileShaderLibrariesResult result = (ElemCompileShaderLibrariesResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemCompileShaderLibraries(graphicsApi, platform, entries, options);
+}
+
+static inline ElemShaderCompilationResult ElemCompileShaderPermutations(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, ElemShaderPermutationAxisSpan axes, const ElemCompileShaderOptions* options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemShaderCompilationResult result = {};
+        #else
+        ElemShaderCompilationResult result = (ElemShaderCompilationResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemCompileShaderPermutations) 
+    {
+        assert(listElementalToolsFunctions.ElemCompileShaderPermutations);
+
+        #ifdef __cplusplus
+        ElemShaderCompilationResult result = {};
+        #else
+        ElemShaderCompilationResult result = (ElemShaderCompilationResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemCompileShaderPermutations(graphicsApi, platform, path, axes, options);
+}
+
 static inline ElemLoadSceneResult ElemLoadScene(char const * path, ElemLoadSceneOptions const * options)
 {
     if (!LoadElementalToolsFunctionPointers()) 
@@ -207,6 +327,37 @@ static inline ElemLoadSceneResult ElemLoadScene(char const * path, ElemLoadScene
     return listElementalToolsFunctions.ElemLoadScene(path, options);
 }
 
+static inline ElemBuildSceneContainerResult ElemBuildSceneContainer(ElemSceneContainerSectionDataSpan sections, const ElemBuildSceneContainerOptions* options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemBuildSceneContainerResult result = {};
+        #else
+        ElemBuildSceneContainerResult result = (ElemBuildSceneContainerResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemBuildSceneContainer) 
+    {
+        assert(listElementalToolsFunctions.ElemBuildSceneContainer);
+
+        #ifdef __cplusplus
+        ElemBuildSceneContainerResult result = {};
+        #else
+        ElemBuildSceneContainerResult result = (ElemBuildSceneContainerResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemBuildSceneContainer(sections, options);
+}
+
 static inline ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, ElemBuildMeshletsOptions const * options)
 {
     if (!LoadElementalToolsFunctionPointers()) 
@@ -238,6 +389,161 @@ static inline ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBu
     return listElementalToolsFunctions.ElemBuildMeshlets(vertexBuffer, indexBuffer, options);
 }
 
+static inline ElemBuildMeshletResult ElemBuildMeshletLodHierarchy(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, ElemBuildMeshletLodHierarchyOptions const * options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemBuildMeshletResult result = {};
+        #else
+        ElemBuildMeshletResult result = (ElemBuildMeshletResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemBuildMeshletLodHierarchy) 
+    {
+        assert(listElementalToolsFunctions.ElemBuildMeshletLodHierarchy);
+
+        #ifdef __cplusplus
+        ElemBuildMeshletResult result = {};
+        #else
+        ElemBuildMeshletResult result = (ElemBuildMeshletResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemBuildMeshletLodHierarchy(vertexBuffer, indexBuffer, options);
+}
+
+static inline ElemEncodeMeshletsResult ElemEncodeMeshlets(ElemBuildMeshletResult const * meshletResult, ElemEncodeMeshletsOptions const * options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemEncodeMeshletsResult result = {};
+        #else
+        ElemEncodeMeshletsResult result = (ElemEncodeMeshletsResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemEncodeMeshlets) 
+    {
+        assert(listElementalToolsFunctions.ElemEncodeMeshlets);
+
+        #ifdef __cplusplus
+        ElemEncodeMeshletsResult result = {};
+        #else
+        ElemEncodeMeshletsResult result = (ElemEncodeMeshletsResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemEncodeMeshlets(meshletResult, options);
+}
+
+static inline ElemEncodeMeshletsResult ElemDecodeMeshlets(ElemEncodeMeshletsResult const * encodedResult)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemEncodeMeshletsResult result = {};
+        #else
+        ElemEncodeMeshletsResult result = (ElemEncodeMeshletsResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemDecodeMeshlets) 
+    {
+        assert(listElementalToolsFunctions.ElemDecodeMeshlets);
+
+        #ifdef __cplusplus
+        ElemEncodeMeshletsResult result = {};
+        #else
+        ElemEncodeMeshletsResult result = (ElemEncodeMeshletsResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemDecodeMeshlets(encodedResult);
+}
+
+static inline ElemMeshResult ElemOptimizeMesh(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemOptimizeMeshOptions* options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemMeshResult result = {};
+        #else
+        ElemMeshResult result = (ElemMeshResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemOptimizeMesh) 
+    {
+        assert(listElementalToolsFunctions.ElemOptimizeMesh);
+
+        #ifdef __cplusplus
+        ElemMeshResult result = {};
+        #else
+        ElemMeshResult result = (ElemMeshResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemOptimizeMesh(vertexBuffer, indexBuffer, options);
+}
+
+static inline ElemMeshResult ElemSimplifyMesh(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemSimplifyMeshOptions* options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemMeshResult result = {};
+        #else
+        ElemMeshResult result = (ElemMeshResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemSimplifyMesh) 
+    {
+        assert(listElementalToolsFunctions.ElemSimplifyMesh);
+
+        #ifdef __cplusplus
+        ElemMeshResult result = {};
+        #else
+        ElemMeshResult result = (ElemMeshResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemSimplifyMesh(vertexBuffer, indexBuffer, options);
+}
+
 static inline ElemLoadTextureResult ElemLoadTexture(char const * path, ElemLoadTextureOptions const * options)
 {
     if (!LoadElementalToolsFunctionPointers()) 
@@ -330,3 +636,65 @@ static inline ElemCompressTextureMipDataResult ElemCompressTextureMipData(ElemTo
 
     return listElementalToolsFunctions.ElemCompressTextureMipData(format, mipData, options);
 }
+
+static inline ElemBuildTexturesResult ElemBuildTextures(ElemBuildTextureEntrySpan entries, const ElemBuildTexturesOptions* options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemBuildTexturesResult result = {};
+        #else
+        ElemBuildTexturesResult result = (ElemBuildTexturesResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemBuildTextures) 
+    {
+        assert(listElementalToolsFunctions.ElemBuildTextures);
+
+        #ifdef __cplusplus
+        ElemBuildTexturesResult result = {};
+        #else
+        ElemBuildTexturesResult result = (ElemBuildTexturesResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemBuildTextures(entries, options);
+}
+
+static inline ElemBuildTextureContainerResult ElemBuildTextureContainer(ElemToolsGraphicsFormat format, ElemTextureMipDataSpan mipData, const ElemBuildTextureContainerOptions* options)
+{
+    if (!LoadElementalToolsFunctionPointers()) 
+    {
+        assert(libraryElementalTools);
+
+        #ifdef __cplusplus
+        ElemBuildTextureContainerResult result = {};
+        #else
+        ElemBuildTextureContainerResult result = (ElemBuildTextureContainerResult){0};
+        #endif
+
+        return result;
+    }
+
+    if (!listElementalToolsFunctions.ElemBuildTextureContainer) 
+    {
+        assert(listElementalToolsFunctions.ElemBuildTextureContainer);
+
+        #ifdef __cplusplus
+        ElemBuildTextureContainerResult result = {};
+        #else
+        ElemBuildTextureContainerResult result = (ElemBuildTextureContainerResult){0};
+        #endif
+
+        return result;
+    }
+
+    return listElementalToolsFunctions.ElemBuildTextureContainer(format, mipData, options);
+}
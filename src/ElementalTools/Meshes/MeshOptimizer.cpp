@@ -0,0 +1,312 @@
+#include "ElementalTools.h"
+#include "VertexFormat.h"
+#include "ToolsUtils.h"
+#include "SystemMemory.h"
+#include "SystemFunctions.h"
+
+// TODO: Do one for each thread
+static MemoryArena MeshOptimizerMemoryArena;
+static MemoryArena MeshSimplifierMemoryArena;
+
+void InitMeshOptimizerMemoryArena(MemoryArena* memoryArena)
+{
+    if (memoryArena->Storage == nullptr)
+    {
+        *memoryArena = SystemAllocateMemoryArena(512 * 1024 * 1024);
+    }
+
+    SystemClearMemoryArena(*memoryArena);
+}
+
+struct MeshOptimizerData
+{
+    Span<uint8_t> VertexList;
+    Span<uint32_t> IndexList;
+    uint32_t VertexCount;
+    const float* VertexPositions;
+    size_t VertexPositionStride;
+};
+
+const char* CheckMeshOptimizerInput(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer)
+{
+    if (vertexBuffer.VertexSize == 0 || vertexBuffer.Data.Length == 0)
+    {
+        return "Vertex buffer is empty.";
+    }
+
+    auto indexCount = indexBuffer.Length > 0 ? indexBuffer.Length : vertexBuffer.Data.Length / vertexBuffer.VertexSize;
+
+    if (indexCount % 3 != 0)
+    {
+        return "Index count must be a multiple of 3.";
+    }
+
+    return nullptr;
+}
+
+MeshOptimizerData PrepareMeshOptimizerData(MemoryArena memoryArena, ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, bool keepVertexBuffer)
+{
+    auto indexCount = vertexBuffer.Data.Length / vertexBuffer.VertexSize;
+    uint32_t* indexBufferPointer = nullptr;
+
+    if (indexBuffer.Length > 0)
+    {
+        indexBufferPointer = indexBuffer.Items;
+        indexCount = indexBuffer.Length;
+    }
+
+    auto sourceVertexCount = indexBufferPointer ? vertexBuffer.Data.Length / vertexBuffer.VertexSize : indexCount;
+    auto vertexCount = sourceVertexCount;
+
+    Span<uint8_t> vertexList;
+    auto indexList = SystemPushArrayZero<uint32_t>(memoryArena, indexCount);
+
+    if (keepVertexBuffer)
+    {
+        // NOTE: The indices must stay valid for the source vertex buffer so the vertices are not deduplicated.
+        vertexList = Span<uint8_t>(vertexBuffer.Data.Items, vertexBuffer.Data.Length);
+
+        for (uint32_t i = 0; i < indexCount; i++)
+        {
+            indexList[i] = indexBufferPointer ? indexBufferPointer[i] : i;
+        }
+    }
+    else
+    {
+        auto vertexRemap = SystemPushArrayZero<uint32_t>(memoryArena, indexCount);
+        vertexCount = meshopt_generateVertexRemap(vertexRemap.Pointer, indexBufferPointer, indexCount, vertexBuffer.Data.Items, sourceVertexCount, vertexBuffer.VertexSize);
+
+        vertexList = SystemPushArrayZero<uint8_t>(memoryArena, vertexCount * vertexBuffer.VertexSize);
+
+        meshopt_remapVertexBuffer(vertexList.Pointer, vertexBuffer.Data.Items, sourceVertexCount, vertexBuffer.VertexSize, vertexRemap.Pointer);
+        meshopt_remapIndexBuffer(indexList.Pointer, indexBufferPointer, indexCount, vertexRemap.Pointer);
+    }
+
+    // NOTE: Compact vertex formats don't store float positions so we decode them for meshoptimizer.
+    auto vertexPositions = (const float*)vertexList.Pointer;
+    auto vertexPositionStride = (size_t)vertexBuffer.VertexSize;
+
+    if (vertexBuffer.Format != ElemVertexFormat_Float32)
+    {
+        auto decodedPositions = SystemPushArray<ElemToolsVector3>(memoryArena, vertexCount);
+        DecodeVertexBufferPositions({ .Data = { .Items = vertexList.Pointer, .Length = (uint32_t)vertexList.Length }, .VertexSize = vertexBuffer.VertexSize, .Format = vertexBuffer.Format, .PositionBounds = vertexBuffer.PositionBounds }, decodedPositions);
+
+        vertexPositions = (const float*)decodedPositions.Pointer;
+        vertexPositionStride = sizeof(ElemToolsVector3);
+    }
+
+    return
+    {
+        .VertexList = vertexList,
+        .IndexList = indexList,
+        .VertexCount = (uint32_t)vertexCount,
+        .VertexPositions = vertexPositions,
+        .VertexPositionStride = vertexPositionStride
+    };
+}
+
+ElemMeshResult ConstructOptimizedMeshResult(MemoryArena memoryArena, ElemVertexBuffer vertexBuffer, const MeshOptimizerData* meshData, Span<uint32_t> indexList, float overdrawThreshold)
+{
+    meshopt_optimizeVertexCache(indexList.Pointer, indexList.Pointer, indexList.Length, meshData->VertexCount);
+    meshopt_optimizeOverdraw(indexList.Pointer, indexList.Pointer, indexList.Length, meshData->VertexPositions, meshData->VertexCount, meshData->VertexPositionStride, overdrawThreshold);
+
+    // NOTE: The fetch optimization also removes the vertices that are not referenced anymore.
+    auto vertexList = SystemPushArray<uint8_t>(memoryArena, meshData->VertexCount * vertexBuffer.VertexSize);
+    auto vertexCount = (uint32_t)meshopt_optimizeVertexFetch(vertexList.Pointer, indexList.Pointer, indexList.Length, meshData->VertexList.Pointer, meshData->VertexCount, vertexBuffer.VertexSize);
+
+    return
+    {
+        .VertexBuffer =
+        {
+            .Data = { .Items = vertexList.Pointer, .Length = vertexCount * vertexBuffer.VertexSize },
+            .VertexSize = vertexBuffer.VertexSize,
+            .VertexCount = vertexCount,
+            .Format = vertexBuffer.Format,
+            .PositionBounds = vertexBuffer.PositionBounds
+        },
+        .IndexBuffer = { .Items = indexList.Pointer, .Length = (uint32_t)indexList.Length }
+    };
+}
+
+ElemToolsAPI ElemMeshResult ElemOptimizeMesh(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemOptimizeMeshOptions* options)
+{
+    InitMeshOptimizerMemoryArena(&MeshOptimizerMemoryArena);
+
+    ElemOptimizeMeshOptions optimizeOptions = {};
+
+    if (options)
+    {
+        optimizeOptions = *options;
+    }
+
+    if (optimizeOptions.OverdrawThreshold == 0.0f)
+    {
+        optimizeOptions.OverdrawThreshold = 1.05f;
+    }
+
+    auto inputError = CheckMeshOptimizerInput(vertexBuffer, indexBuffer);
+
+    if (inputError)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshOptimizerMemoryArena, inputError),
+            .HasErrors = true
+        };
+    }
+
+    auto meshData = PrepareMeshOptimizerData(MeshOptimizerMemoryArena, vertexBuffer, indexBuffer, false);
+    auto result = ConstructOptimizedMeshResult(MeshOptimizerMemoryArena, vertexBuffer, &meshData, meshData.IndexList, optimizeOptions.OverdrawThreshold);
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(MeshOptimizerMemoryArena, 1)
+    };
+
+    WriteToMessageList(ElemToolsMessageType_Information,
+                       SystemFormatString(MeshOptimizerMemoryArena, "Optimized mesh: %d vertices, %d indices", result.VertexBuffer.VertexCount, result.IndexBuffer.Length).Pointer,
+                       &messageList);
+
+    result.Messages = { .Items = messageList.Messages.Pointer, .Length = messageList.MessageCount };
+    return result;
+}
+
+ElemToolsAPI ElemMeshResult ElemSimplifyMesh(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemSimplifyMeshOptions* options)
+{
+    InitMeshOptimizerMemoryArena(&MeshSimplifierMemoryArena);
+
+    ElemSimplifyMeshOptions simplifyOptions = {};
+
+    if (options)
+    {
+        simplifyOptions = *options;
+    }
+
+    if (simplifyOptions.TargetIndexRatio == 0.0f)
+    {
+        simplifyOptions.TargetIndexRatio = 0.5f;
+    }
+
+    if (!simplifyOptions.UseExplicitValues)
+    {
+        if (simplifyOptions.TargetError == 0.0f)
+        {
+            simplifyOptions.TargetError = 0.01f;
+        }
+
+        if (simplifyOptions.NormalWeight == 0.0f)
+        {
+            simplifyOptions.NormalWeight = 1.0f;
+        }
+
+        if (simplifyOptions.TextureCoordinatesWeight == 0.0f)
+        {
+            simplifyOptions.TextureCoordinatesWeight = 1.0f;
+        }
+    }
+
+    auto inputError = CheckMeshOptimizerInput(vertexBuffer, indexBuffer);
+
+    if (!inputError && (simplifyOptions.TargetIndexRatio < 0.0f || simplifyOptions.TargetIndexRatio > 1.0f || simplifyOptions.TargetError < 0.0f || simplifyOptions.TargetError > 1.0f))
+    {
+        inputError = "Target index ratio and target error must be between 0 and 1.";
+    }
+
+    if (inputError)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshSimplifierMemoryArena, inputError),
+            .HasErrors = true
+        };
+    }
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(MeshSimplifierMemoryArena, 2)
+    };
+
+    auto meshData = PrepareMeshOptimizerData(MeshSimplifierMemoryArena, vertexBuffer, indexBuffer, simplifyOptions.KeepVertexBuffer);
+    auto sourceIndexCount = (uint32_t)meshData.IndexList.Length;
+
+    auto targetIndexCount = simplifyOptions.TargetIndexCount;
+
+    if (targetIndexCount == 0)
+    {
+        targetIndexCount = (uint32_t)(sourceIndexCount * simplifyOptions.TargetIndexRatio);
+    }
+
+    targetIndexCount = SystemMin(targetIndexCount / 3 * 3, sourceIndexCount);
+
+    // NOTE: The attributes are read directly from the Float32 layout. Normal, tangent and texture coordinates are
+    // contiguous so we pass them as one attribute block and ignore the tangent with a zero weight.
+    const float* vertexAttributes = nullptr;
+    float attributeWeights[9] = {};
+    auto attributeCount = 0u;
+
+    if (simplifyOptions.UseAttributes)
+    {
+        if (vertexBuffer.Format == ElemVertexFormat_Float32 && vertexBuffer.VertexSize >= sizeof(Float32Vertex))
+        {
+            vertexAttributes = (const float*)(meshData.VertexList.Pointer + offsetof(Float32Vertex, Normal));
+            attributeCount = 9;
+
+            attributeWeights[0] = simplifyOptions.NormalWeight;
+            attributeWeights[1] = simplifyOptions.NormalWeight;
+            attributeWeights[2] = simplifyOptions.NormalWeight;
+            attributeWeights[7] = simplifyOptions.TextureCoordinatesWeight;
+            attributeWeights[8] = simplifyOptions.TextureCoordinatesWeight;
+        }
+        else
+        {
+            WriteToMessageList(ElemToolsMessageType_Warning, "Attribute aware simplification is only supported by the Float32 vertex format. Only the positions are used.", &messageList);
+        }
+    }
+
+    auto simplifyFlags = simplifyOptions.LockBorders ? (uint32_t)meshopt_SimplifyLockBorder : 0u;
+    auto simplifiedIndexList = SystemPushArray<uint32_t>(MeshSimplifierMemoryArena, sourceIndexCount);
+    auto simplifyError = 0.0f;
+
+    auto simplifiedIndexCount = meshopt_simplifyWithAttributes(simplifiedIndexList.Pointer,
+                                                               meshData.IndexList.Pointer,
+                                                               sourceIndexCount,
+                                                               meshData.VertexPositions,
+                                                               meshData.VertexCount,
+                                                               meshData.VertexPositionStride,
+                                                               vertexAttributes,
+                                                               vertexBuffer.VertexSize,
+                                                               vertexAttributes ? attributeWeights : nullptr,
+                                                               attributeCount,
+                                                               nullptr,
+                                                               targetIndexCount,
+                                                               simplifyOptions.TargetError,
+                                                               simplifyFlags,
+                                                               &simplifyError);
+
+    ElemMeshResult result;
+
+    if (simplifyOptions.KeepVertexBuffer)
+    {
+        meshopt_optimizeVertexCache(simplifiedIndexList.Pointer, simplifiedIndexList.Pointer, simplifiedIndexCount, meshData.VertexCount);
+        meshopt_optimizeOverdraw(simplifiedIndexList.Pointer, simplifiedIndexList.Pointer, simplifiedIndexCount, meshData.VertexPositions, meshData.VertexCount, meshData.VertexPositionStride, 1.05f);
+
+        result = 
+        {
+            .VertexBuffer = vertexBuffer,
+            .IndexBuffer = { .Items = simplifiedIndexList.Pointer, .Length = (uint32_t)simplifiedIndexCount }
+        };
+    }
+    else
+    {
+        result = ConstructOptimizedMeshResult(MeshSimplifierMemoryArena, vertexBuffer, &meshData, simplifiedIndexList.Slice(0, simplifiedIndexCount), 1.05f);
+    }
+    result.SimplifyError = simplifyError;
+    result.SimplifyAbsoluteError = simplifyError * meshopt_simplifyScale(meshData.VertexPositions, meshData.VertexCount, meshData.VertexPositionStride);
+
+    WriteToMessageList(ElemToolsMessageType_Information,
+                       SystemFormatString(MeshSimplifierMemoryArena, "Simplified mesh: %d indices (%d before simplification), error: %f", result.IndexBuffer.Length, sourceIndexCount, simplifyError).Pointer,
+                       &messageList);
+
+    result.Messages = { .Items = messageList.Messages.Pointer, .Length = messageList.MessageCount };
+    return result;
+}
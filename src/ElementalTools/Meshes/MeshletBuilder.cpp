@@ -1,9 +1,15 @@
-#include "ElementalTools.h"
-#include "SystemMemory.h"
+#include "MeshletBuilder.h"
+#include "VertexFormat.h"
+#include "SystemFunctions.h"
 
 // TODO: Do one for each thread
 static MemoryArena MeshletBuilderMemoryArena;
 
+MemoryArena GetMeshletBuilderMemoryArena()
+{
+    return MeshletBuilderMemoryArena;
+}
+
 void InitMeshletBuilderMemoryArena()
 {
     if (MeshletBuilderMemoryArena.Storage == nullptr)
@@ -14,14 +20,87 @@ void InitMeshletBuilderMemoryArena()
     SystemClearMemoryArena(MeshletBuilderMemoryArena);
 }
 
-ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemBuildMeshletsOptions* options)
+ElemMeshletCompactBounds CompressMeshletBounds(const ElemMeshletBounds* bounds, const meshopt_Bounds* meshOptBounds)
 {
-    InitMeshletBuilderMemoryArena();
+    ElemMeshletCompactBounds result = {};
+    auto sphereCenter = &bounds->SphereCenter;
 
-    // TODO: Error messages
+    result.SphereCenter[0] = meshopt_quantizeHalf(sphereCenter->X);
+    result.SphereCenter[1] = meshopt_quantizeHalf(sphereCenter->Y);
+    result.SphereCenter[2] = meshopt_quantizeHalf(sphereCenter->Z);
 
-    auto stackMemoryArena = SystemGetStackMemoryArena();
+    // NOTE: Grow the radius by the center quantization error so the sphere stays conservative.
+    ElemToolsVector3 centerError = 
+    {
+        DequantizeHalf(result.SphereCenter[0]) - sphereCenter->X,
+        DequantizeHalf(result.SphereCenter[1]) - sphereCenter->Y,
+        DequantizeHalf(result.SphereCenter[2]) - sphereCenter->Z
+    };
+
+    auto radius = bounds->SphereRadius + ElemToolsMagnitudeV3(centerError);
+    result.SphereRadius = meshopt_quantizeHalf(radius);
+
+    if (DequantizeHalf(result.SphereRadius) < radius)
+    {
+        result.SphereRadius++;
+    }
+
+    result.ConeAxis[0] = meshOptBounds->cone_axis_s8[0];
+    result.ConeAxis[1] = meshOptBounds->cone_axis_s8[1];
+    result.ConeAxis[2] = meshOptBounds->cone_axis_s8[2];
+    result.ConeCutoff = meshOptBounds->cone_cutoff_s8;
+
+    return result;
+}
+
+const char* ResolveBuildMeshletsOptions(const ElemBuildMeshletsOptions* options, ElemBuildMeshletsOptions* result)
+{
+    *result = {};
+
+    if (options)
+    {
+        *result = *options;
+    }
+
+    // TODO: Review the default values
+    if (result->MeshletMaxVertexCount == 0)
+    {
+        result->MeshletMaxVertexCount = 64;
+    }
+
+    if (result->MeshletMaxTriangleCount == 0)
+    {
+        result->MeshletMaxTriangleCount = 64;
+    }
+
+    if (!result->UseExplicitWeights)
+    {
+        if (result->ConeWeight == 0.0f)
+        {
+            result->ConeWeight = 0.5f;
+        }
+
+        if (result->FillWeight == 0.0f)
+        {
+            result->FillWeight = 0.5f;
+        }
+    }
+
+    if (result->MeshletMaxVertexCount < 3)
+    {
+        return "Meshlet max vertex count must be at least 3.";
+    }
+
+    if (result->ConeWeight < 0.0f || result->ConeWeight > 1.0f || result->FillWeight < 0.0f || result->FillWeight > 1.0f)
+    {
+        return "Meshlet cone weight and fill weight must be between 0 and 1.";
+    }
+
+    return nullptr;
+}
 
+MeshletVertexData PrepareMeshletVertexData(MemoryArena memoryArena, ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer)
+{
     auto indexCount = vertexBuffer.Data.Length / vertexBuffer.VertexSize;
     uint32_t* indexBufferPointer = nullptr;
 
@@ -31,7 +110,7 @@ ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuf
         indexCount = indexBuffer.Length;
     }
 
-    auto vertexRemap = SystemPushArrayZero<uint32_t>(stackMemoryArena, indexCount);
+    auto vertexRemap = SystemPushArrayZero<uint32_t>(memoryArena, indexCount);
     
     auto vertexCount = meshopt_generateVertexRemap(vertexRemap.Pointer, indexBufferPointer, indexCount, vertexBuffer.Data.Items, indexCount, vertexBuffer.VertexSize);
 
@@ -44,40 +123,74 @@ ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuf
     meshopt_optimizeVertexCache(indexList.Pointer, indexList.Pointer, indexCount, vertexCount);
     meshopt_optimizeVertexFetch(vertexList.Pointer, indexList.Pointer, indexCount, vertexList.Pointer, vertexCount, vertexBuffer.VertexSize);
 
-    // TODO: Compute bounding sphere and bounding box
+    // NOTE: Compact vertex formats don't store float positions so we decode them for meshoptimizer.
+    auto vertexPositions = (const float*)vertexList.Pointer;
+    auto vertexPositionStride = (size_t)vertexBuffer.VertexSize;
 
-    // TODO: Review the default values
-    // TODO: Allow customisation
-    uint8_t meshletMaxVertexCount = 64u;
-    uint8_t meshletMaxTriangleCount = 64u;
-    auto coneWeight = 0.5f;
-
-    auto meshletCount = (uint32_t)meshopt_buildMeshletsBound(indexCount, meshletMaxVertexCount, meshletMaxTriangleCount);
-
-    auto meshOptMeshletList = SystemPushArray<meshopt_Meshlet>(stackMemoryArena, meshletCount);
-    auto meshletVertexIndexList = SystemPushArray<uint32_t>(MeshletBuilderMemoryArena, meshletCount * meshletMaxVertexCount);
-    auto meshletTriangleIndexListRaw = SystemPushArray<uint8_t>(stackMemoryArena, meshletCount * meshletMaxTriangleCount * 3);
-    auto meshletTriangleIndexList = SystemPushArrayZero<uint32_t>(MeshletBuilderMemoryArena, meshletCount * meshletMaxTriangleCount);
-
-    meshletCount = meshopt_buildMeshlets(meshOptMeshletList.Pointer, 
-                                         meshletVertexIndexList.Pointer, 
-                                         meshletTriangleIndexListRaw.Pointer, 
-                                         indexList.Pointer, 
-                                         indexCount, 
-                                         (const float*)vertexList.Pointer, 
-                                         vertexCount, 
-                                         vertexBuffer.VertexSize, 
-                                         meshletMaxVertexCount, 
-                                         meshletMaxTriangleCount, 
-                                         coneWeight);
+    if (vertexBuffer.Format != ElemVertexFormat_Float32)
+    {
+        auto decodedPositions = SystemPushArray<ElemToolsVector3>(memoryArena, vertexCount);
+        DecodeVertexBufferPositions({ .Data = { .Items = vertexList.Pointer, .Length = (uint32_t)vertexList.Length }, .VertexSize = vertexBuffer.VertexSize, .Format = vertexBuffer.Format, .PositionBounds = vertexBuffer.PositionBounds }, decodedPositions);
 
+        vertexPositions = (const float*)decodedPositions.Pointer;
+        vertexPositionStride = sizeof(ElemToolsVector3);
+    }
 
-    auto meshletVertexIndexCount = 0u;
-    auto meshletTriangleIndexCount = 0u;
+    return
+    {
+        .VertexList = vertexList,
+        .IndexList = indexList,
+        .VertexCount = (uint32_t)vertexCount,
+        .VertexPositions = vertexPositions,
+        .VertexPositionStride = vertexPositionStride
+    };
+}
 
-    //printf("MeshletCount: %d\n", meshletCount);
+Span<MeshletCluster> BuildMeshletClusters(MemoryArena memoryArena, ReadOnlySpan<uint32_t> indices, const MeshletVertexData* vertexData, const ElemBuildMeshletsOptions* options)
+{
+    auto meshletMaxVertexCount = options->MeshletMaxVertexCount;
+    auto meshletMaxTriangleCount = options->MeshletMaxTriangleCount;
 
-    auto meshletList = SystemPushArray<ElemMeshlet>(MeshletBuilderMemoryArena, meshletCount);
+    // NOTE: The spatial builder is allowed to emit smaller meshlets to get tighter clusters.
+    auto meshletMinTriangleCount = options->BuilderMode == ElemMeshletBuilderMode_Spatial ? SystemMax(meshletMaxTriangleCount / 4u, 1u) : meshletMaxTriangleCount;
+
+    auto meshletCount = (uint32_t)meshopt_buildMeshletsBound(indices.Length, meshletMaxVertexCount, meshletMinTriangleCount);
+
+    auto meshOptMeshletList = SystemPushArray<meshopt_Meshlet>(memoryArena, meshletCount);
+    auto meshletVertexIndexList = SystemPushArray<uint32_t>(memoryArena, meshletCount * meshletMaxVertexCount);
+    auto meshletTriangleIndexListRaw = SystemPushArray<uint8_t>(memoryArena, meshletCount * meshletMaxTriangleCount * 3);
+
+    if (options->BuilderMode == ElemMeshletBuilderMode_Spatial)
+    {
+        meshletCount = meshopt_buildMeshletsSpatial(meshOptMeshletList.Pointer, 
+                                                    meshletVertexIndexList.Pointer, 
+                                                    meshletTriangleIndexListRaw.Pointer, 
+                                                    indices.Pointer, 
+                                                    indices.Length, 
+                                                    vertexData->VertexPositions, 
+                                                    vertexData->VertexCount, 
+                                                    vertexData->VertexPositionStride, 
+                                                    meshletMaxVertexCount, 
+                                                    meshletMinTriangleCount, 
+                                                    meshletMaxTriangleCount, 
+                                                    options->FillWeight);
+    }
+    else
+    {
+        meshletCount = meshopt_buildMeshlets(meshOptMeshletList.Pointer, 
+                                             meshletVertexIndexList.Pointer, 
+                                             meshletTriangleIndexListRaw.Pointer, 
+                                             indices.Pointer, 
+                                             indices.Length, 
+                                             vertexData->VertexPositions, 
+                                             vertexData->VertexCount, 
+                                             vertexData->VertexPositionStride, 
+                                             meshletMaxVertexCount, 
+                                             meshletMaxTriangleCount, 
+                                             options->ConeWeight);
+    }
+
+    auto clusters = SystemPushArray<MeshletCluster>(memoryArena, meshletCount);
 
     for (uint32_t i = 0; i < meshletCount; i++)
     {
@@ -88,46 +201,147 @@ ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuf
                                 meshlet.triangle_count, 
                                 meshlet.vertex_count);
 
-        /*auto meshletBounds = meshopt_computeMeshletBounds(&meshletVertexIndexList[meshlet.vertex_offset], 
-                                                          &meshletTriangleIndexListRaw[meshlet.triangle_offset], 
-                                                          meshlet.triangle_count, 
-                                                          (const float*)vertexList.Pointer, 
-                                                          vertexCount, 
-                                                          vertexBuffer.VertexSize);*/
+        clusters[i] =
+        {
+            .VertexIndices = meshletVertexIndexList.Slice(meshlet.vertex_offset, meshlet.vertex_count),
+            .TriangleIndices = meshletTriangleIndexListRaw.Slice(meshlet.triangle_offset, meshlet.triangle_count * 3),
+            .TriangleCount = meshlet.triangle_count
+        };
+    }
+
+    return clusters;
+}
+
+ElemBuildMeshletResult ConstructBuildMeshletResult(ElemVertexBuffer vertexBuffer, const MeshletVertexData* vertexData, ReadOnlySpan<MeshletCluster> clusters, const ElemBuildMeshletsOptions* options, ToolsMessageList* messageList)
+{
+    auto meshletCount = (uint32_t)clusters.Length;
+    auto meshletVertexIndexCount = 0u;
+    auto meshletTriangleCount = 0u;
+
+    for (uint32_t i = 0; i < meshletCount; i++)
+    {
+        meshletVertexIndexCount += clusters[i].VertexIndices.Length;
+        meshletTriangleCount += clusters[i].TriangleCount;
+    }
+
+    auto meshletList = SystemPushArray<ElemMeshlet>(MeshletBuilderMemoryArena, meshletCount);
+    auto meshletBoundsList = SystemPushArray<ElemMeshletBounds>(MeshletBuilderMemoryArena, meshletCount);
+    auto meshletCompactBoundsList = SystemPushArray<ElemMeshletCompactBounds>(MeshletBuilderMemoryArena, meshletCount);
+    auto meshletVertexIndexList = SystemPushArray<uint32_t>(MeshletBuilderMemoryArena, meshletVertexIndexCount);
+    auto meshletTriangleIndexList = SystemPushArray<uint32_t>(MeshletBuilderMemoryArena, meshletTriangleCount);
+
+    auto vertexIndexOffset = 0u;
+    auto triangleOffset = 0u;
+
+    for (uint32_t i = 0; i < meshletCount; i++)
+    {
+        auto cluster = &clusters[i];
+
+        auto meshletBounds = meshopt_computeMeshletBounds(cluster->VertexIndices.Pointer, 
+                                                          cluster->TriangleIndices.Pointer, 
+                                                          cluster->TriangleCount, 
+                                                          vertexData->VertexPositions, 
+                                                          vertexData->VertexCount, 
+                                                          vertexData->VertexPositionStride);
+
+        ElemToolsBoundingBox boundingBox = 
+        {
+            .MinPoint = { FLT_MAX, FLT_MAX, FLT_MAX },
+            .MaxPoint = { -FLT_MAX, -FLT_MAX, -FLT_MAX }
+        };
+
+        for (uint32_t j = 0; j < cluster->VertexIndices.Length; j++)
+        {
+            auto position = (const float*)((const uint8_t*)vertexData->VertexPositions + cluster->VertexIndices[j] * vertexData->VertexPositionStride);
+            AddPointToBoundingBox({ position[0], position[1], position[2] }, &boundingBox);
+        }
 
-        // TODO: Cone and sphere
+        meshletBoundsList[i] =
+        {
+            .SphereCenter = { meshletBounds.center[0], meshletBounds.center[1], meshletBounds.center[2] },
+            .SphereRadius = meshletBounds.radius,
+            .BoundingBox = boundingBox,
+            .ConeApex = { meshletBounds.cone_apex[0], meshletBounds.cone_apex[1], meshletBounds.cone_apex[2] },
+            .ConeAxis = { meshletBounds.cone_axis[0], meshletBounds.cone_axis[1], meshletBounds.cone_axis[2] },
+            .ConeCutoff = meshletBounds.cone_cutoff
+        };
+
+        meshletCompactBoundsList[i] = CompressMeshletBounds(&meshletBoundsList[i], &meshletBounds);
 
         meshletList[i] =
         {
-            .VertexIndexOffset = meshlet.vertex_offset,
-            .VertexIndexCount = meshlet.vertex_count,
-            .TriangleOffset = meshlet.triangle_offset / 3,
-            .TriangleCount = meshlet.triangle_count
+            .VertexIndexOffset = vertexIndexOffset,
+            .VertexIndexCount = (uint32_t)cluster->VertexIndices.Length,
+            .TriangleOffset = triangleOffset,
+            .TriangleCount = cluster->TriangleCount
         };
 
-        for (uint32_t j = 0; j < meshlet.triangle_count; j++)
+        SystemCopyBuffer(meshletVertexIndexList.Slice(vertexIndexOffset), cluster->VertexIndices);
+
+        for (uint32_t j = 0; j < cluster->TriangleCount; j++)
         {
-            auto pointer = &meshletTriangleIndexListRaw[meshlet.triangle_offset + j * 3]; 
+            auto pointer = &cluster->TriangleIndices[j * 3]; 
             
             auto p0 = pointer[0];
             auto p1 = pointer[1];
             auto p2 = pointer[2];
 
-            meshletTriangleIndexList[meshletList[i].TriangleOffset + j] = ((uint32_t)p2) << 16 | ((uint32_t)p1) << 8 | (uint32_t)p0;
+            meshletTriangleIndexList[triangleOffset + j] = ((uint32_t)p2) << 16 | ((uint32_t)p1) << 8 | (uint32_t)p0;
         }
 
-        meshletVertexIndexCount += meshlet.vertex_count;
-        meshletTriangleIndexCount = fmax(meshletTriangleIndexCount, meshlet.triangle_offset / 3 + meshlet.triangle_count);
+        vertexIndexOffset += cluster->VertexIndices.Length;
+        triangleOffset += cluster->TriangleCount;
     }
 
+    auto averageVertexFillRatio = meshletCount > 0 ? (float)meshletVertexIndexCount / (meshletCount * options->MeshletMaxVertexCount) : 0.0f;
+    auto averageTriangleFillRatio = meshletCount > 0 ? (float)meshletTriangleCount / (meshletCount * options->MeshletMaxTriangleCount) : 0.0f;
+
+    WriteToMessageList(ElemToolsMessageType_Information, 
+                       SystemFormatString(MeshletBuilderMemoryArena, "Meshlets: %d, average fill ratio: %f vertices, %f triangles", meshletCount, (double)averageVertexFillRatio, (double)averageTriangleFillRatio).Pointer, 
+                       messageList);
+
     // TODO: Output everything in separate memory arena
     return 
     {
-        .MeshletMaxVertexCount = meshletMaxVertexCount,
-        .MeshletMaxTriangleCount = meshletMaxTriangleCount,
-        .VertexBuffer = { .Data = { .Items = vertexList.Pointer, .Length = (uint32_t)vertexList.Length }, .VertexSize = vertexBuffer.VertexSize, .VertexCount = vertexBuffer.VertexCount },
+        .MeshletMaxVertexCount = options->MeshletMaxVertexCount,
+        .MeshletMaxTriangleCount = options->MeshletMaxTriangleCount,
+        .VertexBuffer = { .Data = { .Items = vertexData->VertexList.Pointer, .Length = (uint32_t)vertexData->VertexList.Length }, .VertexSize = vertexBuffer.VertexSize, .VertexCount = vertexData->VertexCount, .Format = vertexBuffer.Format, .PositionBounds = vertexBuffer.PositionBounds },
         .Meshlets = { .Items = meshletList.Pointer, .Length = (uint32_t)meshletList.Length },
+        .MeshletBounds = { .Items = meshletBoundsList.Pointer, .Length = (uint32_t)meshletBoundsList.Length },
+        .MeshletCompactBounds = { .Items = meshletCompactBoundsList.Pointer, .Length = (uint32_t)meshletCompactBoundsList.Length },
         .MeshletVertexIndexBuffer = { .Items = meshletVertexIndexList.Pointer, .Length = meshletVertexIndexCount },
-        .MeshletTriangleIndexBuffer = { .Items = meshletTriangleIndexList.Pointer, .Length = meshletTriangleIndexCount }
+        .MeshletTriangleIndexBuffer = { .Items = meshletTriangleIndexList.Pointer, .Length = meshletTriangleCount },
+        .AverageVertexFillRatio = averageVertexFillRatio,
+        .AverageTriangleFillRatio = averageTriangleFillRatio,
+        .Messages = { .Items = messageList->Messages.Pointer, .Length = messageList->MessageCount }
+    };
+}
+
+ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshlets(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemBuildMeshletsOptions* options)
+{
+    InitMeshletBuilderMemoryArena();
+
+    ElemBuildMeshletsOptions buildMeshletsOptions;
+    auto errorMessage = ResolveBuildMeshletsOptions(options, &buildMeshletsOptions);
+
+    if (errorMessage)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshletBuilderMemoryArena, errorMessage),
+            .HasErrors = true
+        };
+    }
+
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+
+    auto vertexData = PrepareMeshletVertexData(stackMemoryArena, vertexBuffer, indexBuffer);
+    auto clusters = BuildMeshletClusters(stackMemoryArena, vertexData.IndexList, &vertexData, &buildMeshletsOptions);
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(MeshletBuilderMemoryArena, 1)
     };
+
+    return ConstructBuildMeshletResult(vertexBuffer, &vertexData, clusters, &buildMeshletsOptions, &messageList);
 }
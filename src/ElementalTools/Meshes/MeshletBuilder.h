@@ -0,0 +1,29 @@
+#pragma once
+
+#include "ElementalTools.h"
+#include "SystemMemory.h"
+#include "ToolsUtils.h"
+
+struct MeshletVertexData
+{
+    Span<uint8_t> VertexList;
+    Span<uint32_t> IndexList;
+    uint32_t VertexCount;
+    const float* VertexPositions;
+    size_t VertexPositionStride;
+};
+
+struct MeshletCluster
+{
+    ReadOnlySpan<uint32_t> VertexIndices;
+    ReadOnlySpan<uint8_t> TriangleIndices;
+    uint32_t TriangleCount;
+};
+
+MemoryArena GetMeshletBuilderMemoryArena();
+void InitMeshletBuilderMemoryArena();
+
+const char* ResolveBuildMeshletsOptions(const ElemBuildMeshletsOptions* options, ElemBuildMeshletsOptions* result);
+MeshletVertexData PrepareMeshletVertexData(MemoryArena memoryArena, ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer);
+Span<MeshletCluster> BuildMeshletClusters(MemoryArena memoryArena, ReadOnlySpan<uint32_t> indices, const MeshletVertexData* vertexData, const ElemBuildMeshletsOptions* options);
+ElemBuildMeshletResult ConstructBuildMeshletResult(ElemVertexBuffer vertexBuffer, const MeshletVertexData* vertexData, ReadOnlySpan<MeshletCluster> clusters, const ElemBuildMeshletsOptions* options, ToolsMessageList* messageList);
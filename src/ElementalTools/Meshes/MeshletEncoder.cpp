@@ -0,0 +1,316 @@
+#include "ElementalTools.h"
+#include "ToolsUtils.h"
+#include "SystemMemory.h"
+#include "SystemFunctions.h"
+
+// TODO: Do one for each thread
+static MemoryArena MeshletEncoderMemoryArena;
+static MemoryArena MeshletDecoderMemoryArena;
+
+void InitMeshletEncoderMemoryArena(MemoryArena* memoryArena)
+{
+    if (memoryArena->Storage == nullptr)
+    {
+        *memoryArena = SystemAllocateMemoryArena(512 * 1024 * 1024);
+    }
+
+    SystemClearMemoryArena(*memoryArena);
+}
+
+uint32_t AlignMeshletStreamOffset(uint32_t offset)
+{
+    return (offset + 3) & ~3u;
+}
+
+uint8_t GetMeshletVertexIndexSize(uint32_t vertexIndexRange)
+{
+    if (vertexIndexRange <= UINT8_MAX)
+    {
+        return 1;
+    }
+    else if (vertexIndexRange <= UINT16_MAX)
+    {
+        return 2;
+    }
+
+    return 4;
+}
+
+// NOTE: The streams are compressed with the vertex codec using 4 bytes elements. The streams are padded
+// to 4 bytes so this works for any content. The index codecs cannot be used here because the streams are
+// not triangle lists anymore.
+Span<uint8_t> CompressMeshletStream(ReadOnlySpan<uint8_t> data, uint32_t elementSize)
+{
+    auto elementCount = data.Length / elementSize;
+    auto compressedData = SystemPushArray<uint8_t>(MeshletEncoderMemoryArena, meshopt_encodeVertexBufferBound(elementCount, elementSize));
+    auto compressedSize = meshopt_encodeVertexBuffer(compressedData.Pointer, compressedData.Length, data.Pointer, elementCount, elementSize);
+
+    return compressedData.Slice(0, compressedSize);
+}
+
+bool DecompressMeshletStream(ElemToolsDataSpan compressedData, uint32_t elementSize, uint32_t decodedSize, ElemToolsDataSpan* decodedData)
+{
+    auto data = SystemPushArray<uint8_t>(MeshletDecoderMemoryArena, decodedSize);
+
+    if (decodedSize > 0 && meshopt_decodeVertexBuffer(data.Pointer, decodedSize / elementSize, elementSize, compressedData.Items, compressedData.Length) != 0)
+    {
+        return false;
+    }
+
+    *decodedData = { .Items = data.Pointer, .Length = decodedSize };
+    return true;
+}
+
+bool IsMeshletRangeValid(uint64_t offset, uint64_t count, uint64_t length)
+{
+    return offset <= length && count <= length - offset;
+}
+
+bool ValidateEncodedMeshlets(const ElemEncodeMeshletsResult* result)
+{
+    auto vertexIndexStream = result->MeshletVertexIndexBuffer;
+    auto triangleStream = result->MeshletTriangleIndexBuffer;
+
+    for (uint32_t i = 0; i < result->Meshlets.Length; i++)
+    {
+        auto meshlet = &result->Meshlets.Items[i];
+
+        if (meshlet->VertexIndexCount > result->MeshletMaxVertexCount || meshlet->TriangleCount > result->MeshletMaxTriangleCount)
+        {
+            return false;
+        }
+
+        if (meshlet->VertexIndexSize != 1 && meshlet->VertexIndexSize != 2 && meshlet->VertexIndexSize != 4)
+        {
+            return false;
+        }
+
+        if (!IsMeshletRangeValid(meshlet->VertexIndexOffset, (uint64_t)meshlet->VertexIndexCount * meshlet->VertexIndexSize, vertexIndexStream.Length) ||
+            !IsMeshletRangeValid(meshlet->TriangleOffset, (uint64_t)meshlet->TriangleCount * 3, triangleStream.Length))
+        {
+            return false;
+        }
+
+        auto triangleIndices = &triangleStream.Items[meshlet->TriangleOffset];
+
+        for (uint32_t j = 0; j < (uint32_t)meshlet->TriangleCount * 3; j++)
+        {
+            if (triangleIndices[j] >= meshlet->VertexIndexCount)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+ElemToolsAPI ElemEncodeMeshletsResult ElemEncodeMeshlets(const ElemBuildMeshletResult* meshletResult, const ElemEncodeMeshletsOptions* options)
+{
+    InitMeshletEncoderMemoryArena(&MeshletEncoderMemoryArena);
+
+    ElemEncodeMeshletsOptions encodeOptions = {};
+
+    if (options)
+    {
+        encodeOptions = *options;
+    }
+
+    if (meshletResult == nullptr || meshletResult->HasErrors)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshletEncoderMemoryArena, "Meshlet result is not valid."),
+            .HasErrors = true
+        };
+    }
+
+    auto meshlets = meshletResult->Meshlets;
+    auto vertexIndexBuffer = meshletResult->MeshletVertexIndexBuffer;
+    auto triangleIndexBuffer = meshletResult->MeshletTriangleIndexBuffer;
+
+    auto encodedMeshlets = SystemPushArray<ElemEncodedMeshlet>(MeshletEncoderMemoryArena, meshlets.Length);
+    auto vertexIndexStreamSize = 0u;
+    auto triangleStreamSize = 0u;
+
+    for (uint32_t i = 0; i < meshlets.Length; i++)
+    {
+        auto meshlet = &meshlets.Items[i];
+
+        if (meshlet->VertexIndexCount > meshletResult->MeshletMaxVertexCount || meshlet->TriangleCount > meshletResult->MeshletMaxTriangleCount ||
+            !IsMeshletRangeValid(meshlet->VertexIndexOffset, meshlet->VertexIndexCount, vertexIndexBuffer.Length) ||
+            !IsMeshletRangeValid(meshlet->TriangleOffset, meshlet->TriangleCount, triangleIndexBuffer.Length))
+        {
+            return
+            {
+                .Messages = ConstructErrorMessageSpan(MeshletEncoderMemoryArena, "Meshlet counts or offsets are out of range."),
+                .HasErrors = true
+            };
+        }
+
+        auto minVertexIndex = UINT32_MAX;
+        auto maxVertexIndex = 0u;
+
+        for (uint32_t j = 0; j < meshlet->VertexIndexCount; j++)
+        {
+            auto vertexIndex = vertexIndexBuffer.Items[meshlet->VertexIndexOffset + j];
+
+            minVertexIndex = SystemMin(minVertexIndex, vertexIndex);
+            maxVertexIndex = SystemMax(maxVertexIndex, vertexIndex);
+        }
+
+        auto vertexIndexSize = meshlet->VertexIndexCount > 0 ? GetMeshletVertexIndexSize(maxVertexIndex - minVertexIndex) : (uint8_t)1;
+
+        encodedMeshlets[i] =
+        {
+            .BaseVertex = meshlet->VertexIndexCount > 0 ? minVertexIndex : 0,
+            .VertexIndexOffset = vertexIndexStreamSize,
+            .TriangleOffset = triangleStreamSize,
+            .VertexIndexCount = (uint8_t)meshlet->VertexIndexCount,
+            .TriangleCount = (uint8_t)meshlet->TriangleCount,
+            .VertexIndexSize = vertexIndexSize
+        };
+
+        vertexIndexStreamSize = AlignMeshletStreamOffset(vertexIndexStreamSize + meshlet->VertexIndexCount * vertexIndexSize);
+        triangleStreamSize = AlignMeshletStreamOffset(triangleStreamSize + meshlet->TriangleCount * 3);
+    }
+
+    // NOTE: The shaders read the triangles with 8 bytes loads at 4 bytes aligned offsets, so the last triangle
+    // can read 4 bytes past the end of the stream.
+    triangleStreamSize += sizeof(uint32_t);
+
+    auto vertexIndexStream = SystemPushArrayZero<uint8_t>(MeshletEncoderMemoryArena, vertexIndexStreamSize);
+    auto triangleStream = SystemPushArrayZero<uint8_t>(MeshletEncoderMemoryArena, triangleStreamSize);
+
+    for (uint32_t i = 0; i < meshlets.Length; i++)
+    {
+        auto meshlet = &meshlets.Items[i];
+        auto encodedMeshlet = &encodedMeshlets[i];
+
+        for (uint32_t j = 0; j < meshlet->VertexIndexCount; j++)
+        {
+            auto localVertexIndex = vertexIndexBuffer.Items[meshlet->VertexIndexOffset + j] - encodedMeshlet->BaseVertex;
+            auto destination = &vertexIndexStream[encodedMeshlet->VertexIndexOffset + j * encodedMeshlet->VertexIndexSize];
+
+            switch (encodedMeshlet->VertexIndexSize)
+            {
+                case 1:
+                    *destination = (uint8_t)localVertexIndex;
+                    break;
+
+                case 2:
+                    *(uint16_t*)destination = (uint16_t)localVertexIndex;
+                    break;
+
+                default:
+                    *(uint32_t*)destination = localVertexIndex;
+            }
+        }
+
+        for (uint32_t j = 0; j < meshlet->TriangleCount; j++)
+        {
+            auto packedTriangle = triangleIndexBuffer.Items[meshlet->TriangleOffset + j];
+            auto destination = &triangleStream[encodedMeshlet->TriangleOffset + j * 3];
+
+            destination[0] = packedTriangle & 0xFF;
+            destination[1] = (packedTriangle >> 8) & 0xFF;
+            destination[2] = (packedTriangle >> 16) & 0xFF;
+        }
+    }
+
+    auto vertexBuffer = meshletResult->VertexBuffer;
+    auto vertexCount = vertexBuffer.VertexSize > 0 ? vertexBuffer.Data.Length / vertexBuffer.VertexSize : 0;
+
+    ElemEncodeMeshletsResult result =
+    {
+        .MeshletMaxVertexCount = meshletResult->MeshletMaxVertexCount,
+        .MeshletMaxTriangleCount = meshletResult->MeshletMaxTriangleCount,
+        .Meshlets = { .Items = encodedMeshlets.Pointer, .Length = (uint32_t)encodedMeshlets.Length },
+        .VertexBuffer = vertexBuffer.Data,
+        .MeshletVertexIndexBuffer = { .Items = vertexIndexStream.Pointer, .Length = vertexIndexStreamSize },
+        .MeshletTriangleIndexBuffer = { .Items = triangleStream.Pointer, .Length = triangleStreamSize },
+        .VertexSize = vertexBuffer.VertexSize,
+        .VertexCount = vertexCount,
+        .DecodedMeshletVertexIndexBufferSize = vertexIndexStreamSize,
+        .DecodedMeshletTriangleIndexBufferSize = triangleStreamSize
+    };
+
+    auto sourceSize = vertexBuffer.Data.Length + (vertexIndexBuffer.Length + triangleIndexBuffer.Length) * (uint32_t)sizeof(uint32_t);
+
+    if (encodeOptions.CompressStreams)
+    {
+        if (vertexBuffer.VertexSize % 4 != 0 || vertexBuffer.VertexSize > 256)
+        {
+            return
+            {
+                .Messages = ConstructErrorMessageSpan(MeshletEncoderMemoryArena, "Vertex size must be a multiple of 4 and lower or equal to 256 to be compressed."),
+                .HasErrors = true
+            };
+        }
+
+        auto compressedVertexBuffer = CompressMeshletStream(ReadOnlySpan<uint8_t>(vertexBuffer.Data.Items, vertexBuffer.Data.Length), vertexBuffer.VertexSize);
+        auto compressedVertexIndexStream = CompressMeshletStream(vertexIndexStream, sizeof(uint32_t));
+        auto compressedTriangleStream = CompressMeshletStream(triangleStream, sizeof(uint32_t));
+
+        result.VertexBuffer = { .Items = compressedVertexBuffer.Pointer, .Length = (uint32_t)compressedVertexBuffer.Length };
+        result.MeshletVertexIndexBuffer = { .Items = compressedVertexIndexStream.Pointer, .Length = (uint32_t)compressedVertexIndexStream.Length };
+        result.MeshletTriangleIndexBuffer = { .Items = compressedTriangleStream.Pointer, .Length = (uint32_t)compressedTriangleStream.Length };
+        result.IsCompressed = true;
+    }
+
+    auto encodedSize = result.VertexBuffer.Length + result.MeshletVertexIndexBuffer.Length + result.MeshletTriangleIndexBuffer.Length;
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(MeshletEncoderMemoryArena, 1)
+    };
+
+    WriteToMessageList(ElemToolsMessageType_Information,
+                       SystemFormatString(MeshletEncoderMemoryArena, "Encoded meshlet data: %d bytes (%d bytes before encoding)", encodedSize, sourceSize).Pointer,
+                       &messageList);
+
+    result.Messages = { .Items = messageList.Messages.Pointer, .Length = messageList.MessageCount };
+    return result;
+}
+
+ElemToolsAPI ElemEncodeMeshletsResult ElemDecodeMeshlets(const ElemEncodeMeshletsResult* encodedResult)
+{
+    InitMeshletEncoderMemoryArena(&MeshletDecoderMemoryArena);
+
+    if (encodedResult == nullptr || encodedResult->HasErrors)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshletDecoderMemoryArena, "Encoded meshlet result is not valid."),
+            .HasErrors = true
+        };
+    }
+
+    auto result = *encodedResult;
+    result.Messages = {};
+
+    if (encodedResult->IsCompressed && (!DecompressMeshletStream(encodedResult->VertexBuffer, encodedResult->VertexSize, encodedResult->VertexCount * encodedResult->VertexSize, &result.VertexBuffer) ||
+        !DecompressMeshletStream(encodedResult->MeshletVertexIndexBuffer, sizeof(uint32_t), encodedResult->DecodedMeshletVertexIndexBufferSize, &result.MeshletVertexIndexBuffer) ||
+        !DecompressMeshletStream(encodedResult->MeshletTriangleIndexBuffer, sizeof(uint32_t), encodedResult->DecodedMeshletTriangleIndexBufferSize, &result.MeshletTriangleIndexBuffer)))
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshletDecoderMemoryArena, "Cannot decode the compressed meshlet data."),
+            .HasErrors = true
+        };
+    }
+
+    // NOTE: The meshlet counts and offsets come from the stored data, so they are checked before the streams are indexed
+    // with them. The mesh shaders rely on the counts being within the meshlet limits.
+    if (!ValidateEncodedMeshlets(&result))
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(MeshletDecoderMemoryArena, "Meshlet counts or offsets are out of range of the meshlet streams."),
+            .HasErrors = true
+        };
+    }
+
+    result.IsCompressed = false;
+    return result;
+}
@@ -0,0 +1,523 @@
+#include "MeshletBuilder.h"
+#include "SystemFunctions.h"
+
+#define MESHLET_LOD_MAX_LEVELS 32
+#define MESHLET_LOD_LOCKED_VERTEX (UINT32_MAX - 1)
+
+// NOTE: A group that cannot be reduced by at least this ratio is not simplified. Its meshlets are carried to the next level
+// so their border vertices stay locked, and they only become roots if they are never simplified.
+#define MESHLET_LOD_MIN_REDUCTION_RATIO 0.85f
+
+// TODO: Do one for each thread
+static MemoryArena MeshletLodWorkingMemoryArena;
+
+struct MeshletLodCluster
+{
+    MeshletCluster Cluster;
+    ElemToolsVector4 SelfBounds;
+    float SelfError;
+    ElemToolsVector4 ParentBounds;
+    float ParentError;
+    uint32_t LodLevel;
+};
+
+struct MeshletLodGroupJob
+{
+    ReadOnlySpan<uint32_t> ClusterIndices;
+    Span<MeshletLodCluster> NewClusters;
+};
+
+struct MeshletLodGroupJobPayload
+{
+    Span<MeshletLodCluster*> LevelClusters;
+    Span<MeshletLodGroupJob> Jobs;
+    ReadOnlySpan<uint8_t> VertexLocks;
+    const MeshletVertexData* VertexData;
+    const ElemBuildMeshletsOptions* MeshletOptions;
+    uint32_t LodLevel;
+};
+
+void InitMeshletLodWorkingMemoryArena()
+{
+    if (MeshletLodWorkingMemoryArena.Storage == nullptr)
+    {
+        MeshletLodWorkingMemoryArena = SystemAllocateMemoryArena(2048llu * 1024 * 1024);
+    }
+
+    SystemClearMemoryArena(MeshletLodWorkingMemoryArena);
+}
+
+ElemToolsVector4 MergeBoundingSpheres(ElemToolsVector4 sphere1, ElemToolsVector4 sphere2)
+{
+    auto delta = sphere2.XYZ - sphere1.XYZ;
+    auto distance = ElemToolsMagnitudeV3(delta);
+
+    if (distance + sphere2.W <= sphere1.W)
+    {
+        return sphere1;
+    }
+
+    if (distance + sphere1.W <= sphere2.W)
+    {
+        return sphere2;
+    }
+
+    auto radius = (distance + sphere1.W + sphere2.W) * 0.5f;
+    auto center = sphere1.XYZ + ElemToolsMulScalarV3(delta, (radius - sphere1.W) / distance);
+
+    return { center.X, center.Y, center.Z, radius };
+}
+
+// NOTE: Groups are built greedily by adding the ungrouped meshlet that shares the most vertices with the last added one.
+// This keeps the group borders small so more vertices can be simplified.
+uint32_t GroupMeshletLodClusters(MemoryArena memoryArena, ReadOnlySpan<MeshletLodCluster*> clusters, uint32_t vertexCount, uint32_t groupSize, Span<uint32_t> clusterGroupIds)
+{
+    auto vertexClusterOffsets = SystemPushArrayZero<uint32_t>(memoryArena, vertexCount + 1);
+
+    for (uint32_t i = 0; i < clusters.Length; i++)
+    {
+        for (uint32_t j = 0; j < clusters[i]->Cluster.VertexIndices.Length; j++)
+        {
+            vertexClusterOffsets[clusters[i]->Cluster.VertexIndices[j] + 1]++;
+        }
+    }
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        vertexClusterOffsets[i + 1] += vertexClusterOffsets[i];
+    }
+
+    auto vertexClusterList = SystemPushArray<uint32_t>(memoryArena, vertexClusterOffsets[vertexCount]);
+    auto vertexClusterFillCounts = SystemPushArrayZero<uint32_t>(memoryArena, vertexCount);
+
+    for (uint32_t i = 0; i < clusters.Length; i++)
+    {
+        for (uint32_t j = 0; j < clusters[i]->Cluster.VertexIndices.Length; j++)
+        {
+            auto vertexIndex = clusters[i]->Cluster.VertexIndices[j];
+            vertexClusterList[vertexClusterOffsets[vertexIndex] + vertexClusterFillCounts[vertexIndex]++] = i;
+        }
+    }
+
+    auto sharedVertexCounts = SystemPushArrayZero<uint32_t>(memoryArena, clusters.Length);
+    auto candidateList = SystemPushArray<uint32_t>(memoryArena, clusters.Length);
+    auto groupCount = 0u;
+
+    for (uint32_t i = 0; i < clusters.Length; i++)
+    {
+        clusterGroupIds[i] = UINT32_MAX;
+    }
+
+    for (uint32_t i = 0; i < clusters.Length; i++)
+    {
+        if (clusterGroupIds[i] != UINT32_MAX)
+        {
+            continue;
+        }
+
+        auto groupId = groupCount++;
+        auto lastAddedCluster = i;
+        auto candidateCount = 0u;
+
+        clusterGroupIds[i] = groupId;
+
+        for (uint32_t groupClusterCount = 1; groupClusterCount < groupSize; groupClusterCount++)
+        {
+            auto lastAddedVertices = clusters[lastAddedCluster]->Cluster.VertexIndices;
+
+            for (uint32_t j = 0; j < lastAddedVertices.Length; j++)
+            {
+                auto vertexIndex = lastAddedVertices[j];
+
+                for (uint32_t k = vertexClusterOffsets[vertexIndex]; k < vertexClusterOffsets[vertexIndex + 1]; k++)
+                {
+                    auto candidate = vertexClusterList[k];
+
+                    if (clusterGroupIds[candidate] != UINT32_MAX)
+                    {
+                        continue;
+                    }
+
+                    if (sharedVertexCounts[candidate] == 0)
+                    {
+                        candidateList[candidateCount++] = candidate;
+                    }
+
+                    sharedVertexCounts[candidate]++;
+                }
+            }
+
+            auto bestCandidate = UINT32_MAX;
+            auto bestSharedVertexCount = 0u;
+
+            for (uint32_t j = 0; j < candidateCount; j++)
+            {
+                auto candidate = candidateList[j];
+
+                if (clusterGroupIds[candidate] == UINT32_MAX && sharedVertexCounts[candidate] > bestSharedVertexCount)
+                {
+                    bestCandidate = candidate;
+                    bestSharedVertexCount = sharedVertexCounts[candidate];
+                }
+            }
+
+            if (bestCandidate == UINT32_MAX)
+            {
+                break;
+            }
+
+            clusterGroupIds[bestCandidate] = groupId;
+            lastAddedCluster = bestCandidate;
+        }
+
+        for (uint32_t j = 0; j < candidateCount; j++)
+        {
+            sharedVertexCounts[candidateList[j]] = 0;
+        }
+    }
+
+    return groupCount;
+}
+
+Span<uint8_t> ComputeMeshletLodVertexLocks(MemoryArena memoryArena, ReadOnlySpan<MeshletLodCluster*> clusters, ReadOnlySpan<uint32_t> clusterGroupIds, uint32_t vertexCount)
+{
+    auto vertexGroupIds = SystemPushArray<uint32_t>(memoryArena, vertexCount);
+    auto vertexLocks = SystemPushArray<uint8_t>(memoryArena, vertexCount);
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        vertexGroupIds[i] = UINT32_MAX;
+    }
+
+    for (uint32_t i = 0; i < clusters.Length; i++)
+    {
+        for (uint32_t j = 0; j < clusters[i]->Cluster.VertexIndices.Length; j++)
+        {
+            auto vertexIndex = clusters[i]->Cluster.VertexIndices[j];
+
+            if (vertexGroupIds[vertexIndex] == UINT32_MAX)
+            {
+                vertexGroupIds[vertexIndex] = clusterGroupIds[i];
+            }
+            else if (vertexGroupIds[vertexIndex] != clusterGroupIds[i])
+            {
+                vertexGroupIds[vertexIndex] = MESHLET_LOD_LOCKED_VERTEX;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        vertexLocks[i] = vertexGroupIds[i] == MESHLET_LOD_LOCKED_VERTEX;
+    }
+
+    return vertexLocks;
+}
+
+void BuildMeshletLodGroupJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (MeshletLodGroupJobPayload*)payload;
+    auto job = &jobPayload->Jobs[index];
+    auto vertexData = jobPayload->VertexData;
+
+    auto groupIndexCount = 0u;
+
+    for (uint32_t i = 0; i < job->ClusterIndices.Length; i++)
+    {
+        groupIndexCount += jobPayload->LevelClusters[job->ClusterIndices[i]]->Cluster.TriangleCount * 3;
+    }
+
+    auto groupIndices = SystemPushArray<uint32_t>(MeshletLodWorkingMemoryArena, groupIndexCount);
+    auto currentIndex = 0u;
+
+    for (uint32_t i = 0; i < job->ClusterIndices.Length; i++)
+    {
+        auto cluster = &jobPayload->LevelClusters[job->ClusterIndices[i]]->Cluster;
+
+        for (uint32_t j = 0; j < cluster->TriangleCount * 3; j++)
+        {
+            groupIndices[currentIndex++] = cluster->VertexIndices[cluster->TriangleIndices[j]];
+        }
+    }
+
+    auto simplifiedIndices = SystemPushArray<uint32_t>(MeshletLodWorkingMemoryArena, groupIndexCount);
+    auto targetIndexCount = (groupIndexCount / 3 / 2) * 3;
+    auto simplifyError = 0.0f;
+
+    auto simplifiedIndexCount = (uint32_t)meshopt_simplifyWithAttributes(simplifiedIndices.Pointer,
+                                                                         groupIndices.Pointer,
+                                                                         groupIndexCount,
+                                                                         vertexData->VertexPositions,
+                                                                         vertexData->VertexCount,
+                                                                         vertexData->VertexPositionStride,
+                                                                         nullptr,
+                                                                         0,
+                                                                         nullptr,
+                                                                         0,
+                                                                         jobPayload->VertexLocks.Pointer,
+                                                                         targetIndexCount,
+                                                                         FLT_MAX,
+                                                                         meshopt_SimplifySparse | meshopt_SimplifyErrorAbsolute,
+                                                                         &simplifyError);
+
+    if (simplifiedIndexCount == 0 || simplifiedIndexCount > groupIndexCount * MESHLET_LOD_MIN_REDUCTION_RATIO)
+    {
+        job->NewClusters = {};
+        return;
+    }
+
+    auto groupBounds = jobPayload->LevelClusters[job->ClusterIndices[0]]->SelfBounds;
+    auto maxChildError = 0.0f;
+
+    for (uint32_t i = 0; i < job->ClusterIndices.Length; i++)
+    {
+        auto cluster = jobPayload->LevelClusters[job->ClusterIndices[i]];
+
+        groupBounds = MergeBoundingSpheres(groupBounds, cluster->SelfBounds);
+        maxChildError = SystemMax(maxChildError, cluster->SelfError);
+    }
+
+    // NOTE: The error is accumulated so that it is monotonic along the hierarchy.
+    auto groupError = maxChildError + simplifyError;
+
+    for (uint32_t i = 0; i < job->ClusterIndices.Length; i++)
+    {
+        auto cluster = jobPayload->LevelClusters[job->ClusterIndices[i]];
+
+        cluster->ParentBounds = groupBounds;
+        cluster->ParentError = groupError;
+    }
+
+    auto newClusters = BuildMeshletClusters(MeshletLodWorkingMemoryArena, simplifiedIndices.Slice(0, simplifiedIndexCount), vertexData, jobPayload->MeshletOptions);
+    job->NewClusters = SystemPushArray<MeshletLodCluster>(MeshletLodWorkingMemoryArena, newClusters.Length);
+
+    for (uint32_t i = 0; i < newClusters.Length; i++)
+    {
+        job->NewClusters[i] =
+        {
+            .Cluster = newClusters[i],
+            .SelfBounds = groupBounds,
+            .SelfError = groupError,
+            .ParentError = FLT_MAX,
+            .LodLevel = jobPayload->LodLevel
+        };
+    }
+}
+
+ElemToolsAPI ElemBuildMeshletResult ElemBuildMeshletLodHierarchy(ElemVertexBuffer vertexBuffer, ElemUInt32Span indexBuffer, const ElemBuildMeshletLodHierarchyOptions* options)
+{
+    InitMeshletBuilderMemoryArena();
+    InitMeshletLodWorkingMemoryArena();
+
+    auto meshletBuilderMemoryArena = GetMeshletBuilderMemoryArena();
+    ElemBuildMeshletLodHierarchyOptions lodOptions = {};
+
+    if (options)
+    {
+        lodOptions = *options;
+    }
+
+    if (lodOptions.GroupSize == 0)
+    {
+        lodOptions.GroupSize = 8;
+    }
+
+    if (lodOptions.MaxLodLevelCount == 0)
+    {
+        lodOptions.MaxLodLevelCount = 16;
+    }
+
+    ElemBuildMeshletsOptions meshletOptions;
+    auto errorMessage = ResolveBuildMeshletsOptions(&lodOptions.MeshletOptions, &meshletOptions);
+
+    if (!errorMessage && lodOptions.MaxLodLevelCount > MESHLET_LOD_MAX_LEVELS)
+    {
+        errorMessage = "Max LOD level count must be lower or equal to 32.";
+    }
+
+    if (errorMessage)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(meshletBuilderMemoryArena, errorMessage),
+            .HasErrors = true
+        };
+    }
+
+    auto vertexData = PrepareMeshletVertexData(MeshletLodWorkingMemoryArena, vertexBuffer, indexBuffer);
+    auto baseClusters = BuildMeshletClusters(MeshletLodWorkingMemoryArena, vertexData.IndexList, &vertexData, &meshletOptions);
+
+    Span<MeshletLodCluster> levels[MESHLET_LOD_MAX_LEVELS];
+    levels[0] = SystemPushArray<MeshletLodCluster>(MeshletLodWorkingMemoryArena, baseClusters.Length);
+
+    for (uint32_t i = 0; i < baseClusters.Length; i++)
+    {
+        auto cluster = baseClusters[i];
+        auto bounds = meshopt_computeMeshletBounds(cluster.VertexIndices.Pointer, cluster.TriangleIndices.Pointer, cluster.TriangleCount, vertexData.VertexPositions, vertexData.VertexCount, vertexData.VertexPositionStride);
+
+        levels[0][i] =
+        {
+            .Cluster = cluster,
+            .SelfBounds = { bounds.center[0], bounds.center[1], bounds.center[2], bounds.radius },
+            .SelfError = 0.0f,
+            .ParentError = FLT_MAX,
+            .LodLevel = 0
+        };
+    }
+
+    auto levelClusters = SystemPushArray<MeshletLodCluster*>(MeshletLodWorkingMemoryArena, levels[0].Length);
+
+    for (uint32_t i = 0; i < levels[0].Length; i++)
+    {
+        levelClusters[i] = &levels[0][i];
+    }
+
+    auto levelCount = 1u;
+
+    while (levelCount < lodOptions.MaxLodLevelCount && levelClusters.Length > 1)
+    {
+        auto clusterGroupIds = SystemPushArray<uint32_t>(MeshletLodWorkingMemoryArena, levelClusters.Length);
+        auto groupCount = GroupMeshletLodClusters(MeshletLodWorkingMemoryArena, levelClusters, vertexData.VertexCount, lodOptions.GroupSize, clusterGroupIds);
+        auto vertexLocks = ComputeMeshletLodVertexLocks(MeshletLodWorkingMemoryArena, levelClusters, clusterGroupIds, vertexData.VertexCount);
+
+        auto groupOffsets = SystemPushArrayZero<uint32_t>(MeshletLodWorkingMemoryArena, groupCount + 1);
+        auto groupClusterIndices = SystemPushArray<uint32_t>(MeshletLodWorkingMemoryArena, levelClusters.Length);
+        auto groupFillCounts = SystemPushArrayZero<uint32_t>(MeshletLodWorkingMemoryArena, groupCount);
+
+        for (uint32_t i = 0; i < levelClusters.Length; i++)
+        {
+            groupOffsets[clusterGroupIds[i] + 1]++;
+        }
+
+        for (uint32_t i = 0; i < groupCount; i++)
+        {
+            groupOffsets[i + 1] += groupOffsets[i];
+        }
+
+        for (uint32_t i = 0; i < levelClusters.Length; i++)
+        {
+            auto groupId = clusterGroupIds[i];
+            groupClusterIndices[groupOffsets[groupId] + groupFillCounts[groupId]++] = i;
+        }
+
+        auto jobs = SystemPushArray<MeshletLodGroupJob>(MeshletLodWorkingMemoryArena, groupCount);
+
+        for (uint32_t i = 0; i < groupCount; i++)
+        {
+            jobs[i] = { .ClusterIndices = groupClusterIndices.Slice(groupOffsets[i], groupOffsets[i + 1] - groupOffsets[i]) };
+        }
+
+        MeshletLodGroupJobPayload payload =
+        {
+            .LevelClusters = levelClusters,
+            .Jobs = jobs,
+            .VertexLocks = vertexLocks,
+            .VertexData = &vertexData,
+            .MeshletOptions = &meshletOptions,
+            .LodLevel = levelCount
+        };
+
+        ToolsParallelFor(groupCount, BuildMeshletLodGroupJob, &payload);
+
+        auto newClusterCount = 0u;
+        auto carriedClusterCount = 0u;
+
+        for (uint32_t i = 0; i < groupCount; i++)
+        {
+            newClusterCount += jobs[i].NewClusters.Length;
+
+            if (jobs[i].NewClusters.Length == 0)
+            {
+                carriedClusterCount += jobs[i].ClusterIndices.Length;
+            }
+        }
+
+        if (newClusterCount == 0)
+        {
+            break;
+        }
+
+        auto newClusters = SystemPushArray<MeshletLodCluster>(MeshletLodWorkingMemoryArena, newClusterCount);
+        auto currentCluster = 0u;
+
+        for (uint32_t i = 0; i < groupCount; i++)
+        {
+            SystemCopyBuffer(newClusters.Slice(currentCluster), ReadOnlySpan<MeshletLodCluster>(jobs[i].NewClusters));
+            currentCluster += jobs[i].NewClusters.Length;
+        }
+
+        auto nextLevelClusters = SystemPushArray<MeshletLodCluster*>(MeshletLodWorkingMemoryArena, carriedClusterCount + newClusterCount);
+        auto currentNextLevelCluster = 0u;
+
+        for (uint32_t i = 0; i < groupCount; i++)
+        {
+            if (jobs[i].NewClusters.Length > 0)
+            {
+                continue;
+            }
+
+            for (uint32_t j = 0; j < jobs[i].ClusterIndices.Length; j++)
+            {
+                nextLevelClusters[currentNextLevelCluster++] = levelClusters[jobs[i].ClusterIndices[j]];
+            }
+        }
+
+        for (uint32_t i = 0; i < newClusterCount; i++)
+        {
+            nextLevelClusters[currentNextLevelCluster++] = &newClusters[i];
+        }
+
+        levels[levelCount++] = newClusters;
+        levelClusters = nextLevelClusters;
+    }
+
+    auto totalClusterCount = 0u;
+
+    for (uint32_t i = 0; i < levelCount; i++)
+    {
+        totalClusterCount += levels[i].Length;
+    }
+
+    auto clusters = SystemPushArray<MeshletCluster>(MeshletLodWorkingMemoryArena, totalClusterCount);
+    auto meshletLods = SystemPushArray<ElemMeshletLodInfo>(meshletBuilderMemoryArena, totalClusterCount);
+    auto currentCluster = 0u;
+
+    for (uint32_t i = 0; i < levelCount; i++)
+    {
+        for (uint32_t j = 0; j < levels[i].Length; j++)
+        {
+            auto lodCluster = &levels[i][j];
+
+            clusters[currentCluster] = lodCluster->Cluster;
+            meshletLods[currentCluster] =
+            {
+                .SelfSphereCenter = lodCluster->SelfBounds.XYZ,
+                .SelfSphereRadius = lodCluster->SelfBounds.W,
+                .SelfError = lodCluster->SelfError,
+                .ParentSphereCenter = lodCluster->ParentBounds.XYZ,
+                .ParentSphereRadius = lodCluster->ParentBounds.W,
+                .ParentError = lodCluster->ParentError,
+                .LodLevel = lodCluster->LodLevel
+            };
+
+            currentCluster++;
+        }
+    }
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(meshletBuilderMemoryArena, 2)
+    };
+
+    auto result = ConstructBuildMeshletResult(vertexBuffer, &vertexData, clusters, &meshletOptions, &messageList);
+
+    WriteToMessageList(ElemToolsMessageType_Information,
+                       SystemFormatString(meshletBuilderMemoryArena, "LOD levels: %d (%d meshlets at level 0, %d meshlets at level %d)", levelCount, (int32_t)levels[0].Length, (int32_t)levels[levelCount - 1].Length, levelCount - 1).Pointer,
+                       &messageList);
+
+    result.MeshletLods = { .Items = meshletLods.Pointer, .Length = (uint32_t)meshletLods.Length };
+    result.LodLevelCount = levelCount;
+    result.Messages = { .Items = messageList.Messages.Pointer, .Length = messageList.MessageCount };
+
+    return result;
+}
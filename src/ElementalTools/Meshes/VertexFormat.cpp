@@ -0,0 +1,163 @@
+#include "VertexFormat.h"
+#include "ToolsUtils.h"
+#include "SystemFunctions.h"
+
+ElemToolsVector2 EncodeOctahedral(ElemToolsVector3 vector)
+{
+    auto length = fabsf(vector.X) + fabsf(vector.Y) + fabsf(vector.Z);
+
+    if (length == 0.0f)
+    {
+        return { 0.0f, 0.0f };
+    }
+
+    ElemToolsVector2 result = { vector.X / length, vector.Y / length };
+
+    if (vector.Z < 0.0f)
+    {
+        auto x = result.X;
+
+        result.X = (1.0f - fabsf(result.Y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        result.Y = (1.0f - fabsf(x)) * (result.Y >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    return result;
+}
+
+uint16_t QuantizeUnorm16(float value, float minValue, float maxValue)
+{
+    auto extent = maxValue - minValue;
+
+    if (extent <= 0.0f)
+    {
+        return 0;
+    }
+
+    return (uint16_t)meshopt_quantizeUnorm((value - minValue) / extent, 16);
+}
+
+float DequantizeUnorm16(uint16_t value, float minValue, float maxValue)
+{
+    return minValue + ((float)value / 65535.0f) * (maxValue - minValue);
+}
+
+float DequantizeHalf(uint16_t value)
+{
+    auto exponent = (value >> 10) & 0x1f;
+    auto mantissa = value & 0x3ff;
+    auto sign = (value & 0x8000) ? -1.0f : 1.0f;
+
+    if (exponent == 0)
+    {
+        return sign * ldexpf((float)mantissa, -24);
+    }
+    else if (exponent == 31)
+    {
+        return mantissa ? NAN : sign * INFINITY;
+    }
+
+    return sign * ldexpf((float)(mantissa + 1024), exponent - 25);
+}
+
+uint32_t GetVertexFormatSize(ElemVertexFormat format)
+{
+    switch (format)
+    {
+        case ElemVertexFormat_CompactUnorm16:
+        case ElemVertexFormat_CompactHalf:
+            return sizeof(CompactVertex);
+
+        default:
+            return sizeof(Float32Vertex);
+    }
+}
+
+ElemVertexBuffer ConvertVertexBufferFormat(MemoryArena memoryArena, ElemVertexBuffer vertexBuffer, ElemVertexFormat format, const ElemToolsBoundingBox* positionBounds)
+{
+    SystemAssert(vertexBuffer.Format == ElemVertexFormat_Float32);
+
+    if (format == ElemVertexFormat_Float32 || vertexBuffer.VertexCount == 0)
+    {
+        return vertexBuffer;
+    }
+
+    SystemAssert(vertexBuffer.VertexSize == sizeof(Float32Vertex));
+
+    auto vertexCount = vertexBuffer.VertexCount;
+    auto sourceVertices = (const Float32Vertex*)vertexBuffer.Data.Items;
+    auto destinationVertices = SystemPushArray<CompactVertex>(memoryArena, vertexCount);
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        auto source = &sourceVertices[i];
+        auto destination = &destinationVertices[i];
+
+        if (format == ElemVertexFormat_CompactUnorm16)
+        {
+            destination->Position[0] = QuantizeUnorm16(source->Position.X, positionBounds->MinPoint.X, positionBounds->MaxPoint.X);
+            destination->Position[1] = QuantizeUnorm16(source->Position.Y, positionBounds->MinPoint.Y, positionBounds->MaxPoint.Y);
+            destination->Position[2] = QuantizeUnorm16(source->Position.Z, positionBounds->MinPoint.Z, positionBounds->MaxPoint.Z);
+            destination->Position[3] = source->Tangent.W < 0.0f ? 0 : UINT16_MAX;
+        }
+        else
+        {
+            destination->Position[0] = meshopt_quantizeHalf(source->Position.X);
+            destination->Position[1] = meshopt_quantizeHalf(source->Position.Y);
+            destination->Position[2] = meshopt_quantizeHalf(source->Position.Z);
+            destination->Position[3] = meshopt_quantizeHalf(source->Tangent.W < 0.0f ? -1.0f : 1.0f);
+        }
+
+        auto normal = EncodeOctahedral(source->Normal);
+        destination->Normal[0] = (int16_t)meshopt_quantizeSnorm(normal.X, 16);
+        destination->Normal[1] = (int16_t)meshopt_quantizeSnorm(normal.Y, 16);
+
+        auto tangent = EncodeOctahedral(source->Tangent.XYZ);
+        destination->Tangent[0] = (int16_t)meshopt_quantizeSnorm(tangent.X, 16);
+        destination->Tangent[1] = (int16_t)meshopt_quantizeSnorm(tangent.Y, 16);
+
+        destination->TextureCoordinates[0] = meshopt_quantizeHalf(source->TextureCoordinates.X);
+        destination->TextureCoordinates[1] = meshopt_quantizeHalf(source->TextureCoordinates.Y);
+    }
+
+    return 
+    {
+        .Data = { .Items = (uint8_t*)destinationVertices.Pointer, .Length = (uint32_t)(destinationVertices.Length * sizeof(CompactVertex)) },
+        .VertexSize = sizeof(CompactVertex),
+        .VertexCount = vertexCount,
+        .Format = format,
+        .PositionBounds = *positionBounds
+    };
+}
+
+void DecodeVertexBufferPositions(ElemVertexBuffer vertexBuffer, Span<ElemToolsVector3> positions)
+{
+    auto vertexCount = vertexBuffer.Data.Length / vertexBuffer.VertexSize;
+    SystemAssert(positions.Length >= vertexCount);
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        auto vertexData = vertexBuffer.Data.Items + i * vertexBuffer.VertexSize;
+
+        if (vertexBuffer.Format == ElemVertexFormat_CompactUnorm16)
+        {
+            auto position = (const uint16_t*)vertexData;
+            auto bounds = &vertexBuffer.PositionBounds;
+
+            positions[i] = 
+            {
+                DequantizeUnorm16(position[0], bounds->MinPoint.X, bounds->MaxPoint.X),
+                DequantizeUnorm16(position[1], bounds->MinPoint.Y, bounds->MaxPoint.Y),
+                DequantizeUnorm16(position[2], bounds->MinPoint.Z, bounds->MaxPoint.Z)
+            };
+        }
+        else if (vertexBuffer.Format == ElemVertexFormat_CompactHalf)
+        {
+            auto position = (const uint16_t*)vertexData;
+            positions[i] = { DequantizeHalf(position[0]), DequantizeHalf(position[1]), DequantizeHalf(position[2]) };
+        }
+        else
+        {
+            positions[i] = *(const ElemToolsVector3*)vertexData;
+        }
+    }
+}
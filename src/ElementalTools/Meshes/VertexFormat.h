@@ -0,0 +1,27 @@
+#pragma once
+
+#include "ElementalTools.h"
+#include "SystemMemory.h"
+
+struct Float32Vertex
+{
+    ElemToolsVector3 Position;
+    ElemToolsVector3 Normal;
+    ElemToolsVector4 Tangent;
+    ElemToolsVector2 TextureCoordinates;
+};
+
+struct CompactVertex
+{
+    uint16_t Position[4];
+    int16_t Normal[2];
+    int16_t Tangent[2];
+    uint16_t TextureCoordinates[2];
+};
+
+float DequantizeHalf(uint16_t value);
+uint32_t GetVertexFormatSize(ElemVertexFormat format);
+
+// NOTE: The source vertex buffer must use the Float32 format.
+ElemVertexBuffer ConvertVertexBufferFormat(MemoryArena memoryArena, ElemVertexBuffer vertexBuffer, ElemVertexFormat format, const ElemToolsBoundingBox* positionBounds);
+void DecodeVertexBufferPositions(ElemVertexBuffer vertexBuffer, Span<ElemToolsVector3> positions);
@@ -37,6 +37,7 @@
 #include "dxcapi.h"
 #include "d3d12shader.h"
 
+#include <xxh3.h>
 #include "meshoptimizer.h"
 #include "fast_obj.h"
 #include "cgltf.h"
@@ -37,6 +37,7 @@ using namespace Microsoft::WRL;
 
 #include "metal_irconverter/metal_irconverter.h"
 
+#include <xxh3.h>
 #include "meshoptimizer.h"
 #include "fast_obj.h"
 #include "cgltf.h"
@@ -0,0 +1,172 @@
+#include "ElementalTools.h"
+#include "ToolsUtils.h"
+#include "SystemMemory.h"
+#include "SystemFunctions.h"
+#include "SystemPlatformFunctions.h"
+
+// NOTE: The layout must match the reader in Elemental (Common/Scenes/SceneContainer.cpp)
+#define SCENE_CONTAINER_VERSION 1
+
+struct SceneContainerHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t SectionCount;
+    uint32_t SectionAlignment;
+    uint32_t Reserved;
+    uint64_t SizeInBytes;
+};
+
+struct SceneContainerTableEntry
+{
+    uint32_t Id;
+    uint32_t ElementSize;
+    uint32_t ElementCount;
+    uint32_t Reserved;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+// TODO: Do one for each thread
+static MemoryArena SceneContainerMemoryArena;
+
+void InitSceneContainerMemoryArena()
+{
+    if (SceneContainerMemoryArena.Storage == nullptr)
+    {
+        SceneContainerMemoryArena = SystemAllocateMemoryArena(1024 * 1024 * 1024);
+    }
+
+    SystemClearMemoryArena(SceneContainerMemoryArena);
+}
+
+uint64_t AlignSceneContainerOffset(uint64_t offset, uint32_t alignment)
+{
+    return (offset + alignment - 1) & ~((uint64_t)alignment - 1);
+}
+
+ElemToolsAPI ElemBuildSceneContainerResult ElemBuildSceneContainer(ElemSceneContainerSectionDataSpan sections, const ElemBuildSceneContainerOptions* options)
+{
+    InitSceneContainerMemoryArena();
+
+    ElemBuildSceneContainerOptions containerOptions = {};
+
+    if (options)
+    {
+        containerOptions = *options;
+    }
+
+    if (containerOptions.SectionAlignment == 0)
+    {
+        containerOptions.SectionAlignment = 64;
+    }
+
+    if ((containerOptions.SectionAlignment & (containerOptions.SectionAlignment - 1)) != 0)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(SceneContainerMemoryArena, "Section alignment must be a power of 2."),
+            .HasErrors = true
+        };
+    }
+
+    auto tableEntries = SystemPushArrayZero<SceneContainerTableEntry>(SceneContainerMemoryArena, sections.Length);
+    auto currentOffset = AlignSceneContainerOffset(sizeof(SceneContainerHeader) + sections.Length * sizeof(SceneContainerTableEntry), containerOptions.SectionAlignment);
+
+    for (uint32_t i = 0; i < sections.Length; i++)
+    {
+        auto section = &sections.Items[i];
+
+        for (uint32_t j = 0; j < i; j++)
+        {
+            if (sections.Items[j].Id == section->Id)
+            {
+                return
+                {
+                    .Messages = ConstructErrorMessageSpan(SceneContainerMemoryArena, SystemFormatString(SceneContainerMemoryArena, "Section id %u is used more than once.", section->Id).Pointer),
+                    .HasErrors = true
+                };
+            }
+        }
+
+        if (section->ElementSize > 0 && section->Data.Length % section->ElementSize != 0)
+        {
+            return
+            {
+                .Messages = ConstructErrorMessageSpan(SceneContainerMemoryArena, SystemFormatString(SceneContainerMemoryArena, "Section %u size is not a multiple of its element size.", section->Id).Pointer),
+                .HasErrors = true
+            };
+        }
+
+        tableEntries[i] =
+        {
+            .Id = section->Id,
+            .ElementSize = section->ElementSize,
+            .ElementCount = section->ElementSize > 0 ? section->Data.Length / section->ElementSize : section->Data.Length,
+            .Offset = currentOffset,
+            .SizeInBytes = section->Data.Length
+        };
+
+        currentOffset = AlignSceneContainerOffset(currentOffset + section->Data.Length, containerOptions.SectionAlignment);
+    }
+
+    // NOTE: The result data span stores a 32-bit length.
+    if (currentOffset > UINT32_MAX)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(SceneContainerMemoryArena, SystemFormatString(SceneContainerMemoryArena, "Scene container size (%llu bytes) exceeds the 4 GB limit.", (unsigned long long)currentOffset).Pointer),
+            .HasErrors = true
+        };
+    }
+
+    auto containerData = SystemPushArray<uint8_t>(SceneContainerMemoryArena, currentOffset);
+
+    if (containerData.Pointer == nullptr)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(SceneContainerMemoryArena, "Not enough memory to build the scene container."),
+            .HasErrors = true
+        };
+    }
+
+    SystemPlatformClearMemory(containerData.Pointer, containerData.Length);
+
+    SceneContainerHeader header =
+    {
+        .FileId = { 'E', 'L', 'E', 'M', 'S', 'C', 'N', 'E' },
+        .Version = SCENE_CONTAINER_VERSION,
+        .SectionCount = sections.Length,
+        .SectionAlignment = containerOptions.SectionAlignment,
+        .SizeInBytes = currentOffset
+    };
+
+    SystemCopyBuffer<uint8_t>(containerData, ReadOnlySpan<uint8_t>((uint8_t*)&header, sizeof(SceneContainerHeader)));
+    SystemCopyBuffer<uint8_t>(containerData.Slice(sizeof(SceneContainerHeader)), ReadOnlySpan<uint8_t>((uint8_t*)tableEntries.Pointer, tableEntries.Length * sizeof(SceneContainerTableEntry)));
+
+    for (uint32_t i = 0; i < sections.Length; i++)
+    {
+        auto section = &sections.Items[i];
+
+        if (section->Data.Length > 0)
+        {
+            SystemCopyBuffer<uint8_t>(containerData.Slice(tableEntries[i].Offset), ReadOnlySpan<uint8_t>(section->Data.Items, section->Data.Length));
+        }
+    }
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(SceneContainerMemoryArena, 1)
+    };
+
+    WriteToMessageList(ElemToolsMessageType_Information,
+                       SystemFormatString(SceneContainerMemoryArena, "Scene container: %u sections, %llu bytes", sections.Length, (unsigned long long)currentOffset).Pointer,
+                       &messageList);
+
+    return
+    {
+        .Data = { .Items = containerData.Pointer, .Length = (uint32_t)containerData.Length },
+        .Messages = { .Items = messageList.Messages.Pointer, .Length = messageList.MessageCount }
+    };
+}
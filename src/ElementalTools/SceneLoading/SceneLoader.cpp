@@ -1,4 +1,5 @@
 #include "SceneLoader.h"
+#include "../Meshes/VertexFormat.h"
 #include "SceneLoaderObj.cpp"
 #include "SceneLoaderGltf.cpp"
 
@@ -58,6 +59,57 @@ ElemSceneFormat GetSceneFormatFromPath(const char* path)
     return ElemSceneFormat_Unknown;
 }
 
+struct VertexFormatConversionJobPayload
+{
+    Span<ElemSceneMeshPrimitive*> MeshPrimitives;
+    ElemVertexFormat VertexFormat;
+};
+
+void ConvertMeshPrimitiveVertexFormatJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (VertexFormatConversionJobPayload*)payload;
+    auto meshPrimitive = jobPayload->MeshPrimitives[index];
+
+    meshPrimitive->VertexBuffer = ConvertVertexBufferFormat(SceneLoaderMemoryArena, meshPrimitive->VertexBuffer, jobPayload->VertexFormat, &meshPrimitive->BoundingBox);
+}
+
+void ConvertSceneVertexFormat(ElemLoadSceneResult* sceneResult, ElemVertexFormat vertexFormat)
+{
+    if (sceneResult->HasErrors || vertexFormat == ElemVertexFormat_Float32)
+    {
+        return;
+    }
+
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto meshPrimitiveCount = 0u;
+
+    for (uint32_t i = 0; i < sceneResult->Meshes.Length; i++)
+    {
+        meshPrimitiveCount += sceneResult->Meshes.Items[i].MeshPrimitives.Length;
+    }
+
+    auto meshPrimitives = SystemPushArray<ElemSceneMeshPrimitive*>(stackMemoryArena, meshPrimitiveCount);
+    auto currentIndex = 0u;
+
+    for (uint32_t i = 0; i < sceneResult->Meshes.Length; i++)
+    {
+        auto mesh = &sceneResult->Meshes.Items[i];
+
+        for (uint32_t j = 0; j < mesh->MeshPrimitives.Length; j++)
+        {
+            meshPrimitives[currentIndex++] = &mesh->MeshPrimitives.Items[j];
+        }
+    }
+
+    VertexFormatConversionJobPayload payload =
+    {
+        .MeshPrimitives = meshPrimitives,
+        .VertexFormat = vertexFormat
+    };
+
+    ToolsParallelFor(meshPrimitiveCount, ConvertMeshPrimitiveVertexFormatJob, &payload);
+}
+
 ElemToolsAPI ElemLoadSceneResult ElemLoadScene(const char* path, const ElemLoadSceneOptions* options)
 {
     InitSceneLoaderMemoryArena();
@@ -75,15 +127,18 @@ ElemToolsAPI ElemLoadSceneResult ElemLoadScene(const char* path, const ElemLoadS
     }
 
     auto sceneFormat = GetSceneFormatFromPath(path);
+    ElemLoadSceneResult result = {};
 
     // TODO: Refactor that with array entries and function pointer
     switch (sceneFormat)
     {
         case ElemSceneFormat_Obj:
-            return LoadObjScene(path, &loadSceneOptions);
+            result = LoadObjScene(path, &loadSceneOptions);
+            break;
 
         case ElemSceneFormat_Gltf:
-            return LoadGltfScene(path, &loadSceneOptions);
+            result = LoadGltfScene(path, &loadSceneOptions);
+            break;
 
         default:
             return
@@ -92,4 +147,7 @@ ElemToolsAPI ElemLoadSceneResult ElemLoadScene(const char* path, const ElemLoadS
                 .HasErrors = true
             };
     };
+
+    ConvertSceneVertexFormat(&result, loadSceneOptions.VertexFormat);
+    return result;
 }
@@ -3,6 +3,7 @@
 #include "ElementalTools.h"
 #include "SystemMemory.h"
 #include "SystemFunctions.h"
+#include "SystemPlatformFunctions.h"
 
 cgltf_result ClgtfFileRead(const struct cgltf_memory_options* memory_options, const struct cgltf_file_options* file_options, const char* path, cgltf_size* size, void** data)
 {
@@ -150,23 +151,58 @@ ElemUInt32Span ConstructGltfIndexBuffer(MemoryArena memoryArena, const cgltf_pri
     return { .Items = indexBuffer.Pointer, .Length = (uint32_t)indexBuffer.Length }; 
 }
 
+struct GltfMeshPrimitiveJob
+{
+    const cgltf_primitive* GltfPrimitive;
+    ElemSceneMeshPrimitive* MeshPrimitive;
+};
+
+struct GltfMeshPrimitiveJobPayload
+{
+    MemoryArena MemoryArena;
+    ReadOnlySpan<GltfMeshPrimitiveJob> Jobs;
+    ElemSceneCoordinateSystem CoordinateSystem;
+};
+
+void ConstructGltfMeshPrimitiveJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (GltfMeshPrimitiveJobPayload*)payload;
+    auto job = &jobPayload->Jobs[index];
+    auto meshPrimitive = job->MeshPrimitive;
+
+    meshPrimitive->BoundingBox = 
+    { 
+        .MinPoint = { FLT_MAX, FLT_MAX, FLT_MAX }, 
+        .MaxPoint = { -FLT_MAX, -FLT_MAX, -FLT_MAX } 
+    }; 
+
+    meshPrimitive->VertexBuffer = ConstructGltfVertexBuffer(jobPayload->MemoryArena, job->GltfPrimitive, jobPayload->CoordinateSystem, &meshPrimitive->BoundingBox);
+    meshPrimitive->IndexBuffer = ConstructGltfIndexBuffer(jobPayload->MemoryArena, job->GltfPrimitive, jobPayload->CoordinateSystem);
+}
+
 ReadOnlySpan<ElemSceneMesh> LoadGltfMeshes(MemoryArena memoryArena, const cgltf_data* data, const ElemLoadSceneOptions* options, ToolsMessageList* messageList)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
     auto meshes = SystemPushArray<ElemSceneMesh>(memoryArena, data->meshes_count);
 
+    auto totalPrimitiveCount = 0u;
+
+    for (uint32_t i = 0; i < data->meshes_count; i++)
+    {
+        totalPrimitiveCount += data->meshes[i].primitives_count;
+    }
+
+    auto jobs = SystemPushArray<GltfMeshPrimitiveJob>(stackMemoryArena, totalPrimitiveCount);
+    auto jobCount = 0u;
+
+    // NOTE: First pass, we validate the primitives and collect the work so that the vertex
+    // buffers of all the meshes can be built in parallel.
     for (uint32_t i = 0; i < data->meshes_count; i++)
     {
         auto mesh = &meshes[i];
         auto gltfMesh = &data->meshes[i];
 
-        mesh->BoundingBox = 
-        { 
-            .MinPoint = { FLT_MAX, FLT_MAX, FLT_MAX }, 
-            .MaxPoint = { -FLT_MAX, -FLT_MAX, -FLT_MAX } 
-        }; 
-        
-        auto meshPrimitives = SystemPushArray<ElemSceneMeshPrimitive>(memoryArena, gltfMesh->primitives_count);
+        auto meshPrimitives = SystemPushArrayZero<ElemSceneMeshPrimitive>(memoryArena, gltfMesh->primitives_count);
 
         for (uint32_t j = 0; j < gltfMesh->primitives_count; j++)
         {
@@ -185,18 +221,8 @@ ReadOnlySpan<ElemSceneMesh> LoadGltfMeshes(MemoryArena memoryArena, const cgltf_
                 continue;
             }
 
-            meshPrimitive->BoundingBox = 
-            { 
-                .MinPoint = { FLT_MAX, FLT_MAX, FLT_MAX }, 
-                .MaxPoint = { -FLT_MAX, -FLT_MAX, -FLT_MAX } 
-            }; 
-
-            meshPrimitive->VertexBuffer = ConstructGltfVertexBuffer(memoryArena, gltfPrimitive, options->CoordinateSystem, &meshPrimitive->BoundingBox);
-            meshPrimitive->IndexBuffer = ConstructGltfIndexBuffer(memoryArena, gltfPrimitive, options->CoordinateSystem);
-
             meshPrimitive->MaterialId = gltfPrimitive->material ? cgltf_material_index(data, gltfPrimitive->material) : -1;
-
-            AddBoundingBoxToBoundingBox(&meshPrimitive->BoundingBox, &mesh->BoundingBox);
+            jobs[jobCount++] = { .GltfPrimitive = gltfPrimitive, .MeshPrimitive = meshPrimitive };
         }
 
         if (gltfMesh->name)
@@ -211,6 +237,39 @@ ReadOnlySpan<ElemSceneMesh> LoadGltfMeshes(MemoryArena memoryArena, const cgltf_
         mesh->MeshPrimitives = { .Items = meshPrimitives.Pointer, .Length = (uint32_t)meshPrimitives.Length };
     }
 
+    GltfMeshPrimitiveJobPayload jobPayload =
+    {
+        .MemoryArena = memoryArena,
+        .Jobs = jobs.Slice(0, jobCount),
+        .CoordinateSystem = options->CoordinateSystem
+    };
+
+    auto vertexBuildStartTimestamp = SystemPlatformGetHighPerformanceCounter();
+    ToolsParallelFor(jobCount, ConstructGltfMeshPrimitiveJob, &jobPayload);
+
+    WriteToMessageList(ElemToolsMessageType_Information, SystemFormatString(memoryArena, "Vertex build: %f ms (%d primitives)", ToolsGetElapsedMilliseconds(vertexBuildStartTimestamp), jobCount).Pointer, messageList);
+
+    for (uint32_t i = 0; i < meshes.Length; i++)
+    {
+        auto mesh = &meshes[i];
+
+        mesh->BoundingBox = 
+        { 
+            .MinPoint = { FLT_MAX, FLT_MAX, FLT_MAX }, 
+            .MaxPoint = { -FLT_MAX, -FLT_MAX, -FLT_MAX } 
+        }; 
+
+        for (uint32_t j = 0; j < mesh->MeshPrimitives.Length; j++)
+        {
+            auto meshPrimitive = &mesh->MeshPrimitives.Items[j];
+
+            if (meshPrimitive->VertexBuffer.VertexCount > 0)
+            {
+                AddBoundingBoxToBoundingBox(&meshPrimitive->BoundingBox, &mesh->BoundingBox);
+            }
+        }
+    }
+
     return meshes;
 }
 
@@ -352,6 +411,8 @@ ElemLoadSceneResult LoadGltfScene(const char* path, const ElemLoadSceneOptions*
     };
 
     cgltf_data* data = NULL;
+
+    auto parseStartTimestamp = SystemPlatformGetHighPerformanceCounter();
     cgltf_result result = cgltf_parse_file(&cgltfOptions, path, &data);
 
     if (result != cgltf_result_success)
@@ -359,6 +420,9 @@ ElemLoadSceneResult LoadGltfScene(const char* path, const ElemLoadSceneOptions*
         return { .Messages = ConstructErrorMessageSpan(sceneLoaderMemoryArena, "Error while reading glTF file."), .HasErrors = true };
     }
 
+    WriteToMessageList(ElemToolsMessageType_Information, SystemFormatString(sceneLoaderMemoryArena, "Parse: %f ms", ToolsGetElapsedMilliseconds(parseStartTimestamp)).Pointer, &messageList);
+
+    auto buffersStartTimestamp = SystemPlatformGetHighPerformanceCounter();
     result = cgltf_load_buffers(&cgltfOptions, data, path);
 
     if (result != cgltf_result_success)
@@ -366,6 +430,8 @@ ElemLoadSceneResult LoadGltfScene(const char* path, const ElemLoadSceneOptions*
         return { .Messages = ConstructErrorMessageSpan(sceneLoaderMemoryArena, "Error while loading glTF buffers."), .HasErrors = true };
     }
 
+    WriteToMessageList(ElemToolsMessageType_Information, SystemFormatString(sceneLoaderMemoryArena, "Buffers: %f ms", ToolsGetElapsedMilliseconds(buffersStartTimestamp)).Pointer, &messageList);
+
     result = cgltf_validate(data);
 
     if (result != cgltf_result_success)
@@ -4,15 +4,17 @@
 #include "ElementalTools.h"
 #include "SystemMemory.h"
 #include "SystemFunctions.h"
+#include "SystemPlatformFunctions.h"
 
 struct ObjLoaderFileData
 {
-    ReadOnlySpan<uint8_t> FileData;
-    uint32_t CurrentOffset;
+    ToolsMappedFile MappedFile;
+    size_t CurrentOffset;
 };
 
 struct ObjMeshPrimitiveInfo
 {
+    uint32_t MeshIndex;
     uint32_t VertexOffset;
     uint32_t VertexCount; 
     uint32_t FaceOffset;
@@ -20,6 +22,16 @@ struct ObjMeshPrimitiveInfo
     int32_t MaterialId;
 };
 
+struct ObjMeshPrimitiveJobPayload
+{
+    MemoryArena MemoryArena;
+    const fastObjMesh* ObjMesh;
+    ReadOnlySpan<ObjMeshPrimitiveInfo> MeshPrimitiveInfos;
+    Span<ElemSceneMeshPrimitive> MeshPrimitives;
+    const ElemLoadSceneOptions* Options;
+    uint64_t TangentTicks;
+};
+
 struct ObjVertex
 {
     ElemToolsVector3 Position;
@@ -29,25 +41,31 @@ struct ObjVertex
     ElemToolsVector2 TextureCoordinates;
 };
 
+// NOTE: The file is memory mapped and streamed to fast_obj in chunks so we never hold a full copy of
+// the file in memory. Pages already parsed can be evicted by the OS at any time.
 void* FastObjFileOpen(const char* path, void* userData)
 {
-    // TODO: Add support for streaming
-    auto objFileData = LoadFileData(path); 
+    auto mappedFile = MapFileData(path, true); 
 
-    if (objFileData.Length == 0)
+    if (mappedFile.Data.Length == 0)
     {
         return nullptr;
     }
 
     auto objLoaderFileData = SystemPushStruct<ObjLoaderFileData>(*(MemoryArena*)userData);
     objLoaderFileData->CurrentOffset = 0;
-    objLoaderFileData->FileData = objFileData;
+    objLoaderFileData->MappedFile = mappedFile;
     
     return objLoaderFileData;
 }
 
 void FastObjFileClose(void* file, void* userData)
 {
+    SystemAssert(file);
+
+    auto objLoaderFileData = (ObjLoaderFileData*)file;
+    UnmapFileData(objLoaderFileData->MappedFile);
+    objLoaderFileData->MappedFile = {};
 }
 
 size_t FastObjFileRead(void* file, void* destination, size_t bytes, void* userData)
@@ -55,7 +73,7 @@ size_t FastObjFileRead(void* file, void* destination, size_t bytes, void* userDa
     SystemAssert(file);
 
     auto objLoaderFileData = (ObjLoaderFileData*)file;
-    auto sourceSpan = objLoaderFileData->FileData;
+    auto sourceSpan = objLoaderFileData->MappedFile.Data;
     auto destinationSpan = Span<uint8_t>((uint8_t*)destination, bytes);
 
     auto readLength = SystemMin(sourceSpan.Length - objLoaderFileData->CurrentOffset, bytes);
@@ -69,15 +87,22 @@ size_t FastObjFileRead(void* file, void* destination, size_t bytes, void* userDa
     return readLength;
 }
 
+uint64_t GetObjLoaderFileSize(const ObjLoaderFileData* objLoaderFileData)
+{
+    return (uint64_t)objLoaderFileData->MappedFile.Data.Length;
+}
+
 unsigned long FastObjFileSize(void* file, void* userData)
 {
     SystemAssert(file);
 
-    auto objLoaderFileData = (ObjLoaderFileData*)file;
-    return objLoaderFileData->FileData.Length;
+    // NOTE: fast_obj declares this callback with unsigned long, which is 32-bit on Windows.
+    // The parser reads the file with FastObjFileRead and a size_t offset so the size is saturated
+    // instead of being silently truncated.
+    auto fileSize = GetObjLoaderFileSize((ObjLoaderFileData*)file);
+    return (unsigned long)SystemMin(fileSize, (uint64_t)(unsigned long)-1);
 }
 
-
 ObjVertex ReadObjVertex(fastObjIndex objVertex, const fastObjMesh* objMesh, ElemSceneCoordinateSystem coordinateSystem, bool flipVerticalTextureCoordinates)
 {
     ObjVertex result = {};
@@ -157,7 +182,7 @@ void WriteObjVertex(const ObjVertex* vertex, uint8_t** vertexBufferPointer)
     *vertexBufferPointer = currentVertexBufferPointer;
 }
 
-ElemSceneMeshPrimitive ConstructObjMeshPrimitive(MemoryArena memoryArena, const fastObjMesh* objMesh, const ObjMeshPrimitiveInfo* meshPrimitiveInfo, const ElemLoadSceneOptions* options)
+ElemSceneMeshPrimitive ConstructObjMeshPrimitive(MemoryArena memoryArena, const fastObjMesh* objMesh, const ObjMeshPrimitiveInfo* meshPrimitiveInfo, const ElemLoadSceneOptions* options, uint64_t* tangentTicks)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
 
@@ -255,7 +280,6 @@ ElemSceneMeshPrimitive ConstructObjMeshPrimitive(MemoryArena memoryArena, const
         currentObjIndex += faceVertexCount;
     }
 
-    // TODO: To replace
     GenerateTangentVectorsParameters generateTangentParams =
     {
         .PositionPointer = &vertexList.Pointer[0].Position,
@@ -263,10 +287,22 @@ ElemSceneMeshPrimitive ConstructObjMeshPrimitive(MemoryArena memoryArena, const
         .TextureCoordinatesPointer = &vertexList.Pointer[0].TextureCoordinates,
         .TangentPointer = &vertexList.Pointer[0].Tangent,
         .VertexSize = sizeof(ObjVertex),
+        .VertexCount = meshPrimitiveInfo->VertexCount,
         .IndexData = indexBufferData
     };
 
-    AssertIfFailed(GenerateTangentVectors(&generateTangentParams));
+    auto tangentStartTimestamp = SystemPlatformGetHighPerformanceCounter();
+
+    if (options->TangentMode == ElemSceneTangentMode_Fast)
+    {
+        AssertIfFailed(GenerateFastTangentVectors(stackMemoryArena, &generateTangentParams));
+    }
+    else
+    {
+        AssertIfFailed(GenerateTangentVectors(&generateTangentParams));
+    }
+
+    SystemAtomicAdd(*tangentTicks, SystemPlatformGetHighPerformanceCounter() - tangentStartTimestamp);
 
     auto vertexBufferData = SystemPushArray<uint8_t>(memoryArena, meshPrimitiveInfo->VertexCount * maxVertexSize);
     auto currentVertexBufferPointer = vertexBufferData.Pointer;
@@ -290,6 +326,12 @@ ElemSceneMeshPrimitive ConstructObjMeshPrimitive(MemoryArena memoryArena, const
     return result;
 }
 
+void ConstructObjMeshPrimitiveJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (ObjMeshPrimitiveJobPayload*)payload;
+    jobPayload->MeshPrimitives[index] = ConstructObjMeshPrimitive(jobPayload->MemoryArena, jobPayload->ObjMesh, &jobPayload->MeshPrimitiveInfos[index], jobPayload->Options, &jobPayload->TangentTicks);
+}
+
 void ApplyObjMeshPrimitiveInverseTranslation(ElemToolsVector3 translation, ElemVertexBuffer* vertexBuffer)
 {
     for (uint32_t i = 0; i < vertexBuffer->VertexCount; i++)
@@ -301,11 +343,11 @@ void ApplyObjMeshPrimitiveInverseTranslation(ElemToolsVector3 translation, ElemV
 
 void ApplyObjBoundingBoxInverseTranslation(ElemToolsVector3 translation, ElemToolsBoundingBox* boundingBox)
 {
-    boundingBox->MinPoint = { boundingBox->MinPoint.X - translation.X, boundingBox->MinPoint.Y - translation.Y, boundingBox->MinPoint.Z - translation.Y };
-    boundingBox->MaxPoint = { boundingBox->MaxPoint.X - translation.X, boundingBox->MaxPoint.Y - translation.Y, boundingBox->MaxPoint.Z - translation.Y };
+    boundingBox->MinPoint = { boundingBox->MinPoint.X - translation.X, boundingBox->MinPoint.Y - translation.Y, boundingBox->MinPoint.Z - translation.Z };
+    boundingBox->MaxPoint = { boundingBox->MaxPoint.X - translation.X, boundingBox->MaxPoint.Y - translation.Y, boundingBox->MaxPoint.Z - translation.Z };
 }
 
-ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const ElemLoadSceneOptions* options)
+ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const ElemLoadSceneOptions* options, ToolsMessageList* messageList)
 {
     auto hasErrors = false;
 
@@ -316,34 +358,73 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
 
     auto meshes = SystemPushArray<ElemSceneMesh>(sceneLoaderMemoryArena, objFileData->group_count);
     auto sceneNodes = SystemPushArray<ElemSceneNode>(sceneLoaderMemoryArena, objFileData->group_count);
-    auto meshPrimitiveInfos = SystemPushArray<ObjMeshPrimitiveInfo>(stackMemoryArena, UINT16_MAX);
+
+    // NOTE: Vertex offset of each face so we don't need to walk all the previous faces for each group.
+    auto faceVertexOffsets = SystemPushArray<uint32_t>(stackMemoryArena, objFileData->face_count + 1);
+    faceVertexOffsets[0] = 0;
+
+    for (uint32_t i = 0; i < objFileData->face_count; i++)
+    {
+        faceVertexOffsets[i + 1] = faceVertexOffsets[i] + objFileData->face_vertices[i];
+    }
+
+    // NOTE: First pass, we split the groups into mesh primitives (one per material range). The primitives
+    // of all the groups are stored in one list so they can be processed in parallel.
+    auto meshPrimitiveCount = 0u;
 
     for (uint32_t i = 0; i < objFileData->group_count; i++)
     {
-        auto mesh = &meshes[i];
-        auto sceneNode = &sceneNodes[i];
         auto groupData = &objFileData->groups[i];
 
         if (groupData->face_count == 0)
         {
-            printf("Invalid object\n");
             continue;
         }
 
-        auto vertexOffset = 0u;
+        auto currentMaterial = objFileData->face_materials[groupData->face_offset];
+        meshPrimitiveCount++;
 
-        for (uint32_t j = 0; j < groupData->face_offset; j++) 
+        for (uint32_t j = 0; j < groupData->face_count; j++) 
         {
-            vertexOffset += objFileData->face_vertices[j];
+            auto faceVertexCount = objFileData->face_vertices[groupData->face_offset + j];
+
+            if (faceVertexCount != 3 && faceVertexCount != 4)
+            {
+                return
+                {
+                    .Messages = ConstructErrorMessageSpan(sceneLoaderMemoryArena, "Obj mesh loader only support triangles or quads."),
+                    .HasErrors = true
+                };
+            }
+
+            if (objFileData->face_materials[groupData->face_offset + j] != currentMaterial)
+            {
+                currentMaterial = objFileData->face_materials[groupData->face_offset + j];
+                meshPrimitiveCount++;
+            }
+        }
+    }
+
+    auto meshPrimitiveInfos = SystemPushArray<ObjMeshPrimitiveInfo>(stackMemoryArena, meshPrimitiveCount);
+    auto meshPrimitiveIndex = 0u;
+
+    for (uint32_t i = 0; i < objFileData->group_count; i++)
+    {
+        auto groupData = &objFileData->groups[i];
+
+        if (groupData->face_count == 0)
+        {
+            printf("Invalid object\n");
+            continue;
         }
 
         auto currentMaterial = objFileData->face_materials[groupData->face_offset];
-        auto meshPrimitiveCount = 0u;
 
-        auto meshPrimitiveInfo = &meshPrimitiveInfos[meshPrimitiveCount++];
+        auto meshPrimitiveInfo = &meshPrimitiveInfos[meshPrimitiveIndex++];
         *meshPrimitiveInfo = 
         { 
-            .VertexOffset = vertexOffset, 
+            .MeshIndex = i,
+            .VertexOffset = faceVertexOffsets[groupData->face_offset], 
             .FaceOffset = groupData->face_offset,
             .MaterialId = (int32_t)currentMaterial
         };
@@ -353,15 +434,6 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
             auto faceMaterial = objFileData->face_materials[groupData->face_offset + j];
             auto faceVertexCount = objFileData->face_vertices[groupData->face_offset + j];
 
-            if (faceVertexCount != 3 && faceVertexCount != 4)
-            {
-                return
-                {
-                    .Messages = ConstructErrorMessageSpan(sceneLoaderMemoryArena, "Obj mesh loader only support triangles or quads."),
-                    .HasErrors = true
-                };
-            }
-
             if (faceMaterial != currentMaterial)
             {
                 currentMaterial = faceMaterial;
@@ -372,9 +444,10 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
                 auto previousFaceOffset = meshPrimitiveInfo->FaceOffset;
                 auto previousFaceCount = meshPrimitiveInfo->FaceCount;
 
-                meshPrimitiveInfo = &meshPrimitiveInfos[meshPrimitiveCount++];
+                meshPrimitiveInfo = &meshPrimitiveInfos[meshPrimitiveIndex++];
                 *meshPrimitiveInfo = 
                 { 
+                    .MeshIndex = i,
                     .VertexOffset = previousVertexOffset + previousVertexCount, 
                     .FaceOffset = previousFaceOffset + previousFaceCount,
                     .MaterialId = (int32_t)currentMaterial
@@ -384,6 +457,49 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
             meshPrimitiveInfo->VertexCount += faceVertexCount;
             meshPrimitiveInfo->FaceCount++;
         }
+    }
+
+    auto meshPrimitives = SystemPushArray<ElemSceneMeshPrimitive>(sceneLoaderMemoryArena, meshPrimitiveCount);
+
+    ObjMeshPrimitiveJobPayload jobPayload =
+    {
+        .MemoryArena = sceneLoaderMemoryArena,
+        .ObjMesh = objFileData,
+        .MeshPrimitiveInfos = meshPrimitiveInfos,
+        .MeshPrimitives = meshPrimitives,
+        .Options = options,
+        .TangentTicks = 0
+    };
+
+    auto vertexBuildStartTimestamp = SystemPlatformGetHighPerformanceCounter();
+    ToolsParallelFor(meshPrimitiveCount, ConstructObjMeshPrimitiveJob, &jobPayload);
+    auto vertexBuildDuration = ToolsGetElapsedMilliseconds(vertexBuildStartTimestamp);
+    auto tangentDuration = (double)jobPayload.TangentTicks * 1000.0 / (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds();
+
+    WriteToMessageList(ElemToolsMessageType_Information, SystemFormatString(sceneLoaderMemoryArena, "Vertex build: %f ms (%d primitives)", vertexBuildDuration, meshPrimitiveCount).Pointer, messageList);
+    WriteToMessageList(ElemToolsMessageType_Information, SystemFormatString(sceneLoaderMemoryArena, "Tangents: %f ms (summed over all workers)", tangentDuration).Pointer, messageList);
+
+    meshPrimitiveIndex = 0;
+
+    for (uint32_t i = 0; i < objFileData->group_count; i++)
+    {
+        auto mesh = &meshes[i];
+        auto sceneNode = &sceneNodes[i];
+        auto groupData = &objFileData->groups[i];
+
+        if (groupData->face_count == 0)
+        {
+            continue;
+        }
+
+        auto meshPrimitiveStartIndex = meshPrimitiveIndex;
+
+        while (meshPrimitiveIndex < meshPrimitiveCount && meshPrimitiveInfos[meshPrimitiveIndex].MeshIndex == i)
+        {
+            meshPrimitiveIndex++;
+        }
+
+        auto groupMeshPrimitives = meshPrimitives.Slice(meshPrimitiveStartIndex, meshPrimitiveIndex - meshPrimitiveStartIndex);
 
         mesh->BoundingBox = 
         { 
@@ -391,20 +507,17 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
             .MaxPoint = { -FLT_MAX, -FLT_MAX, -FLT_MAX } 
         }; 
 
-        auto meshPrimitives = SystemPushArray<ElemSceneMeshPrimitive>(sceneLoaderMemoryArena, meshPrimitiveCount);
-
-        for (uint32_t j = 0; j < meshPrimitiveCount; j++)
+        for (uint32_t j = 0; j < groupMeshPrimitives.Length; j++)
         {
-            meshPrimitives[j] = ConstructObjMeshPrimitive(sceneLoaderMemoryArena, objFileData, &meshPrimitiveInfos[j], options);
-            AddBoundingBoxToBoundingBox(&meshPrimitives[j].BoundingBox, &mesh->BoundingBox);
+            AddBoundingBoxToBoundingBox(&groupMeshPrimitives[j].BoundingBox, &mesh->BoundingBox);
         }
             
         auto boundingBoxCenter = GetBoundingBoxCenter(&mesh->BoundingBox);
         ApplyObjBoundingBoxInverseTranslation(boundingBoxCenter, &mesh->BoundingBox);
 
-        for (uint32_t j = 0; j < meshPrimitiveCount; j++)
+        for (uint32_t j = 0; j < groupMeshPrimitives.Length; j++)
         {
-            auto meshPrimitive = &meshPrimitives[j];
+            auto meshPrimitive = &groupMeshPrimitives[j];
 
             ApplyObjMeshPrimitiveInverseTranslation(boundingBoxCenter, &meshPrimitive->VertexBuffer);
             ApplyObjBoundingBoxInverseTranslation(boundingBoxCenter, &meshPrimitive->BoundingBox);
@@ -419,7 +532,7 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
             mesh->Name = "Mesh";
         }
 
-        mesh->MeshPrimitives = { .Items = meshPrimitives.Pointer, .Length = (uint32_t)meshPrimitives.Length };
+        mesh->MeshPrimitives = { .Items = groupMeshPrimitives.Pointer, .Length = (uint32_t)groupMeshPrimitives.Length };
 
         if (groupData->name)
         {
@@ -445,7 +558,8 @@ ElemLoadSceneResult LoadObjSceneAndNodes(const fastObjMesh* objFileData, const E
         .CoordinateSystem = options->CoordinateSystem,
         .Meshes = { .Items = meshes.Pointer, .Length = (uint32_t)meshes.Length },
         .Nodes = { .Items = sceneNodes.Pointer, .Length = (uint32_t)sceneNodes.Length },
-        .HasErrors = hasErrors
+        .Messages = { .Items = messageList->Messages.Pointer, .Length = messageList->MessageCount },
+        .HasErrors = hasErrors || messageList->HasErrors
     };
 }
 
@@ -489,6 +603,12 @@ ElemSceneMaterialSpan LoadObjMaterials(const fastObjMesh* objFileData, const Ele
 ElemLoadSceneResult LoadObjScene(const char* path, const ElemLoadSceneOptions* options)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto sceneLoaderMemoryArena = GetSceneLoaderMemoryArena();
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(sceneLoaderMemoryArena, 1024)
+    };
 
     auto callbacks = fastObjCallbacks
     {
@@ -498,9 +618,17 @@ ElemLoadSceneResult LoadObjScene(const char* path, const ElemLoadSceneOptions* o
         .file_size = FastObjFileSize
     };
 
+    auto parseStartTimestamp = SystemPlatformGetHighPerformanceCounter();
     auto objFileData = fast_obj_read_with_callbacks(path, &callbacks, &stackMemoryArena);
 
-    auto result = LoadObjSceneAndNodes(objFileData, options);
+    if (!objFileData)
+    {
+        return { .Messages = ConstructErrorMessageSpan(sceneLoaderMemoryArena, "Error while reading obj file."), .HasErrors = true };
+    }
+
+    WriteToMessageList(ElemToolsMessageType_Information, SystemFormatString(sceneLoaderMemoryArena, "Parse: %f ms", ToolsGetElapsedMilliseconds(parseStartTimestamp)).Pointer, &messageList);
+
+    auto result = LoadObjSceneAndNodes(objFileData, options, &messageList);
     result.Materials = LoadObjMaterials(objFileData, options);
 
     return result;
@@ -79,3 +79,241 @@ bool GenerateTangentVectors(const GenerateTangentVectorsParameters* parameters)
 
     return genTangSpaceDefault(&mikkTSpaceContext);
 }
+
+#define TANGENT_BATCH_SIZE 64
+
+struct TangentVertexStreams
+{
+    Span<float> PositionX;
+    Span<float> PositionY;
+    Span<float> PositionZ;
+    Span<float> NormalX;
+    Span<float> NormalY;
+    Span<float> NormalZ;
+    Span<float> TextureCoordinatesU;
+    Span<float> TextureCoordinatesV;
+    Span<float> TangentX;
+    Span<float> TangentY;
+    Span<float> TangentZ;
+    Span<float> Orientation;
+};
+
+struct TangentTriangleBatch
+{
+    uint32_t VertexIndices[3][TANGENT_BATCH_SIZE];
+    float Edge1X[TANGENT_BATCH_SIZE];
+    float Edge1Y[TANGENT_BATCH_SIZE];
+    float Edge1Z[TANGENT_BATCH_SIZE];
+    float Edge2X[TANGENT_BATCH_SIZE];
+    float Edge2Y[TANGENT_BATCH_SIZE];
+    float Edge2Z[TANGENT_BATCH_SIZE];
+    float Edge3X[TANGENT_BATCH_SIZE];
+    float Edge3Y[TANGENT_BATCH_SIZE];
+    float Edge3Z[TANGENT_BATCH_SIZE];
+    float TextureEdge1U[TANGENT_BATCH_SIZE];
+    float TextureEdge1V[TANGENT_BATCH_SIZE];
+    float TextureEdge2U[TANGENT_BATCH_SIZE];
+    float TextureEdge2V[TANGENT_BATCH_SIZE];
+    float TangentX[TANGENT_BATCH_SIZE];
+    float TangentY[TANGENT_BATCH_SIZE];
+    float TangentZ[TANGENT_BATCH_SIZE];
+    float Orientation[TANGENT_BATCH_SIZE];
+    float CornerAngles[3][TANGENT_BATCH_SIZE];
+};
+
+TangentVertexStreams ExtractTangentVertexStreams(MemoryArena memoryArena, const GenerateTangentVectorsParameters* parameters, ReadOnlySpan<uint32_t> vertexRemap, uint32_t vertexCount)
+{
+    TangentVertexStreams result =
+    {
+        .PositionX = SystemPushArray<float>(memoryArena, vertexCount),
+        .PositionY = SystemPushArray<float>(memoryArena, vertexCount),
+        .PositionZ = SystemPushArray<float>(memoryArena, vertexCount),
+        .NormalX = SystemPushArray<float>(memoryArena, vertexCount),
+        .NormalY = SystemPushArray<float>(memoryArena, vertexCount),
+        .NormalZ = SystemPushArray<float>(memoryArena, vertexCount),
+        .TextureCoordinatesU = SystemPushArray<float>(memoryArena, vertexCount),
+        .TextureCoordinatesV = SystemPushArray<float>(memoryArena, vertexCount),
+        .TangentX = SystemPushArrayZero<float>(memoryArena, vertexCount),
+        .TangentY = SystemPushArrayZero<float>(memoryArena, vertexCount),
+        .TangentZ = SystemPushArrayZero<float>(memoryArena, vertexCount),
+        .Orientation = SystemPushArrayZero<float>(memoryArena, vertexCount)
+    };
+
+    auto positionPointer = (uint8_t*)parameters->PositionPointer;
+    auto normalPointer = (uint8_t*)parameters->NormalPointer;
+    auto textureCoordinatesPointer = (uint8_t*)parameters->TextureCoordinatesPointer;
+
+    for (uint32_t i = 0; i < parameters->VertexCount; i++)
+    {
+        auto position = (ElemToolsVector3*)(positionPointer + i * parameters->VertexSize);
+        auto normal = (ElemToolsVector3*)(normalPointer + i * parameters->VertexSize);
+        auto textureCoordinates = (ElemToolsVector2*)(textureCoordinatesPointer + i * parameters->VertexSize);
+        auto weldedIndex = vertexRemap[i];
+
+        result.PositionX[weldedIndex] = position->X;
+        result.PositionY[weldedIndex] = position->Y;
+        result.PositionZ[weldedIndex] = position->Z;
+        result.NormalX[weldedIndex] = normal->X;
+        result.NormalY[weldedIndex] = normal->Y;
+        result.NormalZ[weldedIndex] = normal->Z;
+        result.TextureCoordinatesU[weldedIndex] = textureCoordinates->X;
+        result.TextureCoordinatesV[weldedIndex] = textureCoordinates->Y;
+    }
+
+    return result;
+}
+
+float ComputeTangentEdgeAngle(float ax, float ay, float az, float bx, float by, float bz)
+{
+    auto lengthProduct = sqrtf((ax * ax + ay * ay + az * az) * (bx * bx + by * by + bz * bz));
+    auto cosAngle = lengthProduct > FLT_MIN ? (ax * bx + ay * by + az * bz) / lengthProduct : 1.0f;
+
+    return acosf(SystemMax(-1.0f, SystemMin(1.0f, cosAngle)));
+}
+
+void ComputeTangentBatch(const TangentVertexStreams* streams, ReadOnlySpan<uint32_t> indices, uint32_t triangleCount, TangentTriangleBatch* batch)
+{
+    // NOTE: The batch is processed in 3 passes. The gather and scatter passes do the indexed memory accesses
+    // so the compute pass only reads and writes contiguous arrays.
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        auto index0 = indices[i * 3];
+        auto index1 = indices[i * 3 + 1];
+        auto index2 = indices[i * 3 + 2];
+
+        batch->VertexIndices[0][i] = index0;
+        batch->VertexIndices[1][i] = index1;
+        batch->VertexIndices[2][i] = index2;
+
+        batch->Edge1X[i] = streams->PositionX[index1] - streams->PositionX[index0];
+        batch->Edge1Y[i] = streams->PositionY[index1] - streams->PositionY[index0];
+        batch->Edge1Z[i] = streams->PositionZ[index1] - streams->PositionZ[index0];
+        batch->Edge2X[i] = streams->PositionX[index2] - streams->PositionX[index0];
+        batch->Edge2Y[i] = streams->PositionY[index2] - streams->PositionY[index0];
+        batch->Edge2Z[i] = streams->PositionZ[index2] - streams->PositionZ[index0];
+        batch->Edge3X[i] = streams->PositionX[index2] - streams->PositionX[index1];
+        batch->Edge3Y[i] = streams->PositionY[index2] - streams->PositionY[index1];
+        batch->Edge3Z[i] = streams->PositionZ[index2] - streams->PositionZ[index1];
+
+        batch->TextureEdge1U[i] = streams->TextureCoordinatesU[index1] - streams->TextureCoordinatesU[index0];
+        batch->TextureEdge1V[i] = streams->TextureCoordinatesV[index1] - streams->TextureCoordinatesV[index0];
+        batch->TextureEdge2U[i] = streams->TextureCoordinatesU[index2] - streams->TextureCoordinatesU[index0];
+        batch->TextureEdge2V[i] = streams->TextureCoordinatesV[index2] - streams->TextureCoordinatesV[index0];
+    }
+
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        // NOTE: Same face tangent as MikkTSpace. The sign of the texture space area gives the orientation.
+        auto signedArea = batch->TextureEdge1U[i] * batch->TextureEdge2V[i] - batch->TextureEdge1V[i] * batch->TextureEdge2U[i];
+        auto orientation = signedArea > 0.0f ? 1.0f : -1.0f;
+
+        auto tangentX = batch->TextureEdge2V[i] * batch->Edge1X[i] - batch->TextureEdge1V[i] * batch->Edge2X[i];
+        auto tangentY = batch->TextureEdge2V[i] * batch->Edge1Y[i] - batch->TextureEdge1V[i] * batch->Edge2Y[i];
+        auto tangentZ = batch->TextureEdge2V[i] * batch->Edge1Z[i] - batch->TextureEdge1V[i] * batch->Edge2Z[i];
+
+        auto tangentLength = sqrtf(tangentX * tangentX + tangentY * tangentY + tangentZ * tangentZ);
+        auto tangentScale = tangentLength > FLT_MIN ? orientation / tangentLength : 0.0f;
+
+        batch->TangentX[i] = tangentX * tangentScale;
+        batch->TangentY[i] = tangentY * tangentScale;
+        batch->TangentZ[i] = tangentZ * tangentScale;
+        batch->Orientation[i] = orientation;
+
+        auto angle0 = ComputeTangentEdgeAngle(batch->Edge1X[i], batch->Edge1Y[i], batch->Edge1Z[i], batch->Edge2X[i], batch->Edge2Y[i], batch->Edge2Z[i]);
+        auto angle1 = ComputeTangentEdgeAngle(-batch->Edge1X[i], -batch->Edge1Y[i], -batch->Edge1Z[i], batch->Edge3X[i], batch->Edge3Y[i], batch->Edge3Z[i]);
+
+        batch->CornerAngles[0][i] = angle0;
+        batch->CornerAngles[1][i] = angle1;
+        batch->CornerAngles[2][i] = SystemMax(0.0f, 3.14159265f - angle0 - angle1);
+    }
+
+    for (uint32_t i = 0; i < triangleCount; i++)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            auto vertexIndex = batch->VertexIndices[j][i];
+            auto weight = batch->CornerAngles[j][i];
+
+            // NOTE: The face tangent is projected on the tangent plane of each corner before it is accumulated.
+            auto normalX = streams->NormalX[vertexIndex];
+            auto normalY = streams->NormalY[vertexIndex];
+            auto normalZ = streams->NormalZ[vertexIndex];
+            auto normalDot = normalX * batch->TangentX[i] + normalY * batch->TangentY[i] + normalZ * batch->TangentZ[i];
+
+            auto tangentX = batch->TangentX[i] - normalX * normalDot;
+            auto tangentY = batch->TangentY[i] - normalY * normalDot;
+            auto tangentZ = batch->TangentZ[i] - normalZ * normalDot;
+
+            auto tangentLength = sqrtf(tangentX * tangentX + tangentY * tangentY + tangentZ * tangentZ);
+            auto tangentScale = tangentLength > FLT_MIN ? weight / tangentLength : 0.0f;
+
+            streams->TangentX[vertexIndex] += tangentX * tangentScale;
+            streams->TangentY[vertexIndex] += tangentY * tangentScale;
+            streams->TangentZ[vertexIndex] += tangentZ * tangentScale;
+            streams->Orientation[vertexIndex] += batch->Orientation[i] * weight;
+        }
+    }
+}
+
+bool GenerateFastTangentVectors(MemoryArena memoryArena, const GenerateTangentVectorsParameters* parameters)
+{
+    if (parameters->IndexData.Length % 3 != 0)
+    {
+        return false;
+    }
+
+    // NOTE: The loaders can output one vertex per face corner (OBJ for example). The vertices with the same position,
+    // normal and texture coordinates are welded so the tangents are accumulated over all the faces that share them.
+    meshopt_Stream weldStreams[] =
+    {
+        { parameters->PositionPointer, sizeof(ElemToolsVector3), parameters->VertexSize },
+        { parameters->NormalPointer, sizeof(ElemToolsVector3), parameters->VertexSize },
+        { parameters->TextureCoordinatesPointer, sizeof(ElemToolsVector2), parameters->VertexSize }
+    };
+
+    auto vertexRemap = SystemPushArray<uint32_t>(memoryArena, parameters->VertexCount);
+    auto weldedVertexCount = (uint32_t)meshopt_generateVertexRemapMulti(vertexRemap.Pointer, nullptr, parameters->VertexCount, parameters->VertexCount, weldStreams, 3);
+
+    auto weldedIndices = SystemPushArray<uint32_t>(memoryArena, parameters->IndexData.Length);
+
+    for (uint32_t i = 0; i < parameters->IndexData.Length; i++)
+    {
+        weldedIndices[i] = vertexRemap[parameters->IndexData[i]];
+    }
+
+    auto streams = ExtractTangentVertexStreams(memoryArena, parameters, vertexRemap, weldedVertexCount);
+    auto batch = SystemPushStruct<TangentTriangleBatch>(memoryArena);
+    auto triangleCount = (uint32_t)parameters->IndexData.Length / 3;
+
+    for (uint32_t i = 0; i < triangleCount; i += TANGENT_BATCH_SIZE)
+    {
+        auto batchTriangleCount = SystemMin(triangleCount - i, (uint32_t)TANGENT_BATCH_SIZE);
+        ComputeTangentBatch(&streams, ReadOnlySpan<uint32_t>(weldedIndices.Pointer + i * 3, batchTriangleCount * 3), batchTriangleCount, batch);
+    }
+
+    auto tangentPointer = (uint8_t*)parameters->TangentPointer;
+
+    for (uint32_t i = 0; i < parameters->VertexCount; i++)
+    {
+        auto weldedIndex = vertexRemap[i];
+
+        ElemToolsVector3 normal = { streams.NormalX[weldedIndex], streams.NormalY[weldedIndex], streams.NormalZ[weldedIndex] };
+        ElemToolsVector3 tangent = { streams.TangentX[weldedIndex], streams.TangentY[weldedIndex], streams.TangentZ[weldedIndex] };
+
+        tangent = tangent - normal * ElemToolsDotProductV3(normal, tangent);
+
+        if (ElemToolsMagnitudeSquaredV3(tangent) <= FLT_MIN)
+        {
+            // NOTE: No valid texture space, we pick any direction orthogonal to the normal.
+            ElemToolsVector3 axis = fabsf(normal.X) < 0.9f ? ElemToolsVector3 { 1.0f, 0.0f, 0.0f } : ElemToolsVector3 { 0.0f, 1.0f, 0.0f };
+            tangent = ElemToolsCrossProductV3(axis, normal);
+        }
+
+        tangent = ElemToolsNormalizeV3(tangent);
+
+        auto outputTangent = (ElemToolsVector4*)(tangentPointer + i * parameters->VertexSize);
+        *outputTangent = { tangent.X, tangent.Y, tangent.Z, streams.Orientation[weldedIndex] >= 0.0f ? 1.0f : -1.0f };
+    }
+
+    return true;
+}
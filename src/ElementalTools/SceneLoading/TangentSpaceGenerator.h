@@ -10,7 +10,9 @@ struct GenerateTangentVectorsParameters
     ElemToolsVector2* TextureCoordinatesPointer;
     ElemToolsVector4* TangentPointer;
     uint32_t VertexSize;
+    uint32_t VertexCount;
     ReadOnlySpan<uint32_t> IndexData;
 };
 
 bool GenerateTangentVectors(const GenerateTangentVectorsParameters* parameters);
+bool GenerateFastTangentVectors(MemoryArena memoryArena, const GenerateTangentVectorsParameters* parameters);
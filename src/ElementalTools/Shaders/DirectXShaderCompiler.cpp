@@ -1,11 +1,64 @@
 #include "DirectXShaderCompiler.h"
 #include "ShaderCompilerUtils.h"
+#include "ToolsUtils.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
 
+#define DIRECTX_SHADER_COMPILER_MAX_ENTRY_POINT_MESSAGES 256
+
+struct DirectXShaderEntryPoint
+{
+    const char* Name;
+    DxilShaderKind ShaderKind;
+    ShaderType ShaderType;
+};
+
+struct DirectXShaderEntryPointResult
+{
+    ShaderPart ShaderPart;
+    Span<ElemToolsMessage> Messages;
+    uint32_t MessageCount;
+    bool HasErrors;
+};
+
+struct DirectXShaderCompileJobPayload
+{
+    MemoryArena MemoryArena;
+    ReadOnlySpan<uint8_t> ShaderCode;
+    ElemToolsGraphicsApi TargetGraphicsApi;
+    const ElemCompileShaderOptions* Options;
+    ReadOnlySpan<DirectXShaderEntryPoint> EntryPoints;
+    Span<DirectXShaderEntryPointResult> Results;
+};
+
 SystemLibrary directXShaderCompilerLibrary = {};
 DxcCreateInstanceProc directXShaderCompilerCreateInstanceFunction = nullptr;
 
+// NOTE: The compiler instances are not thread safe so each worker thread creates its own and reuses it
+// for all the entry points it compiles.
+thread_local ComPtr<IDxcCompiler3> threadDirectXShaderCompiler;
+thread_local ComPtr<IDxcUtils> threadDirectXShaderCompilerUtils;
+
+ComPtr<IDxcCompiler3> GetDirectXShaderCompilerInstance()
+{
+    if (!threadDirectXShaderCompiler)
+    {
+        AssertIfFailed(directXShaderCompilerCreateInstanceFunction(CLSID_DxcCompiler, IID_PPV_ARGS(&threadDirectXShaderCompiler)));
+    }
+
+    return threadDirectXShaderCompiler;
+}
+
+ComPtr<IDxcUtils> GetDirectXShaderCompilerUtilsInstance()
+{
+    if (!threadDirectXShaderCompilerUtils)
+    {
+        AssertIfFailed(directXShaderCompilerCreateInstanceFunction(CLSID_DxcUtils, IID_PPV_ARGS(&threadDirectXShaderCompilerUtils)));
+    }
+
+    return threadDirectXShaderCompilerUtils;
+}
+
 void InitDirectXShaderCompiler()
 {
     if (!directXShaderCompilerLibrary.Handle)
@@ -99,16 +152,15 @@ ShaderType GetShaderTypeEnum(DxilShaderKind shaderKind)
     }
 }
 
-ComPtr<IDxcResult> CompileDirectXShader(ReadOnlySpan<uint8_t> shaderCode, ReadOnlySpan<char> target, ElemToolsGraphicsApi targetApi, ReadOnlySpan<char> entryPoint, const ElemCompileShaderOptions* options)
+ComPtr<IDxcResult> CompileDirectXShader(ReadOnlySpan<uint8_t> shaderCode, ReadOnlySpan<char> target, ElemToolsGraphicsApi targetApi, ReadOnlySpan<char> entryPoint, const ElemCompileShaderOptions* options, bool preprocessOnly)
 {
     // TODO: Allow passing the pass to have a correct name in the messages
 
     auto stackMemoryArena = SystemGetStackMemoryArena();
-    
-    ComPtr<IDxcCompiler3> compiler;
-    AssertIfFailed(directXShaderCompilerCreateInstanceFunction(CLSID_DxcCompiler, IID_PPV_ARGS(&compiler)));
+    auto compiler = GetDirectXShaderCompilerInstance();
 
-    auto parameters = SystemPushArray<const wchar_t*>(stackMemoryArena, 64);
+    auto defineCount = options ? options->Defines.Length : 0u;
+    auto parameters = SystemPushArray<const wchar_t*>(stackMemoryArena, 64 + defineCount * 2);
     auto parameterIndex = 0u;
 
     parameters[parameterIndex++] = L"-Wno-ignored-attributes";
@@ -149,6 +201,22 @@ ComPtr<IDxcResult> CompileDirectXShader(ReadOnlySpan<uint8_t> shaderCode, ReadOn
     // TODO: Add an options for this
     parameters[parameterIndex++] = DXC_ARG_PACK_MATRIX_ROW_MAJOR;
 
+    for (uint32_t i = 0; i < defineCount; i++)
+    {
+        auto define = options->Defines.Items[i];
+        SystemAssert(define.Name);
+
+        auto defineString = SystemFormatString(stackMemoryArena, "%s=%s", define.Name, define.Value ? define.Value : "1");
+
+        parameters[parameterIndex++] = L"-D";
+        parameters[parameterIndex++] = SystemConvertUtf8ToWideChar(stackMemoryArena, defineString).Pointer;
+    }
+
+    if (preprocessOnly)
+    {
+        parameters[parameterIndex++] = L"-P";
+    }
+
     if (options && options->DebugMode)
     {
         parameters[parameterIndex++] = DXC_ARG_DEBUG;
@@ -170,7 +238,7 @@ ComPtr<IDxcResult> CompileDirectXShader(ReadOnlySpan<uint8_t> shaderCode, ReadOn
 
 ComPtr<ID3D12ShaderReflection> GetDirectXShaderReflection(ComPtr<IDxcUtils> dxcUtils, ReadOnlySpan<uint8_t> shaderCode, ReadOnlySpan<char> target, ReadOnlySpan<char> entryPoint, const ElemCompileShaderOptions* options)
 {
-    ComPtr<IDxcResult> dxilCompileResult = CompileDirectXShader(shaderCode, target, ElemToolsGraphicsApi_DirectX12, entryPoint, options);
+    ComPtr<IDxcResult> dxilCompileResult = CompileDirectXShader(shaderCode, target, ElemToolsGraphicsApi_DirectX12, entryPoint, options, false);
 
     ComPtr<IDxcBlob> shaderReflectionBlob;
     AssertIfFailed(dxilCompileResult->GetOutput(DXC_OUT_REFLECTION, IID_PPV_ARGS(&shaderReflectionBlob), nullptr));
@@ -188,6 +256,48 @@ ComPtr<ID3D12ShaderReflection> GetDirectXShaderReflection(ComPtr<IDxcUtils> dxcU
     return shaderReflection;
 }
 
+void CompileDirectXShaderEntryPointJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (DirectXShaderCompileJobPayload*)payload;
+    auto entryPoint = &jobPayload->EntryPoints[index];
+    auto result = &jobPayload->Results[index];
+
+    auto target = GetShaderTypeTarget(entryPoint->ShaderKind);
+
+    result->Messages = SystemPushArray<ElemToolsMessage>(jobPayload->MemoryArena, DIRECTX_SHADER_COMPILER_MAX_ENTRY_POINT_MESSAGES);
+
+    auto dxilCompileResult = CompileDirectXShader(jobPayload->ShaderCode, target, jobPayload->TargetGraphicsApi, entryPoint->Name, jobPayload->Options, false);
+    result->HasErrors = ProcessDirectXShaderCompilerLogOutput(jobPayload->MemoryArena, dxilCompileResult, jobPayload->TargetGraphicsApi, result->Messages, &result->MessageCount);
+
+    if (result->HasErrors)
+    {
+        return;
+    }
+
+    ComPtr<IDxcBlob> shaderByteCodeComPtr;
+    AssertIfFailed(dxilCompileResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderByteCodeComPtr), nullptr));
+
+    auto shaderReflection = GetDirectXShaderReflection(GetDirectXShaderCompilerUtilsInstance(), jobPayload->ShaderCode, target, entryPoint->Name, jobPayload->Options);
+
+    uint32_t threadCountX, threadCountY, threadCountZ;
+    shaderReflection->GetThreadGroupSize(&threadCountX, &threadCountY, &threadCountZ);
+
+    // NOTE: The worker stack arenas are released when the workers exit so the part data is allocated in the
+    // shared working arena.
+    auto metadata = SystemPushArray<ShaderMetadata>(jobPayload->MemoryArena, 1);
+    metadata[0] = { .Type = ShaderMetadataType_ThreadGroupSize, .Value = { threadCountX, threadCountY, threadCountZ } };
+
+    auto shaderByteCode = Span<uint8_t>((uint8_t*)shaderByteCodeComPtr->GetBufferPointer(), shaderByteCodeComPtr->GetBufferSize());
+
+    result->ShaderPart =
+    {
+        .ShaderType = entryPoint->ShaderType,
+        .Name = SystemDuplicateBuffer(jobPayload->MemoryArena, ReadOnlySpan<char>(entryPoint->Name)),
+        .Metadata = metadata,
+        .ShaderCode = SystemDuplicateBuffer<uint8_t>(jobPayload->MemoryArena, shaderByteCode),
+    };
+}
+
 bool DirectXShaderCompilerIsInstalled()
 {
     InitDirectXShaderCompiler();
@@ -195,6 +305,77 @@ bool DirectXShaderCompilerIsInstalled()
     return directXShaderCompilerCreateInstanceFunction != nullptr;
 }
 
+uint64_t DirectXShaderCompilerGetVersion()
+{
+    InitDirectXShaderCompiler();
+    SystemAssert(directXShaderCompilerCreateInstanceFunction != nullptr);
+
+    ComPtr<IDxcVersionInfo> versionInfo;
+
+    if (FAILED(GetDirectXShaderCompilerInstance()->QueryInterface(IID_PPV_ARGS(&versionInfo))))
+    {
+        return 0;
+    }
+
+    uint32_t major, minor;
+    AssertIfFailed(versionInfo->GetVersion(&major, &minor));
+
+    uint32_t versionValues[] = { major, minor };
+    auto version = XXH64(versionValues, sizeof(versionValues), 0);
+
+    // NOTE: The release version is not changed by every build of the compiler so the commit is also used.
+    ComPtr<IDxcVersionInfo2> commitInfo;
+
+    if (SUCCEEDED(GetDirectXShaderCompilerInstance()->QueryInterface(IID_PPV_ARGS(&commitInfo))))
+    {
+        uint32_t commitCount = 0;
+        char* commitHash = nullptr;
+
+        if (SUCCEEDED(commitInfo->GetCommitInfo(&commitCount, &commitHash)) && commitHash)
+        {
+            version = XXH64(&commitCount, sizeof(commitCount), version);
+            version = XXH64(commitHash, strlen(commitHash), version);
+
+            // NOTE: The DXC allocator is malloc outside of Windows.
+            #ifdef _WIN32
+            CoTaskMemFree(commitHash);
+            #else
+            free(commitHash);
+            #endif
+        }
+    }
+
+    return version;
+}
+
+// NOTE: The preprocessing uses the same arguments as the compilation because some of them (like -spirv)
+// add defines.
+ReadOnlySpan<uint8_t> DirectXShaderCompilerPreprocessShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemToolsGraphicsApi targetGraphicsApi, const ElemCompileShaderOptions* options)
+{
+    InitDirectXShaderCompiler();
+    SystemAssert(directXShaderCompilerCreateInstanceFunction != nullptr);
+
+    auto preprocessResult = CompileDirectXShader(shaderCode, "lib_6_8", targetGraphicsApi, "", options, true);
+
+    HRESULT status;
+    AssertIfFailed(preprocessResult->GetStatus(&status));
+
+    if (FAILED(status))
+    {
+        return {};
+    }
+
+    ComPtr<IDxcBlobUtf8> preprocessedSource;
+    AssertIfFailed(preprocessResult->GetOutput(DXC_OUT_HLSL, IID_PPV_ARGS(&preprocessedSource), nullptr));
+
+    if (!preprocessedSource || preprocessedSource->GetStringLength() == 0)
+    {
+        return {};
+    }
+
+    return SystemDuplicateBuffer<uint8_t>(memoryArena, ReadOnlySpan<uint8_t>((uint8_t*)preprocessedSource->GetBufferPointer(), preprocessedSource->GetStringLength()));
+}
+
 ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform, const ElemCompileShaderOptions* options)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
@@ -205,10 +386,11 @@ ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memor
     auto compilationMessages = SystemPushArray<ElemToolsMessage>(memoryArena, 1024);
     auto compilationMessageIndex = 0u;
 
-    auto dxilCompileResult = CompileDirectXShader(shaderCode, "lib_6_8", ElemToolsGraphicsApi_DirectX12, "", options);
+    auto dxilCompileResult = CompileDirectXShader(shaderCode, "lib_6_8", ElemToolsGraphicsApi_DirectX12, "", options, false);
     auto hasErrors = ProcessDirectXShaderCompilerLogOutput(memoryArena, dxilCompileResult, targetGraphicsApi, compilationMessages, &compilationMessageIndex);
 
-    auto outputShaderDataList = SystemPushArray<ShaderPart>(stackMemoryArena, 64);
+    auto outputShaderDataList = Span<ShaderPart>();
+    auto workingMemoryArena = MemoryArena();
     auto outputShaderDataListIndex = 0u;
 
     if (!hasErrors)
@@ -216,8 +398,7 @@ ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memor
         ComPtr<IDxcBlob> shaderByteCodeComPtr;
         AssertIfFailed(dxilCompileResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderByteCodeComPtr), nullptr));
 
-        ComPtr<IDxcUtils> dxcUtils;
-        AssertIfFailed(directXShaderCompilerCreateInstanceFunction(CLSID_DxcUtils, IID_PPV_ARGS(&dxcUtils)));
+        auto dxcUtils = GetDirectXShaderCompilerUtilsInstance();
         
         ComPtr<IDxcBlob> shaderReflectionBlob;
         AssertIfFailed(dxilCompileResult->GetOutput(DXC_OUT_REFLECTION, IID_PPV_ARGS(&shaderReflectionBlob), nullptr));
@@ -233,6 +414,9 @@ ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memor
         D3D12_LIBRARY_DESC libraryDescription;
         AssertIfFailed(shaderReflection->GetDesc(&libraryDescription));
 
+        auto entryPoints = SystemPushArray<DirectXShaderEntryPoint>(stackMemoryArena, libraryDescription.FunctionCount);
+        auto entryPointCount = 0u;
+
         for (uint32_t i = 0; i < libraryDescription.FunctionCount; i++)
         {
             auto functionReflection = shaderReflection->GetFunctionByIndex(i);
@@ -245,38 +429,46 @@ ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memor
 
             if (shaderType != ShaderType_Unknown)
             {
-                auto dxilCompileResult = CompileDirectXShader(shaderCode, GetShaderTypeTarget(dxilShaderType), targetGraphicsApi, functionDescription.Name, options);
-   
-                auto hasErrors = ProcessDirectXShaderCompilerLogOutput(memoryArena, dxilCompileResult, targetGraphicsApi, compilationMessages, &compilationMessageIndex);
-
-                if (hasErrors)
-                {
-                    continue;
-                }
-
-                ComPtr<IDxcBlob> shaderByteCodeComPtr;
-                AssertIfFailed(dxilCompileResult->GetOutput(DXC_OUT_OBJECT, IID_PPV_ARGS(&shaderByteCodeComPtr), nullptr));
+                entryPoints[entryPointCount++] = { .Name = functionDescription.Name, .ShaderKind = dxilShaderType, .ShaderType = shaderType };
+            }
+        }
 
-                auto shaderReflection = GetDirectXShaderReflection(dxcUtils, shaderCode, GetShaderTypeTarget(dxilShaderType), functionDescription.Name, options);
+        // NOTE: The entry points are compiled in parallel but the results are merged in the library order so
+        // the output doesn't depend on the scheduling of the workers. The output arena can be the stack arena
+        // of the calling thread so the workers use their own arena.
+        workingMemoryArena = SystemAllocateMemoryArena();
 
-                uint32_t threadCountX, threadCountY, threadCountZ;
-                shaderReflection->GetThreadGroupSize(&threadCountX, &threadCountY, &threadCountZ);
+        DirectXShaderCompileJobPayload payload =
+        {
+            .MemoryArena = workingMemoryArena,
+            .ShaderCode = shaderCode,
+            .TargetGraphicsApi = targetGraphicsApi,
+            .Options = options,
+            .EntryPoints = entryPoints.Slice(0, entryPointCount),
+            .Results = SystemPushArrayZero<DirectXShaderEntryPointResult>(workingMemoryArena, entryPointCount)
+        };
 
-                auto metadata = SystemPushArray<ShaderMetadata>(stackMemoryArena, 1);
-                auto currentMetadataIndex = 0u;
+        ToolsParallelFor(entryPointCount, CompileDirectXShaderEntryPointJob, &payload);
 
-                metadata[currentMetadataIndex++] = { .Type = ShaderMetadataType_ThreadGroupSize, .Value = { threadCountX, threadCountY, threadCountZ } };
+        outputShaderDataList = SystemPushArray<ShaderPart>(stackMemoryArena, entryPointCount);
 
-                auto shaderByteCode = Span<uint8_t>((uint8_t*)shaderByteCodeComPtr->GetBufferPointer(), shaderByteCodeComPtr->GetBufferSize());
+        for (uint32_t i = 0; i < entryPointCount; i++)
+        {
+            auto result = &payload.Results[i];
 
-                outputShaderDataList[outputShaderDataListIndex++] = 
+            for (uint32_t j = 0; j < result->MessageCount; j++)
+            {
+                compilationMessages[compilationMessageIndex++] =
                 {
-                    .ShaderType = shaderType,
-                    .Name = SystemDuplicateBuffer(stackMemoryArena, ReadOnlySpan<char>(functionDescription.Name)),
-                    .Metadata = metadata,
-                    .ShaderCode = SystemDuplicateBuffer<uint8_t>(stackMemoryArena, shaderByteCode),
+                    .Type = result->Messages[j].Type,
+                    .Message = SystemDuplicateBuffer(memoryArena, ReadOnlySpan<char>(result->Messages[j].Message)).Pointer
                 };
             }
+
+            if (!result->HasErrors)
+            {
+                outputShaderDataList[outputShaderDataListIndex++] = result->ShaderPart;
+            }
         }
     } 
     
@@ -287,6 +479,11 @@ ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memor
         outputShaderData = CombineShaderParts(memoryArena, outputShaderDataList.Slice(0, outputShaderDataListIndex)); 
     }
 
+    if (workingMemoryArena.Storage != nullptr)
+    {
+        SystemFreeMemoryArena(workingMemoryArena);
+    }
+
     return 
     {
         .Data = 
@@ -26,4 +26,6 @@ enum DxilShaderKind
 };
 
 bool DirectXShaderCompilerIsInstalled();
+uint64_t DirectXShaderCompilerGetVersion();
+ReadOnlySpan<uint8_t> DirectXShaderCompilerPreprocessShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemToolsGraphicsApi targetGraphicsApi, const ElemCompileShaderOptions* options);
 ElemShaderCompilationResult DirectXShaderCompilerCompileShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform,const ElemCompileShaderOptions* options);
@@ -85,6 +85,13 @@ bool MetalShaderConverterIsInstalled()
     return compiler != nullptr;
 }
 
+// NOTE: The converter library doesn't expose its version so the release defined by the build is used.
+uint64_t MetalShaderConverterGetVersion()
+{
+    auto version = ReadOnlySpan<char>(METAL_SHADER_CONVERTER_VERSION);
+    return XXH64(version.Pointer, version.Length, 0);
+}
+
 ElemShaderCompilationResult MetalShaderConverterCompileShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform, const ElemCompileShaderOptions* options)
 {
     auto stackMemoryArena = SystemGetStackMemoryArena();
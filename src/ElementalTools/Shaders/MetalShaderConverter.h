@@ -4,4 +4,5 @@
 #include "SystemMemory.h"
 
 bool MetalShaderConverterIsInstalled();
+uint64_t MetalShaderConverterGetVersion();
 ElemShaderCompilationResult MetalShaderConverterCompileShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform, const ElemCompileShaderOptions* options);
@@ -2,13 +2,28 @@
 #include "ToolsUtils.h"
 #include "DirectXShaderCompiler.h"
 #include "MetalShaderConverter.h"
+#include "SpirvOptimizer.h"
+#include "ShaderCompilerUtils.h"
+#include "SystemDictionary.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
 
 #define SHADERCOMPILER_MAX_COMPILERS 32 
+#define SHADERCOMPILER_MAX_PERMUTATIONS 1024
+#define SHADERCOMPILER_MIN_MEMORY_SIZE 1024 * 1024
+
+// NOTE: The compiled library and the messages are usually a few times bigger than the source. The memory is only
+// reserved, the pages are committed when they are pushed.
+#define SHADERCOMPILER_MEMORY_SIZE_PER_SOURCE_BYTE 64
+
+// NOTE: Bump the version when the output format of the compilers changes so the old cache entries
+// are not reused.
+#define SHADERCOMPILER_CACHE_VERSION 3
 
 typedef bool (*CheckCompilerPtr)();
 typedef ElemShaderCompilationResult (*CompileShaderPtr)(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform, const ElemCompileShaderOptions* options);
+typedef ReadOnlySpan<uint8_t> (*PreprocessShaderPtr)(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemToolsGraphicsApi targetGraphicsApi, const ElemCompileShaderOptions* options);
+typedef uint64_t (*GetCompilerVersionPtr)();
 
 struct ShaderCompiler
 {
@@ -16,6 +31,20 @@ struct ShaderCompiler
     ReadOnlySpan<ElemShaderLanguage> OutputLanguages;
     CheckCompilerPtr CheckCompilerFunction; 
     CompileShaderPtr CompileShaderFunction;
+    // Optional, used to compute the cache key when the compiler is the first step of the chain.
+    PreprocessShaderPtr PreprocessShaderFunction;
+    // Optional, the cache entries are invalidated when the version changes. The steps implemented in this
+    // repository (like the SPIR-V optimizer) are covered by SHADERCOMPILER_CACHE_VERSION instead.
+    GetCompilerVersionPtr GetCompilerVersionFunction;
+};
+
+struct ShaderCacheHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t DataSizeInBytes;
+    uint64_t Key;
+    uint64_t DataHash;
 };
 
 struct ShaderCompilerStep
@@ -25,9 +54,107 @@ struct ShaderCompilerStep
     ElemShaderLanguage OutputLanguage;
 };
 
+struct CompileShaderLibraryJobPayload
+{
+    Span<MemoryArena> MemoryArenas;
+    ElemToolsGraphicsApi GraphicsApi;
+    ElemToolsPlatform Platform;
+    const ElemCompileShaderOptions* Options;
+    ReadOnlySpan<ElemCompileShaderLibraryEntry> Entries;
+    Span<ElemShaderCompilationResult> Results;
+};
+
+struct CompileShaderPermutationJobPayload
+{
+    Span<MemoryArena> MemoryArenas;
+    ElemToolsGraphicsApi GraphicsApi;
+    ElemToolsPlatform Platform;
+    const char* Path;
+    ReadOnlySpan<ElemCompileShaderOptions> Options;
+    Span<ElemShaderCompilationResult> Results;
+};
+
 MemoryArena ShaderCompilerMemoryArena;
 ReadOnlySpan<ShaderCompiler> shaderCompilers;
 
+// NOTE: Keeps the results of the last compile call alive until the next call.
+static MemoryArena CompileShaderLibraryMemoryArena;
+
+// NOTE: The message is static so it can be returned when the result doesn't fit in the memory arena.
+static ElemToolsMessage shaderCompilerOutOfMemoryMessage = 
+{
+    .Type = ElemToolsMessageType_Error,
+    .Message = "Not enough memory to store the shader compilation result."
+};
+
+void ResetCompileShaderLibraryMemoryArena(size_t sizeInBytes)
+{
+    if (CompileShaderLibraryMemoryArena.Storage != nullptr)
+    {
+        SystemFreeMemoryArena(CompileShaderLibraryMemoryArena);
+    }
+
+    CompileShaderLibraryMemoryArena = SystemAllocateMemoryArena(SHADERCOMPILER_MIN_MEMORY_SIZE + sizeInBytes);
+}
+
+size_t GetShaderCompilationResultMemorySize(const ElemShaderCompilationResult* result)
+{
+    // NOTE: Each push is aligned so the sizes are rounded up to the alignment of the arena.
+    auto sizeInBytes = SystemAlign(result->Data.Length, 8) + SystemAlign(result->Messages.Length * sizeof(ElemToolsMessage), 8);
+
+    for (uint32_t i = 0; i < result->Messages.Length; i++)
+    {
+        sizeInBytes += SystemAlign(strlen(result->Messages.Items[i].Message) + 1, 8);
+    }
+
+    return sizeInBytes;
+}
+
+ElemShaderCompilationResult CopyShaderCompilationResult(MemoryArena memoryArena, const ElemShaderCompilationResult* result)
+{
+    auto data = SystemDuplicateBuffer<uint8_t>(memoryArena, ReadOnlySpan<uint8_t>(result->Data.Items, result->Data.Length));
+    auto messages = SystemPushArray<ElemToolsMessage>(memoryArena, result->Messages.Length);
+
+    for (uint32_t i = 0; i < result->Messages.Length; i++)
+    {
+        messages[i] =
+        {
+            .Type = result->Messages.Items[i].Type,
+            .Message = SystemDuplicateBuffer<char>(memoryArena, result->Messages.Items[i].Message).Pointer
+        };
+    }
+
+    return
+    {
+        .Data = { .Items = data.Pointer, .Length = (uint32_t)data.Length },
+        .Messages = { .Items = messages.Pointer, .Length = (uint32_t)messages.Length },
+        .HasErrors = result->HasErrors
+    };
+}
+
+// NOTE: The arena of a job is sized from its source so the result is checked before it is copied.
+ElemShaderCompilationResult StoreShaderCompilationJobResult(MemoryArena memoryArena, const ElemShaderCompilationResult* result)
+{
+    auto allocationInfos = SystemGetMemoryArenaAllocationInfos(memoryArena);
+
+    if (allocationInfos.AllocatedBytes + GetShaderCompilationResultMemorySize(result) > allocationInfos.MaximumSizeInBytes)
+    {
+        return
+        {
+            .Messages = { .Items = &shaderCompilerOutOfMemoryMessage, .Length = 1 },
+            .HasErrors = true
+        };
+    }
+
+    return CopyShaderCompilationResult(memoryArena, result);
+}
+
+ElemShaderCompilationResult StoreShaderCompilationResult(const ElemShaderCompilationResult* result)
+{
+    ResetCompileShaderLibraryMemoryArena(GetShaderCompilationResultMemorySize(result));
+    return CopyShaderCompilationResult(CompileShaderLibraryMemoryArena, result);
+}
+
 ReadOnlySpan<ElemShaderLanguage> InitShaderLanguages(std::initializer_list<ElemShaderLanguage> initList)
 {
     auto array = SystemPushArray<ElemShaderLanguage>(ShaderCompilerMemoryArena, initList.size());
@@ -53,7 +180,18 @@ void InitShaderCompiler()
             .InputLanguage = ElemShaderLanguage_Hlsl, 
             .OutputLanguages = InitShaderLanguages({ ElemShaderLanguage_Dxil, ElemShaderLanguage_Spirv }),
             .CheckCompilerFunction = DirectXShaderCompilerIsInstalled,
-            .CompileShaderFunction = DirectXShaderCompilerCompileShader
+            .CompileShaderFunction = DirectXShaderCompilerCompileShader,
+            .PreprocessShaderFunction = DirectXShaderCompilerPreprocessShader,
+            .GetCompilerVersionFunction = DirectXShaderCompilerGetVersion
+        };
+
+        // NOTE: The compilers that have the same input and output language are optimization steps that are
+        // appended to the end of the chain.
+        compilerArray[shaderCompilerIndex++] = {
+            .InputLanguage = ElemShaderLanguage_Spirv, 
+            .OutputLanguages = InitShaderLanguages({ ElemShaderLanguage_Spirv }),
+            .CheckCompilerFunction = SpirvOptimizerIsInstalled,
+            .CompileShaderFunction = SpirvOptimizerCompileShader
         };
 
         #ifndef __linux__
@@ -61,7 +199,8 @@ void InitShaderCompiler()
             .InputLanguage = ElemShaderLanguage_Dxil, 
             .OutputLanguages = InitShaderLanguages({ ElemShaderLanguage_MetalIR }),
             .CheckCompilerFunction = MetalShaderConverterIsInstalled,
-            .CompileShaderFunction = MetalShaderConverterCompileShader
+            .CompileShaderFunction = MetalShaderConverterCompileShader,
+            .GetCompilerVersionFunction = MetalShaderConverterGetVersion
         };
         #endif
 
@@ -125,7 +264,7 @@ ReadOnlySpan<const ShaderCompiler*> FindShaderCompilersForTargetLanguage(ElemSha
 
         for (uint32_t j = 0; j < shaderCompiler->OutputLanguages.Length; j++)
         {
-            if (shaderCompiler->OutputLanguages[j] == targetLanguage && shaderCompiler->CheckCompilerFunction())
+            if (shaderCompiler->OutputLanguages[j] == targetLanguage && shaderCompiler->InputLanguage != targetLanguage && shaderCompiler->CheckCompilerFunction())
             {
                 result[currentIndex++] = shaderCompiler;
             }
@@ -172,6 +311,130 @@ bool FindShaderCompilerChain(ElemShaderLanguage sourceLanguage, ElemShaderLangua
     return false;
 }
 
+// NOTE: The optimization steps strip the debug information so they are skipped in debug mode.
+void AppendShaderOptimizationSteps(ElemShaderLanguage targetLanguage, Span<ShaderCompilerStep> compilerSteps, uint32_t* level, const ElemCompileShaderOptions* options)
+{
+    if (options && options->DebugMode)
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < shaderCompilers.Length; i++)
+    {
+        auto shaderCompiler = &shaderCompilers[i];
+
+        if (shaderCompiler->InputLanguage == targetLanguage && *level < compilerSteps.Length && shaderCompiler->CheckCompilerFunction())
+        {
+            compilerSteps[(*level)++] = 
+            {
+                .ShaderCompiler = shaderCompiler,
+                .InputLanguage = targetLanguage,
+                .OutputLanguage = targetLanguage
+            };
+        }
+    }
+}
+
+// NOTE: The source is hashed after preprocessing so that a change in an included file invalidates the entry.
+uint64_t ComputeShaderCacheKey(MemoryArena memoryArena, ReadOnlySpan<uint8_t> sourceData, ReadOnlySpan<ShaderCompilerStep> compilerSteps, ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const ElemCompileShaderOptions* options)
+{
+    auto keySourceData = sourceData;
+    auto firstCompiler = compilerSteps[0].ShaderCompiler;
+
+    if (firstCompiler->PreprocessShaderFunction)
+    {
+        auto preprocessedData = firstCompiler->PreprocessShaderFunction(memoryArena, sourceData, graphicsApi, options);
+
+        if (preprocessedData.Length > 0)
+        {
+            keySourceData = preprocessedData;
+        }
+    }
+
+    uint32_t keyValues[] = { SHADERCOMPILER_CACHE_VERSION, (uint32_t)graphicsApi, (uint32_t)platform, (uint32_t)options->DebugMode };
+    auto hash = XXH64(keyValues, sizeof(keyValues), 0);
+    hash = XXH64(keySourceData.Pointer, keySourceData.Length, hash);
+
+    // NOTE: The defines are already applied to the preprocessed source but not all the compilers can preprocess.
+    for (uint32_t i = 0; i < options->Defines.Length; i++)
+    {
+        auto define = options->Defines.Items[i];
+        auto defineValue = define.Value ? define.Value : "1";
+
+        hash = XXH64(define.Name, strlen(define.Name) + 1, hash);
+        hash = XXH64(defineValue, strlen(defineValue) + 1, hash);
+    }
+
+    for (uint32_t i = 0; i < compilerSteps.Length; i++)
+    {
+        auto compilerStep = &compilerSteps[i];
+        auto compilerVersion = compilerStep->ShaderCompiler->GetCompilerVersionFunction ? compilerStep->ShaderCompiler->GetCompilerVersionFunction() : 0;
+
+        uint64_t stepValues[] = { (uint64_t)compilerStep->InputLanguage, (uint64_t)compilerStep->OutputLanguage, compilerVersion };
+        hash = XXH64(stepValues, sizeof(stepValues), hash);
+    }
+
+    return hash;
+}
+
+// NOTE: The entry is validated with its hash so a partially written file is treated as a miss.
+ReadOnlySpan<uint8_t> ReadShaderCacheFile(MemoryArena memoryArena, ReadOnlySpan<char> path, uint64_t key)
+{
+    if (!SystemFileExists(path))
+    {
+        return {};
+    }
+
+    auto fileData = SystemFileReadBytes(memoryArena, path);
+
+    if (fileData.Length < sizeof(ShaderCacheHeader))
+    {
+        return {};
+    }
+
+    auto header = (const ShaderCacheHeader*)fileData.Pointer;
+    auto data = fileData.Slice(sizeof(ShaderCacheHeader));
+
+    if (memcmp(header->FileId, "ELEMSHDC", sizeof(header->FileId)) != 0 ||
+        header->Version != SHADERCOMPILER_CACHE_VERSION ||
+        header->Key != key ||
+        header->DataSizeInBytes != data.Length ||
+        XXH64(data.Pointer, data.Length, 0) != header->DataHash)
+    {
+        return {};
+    }
+
+    return data;
+}
+
+void WriteShaderCacheFile(ReadOnlySpan<char> path, uint64_t key, ReadOnlySpan<uint8_t> data)
+{
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto fileData = SystemPushArray<uint8_t>(stackMemoryArena, sizeof(ShaderCacheHeader) + data.Length);
+
+    ShaderCacheHeader header =
+    {
+        .FileId = { 'E', 'L', 'E', 'M', 'S', 'H', 'D', 'C' },
+        .Version = SHADERCOMPILER_CACHE_VERSION,
+        .DataSizeInBytes = (uint32_t)data.Length,
+        .Key = key,
+        .DataHash = XXH64(data.Pointer, data.Length, 0)
+    };
+
+    SystemCopyBuffer<uint8_t>(fileData, ReadOnlySpan<uint8_t>((uint8_t*)&header, sizeof(ShaderCacheHeader)));
+    SystemCopyBuffer<uint8_t>(fileData.Slice(sizeof(ShaderCacheHeader)), data);
+
+    // NOTE: The entry is written next to its final path and renamed so that an interrupted write or another
+    // process reading the cache never sees a partial file.
+    auto temporaryPath = SystemFormatString(stackMemoryArena, "%s.tmp", path.Pointer);
+    SystemFileWriteBytes(temporaryPath, fileData);
+
+    if (!SystemFileMove(temporaryPath, path) && SystemFileExists(temporaryPath))
+    {
+        SystemFileDelete(temporaryPath);
+    }
+}
+
 ElemToolsAPI bool ElemCanCompileShader(ElemShaderLanguage shaderLanguage, ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform)
 {
     InitShaderCompiler();
@@ -183,11 +446,11 @@ ElemToolsAPI bool ElemCanCompileShader(ElemShaderLanguage shaderLanguage, ElemTo
     return FindShaderCompilerChain(shaderLanguage, targetLanguage, compilerSteps, &level);
 }
 
-ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, const ElemCompileShaderOptions* options)
+// NOTE: The memory arena is allocated from the size of the source and must be freed by the caller. Only the output
+// data and the messages are stored in it, the temporary data uses the stack memory arena of the calling thread so
+// several libraries can be compiled at the same time.
+ElemShaderCompilationResult CompileShaderLibrary(MemoryArena* memoryArena, ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, const ElemCompileShaderOptions* options)
 {
-    SystemAssert(path);
-
-    InitShaderCompiler();
     auto stackMemoryArena = SystemGetStackMemoryArena();
     auto compilerSteps = SystemPushArray<ShaderCompilerStep>(stackMemoryArena, SHADERCOMPILER_MAX_COMPILERS);
     auto targetLanguage = GetApiTargetLanguage(graphicsApi);
@@ -199,48 +462,82 @@ ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGraph
     auto shaderLanguage = GetShaderLanguageFromPath(path);
     SystemAssert(shaderLanguage != ElemShaderLanguage_Unknown);
 
+    auto mappedFile = MapFileData(path, true);
+    auto stepSourceData = mappedFile.Data;
+
+    *memoryArena = SystemAllocateMemoryArena(SHADERCOMPILER_MIN_MEMORY_SIZE + stepSourceData.Length * SHADERCOMPILER_MEMORY_SIZE_PER_SOURCE_BYTE);
+
     if (!FindShaderCompilerChain(shaderLanguage, targetLanguage, compilerSteps, &level))
     {
+        UnmapFileData(mappedFile);
+
         return
         {
-            .Messages = ConstructErrorMessageSpan(ShaderCompilerMemoryArena, "Cannot find a compatible shader compilers chain."),
+            .Messages = ConstructErrorMessageSpan(*memoryArena, "Cannot find a compatible shader compilers chain."),
             .HasErrors = true
         };
     }
 
-    auto hasErrors = false;
+    AppendShaderOptimizationSteps(targetLanguage, compilerSteps, &level, options);
 
-    auto stepSourceData = LoadFileData(path); 
+    auto hasErrors = false;
 
     if (stepSourceData.Length == 0)
     {
         return
         {
-            .Messages = ConstructErrorMessageSpan(ShaderCompilerMemoryArena, "Cannot read input file."),
+            .Messages = ConstructErrorMessageSpan(*memoryArena, "Cannot read input file."),
             .HasErrors = true
         };
     }
 
+    auto cacheFilePath = ReadOnlySpan<char>();
+    auto cacheKey = 0ull;
+
+    if (options && options->CacheDirectory)
+    {
+        auto cacheDirectory = ReadOnlySpan<char>(options->CacheDirectory);
+        auto needSeparator = cacheDirectory.Length > 0 && cacheDirectory[cacheDirectory.Length - 1] != '/' && cacheDirectory[cacheDirectory.Length - 1] != '\\';
+
+        cacheKey = ComputeShaderCacheKey(stackMemoryArena, stepSourceData, compilerSteps.Slice(0, level), graphicsApi, platform, options);
+        cacheFilePath = SystemFormatString(stackMemoryArena, "%s%s%016llx.shader", options->CacheDirectory, needSeparator ? "/" : "", cacheKey);
+
+        auto cachedData = ReadShaderCacheFile(stackMemoryArena, cacheFilePath, cacheKey);
+
+        if (cachedData.Length > 0)
+        {
+            UnmapFileData(mappedFile);
+
+            ElemToolsMessage cacheMessage =
+            {
+                .Type = ElemToolsMessageType_Information,
+                .Message = SystemFormatString(stackMemoryArena, "Shader library read from cache: %s", cacheFilePath.Pointer).Pointer
+            };
+
+            ElemShaderCompilationResult cacheResult =
+            {
+                .Data = { .Items = (uint8_t*)cachedData.Pointer, .Length = (uint32_t)cachedData.Length },
+                .Messages = { .Items = &cacheMessage, .Length = 1 }
+            };
+
+            return StoreShaderCompilationJobResult(*memoryArena, &cacheResult);
+        }
+    }
+
     for (uint32_t i = 0; i < level; i++)
     {
         auto compilerStep = compilerSteps[i];
         auto compilationResults = compilerStep.ShaderCompiler->CompileShaderFunction(stackMemoryArena, stepSourceData, compilerStep.OutputLanguage, graphicsApi, platform, options);
 
-        auto resultMessages = SystemPushArray<ElemToolsMessage>(stackMemoryArena, compilationResults.Messages.Length);
-
         for (uint32_t j = 0; j < compilationResults.Messages.Length; j++)
         {
-            auto compilationMessage = compilationResults.Messages.Items[j];
-            resultMessages[j].Type = compilationMessage.Type;
-            resultMessages[j].Message = SystemDuplicateBuffer<char>(stackMemoryArena, compilationMessage.Message).Pointer;
-
-            if (compilationMessage.Type == ElemToolsMessageType_Error)
+            if (compilationResults.Messages.Items[j].Type == ElemToolsMessageType_Error)
             {
                 hasErrors = true;
             }
         }
 
-        compilationMessages = SystemConcatBuffers(stackMemoryArena, ReadOnlySpan<ElemToolsMessage>(compilationMessages), ReadOnlySpan<ElemToolsMessage>(resultMessages)); 
+        compilationMessages = SystemConcatBuffers(stackMemoryArena, ReadOnlySpan<ElemToolsMessage>(compilationMessages), ReadOnlySpan<ElemToolsMessage>(compilationResults.Messages.Items, compilationResults.Messages.Length)); 
 
         if (hasErrors)
         {
@@ -251,14 +548,19 @@ ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGraph
         stepSourceData = compilationData;
     }
 
-    ResetLoadFileDataMemory();
+    UnmapFileData(mappedFile);
+
+    if (!hasErrors && cacheFilePath.Length > 0 && compilationData.Length > 0)
+    {
+        WriteShaderCacheFile(cacheFilePath, cacheKey, compilationData);
+    }
 
-    return 
+    ElemShaderCompilationResult result =
     {
         .Data = 
         {
-            .Items = (uint8_t*)compilationData.Pointer,
-            .Length = (uint32_t)compilationData.Length
+            .Items = hasErrors ? nullptr : (uint8_t*)compilationData.Pointer,
+            .Length = hasErrors ? 0u : (uint32_t)compilationData.Length
         },
         .Messages = 
         {
@@ -267,4 +569,385 @@ ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGraph
         },
         .HasErrors = hasErrors
     };
+
+    return StoreShaderCompilationJobResult(*memoryArena, &result);
+}
+
+ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderLibrary(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, const ElemCompileShaderOptions* options)
+{
+    SystemAssert(path);
+
+    InitShaderCompiler();
+
+    auto memoryArena = MemoryArena();
+    auto result = CompileShaderLibrary(&memoryArena, graphicsApi, platform, path, options);
+    ResetLoadFileDataMemory();
+
+    result = StoreShaderCompilationResult(&result);
+    SystemFreeMemoryArena(memoryArena);
+
+    return result;
+}
+
+void CompileShaderLibraryJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (CompileShaderLibraryJobPayload*)payload;
+    auto entry = &jobPayload->Entries[index];
+
+    if (entry->Path == nullptr)
+    {
+        jobPayload->MemoryArenas[index] = SystemAllocateMemoryArena(SHADERCOMPILER_MIN_MEMORY_SIZE);
+        jobPayload->Results[index] = 
+        {
+            .Messages = ConstructErrorMessageSpan(jobPayload->MemoryArenas[index], "Shader library path is null."),
+            .HasErrors = true
+        };
+        return;
+    }
+
+    jobPayload->Results[index] = CompileShaderLibrary(&jobPayload->MemoryArenas[index], jobPayload->GraphicsApi, jobPayload->Platform, entry->Path, jobPayload->Options);
+}
+
+ElemToolsAPI ElemCompileShaderLibrariesResult ElemCompileShaderLibraries(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, ElemCompileShaderLibraryEntrySpan entries, const ElemCompileShaderOptions* options)
+{
+    InitShaderCompiler();
+
+    // NOTE: The compilers load their library the first time they are checked so it is done before starting
+    // the workers.
+    for (uint32_t i = 0; i < shaderCompilers.Length; i++)
+    {
+        shaderCompilers[i].CheckCompilerFunction();
+    }
+
+    // NOTE: Each library is compiled in its own arena, only the results are copied to the output arena.
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+
+    CompileShaderLibraryJobPayload payload =
+    {
+        .MemoryArenas = SystemPushArrayZero<MemoryArena>(stackMemoryArena, entries.Length),
+        .GraphicsApi = graphicsApi,
+        .Platform = platform,
+        .Options = options,
+        .Entries = ReadOnlySpan<ElemCompileShaderLibraryEntry>(entries.Items, entries.Length),
+        .Results = SystemPushArrayZero<ElemShaderCompilationResult>(stackMemoryArena, entries.Length)
+    };
+
+    ToolsParallelFor(entries.Length, CompileShaderLibraryJob, &payload);
+    ResetLoadFileDataMemory();
+
+    auto hasErrors = false;
+    auto resultsSizeInBytes = SystemAlign(entries.Length * sizeof(ElemShaderCompilationResult), 8);
+
+    for (uint32_t i = 0; i < entries.Length; i++)
+    {
+        if (payload.Results[i].HasErrors)
+        {
+            hasErrors = true;
+        }
+
+        resultsSizeInBytes += GetShaderCompilationResultMemorySize(&payload.Results[i]);
+    }
+
+    ResetCompileShaderLibraryMemoryArena(resultsSizeInBytes);
+    auto results = SystemPushArray<ElemShaderCompilationResult>(CompileShaderLibraryMemoryArena, entries.Length);
+
+    for (uint32_t i = 0; i < entries.Length; i++)
+    {
+        results[i] = CopyShaderCompilationResult(CompileShaderLibraryMemoryArena, &payload.Results[i]);
+        SystemFreeMemoryArena(payload.MemoryArenas[i]);
+    }
+
+    return
+    {
+        .Results = { .Items = results.Pointer, .Length = (uint32_t)results.Length },
+        .HasErrors = hasErrors
+    };
+}
+
+void CompileShaderPermutationJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (CompileShaderPermutationJobPayload*)payload;
+    jobPayload->Results[index] = CompileShaderLibrary(&jobPayload->MemoryArenas[index], jobPayload->GraphicsApi, jobPayload->Platform, jobPayload->Path, &jobPayload->Options[index]);
+}
+
+uint64_t ComputeShaderPartHash(const ShaderPart* shaderPart)
+{
+    auto hash = XXH64(&shaderPart->ShaderType, sizeof(ShaderType), 0);
+    hash = XXH64(shaderPart->Name.Pointer, shaderPart->Name.Length, hash);
+    hash = XXH64(shaderPart->Metadata.Pointer, shaderPart->Metadata.Length * sizeof(ShaderMetadata), hash);
+
+    return XXH64(shaderPart->ShaderCode.Pointer, shaderPart->ShaderCode.Length, hash);
+}
+
+bool IsShaderPartEqual(const ShaderPart* shaderPart1, const ShaderPart* shaderPart2)
+{
+    return shaderPart1->ShaderType == shaderPart2->ShaderType &&
+           shaderPart1->Name.Length == shaderPart2->Name.Length &&
+           shaderPart1->Metadata.Length == shaderPart2->Metadata.Length &&
+           shaderPart1->ShaderCode.Length == shaderPart2->ShaderCode.Length &&
+           memcmp(shaderPart1->Name.Pointer, shaderPart2->Name.Pointer, shaderPart1->Name.Length) == 0 &&
+           memcmp(shaderPart1->Metadata.Pointer, shaderPart2->Metadata.Pointer, shaderPart1->Metadata.Length * sizeof(ShaderMetadata)) == 0 &&
+           memcmp(shaderPart1->ShaderCode.Pointer, shaderPart2->ShaderCode.Pointer, shaderPart1->ShaderCode.Length) == 0;
+}
+
+uint32_t FindShaderPermutationFunction(ReadOnlySpan<ShaderPermutationFunction> functions, const ShaderPart* shaderPart)
+{
+    for (uint32_t i = 0; i < functions.Length; i++)
+    {
+        auto function = &functions[i];
+
+        if (function->ShaderType == shaderPart->ShaderType && function->Name.Length == shaderPart->Name.Length && memcmp(function->Name.Pointer, shaderPart->Name.Pointer, function->Name.Length) == 0)
+        {
+            return i;
+        }
+    }
+
+    return SHADER_PERMUTATION_NO_PART;
+}
+
+// NOTE: The first axis varies first so the permutation index is the sum of valueIndex * stride of each axis.
+ReadOnlySpan<ElemCompileShaderOptions> BuildShaderPermutationOptions(MemoryArena memoryArena, ElemShaderPermutationAxisSpan axes, uint32_t permutationCount, const ElemCompileShaderOptions* options)
+{
+    auto baseOptions = options ? *options : ElemCompileShaderOptions {};
+    auto result = SystemPushArray<ElemCompileShaderOptions>(memoryArena, permutationCount);
+
+    for (uint32_t i = 0; i < permutationCount; i++)
+    {
+        auto defines = SystemPushArray<ElemShaderDefine>(memoryArena, baseOptions.Defines.Length + axes.Length);
+        auto valueIndex = i;
+
+        for (uint32_t j = 0; j < baseOptions.Defines.Length; j++)
+        {
+            defines[j] = baseOptions.Defines.Items[j];
+        }
+
+        for (uint32_t j = 0; j < axes.Length; j++)
+        {
+            auto axis = axes.Items[j];
+
+            defines[baseOptions.Defines.Length + j] = { .Name = axis.Name, .Value = axis.Values.Items[valueIndex % axis.Values.Length] };
+            valueIndex /= axis.Values.Length;
+        }
+
+        result[i] = baseOptions;
+        result[i].Defines = { .Items = defines.Pointer, .Length = (uint32_t)defines.Length };
+    }
+
+    return result;
+}
+
+ReadOnlySpan<ShaderPermutationAxis> BuildShaderPermutationAxes(MemoryArena memoryArena, ElemShaderPermutationAxisSpan axes)
+{
+    auto result = SystemPushArray<ShaderPermutationAxis>(memoryArena, axes.Length);
+
+    for (uint32_t i = 0; i < axes.Length; i++)
+    {
+        auto values = SystemPushArray<ReadOnlySpan<char>>(memoryArena, axes.Items[i].Values.Length);
+
+        for (uint32_t j = 0; j < values.Length; j++)
+        {
+            values[j] = axes.Items[i].Values.Items[j];
+        }
+
+        result[i] = { .Name = axes.Items[i].Name, .Values = values };
+    }
+
+    return result;
+}
+
+ElemToolsAPI ElemShaderCompilationResult ElemCompileShaderPermutations(ElemToolsGraphicsApi graphicsApi, ElemToolsPlatform platform, const char* path, ElemShaderPermutationAxisSpan axes, const ElemCompileShaderOptions* options)
+{
+    SystemAssert(path);
+
+    InitShaderCompiler();
+
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto permutationCount = 1u;
+
+    for (uint32_t i = 0; i < axes.Length; i++)
+    {
+        auto axis = axes.Items[i];
+        SystemAssert(axis.Name);
+
+        if (axis.Values.Length == 0)
+        {
+            ElemShaderCompilationResult result =
+            {
+                .Messages = ConstructErrorMessageSpan(stackMemoryArena, SystemFormatString(stackMemoryArena, "Shader permutation axis '%s' has no values.", axis.Name).Pointer),
+                .HasErrors = true
+            };
+
+            return StoreShaderCompilationResult(&result);
+        }
+
+        permutationCount *= axis.Values.Length;
+
+        if (permutationCount > SHADERCOMPILER_MAX_PERMUTATIONS)
+        {
+            ElemShaderCompilationResult result =
+            {
+                .Messages = ConstructErrorMessageSpan(stackMemoryArena, SystemFormatString(stackMemoryArena, "Shader permutations count is greater than %d.", SHADERCOMPILER_MAX_PERMUTATIONS).Pointer),
+                .HasErrors = true
+            };
+
+            return StoreShaderCompilationResult(&result);
+        }
+    }
+
+    // NOTE: The compilers load their library the first time they are checked so it is done before starting
+    // the workers.
+    for (uint32_t i = 0; i < shaderCompilers.Length; i++)
+    {
+        shaderCompilers[i].CheckCompilerFunction();
+    }
+
+    // NOTE: The intermediate libraries are only needed to build the final one so they use the arenas of the jobs and
+    // a working arena.
+    auto workingMemoryArena = SystemAllocateMemoryArena();
+
+    CompileShaderPermutationJobPayload payload =
+    {
+        .MemoryArenas = SystemPushArrayZero<MemoryArena>(workingMemoryArena, permutationCount),
+        .GraphicsApi = graphicsApi,
+        .Platform = platform,
+        .Path = path,
+        .Options = BuildShaderPermutationOptions(workingMemoryArena, axes, permutationCount, options),
+        .Results = SystemPushArrayZero<ElemShaderCompilationResult>(workingMemoryArena, permutationCount)
+    };
+
+    ToolsParallelFor(permutationCount, CompileShaderPermutationJob, &payload);
+    ResetLoadFileDataMemory();
+
+    auto hasErrors = false;
+    auto messageCount = 0u;
+
+    for (uint32_t i = 0; i < permutationCount; i++)
+    {
+        hasErrors |= payload.Results[i].HasErrors;
+        messageCount += payload.Results[i].Messages.Length;
+    }
+
+    auto messages = SystemPushArray<ElemToolsMessage>(workingMemoryArena, messageCount);
+    auto messageIndex = 0u;
+
+    for (uint32_t i = 0; i < permutationCount; i++)
+    {
+        auto permutationMessages = payload.Results[i].Messages;
+
+        for (uint32_t j = 0; j < permutationMessages.Length; j++)
+        {
+            messages[messageIndex++] = 
+            {
+                .Type = permutationMessages.Items[j].Type,
+                .Message = SystemFormatString(workingMemoryArena, "Permutation %d: %s", i, permutationMessages.Items[j].Message).Pointer
+            };
+        }
+    }
+
+    auto outputData = Span<uint8_t>();
+
+    if (!hasErrors)
+    {
+        auto permutationParts = SystemPushArray<ReadOnlySpan<ShaderPart>>(workingMemoryArena, permutationCount);
+        auto totalPartCount = 0u;
+
+        for (uint32_t i = 0; i < permutationCount; i++)
+        {
+            permutationParts[i] = ReadShaderParts(workingMemoryArena, ReadOnlySpan<uint8_t>(payload.Results[i].Data.Items, payload.Results[i].Data.Length));
+            totalPartCount += permutationParts[i].Length;
+        }
+
+        auto functions = SystemPushArray<ShaderPermutationFunction>(workingMemoryArena, totalPartCount);
+        auto functionCount = 0u;
+
+        for (uint32_t i = 0; i < permutationCount; i++)
+        {
+            for (uint32_t j = 0; j < permutationParts[i].Length; j++)
+            {
+                auto shaderPart = &permutationParts[i][j];
+
+                if (FindShaderPermutationFunction(functions.Slice(0, functionCount), shaderPart) == SHADER_PERMUTATION_NO_PART)
+                {
+                    functions[functionCount++] = { .ShaderType = shaderPart->ShaderType, .Name = shaderPart->Name };
+                }
+            }
+        }
+
+        // NOTE: The parts are deduplicated with their hash. The content is still compared because the
+        // dictionary only stores the hash.
+        auto partIndices = SystemPushArray<uint32_t>(workingMemoryArena, permutationCount * functionCount);
+        auto uniqueParts = SystemPushArray<ShaderPart>(workingMemoryArena, totalPartCount);
+        auto uniquePartCount = 0u;
+        auto partDictionary = SystemCreateDictionary<uint64_t, uint32_t>(workingMemoryArena, SystemMax(totalPartCount, 1u));
+
+        for (uint32_t i = 0; i < partIndices.Length; i++)
+        {
+            partIndices[i] = SHADER_PERMUTATION_NO_PART;
+        }
+
+        for (uint32_t i = 0; i < permutationCount; i++)
+        {
+            for (uint32_t j = 0; j < permutationParts[i].Length; j++)
+            {
+                auto shaderPart = &permutationParts[i][j];
+                auto partHash = ComputeShaderPartHash(shaderPart);
+                auto existingPartIndex = SystemGetDictionaryValue(partDictionary, partHash);
+                auto partIndex = 0u;
+
+                if (existingPartIndex && IsShaderPartEqual(&uniqueParts[*existingPartIndex], shaderPart))
+                {
+                    partIndex = *existingPartIndex;
+                }
+                else
+                {
+                    partIndex = uniquePartCount++;
+                    uniqueParts[partIndex] = *shaderPart;
+
+                    if (!existingPartIndex)
+                    {
+                        SystemAddDictionaryEntry(partDictionary, partHash, partIndex);
+                    }
+                }
+
+                auto functionIndex = FindShaderPermutationFunction(functions.Slice(0, functionCount), shaderPart);
+                partIndices[i * functionCount + functionIndex] = partIndex;
+            }
+        }
+
+        ShaderPermutationTable permutationTable =
+        {
+            .Axes = BuildShaderPermutationAxes(workingMemoryArena, axes),
+            .Functions = functions.Slice(0, functionCount),
+            .PermutationCount = permutationCount,
+            .PartIndices = partIndices
+        };
+
+        outputData = CombineShaderParts(workingMemoryArena, uniqueParts.Slice(0, uniquePartCount), &permutationTable);
+    }
+
+    ElemShaderCompilationResult result =
+    {
+        .Data = 
+        {
+            .Items = outputData.Pointer,
+            .Length = (uint32_t)outputData.Length
+        },
+        .Messages = 
+        {
+            .Items = messages.Pointer,
+            .Length = (uint32_t)messages.Length
+        },
+        .HasErrors = hasErrors
+    };
+
+    result = StoreShaderCompilationResult(&result);
+
+    for (uint32_t i = 0; i < permutationCount; i++)
+    {
+        SystemFreeMemoryArena(payload.MemoryArenas[i]);
+    }
+
+    SystemFreeMemoryArena(workingMemoryArena);
+
+    return result;
 }
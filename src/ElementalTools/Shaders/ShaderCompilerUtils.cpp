@@ -1,162 +1,279 @@
 #include "ShaderCompilerUtils.h"
+#include "SystemFunctions.h"
 
-template<typename T>
-void WriteShaderData(Span<uint8_t> data, uint32_t* currentOffset, T value)
+struct ShaderLibraryWriter
 {
-    *(T*)data.Slice(*currentOffset).Pointer = value; 
-    *currentOffset += sizeof(T);
-}
+    Span<uint8_t> Data;
+    uint32_t StringOffset;
+};
 
-template<>
-void WriteShaderData(Span<uint8_t> data, uint32_t* currentOffset, ReadOnlySpan<uint8_t> value)
+template<typename T>
+Span<T> GetShaderLibrarySpan(Span<uint8_t> data, uint32_t offset, uint32_t count)
 {
-    SystemCopyBuffer(data.Slice(*currentOffset), value);
-    *currentOffset += value.Length;
+    return Span<T>((T*)(data.Pointer + offset), count);
 }
 
-template<>
-void WriteShaderData(Span<uint8_t> data, uint32_t* currentOffset, ReadOnlySpan<char> value)
+template<typename T>
+ReadOnlySpan<T> GetShaderLibrarySpan(ReadOnlySpan<uint8_t> data, uint32_t offset, uint32_t count)
 {
-    auto dataSpan = ReadOnlySpan<uint8_t>((uint8_t*)value.Pointer, value.Length);
-    SystemCopyBuffer(data.Slice(*currentOffset), dataSpan);
-    *currentOffset += value.Length + 1;
+    return ReadOnlySpan<T>((T*)(data.Pointer + offset), count);
 }
 
-template<typename T>
-T ReadShaderData(ReadOnlySpan<uint8_t> data, uint32_t* currentOffset)
+// NOTE: The strings are null terminated because the data is cleared when it is allocated.
+ShaderLibraryStringEntry WriteShaderLibraryString(ShaderLibraryWriter* writer, ReadOnlySpan<char> value)
 {
-    auto dataSpan = Span<uint8_t>((uint8_t*)data.Pointer, data.Length);
-    auto result = *(T*)dataSpan.Slice(*currentOffset).Pointer; 
-    *currentOffset += sizeof(T);
+    ShaderLibraryStringEntry result = { .Offset = writer->StringOffset, .Length = (uint32_t)value.Length };
+
+    SystemCopyBuffer(writer->Data.Slice(writer->StringOffset), ReadOnlySpan<uint8_t>((uint8_t*)value.Pointer, value.Length));
+    writer->StringOffset += value.Length + 1;
+
     return result;
 }
 
-Span<uint8_t> ReadShaderData(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data, uint32_t* currentOffset)
+uint64_t ComputeShaderFunctionHash(ShaderType shaderType, ReadOnlySpan<char> name)
 {
-    auto shaderPartSizeInBytes = ReadShaderData<uint32_t>(data, currentOffset);
-    auto result = SystemPushArray<uint8_t>(memoryArena, shaderPartSizeInBytes);
-
-    auto dataSpan = Span<uint8_t>((uint8_t*)data.Pointer, data.Length);
-    SystemCopyBuffer(result, ReadOnlySpan<uint8_t>(dataSpan.Slice(*currentOffset, shaderPartSizeInBytes))); 
-    *currentOffset += shaderPartSizeInBytes;
-    return result;
+    return XXH64(name.Pointer, name.Length, (uint64_t)shaderType);
 }
 
-ReadOnlySpan<char> ReadShaderStringData(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data, uint32_t* currentOffset)
+// NOTE: Without permutations each part is a function of the only permutation.
+ShaderPermutationTable BuildDefaultShaderPermutationTable(MemoryArena memoryArena, ReadOnlySpan<ShaderPart> shaderParts)
 {
-    auto stringLength = ReadShaderData<uint32_t>(data, currentOffset);
-    auto result = SystemPushArray<uint8_t>(memoryArena, stringLength);
+    auto functions = SystemPushArray<ShaderPermutationFunction>(memoryArena, shaderParts.Length);
+    auto partIndices = SystemPushArray<uint32_t>(memoryArena, shaderParts.Length);
 
-    auto dataSpan = Span<uint8_t>((uint8_t*)data.Pointer, data.Length);
-    SystemCopyBuffer(result, ReadOnlySpan<uint8_t>(dataSpan.Slice(*currentOffset, stringLength))); 
-    *currentOffset += stringLength;
-    return ReadOnlySpan<char>((char*)result.Pointer);
+    for (uint32_t i = 0; i < shaderParts.Length; i++)
+    {
+        functions[i] = { .ShaderType = shaderParts[i].ShaderType, .Name = shaderParts[i].Name };
+        partIndices[i] = i;
+    }
+
+    return
+    {
+        .Functions = functions,
+        .PermutationCount = 1,
+        .PartIndices = partIndices
+    };
 }
 
-Span<uint8_t> CombineShaderParts(MemoryArena memoryArena, ReadOnlySpan<ShaderPart> shaderParts)
+Span<uint8_t> CombineShaderParts(MemoryArena memoryArena, ReadOnlySpan<ShaderPart> shaderParts, const ShaderPermutationTable* permutationTable)
 {
-    auto dataSize = 8;
-    dataSize += sizeof(uint32_t);
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto defaultPermutationTable = ShaderPermutationTable();
 
-    for (uint32_t i = 0; i < shaderParts.Length; i++)
+    if (!permutationTable)
     {
-        dataSize += sizeof(ShaderType);
-        dataSize += sizeof(uint32_t);
+        defaultPermutationTable = BuildDefaultShaderPermutationTable(stackMemoryArena, shaderParts);
+        permutationTable = &defaultPermutationTable;
+    }
+
+    auto functions = permutationTable->Functions;
+    auto axes = permutationTable->Axes;
+
+    // NOTE: The hash table is at most half full so the probing sequences stay short.
+    auto hashTableSize = functions.Length > 0 ? (uint32_t)SystemRoundUpToPowerOf2(functions.Length * 2) : 0u;
+    auto axisValueCount = 0u;
+    auto stringDataSize = 0u;
+    auto metadataCount = 0u;
 
-        dataSize += sizeof(uint32_t);
-        dataSize += shaderParts[i].Name.Length + 1;
+    for (uint32_t i = 0; i < axes.Length; i++)
+    {
+        stringDataSize += axes[i].Name.Length + 1;
+        axisValueCount += axes[i].Values.Length;
 
-        for (uint32_t j = 0; j < shaderParts[i].Metadata.Length; j++)
+        for (uint32_t j = 0; j < axes[i].Values.Length; j++)
         {
-            dataSize += sizeof(ShaderMetadataType);
-            dataSize += 4 * sizeof(uint32_t);
+            stringDataSize += axes[i].Values[j].Length + 1;
         }
+    }
 
-        dataSize += sizeof(uint32_t);
-        dataSize += shaderParts[i].ShaderCode.Length;
+    for (uint32_t i = 0; i < functions.Length; i++)
+    {
+        stringDataSize += functions[i].Name.Length + 1;
     }
 
-    auto outputShaderData = SystemPushArray<uint8_t>(memoryArena, dataSize);
-    uint32_t currentOffset = 0;
+    for (uint32_t i = 0; i < shaderParts.Length; i++)
+    {
+        stringDataSize += shaderParts[i].Name.Length + 1;
+        metadataCount += shaderParts[i].Metadata.Length;
+    }
+
+    ShaderLibraryHeader header =
+    {
+        .FileId = { 'E', 'L', 'E', 'M', 'S', 'L', 'I', 'B' },
+        .Version = SHADER_LIBRARY_VERSION,
+        .ShaderCount = (uint32_t)shaderParts.Length,
+        .FunctionCount = (uint32_t)functions.Length,
+        .FunctionHashTableSize = hashTableSize,
+        .PermutationCount = permutationTable->PermutationCount,
+        .AxisCount = (uint32_t)axes.Length,
+        .AxisValueCount = axisValueCount
+    };
+
+    uint32_t dataSize = sizeof(ShaderLibraryHeader);
 
-    char signature[8] = { 'E', 'L', 'E', 'M', 'S', 'L', 'I', 'B' };
+    header.ShadersOffset = dataSize;
+    dataSize += header.ShaderCount * sizeof(ShaderLibraryShaderEntry);
 
-    for (uint32_t i = 0; i < ARRAYSIZE(signature); i++)
+    header.FunctionsOffset = dataSize;
+    dataSize += header.FunctionCount * sizeof(ShaderLibraryFunctionEntry);
+
+    header.FunctionHashTableOffset = dataSize;
+    dataSize += header.FunctionHashTableSize * sizeof(uint32_t);
+
+    header.PermutationTableOffset = dataSize;
+    dataSize += header.PermutationCount * header.FunctionCount * sizeof(uint32_t);
+
+    header.AxesOffset = dataSize;
+    dataSize += header.AxisCount * sizeof(ShaderLibraryAxisEntry);
+
+    header.AxisValuesOffset = dataSize;
+    dataSize += header.AxisValueCount * sizeof(ShaderLibraryStringEntry);
+
+    auto metadataOffset = dataSize;
+    dataSize += metadataCount * sizeof(ShaderMetadata);
+
+    auto stringOffset = dataSize;
+    dataSize += stringDataSize;
+
+    auto codeOffset = (uint32_t)SystemAlign(dataSize, SHADER_LIBRARY_CODE_ALIGNMENT);
+    dataSize = codeOffset;
+
+    for (uint32_t i = 0; i < shaderParts.Length; i++)
     {
-        WriteShaderData(outputShaderData, &currentOffset, signature[i]);
+        dataSize = (uint32_t)SystemAlign(dataSize + shaderParts[i].ShaderCode.Length, SHADER_LIBRARY_CODE_ALIGNMENT);
     }
 
-    WriteShaderData(outputShaderData, &currentOffset, (uint32_t)shaderParts.Length);
+    header.DataSizeInBytes = dataSize;
+
+    auto outputShaderData = SystemPushArrayZero<uint8_t>(memoryArena, dataSize);
+    ShaderLibraryWriter writer = { .Data = outputShaderData, .StringOffset = stringOffset };
+
+    SystemCopyBuffer(outputShaderData, ReadOnlySpan<uint8_t>((uint8_t*)&header, sizeof(ShaderLibraryHeader)));
+
+    auto shaderEntries = GetShaderLibrarySpan<ShaderLibraryShaderEntry>(outputShaderData, header.ShadersOffset, header.ShaderCount);
 
     for (uint32_t i = 0; i < shaderParts.Length; i++)
     {
         auto shaderPart = shaderParts[i];
+        auto name = WriteShaderLibraryString(&writer, shaderPart.Name);
 
-        WriteShaderData(outputShaderData, &currentOffset, shaderPart.ShaderType);
+        SystemCopyBuffer(outputShaderData.Slice(metadataOffset), ReadOnlySpan<uint8_t>((uint8_t*)shaderPart.Metadata.Pointer, shaderPart.Metadata.Length * sizeof(ShaderMetadata)));
+        SystemCopyBuffer(outputShaderData.Slice(codeOffset), shaderPart.ShaderCode);
 
-        WriteShaderData(outputShaderData, &currentOffset, (uint32_t)shaderPart.Name.Length + 1);
-        WriteShaderData(outputShaderData, &currentOffset, shaderPart.Name);
+        shaderEntries[i] = 
+        {
+            .ShaderType = (uint32_t)shaderPart.ShaderType,
+            .NameOffset = name.Offset,
+            .NameLength = name.Length,
+            .MetadataOffset = metadataOffset,
+            .MetadataCount = (uint32_t)shaderPart.Metadata.Length,
+            .CodeOffset = codeOffset,
+            .CodeSizeInBytes = (uint32_t)shaderPart.ShaderCode.Length
+        };
+
+        metadataOffset += shaderPart.Metadata.Length * sizeof(ShaderMetadata);
+        codeOffset = (uint32_t)SystemAlign(codeOffset + shaderPart.ShaderCode.Length, SHADER_LIBRARY_CODE_ALIGNMENT);
+    }
 
-        WriteShaderData(outputShaderData, &currentOffset, (uint32_t)shaderPart.Metadata.Length);
+    auto functionEntries = GetShaderLibrarySpan<ShaderLibraryFunctionEntry>(outputShaderData, header.FunctionsOffset, header.FunctionCount);
+    auto hashTable = GetShaderLibrarySpan<uint32_t>(outputShaderData, header.FunctionHashTableOffset, header.FunctionHashTableSize);
 
-        for (uint32_t j = 0; j < shaderPart.Metadata.Length; j++)
-        {
-            auto metadata = shaderPart.Metadata[j];
-            WriteShaderData(outputShaderData, &currentOffset, metadata.Type);
+    for (uint32_t i = 0; i < hashTable.Length; i++)
+    {
+        hashTable[i] = SHADER_PERMUTATION_NO_PART;
+    }
+
+    for (uint32_t i = 0; i < functions.Length; i++)
+    {
+        auto function = functions[i];
+        auto name = WriteShaderLibraryString(&writer, function.Name);
+
+        functionEntries[i] = { .ShaderType = (uint32_t)function.ShaderType, .NameOffset = name.Offset, .NameLength = name.Length };
+
+        auto hashTableIndex = ComputeShaderFunctionHash(function.ShaderType, function.Name) & (hashTableSize - 1);
 
-            for (uint32_t k = 0; k < ARRAYSIZE(metadata.Value); k++)
-            {
-                WriteShaderData(outputShaderData, &currentOffset, metadata.Value[k]);
-            }
+        while (hashTable[hashTableIndex] != SHADER_PERMUTATION_NO_PART)
+        {
+            hashTableIndex = (hashTableIndex + 1) & (hashTableSize - 1);
         }
 
-        WriteShaderData(outputShaderData, &currentOffset, (uint32_t)shaderPart.ShaderCode.Length);
-        WriteShaderData(outputShaderData, &currentOffset, shaderPart.ShaderCode);
+        hashTable[hashTableIndex] = i;
+    }
+
+    auto permutationTableData = GetShaderLibrarySpan<uint32_t>(outputShaderData, header.PermutationTableOffset, header.PermutationCount * header.FunctionCount);
+    SystemCopyBuffer(permutationTableData, permutationTable->PartIndices);
+
+    auto axisEntries = GetShaderLibrarySpan<ShaderLibraryAxisEntry>(outputShaderData, header.AxesOffset, header.AxisCount);
+    auto axisValueEntries = GetShaderLibrarySpan<ShaderLibraryStringEntry>(outputShaderData, header.AxisValuesOffset, header.AxisValueCount);
+    auto axisValueIndex = 0u;
+
+    for (uint32_t i = 0; i < axes.Length; i++)
+    {
+        auto name = WriteShaderLibraryString(&writer, axes[i].Name);
+        axisEntries[i] = { .NameOffset = name.Offset, .NameLength = name.Length, .FirstValueIndex = axisValueIndex, .ValueCount = (uint32_t)axes[i].Values.Length };
+
+        for (uint32_t j = 0; j < axes[i].Values.Length; j++)
+        {
+            axisValueEntries[axisValueIndex++] = WriteShaderLibraryString(&writer, axes[i].Values[j]);
+        }
     }
 
     return outputShaderData;
 }
 
+// NOTE: The sizes are computed in 64 bits so corrupted offsets or counts cannot wrap around.
+bool CheckShaderLibraryRange(const ShaderLibraryHeader* header, uint64_t offset, uint64_t sizeInBytes)
+{
+    return offset <= header->DataSizeInBytes && sizeInBytes <= header->DataSizeInBytes - offset;
+}
+
+// NOTE: The parts point directly into the data so it must stay alive while they are used.
 ReadOnlySpan<ShaderPart> ReadShaderParts(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data)
 {
-    uint32_t currentOffset = 0;
+    if (data.Length < sizeof(ShaderLibraryHeader))
+    {
+        return {};
+    }
 
-    char signature[9] = { };
+    auto header = (const ShaderLibraryHeader*)data.Pointer;
 
-    for (uint32_t i = 0; i < ARRAYSIZE(signature) - 1; i++)
+    if (memcmp(header->FileId, "ELEMSLIB", sizeof(header->FileId)) != 0 || header->Version != SHADER_LIBRARY_VERSION || header->DataSizeInBytes > data.Length)
     {
-        signature[i] = ReadShaderData<char>(data, &currentOffset);
+        return {}; 
     }
 
-    if (!strstr(signature, "ELEMSLIB"))
+    if (!CheckShaderLibraryRange(header, header->ShadersOffset, (uint64_t)header->ShaderCount * sizeof(ShaderLibraryShaderEntry)))
     {
-        return {}; 
+        return {};
     }
 
-    auto shaderPartsCount = ReadShaderData<uint32_t>(data, &currentOffset);
-    auto shaderParts = SystemPushArray<ShaderPart>(memoryArena, shaderPartsCount);
+    auto shaderEntries = GetShaderLibrarySpan<ShaderLibraryShaderEntry>(data, header->ShadersOffset, header->ShaderCount);
 
-    for (uint32_t i = 0; i < shaderPartsCount; i++)
+    for (uint32_t i = 0; i < shaderEntries.Length; i++)
     {
-        shaderParts[i].ShaderType = ReadShaderData<ShaderType>(data, &currentOffset);
-        auto name = ReadShaderStringData(memoryArena, data, &currentOffset);
-
-        auto metadataLength = ReadShaderData<uint32_t>(data, &currentOffset);
-        auto metadata = SystemPushArray<ShaderMetadata>(memoryArena, metadataLength);
+        auto shaderEntry = &shaderEntries[i];
 
-        for (uint32_t j = 0; j < metadataLength; j++)
+        if (!CheckShaderLibraryRange(header, shaderEntry->NameOffset, shaderEntry->NameLength) ||
+            !CheckShaderLibraryRange(header, shaderEntry->MetadataOffset, (uint64_t)shaderEntry->MetadataCount * sizeof(ShaderMetadata)) ||
+            !CheckShaderLibraryRange(header, shaderEntry->CodeOffset, shaderEntry->CodeSizeInBytes))
         {
-            metadata[j].Type = ReadShaderData<ShaderMetadataType>(data, &currentOffset);
-
-            for (uint32_t k = 0; k < ARRAYSIZE(metadata[j].Value); k++)
-            {
-                metadata[j].Value[k] = ReadShaderData<uint32_t>(data, &currentOffset);
-            }
+            return {};
         }
+    }
 
-        shaderParts[i].Name = name;
-        shaderParts[i].Metadata = metadata;
-        shaderParts[i].ShaderCode = ReadShaderData(memoryArena, data, &currentOffset);
+    auto shaderParts = SystemPushArray<ShaderPart>(memoryArena, header->ShaderCount);
+
+    for (uint32_t i = 0; i < shaderEntries.Length; i++)
+    {
+        auto shaderEntry = shaderEntries[i];
+
+        shaderParts[i] = 
+        {
+            .ShaderType = (ShaderType)shaderEntry.ShaderType,
+            .Name = ReadOnlySpan<char>((char*)data.Pointer + shaderEntry.NameOffset, shaderEntry.NameLength),
+            .Metadata = GetShaderLibrarySpan<ShaderMetadata>(data, shaderEntry.MetadataOffset, shaderEntry.MetadataCount),
+            .ShaderCode = GetShaderLibrarySpan<uint8_t>(data, shaderEntry.CodeOffset, shaderEntry.CodeSizeInBytes)
+        };
     }
 
     return shaderParts;
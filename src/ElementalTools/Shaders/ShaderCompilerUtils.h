@@ -31,5 +31,88 @@ struct ShaderPart
     ReadOnlySpan<uint8_t> ShaderCode;
 };
 
-Span<uint8_t> CombineShaderParts(MemoryArena memoryArena, ReadOnlySpan<ShaderPart> shaderParts);
+// NOTE: The layout must match the one read by the runtime. All the offsets are relative to the start of
+// the data and all the fields are 4 bytes so the structures can be read in place.
+#define SHADER_LIBRARY_VERSION 2
+#define SHADER_LIBRARY_CODE_ALIGNMENT 16
+
+struct ShaderLibraryHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t DataSizeInBytes;
+    uint32_t ShaderCount;
+    uint32_t FunctionCount;
+    uint32_t FunctionHashTableSize;
+    uint32_t PermutationCount;
+    uint32_t AxisCount;
+    uint32_t AxisValueCount;
+    uint32_t ShadersOffset;
+    uint32_t FunctionsOffset;
+    uint32_t FunctionHashTableOffset;
+    uint32_t PermutationTableOffset;
+    uint32_t AxesOffset;
+    uint32_t AxisValuesOffset;
+};
+
+struct ShaderLibraryShaderEntry
+{
+    uint32_t ShaderType;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t MetadataOffset;
+    uint32_t MetadataCount;
+    uint32_t CodeOffset;
+    uint32_t CodeSizeInBytes;
+    uint32_t Reserved;
+};
+
+struct ShaderLibraryFunctionEntry
+{
+    uint32_t ShaderType;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t Reserved;
+};
+
+struct ShaderLibraryAxisEntry
+{
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t FirstValueIndex;
+    uint32_t ValueCount;
+};
+
+struct ShaderLibraryStringEntry
+{
+    uint32_t Offset;
+    uint32_t Length;
+};
+
+struct ShaderPermutationAxis
+{
+    ReadOnlySpan<char> Name;
+    ReadOnlySpan<ReadOnlySpan<char>> Values;
+};
+
+struct ShaderPermutationFunction
+{
+    ShaderType ShaderType;
+    ReadOnlySpan<char> Name;
+};
+
+// NOTE: The part indices are stored per permutation so the runtime can find the shaders of a permutation
+// with its index. SHADER_PERMUTATION_NO_PART is used when a function is not present in a permutation.
+struct ShaderPermutationTable
+{
+    ReadOnlySpan<ShaderPermutationAxis> Axes;
+    ReadOnlySpan<ShaderPermutationFunction> Functions;
+    uint32_t PermutationCount;
+    ReadOnlySpan<uint32_t> PartIndices;
+};
+
+#define SHADER_PERMUTATION_NO_PART UINT32_MAX
+
+uint64_t ComputeShaderFunctionHash(ShaderType shaderType, ReadOnlySpan<char> name);
+Span<uint8_t> CombineShaderParts(MemoryArena memoryArena, ReadOnlySpan<ShaderPart> shaderParts, const ShaderPermutationTable* permutationTable = nullptr);
 ReadOnlySpan<ShaderPart> ReadShaderParts(MemoryArena memoryArena, ReadOnlySpan<uint8_t> data);
@@ -0,0 +1,215 @@
+#include "SpirvOptimizer.h"
+#include "ShaderCompilerUtils.h"
+#include "SystemFunctions.h"
+#include "SystemMemory.h"
+
+// NOTE: DXC already runs the spirv-opt performance passes (dead code elimination, inlining, constant folding)
+// when it compiles without -Od. This step removes what the driver doesn't need: the debug instructions and the
+// HLSL reflection decorations.
+// See: https://registry.khronos.org/SPIR-V/specs/unified1/SPIRV.html
+
+#define SPIRV_MAGIC_NUMBER 0x07230203
+#define SPIRV_HEADER_WORD_COUNT 5
+
+enum SpirvOpCode
+{
+    SpirvOpCode_SourceContinued = 2,
+    SpirvOpCode_Source = 3,
+    SpirvOpCode_SourceExtension = 4,
+    SpirvOpCode_Name = 5,
+    SpirvOpCode_MemberName = 6,
+    SpirvOpCode_String = 7,
+    SpirvOpCode_Line = 8,
+    SpirvOpCode_Extension = 10,
+    SpirvOpCode_ExtInstImport = 11,
+    SpirvOpCode_Decorate = 71,
+    SpirvOpCode_MemberDecorate = 72,
+    SpirvOpCode_NoLine = 317,
+    SpirvOpCode_ModuleProcessed = 330,
+    SpirvOpCode_DecorateId = 332,
+    SpirvOpCode_DecorateString = 5632,
+    SpirvOpCode_MemberDecorateString = 5633
+};
+
+enum SpirvDecoration
+{
+    SpirvDecoration_HlslCounterBufferGOOGLE = 5634,
+    SpirvDecoration_UserSemantic = 5635,
+    SpirvDecoration_UserTypeGOOGLE = 5636
+};
+
+struct SpirvInstruction
+{
+    uint32_t OpCode;
+    ReadOnlySpan<uint32_t> Words;
+};
+
+SpirvInstruction ReadSpirvInstruction(ReadOnlySpan<uint32_t> module, uint32_t offset)
+{
+    auto wordCount = module[offset] >> 16;
+
+    if (wordCount == 0 || offset + wordCount > module.Length)
+    {
+        return {};
+    }
+
+    return 
+    {
+        .OpCode = module[offset] & 0xFFFF,
+        .Words = ReadOnlySpan<uint32_t>((uint32_t*)module.Pointer + offset, wordCount)
+    };
+}
+
+// NOTE: The strings are null terminated and padded to the next word.
+const char* GetSpirvString(ReadOnlySpan<uint32_t> words, uint32_t wordOffset)
+{
+    if (wordOffset >= words.Length || (words[words.Length - 1] >> 24) != 0)
+    {
+        return "";
+    }
+
+    return (const char*)(words.Pointer + wordOffset);
+}
+
+bool IsSpirvReflectionInstruction(SpirvInstruction instruction)
+{
+    switch (instruction.OpCode)
+    {
+        case SpirvOpCode_DecorateString:
+        case SpirvOpCode_DecorateId:
+            return instruction.Words.Length > 2 && (instruction.Words[2] == SpirvDecoration_UserSemantic || 
+                                                    instruction.Words[2] == SpirvDecoration_HlslCounterBufferGOOGLE || 
+                                                    instruction.Words[2] == SpirvDecoration_UserTypeGOOGLE);
+
+        case SpirvOpCode_Decorate:
+            return instruction.Words.Length > 2 && instruction.Words[2] == SpirvDecoration_UserTypeGOOGLE;
+
+        case SpirvOpCode_MemberDecorateString:
+        case SpirvOpCode_MemberDecorate:
+            return instruction.Words.Length > 3 && (instruction.Words[3] == SpirvDecoration_UserSemantic || 
+                                                    instruction.Words[3] == SpirvDecoration_UserTypeGOOGLE);
+
+        case SpirvOpCode_Extension:
+            return strcmp(GetSpirvString(instruction.Words, 1), "SPV_GOOGLE_hlsl_functionality1") == 0 || 
+                   strcmp(GetSpirvString(instruction.Words, 1), "SPV_GOOGLE_user_type") == 0;
+
+        default:
+            return false;
+    }
+}
+
+// NOTE: The strings are kept when the module uses non semantic instructions because they can reference them.
+bool IsSpirvDebugInstruction(SpirvInstruction instruction, bool hasNonSemanticInstructions)
+{
+    switch (instruction.OpCode)
+    {
+        case SpirvOpCode_SourceContinued:
+        case SpirvOpCode_Source:
+        case SpirvOpCode_SourceExtension:
+        case SpirvOpCode_Name:
+        case SpirvOpCode_MemberName:
+        case SpirvOpCode_Line:
+        case SpirvOpCode_NoLine:
+        case SpirvOpCode_ModuleProcessed:
+            return true;
+
+        case SpirvOpCode_String:
+            return !hasNonSemanticInstructions;
+
+        default:
+            return false;
+    }
+}
+
+ReadOnlySpan<uint8_t> StripSpirvModule(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode)
+{
+    auto module = ReadOnlySpan<uint32_t>((uint32_t*)shaderCode.Pointer, shaderCode.Length / sizeof(uint32_t));
+
+    if (module.Length < SPIRV_HEADER_WORD_COUNT || module[0] != SPIRV_MAGIC_NUMBER)
+    {
+        return shaderCode;
+    }
+
+    auto hasNonSemanticInstructions = false;
+
+    for (uint32_t offset = SPIRV_HEADER_WORD_COUNT; offset < module.Length;)
+    {
+        auto instruction = ReadSpirvInstruction(module, offset);
+
+        if (instruction.Words.Length == 0)
+        {
+            return shaderCode;
+        }
+
+        if (instruction.OpCode == SpirvOpCode_ExtInstImport && strncmp(GetSpirvString(instruction.Words, 2), "NonSemantic.", 12) == 0)
+        {
+            hasNonSemanticInstructions = true;
+        }
+
+        offset += instruction.Words.Length;
+    }
+
+    auto result = SystemPushArray<uint32_t>(memoryArena, module.Length);
+    SystemCopyBuffer(result, ReadOnlySpan<uint32_t>((uint32_t*)module.Pointer, SPIRV_HEADER_WORD_COUNT));
+    auto resultLength = SPIRV_HEADER_WORD_COUNT;
+
+    for (uint32_t offset = SPIRV_HEADER_WORD_COUNT; offset < module.Length;)
+    {
+        auto instruction = ReadSpirvInstruction(module, offset);
+
+        if (!IsSpirvDebugInstruction(instruction, hasNonSemanticInstructions) && !IsSpirvReflectionInstruction(instruction))
+        {
+            SystemCopyBuffer(result.Slice(resultLength), instruction.Words);
+            resultLength += instruction.Words.Length;
+        }
+
+        offset += instruction.Words.Length;
+    }
+
+    return ReadOnlySpan<uint8_t>((uint8_t*)result.Pointer, resultLength * sizeof(uint32_t));
+}
+
+bool SpirvOptimizerIsInstalled()
+{
+    return true;
+}
+
+ElemShaderCompilationResult SpirvOptimizerCompileShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform, const ElemCompileShaderOptions* options)
+{
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+
+    auto shaderParts = ReadShaderParts(stackMemoryArena, shaderCode);
+    auto outputShaderParts = SystemPushArray<ShaderPart>(stackMemoryArena, shaderParts.Length);
+    auto compilationMessages = SystemPushArray<ElemToolsMessage>(memoryArena, shaderParts.Length);
+
+    for (uint32_t i = 0; i < shaderParts.Length; i++)
+    {
+        auto shaderPart = shaderParts[i];
+        auto optimizedShaderCode = StripSpirvModule(stackMemoryArena, shaderPart.ShaderCode);
+
+        outputShaderParts[i] = shaderPart;
+        outputShaderParts[i].ShaderCode = optimizedShaderCode;
+
+        compilationMessages[i] =
+        {
+            .Type = ElemToolsMessageType_Information,
+            .Message = SystemFormatString(memoryArena, "SPIR-V %s: %d bytes => %d bytes", shaderPart.Name.Pointer, (uint32_t)shaderPart.ShaderCode.Length, (uint32_t)optimizedShaderCode.Length).Pointer
+        };
+    }
+
+    auto outputShaderData = CombineShaderParts(memoryArena, outputShaderParts); 
+
+    return 
+    {
+        .Data = 
+        {
+            .Items = outputShaderData.Pointer,
+            .Length = (uint32_t)outputShaderData.Length
+        },
+        .Messages = 
+        {
+            .Items = compilationMessages.Pointer,
+            .Length = (uint32_t)compilationMessages.Length
+        }
+    };
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "ElementalTools.h"
+#include "SystemMemory.h"
+
+bool SpirvOptimizerIsInstalled();
+ElemShaderCompilationResult SpirvOptimizerCompileShader(MemoryArena memoryArena, ReadOnlySpan<uint8_t> shaderCode, ElemShaderLanguage targetLanguage, ElemToolsGraphicsApi targetGraphicsApi, ElemToolsPlatform targetPlatform, const ElemCompileShaderOptions* options);
@@ -0,0 +1,393 @@
+#include "ElementalTools.h"
+#include "ToolsUtils.h"
+#include "TextureLoader.h"
+#include "SystemMemory.h"
+#include "SystemFunctions.h"
+#include "SystemPlatformFunctions.h"
+
+#define TEXTURE_BUILDER_DEFAULT_MAX_TEXTURE_COUNT 16
+#define TEXTURE_BUILDER_COMPRESS_JOB_BLOCK_ROWS 16
+#define TEXTURE_BUILDER_MIN_WORKING_MEMORY_SIZE 512llu * 1024 * 1024
+#define TEXTURE_BUILDER_WORKING_MEMORY_SIZE_PER_TEXTURE 256llu * 1024 * 1024
+#define TEXTURE_BUILDER_RESULT_MEMORY_SIZE 1024 * 1024
+
+struct TextureBuildItem
+{
+    ElemToolsGraphicsFormat Format;
+    ElemLoadTextureResult LoadResult;
+    LoadedTextureStorage LoadStorage;
+    Span<ElemTextureMipData> MipData;
+    Span<ElemTextureMipData> OutputMipData;
+};
+
+struct TextureBuildJob
+{
+    uint32_t ItemIndex;
+    uint32_t MipLevel;
+    uint32_t StartBlockRow;
+    uint32_t BlockRowCount;
+};
+
+struct TextureBuildJobPayload
+{
+    MemoryArena MemoryArena;
+    ReadOnlySpan<ElemBuildTextureEntry> Entries;
+    Span<TextureBuildItem> Items;
+    Span<TextureBuildJob> Jobs;
+    const TextureCompressionParameters* CompressionParameters;
+};
+
+struct TextureBuildStageStatistics
+{
+    uint64_t SizeInBytes;
+    double ElapsedMilliseconds;
+};
+
+// NOTE: Keeps the messages of the last ElemBuildTextures call alive until the next call.
+static MemoryArena TextureBuilderMemoryArena;
+
+bool IsTextureSourceFormat(ElemToolsGraphicsFormat format)
+{
+    return format == ElemToolsGraphicsFormat_R8G8B8A8 || format == ElemToolsGraphicsFormat_R32G32B32A32_FLOAT;
+}
+
+void SetTextureBuildItemOutOfMemoryError(MemoryArena memoryArena, TextureBuildItem* item)
+{
+    item->LoadResult.Messages = ConstructErrorMessageSpan(memoryArena, "Not enough working memory to build the texture, reduce MaxTextureCountInFlight.");
+    item->LoadResult.HasErrors = true;
+    item->OutputMipData = {};
+}
+
+void LoadTextureJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (TextureBuildJobPayload*)payload;
+    auto entry = &jobPayload->Entries[index];
+    auto item = &jobPayload->Items[index];
+
+    item->Format = entry->Format != ElemToolsGraphicsFormat_Unknown ? entry->Format : ElemToolsGraphicsFormat_BC7;
+    item->LoadResult = LoadTexture(entry->Path, nullptr, &item->LoadStorage);
+
+    if (item->LoadResult.HasErrors || item->LoadResult.MipData.Length == 0)
+    {
+        return;
+    }
+
+    if (item->LoadResult.Type != ElemToolsTextureType_Texture2D || item->LoadResult.ArraySize > 1)
+    {
+        item->LoadResult.Messages = ConstructErrorMessageSpan(item->LoadStorage.MemoryArena, "Only Texture2D can be built.");
+        item->LoadResult.HasErrors = true;
+        return;
+    }
+
+    item->MipData = Span<ElemTextureMipData>(item->LoadResult.MipData.Items, item->LoadResult.MipData.Length);
+    item->OutputMipData = item->MipData;
+
+    // NOTE: Compressed textures are written as is, the mips cannot be generated from them.
+    if (IsTextureSourceFormat(item->LoadResult.Format) && item->MipData.Length == 1)
+    {
+        auto mipCount = GetTextureMipCount(item->LoadResult.Width, item->LoadResult.Height);
+
+        item->MipData = SystemPushArray<ElemTextureMipData>(jobPayload->MemoryArena, mipCount);
+
+        if (item->MipData.Pointer == nullptr)
+        {
+            SetTextureBuildItemOutOfMemoryError(jobPayload->MemoryArena, item);
+            return;
+        }
+
+        item->MipData[0] = item->LoadResult.MipData.Items[0];
+        item->OutputMipData = item->MipData;
+    }
+}
+
+void GenerateTextureMipJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (TextureBuildJobPayload*)payload;
+    auto job = &jobPayload->Jobs[index];
+    auto item = &jobPayload->Items[job->ItemIndex];
+
+    item->MipData[job->MipLevel] = GenerateTextureMipLevel(jobPayload->MemoryArena, item->LoadResult.Format, &item->MipData[0], job->MipLevel);
+}
+
+void CompressTextureJob(uint32_t index, void* payload)
+{
+    auto jobPayload = (TextureBuildJobPayload*)payload;
+    auto job = &jobPayload->Jobs[index];
+    auto item = &jobPayload->Items[job->ItemIndex];
+
+    CompressTextureBlockRows(item->Format, item->LoadResult.Format, &item->MipData[job->MipLevel], job->StartBlockRow, job->BlockRowCount, jobPayload->CompressionParameters, item->OutputMipData[job->MipLevel].Data.Items);
+}
+
+bool NeedTextureCompression(const TextureBuildItem* item)
+{
+    return !item->LoadResult.HasErrors && IsTextureSourceFormat(item->LoadResult.Format) && GetTextureFormatBlockSizeInBytes(item->Format) > 0;
+}
+
+void RunTextureBuildStage(TextureBuildJobPayload* payload, uint32_t jobCount, ToolsParallelForFunction function, TextureBuildStageStatistics* statistics)
+{
+    auto startTimestamp = SystemPlatformGetHighPerformanceCounter();
+    ToolsParallelFor(jobCount, function, payload);
+    statistics->ElapsedMilliseconds += ToolsGetElapsedMilliseconds(startTimestamp);
+}
+
+void WriteTextureBuildStageStatistics(const char* stageName, const TextureBuildStageStatistics* statistics, ToolsMessageList* messageList)
+{
+    auto sizeInMegaBytes = (double)statistics->SizeInBytes / (1024.0 * 1024.0);
+    auto throughput = statistics->ElapsedMilliseconds > 0.0 ? sizeInMegaBytes / (statistics->ElapsedMilliseconds / 1000.0) : 0.0;
+
+    WriteToMessageList(ElemToolsMessageType_Information,
+                       SystemFormatString(TextureBuilderMemoryArena, "%s: %.2f MB/s (%.2f MB in %.2f ms)", stageName, throughput, sizeInMegaBytes, statistics->ElapsedMilliseconds).Pointer,
+                       messageList);
+}
+
+ElemToolsAPI ElemBuildTexturesResult ElemBuildTextures(ElemBuildTextureEntrySpan entries, const ElemBuildTexturesOptions* options)
+{
+    if (TextureBuilderMemoryArena.Storage != nullptr)
+    {
+        SystemFreeMemoryArena(TextureBuilderMemoryArena);
+    }
+
+    TextureBuilderMemoryArena = SystemAllocateMemoryArena(TEXTURE_BUILDER_RESULT_MEMORY_SIZE);
+
+    ElemBuildTexturesOptions buildOptions = {};
+
+    if (options)
+    {
+        buildOptions = *options;
+    }
+
+    if (buildOptions.MaxTextureCountInFlight == 0)
+    {
+        buildOptions.MaxTextureCountInFlight = TEXTURE_BUILDER_DEFAULT_MAX_TEXTURE_COUNT;
+    }
+
+    if (buildOptions.BuildTextureHandler == nullptr)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(TextureBuilderMemoryArena, "A build texture handler is needed to receive the built textures."),
+            .HasErrors = true
+        };
+    }
+
+    ToolsMessageList messageList =
+    {
+        .Messages = SystemPushArray<ElemToolsMessage>(TextureBuilderMemoryArena, 8)
+    };
+
+    TextureCompressionParameters compressionParameters;
+    InitTextureCompressionParameters(&compressionParameters);
+
+    // NOTE: Each texture is loaded in its own arena sized from the file header. The working memory holds the mips
+    // and the compressed data and is reserved for the number of textures in flight, pages are committed when they
+    // are pushed. The arena is cleared after each batch so the memory usage doesn't depend on the number of entries.
+    // A texture that doesn't fit in its share of the reservation is reported as an error.
+    auto workingMemorySize = SystemMax((uint64_t)TEXTURE_BUILDER_MIN_WORKING_MEMORY_SIZE, (uint64_t)(buildOptions.MaxTextureCountInFlight * TEXTURE_BUILDER_WORKING_MEMORY_SIZE_PER_TEXTURE));
+    auto workingMemoryArena = SystemAllocateMemoryArena(workingMemorySize);
+
+    TextureBuildStageStatistics loadStatistics = {};
+    TextureBuildStageStatistics mipStatistics = {};
+    TextureBuildStageStatistics compressStatistics = {};
+
+    auto builtTextureCount = 0u;
+    auto hasErrors = false;
+
+    for (uint32_t batchStart = 0; batchStart < entries.Length; batchStart += buildOptions.MaxTextureCountInFlight)
+    {
+        SystemClearMemoryArena(workingMemoryArena);
+
+        auto batchCount = SystemMin(buildOptions.MaxTextureCountInFlight, entries.Length - batchStart);
+
+        TextureBuildJobPayload payload =
+        {
+            .MemoryArena = workingMemoryArena,
+            .Entries = ReadOnlySpan<ElemBuildTextureEntry>(entries.Items + batchStart, batchCount),
+            .Items = SystemPushArrayZero<TextureBuildItem>(workingMemoryArena, batchCount),
+            .CompressionParameters = &compressionParameters
+        };
+
+        RunTextureBuildStage(&payload, batchCount, LoadTextureJob, &loadStatistics);
+
+        auto mipJobCount = 0u;
+        auto compressJobCount = 0u;
+
+        for (uint32_t i = 0; i < batchCount; i++)
+        {
+            auto item = &payload.Items[i];
+
+            if (item->LoadResult.HasErrors)
+            {
+                continue;
+            }
+
+            for (uint32_t j = 0; j < item->LoadResult.MipData.Length; j++)
+            {
+                loadStatistics.SizeInBytes += item->LoadResult.MipData.Items[j].Data.Length;
+            }
+
+            if (item->MipData.Length > item->LoadResult.MipData.Length)
+            {
+                mipJobCount += item->MipData.Length - 1;
+            }
+
+            if (NeedTextureCompression(item))
+            {
+                for (uint32_t j = 0; j < item->MipData.Length; j++)
+                {
+                    auto blockRowCount = (SystemMax(1u, item->LoadResult.Height >> j) + 3) / 4;
+                    compressJobCount += (blockRowCount + TEXTURE_BUILDER_COMPRESS_JOB_BLOCK_ROWS - 1) / TEXTURE_BUILDER_COMPRESS_JOB_BLOCK_ROWS;
+                }
+            }
+        }
+
+        payload.Jobs = SystemPushArray<TextureBuildJob>(workingMemoryArena, SystemMax(mipJobCount, compressJobCount));
+
+        if (payload.Jobs.Pointer == nullptr)
+        {
+            for (uint32_t i = 0; i < batchCount; i++)
+            {
+                if (!payload.Items[i].LoadResult.HasErrors)
+                {
+                    SetTextureBuildItemOutOfMemoryError(workingMemoryArena, &payload.Items[i]);
+                }
+            }
+        }
+
+        // NOTE: Second stage, all the mips of all the textures of the batch are generated in parallel.
+        auto jobCount = 0u;
+
+        for (uint32_t i = 0; i < batchCount; i++)
+        {
+            auto item = &payload.Items[i];
+
+            if (item->LoadResult.HasErrors || item->MipData.Length <= item->LoadResult.MipData.Length)
+            {
+                continue;
+            }
+
+            for (uint32_t j = 1; j < item->MipData.Length; j++)
+            {
+                payload.Jobs[jobCount++] = { .ItemIndex = i, .MipLevel = j };
+                mipStatistics.SizeInBytes += SystemMax(1u, item->LoadResult.Width >> j) * SystemMax(1u, item->LoadResult.Height >> j) * GetTexturePixelSizeInBytes(item->LoadResult.Format);
+            }
+        }
+
+        RunTextureBuildStage(&payload, jobCount, GenerateTextureMipJob, &mipStatistics);
+
+        for (uint32_t i = 0; i < batchCount; i++)
+        {
+            auto item = &payload.Items[i];
+
+            for (uint32_t j = 0; j < item->MipData.Length && !item->LoadResult.HasErrors; j++)
+            {
+                if (item->MipData[j].Data.Items == nullptr)
+                {
+                    SetTextureBuildItemOutOfMemoryError(workingMemoryArena, item);
+                }
+            }
+        }
+
+        // NOTE: Third stage, the mips are split in block rows so that big mips don't end up on a single worker.
+        jobCount = 0;
+
+        for (uint32_t i = 0; i < batchCount; i++)
+        {
+            auto item = &payload.Items[i];
+
+            if (!NeedTextureCompression(item))
+            {
+                continue;
+            }
+
+            item->OutputMipData = SystemPushArray<ElemTextureMipData>(workingMemoryArena, item->MipData.Length);
+
+            if (item->OutputMipData.Pointer == nullptr)
+            {
+                SetTextureBuildItemOutOfMemoryError(workingMemoryArena, item);
+                continue;
+            }
+
+            auto itemJobCount = jobCount;
+
+            for (uint32_t j = 0; j < item->MipData.Length; j++)
+            {
+                auto mipData = &item->MipData[j];
+                auto compressedData = SystemPushArray<uint8_t>(workingMemoryArena, GetTextureCompressedSize(item->Format, mipData->Width, mipData->Height));
+
+                if (compressedData.Pointer == nullptr)
+                {
+                    // NOTE: The jobs already added for this texture are discarded so nothing is written through null.
+                    SetTextureBuildItemOutOfMemoryError(workingMemoryArena, item);
+                    jobCount = itemJobCount;
+                    break;
+                }
+
+                item->OutputMipData[j] =
+                {
+                    .Width = mipData->Width,
+                    .Height = mipData->Height,
+                    .Data = { .Items = compressedData.Pointer, .Length = (uint32_t)compressedData.Length }
+                };
+
+                auto blockRowCount = (mipData->Height + 3) / 4;
+
+                for (uint32_t k = 0; k < blockRowCount; k += TEXTURE_BUILDER_COMPRESS_JOB_BLOCK_ROWS)
+                {
+                    payload.Jobs[jobCount++] =
+                    {
+                        .ItemIndex = i,
+                        .MipLevel = j,
+                        .StartBlockRow = k,
+                        .BlockRowCount = SystemMin((uint32_t)TEXTURE_BUILDER_COMPRESS_JOB_BLOCK_ROWS, blockRowCount - k)
+                    };
+                }
+
+                compressStatistics.SizeInBytes += mipData->Data.Length;
+            }
+        }
+
+        RunTextureBuildStage(&payload, jobCount, CompressTextureJob, &compressStatistics);
+
+        for (uint32_t i = 0; i < batchCount; i++)
+        {
+            auto item = &payload.Items[i];
+            auto outputFormat = NeedTextureCompression(item) ? item->Format : item->LoadResult.Format;
+
+            ElemBuildTextureResult result =
+            {
+                .Index = batchStart + i,
+                .Format = outputFormat,
+                .Width = item->LoadResult.Width,
+                .Height = item->LoadResult.Height,
+                .MipData = { .Items = item->OutputMipData.Pointer, .Length = (uint32_t)item->OutputMipData.Length },
+                .Messages = item->LoadResult.Messages,
+                .HasErrors = item->LoadResult.HasErrors || item->OutputMipData.Length == 0
+            };
+
+            if (result.HasErrors)
+            {
+                hasErrors = true;
+            }
+            else
+            {
+                builtTextureCount++;
+            }
+
+            buildOptions.BuildTextureHandler(&result, buildOptions.BuildTextureHandlerPayload);
+            FreeLoadedTextureStorage(&item->LoadStorage);
+        }
+    }
+
+    SystemFreeMemoryArena(workingMemoryArena);
+
+    WriteTextureBuildStageStatistics("Load", &loadStatistics, &messageList);
+    WriteTextureBuildStageStatistics("Mip generation", &mipStatistics, &messageList);
+    WriteTextureBuildStageStatistics("Compression", &compressStatistics, &messageList);
+
+    return
+    {
+        .BuiltTextureCount = builtTextureCount,
+        .Messages = { .Items = messageList.Messages.Pointer, .Length = messageList.MessageCount },
+        .HasErrors = hasErrors
+    };
+}
@@ -0,0 +1,227 @@
+#include "ElementalTools.h"
+#include "ToolsUtils.h"
+#include "SystemMemory.h"
+#include "SystemFunctions.h"
+#include "SystemPlatformFunctions.h"
+
+// NOTE: The layout must match the reader in Elemental (Common/Textures/TextureContainer.cpp)
+#define TEXTURE_CONTAINER_VERSION 1
+
+enum TextureContainerFormat
+{
+    TextureContainerFormat_Unknown = 0,
+    TextureContainerFormat_BC7 = 1,
+    TextureContainerFormat_BC1 = 2,
+    TextureContainerFormat_BC3 = 3,
+    TextureContainerFormat_BC4 = 4,
+    TextureContainerFormat_BC5 = 5,
+    TextureContainerFormat_BC6H = 6,
+    TextureContainerFormat_R32G32B32A32_FLOAT = 7
+};
+
+struct TextureContainerHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t Format;
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t MipCount;
+    uint32_t MipAlignment;
+    uint64_t SizeInBytes;
+};
+
+// NOTE: The entries are indexed by mip level but the data is stored from the smallest mip to the biggest so
+// that the lowest mips can be read with one request.
+struct TextureContainerMipEntry
+{
+    uint32_t Width;
+    uint32_t Height;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+// TODO: Do one for each thread
+static MemoryArena TextureContainerMemoryArena;
+
+// NOTE: The container is built in one buffer so the arena is reallocated when the container doesn't fit.
+// The previous result is not valid anymore at this point so its content can be discarded.
+void InitTextureContainerMemoryArena(size_t sizeInBytes)
+{
+    if (TextureContainerMemoryArena.Storage != nullptr && SystemGetMemoryArenaAllocationInfos(TextureContainerMemoryArena).MaximumSizeInBytes < sizeInBytes)
+    {
+        SystemFreeMemoryArena(TextureContainerMemoryArena);
+        TextureContainerMemoryArena = {};
+    }
+
+    if (TextureContainerMemoryArena.Storage == nullptr)
+    {
+        TextureContainerMemoryArena = SystemAllocateMemoryArena(SystemMax(sizeInBytes, (size_t)512 * 1024 * 1024));
+    }
+
+    SystemClearMemoryArena(TextureContainerMemoryArena);
+}
+
+TextureContainerFormat GetTextureContainerFormat(ElemToolsGraphicsFormat format)
+{
+    switch (format)
+    {
+        case ElemToolsGraphicsFormat_BC7:
+            return TextureContainerFormat_BC7;
+
+        case ElemToolsGraphicsFormat_BC1:
+            return TextureContainerFormat_BC1;
+
+        case ElemToolsGraphicsFormat_BC3:
+            return TextureContainerFormat_BC3;
+
+        case ElemToolsGraphicsFormat_BC4:
+            return TextureContainerFormat_BC4;
+
+        case ElemToolsGraphicsFormat_BC5:
+            return TextureContainerFormat_BC5;
+
+        case ElemToolsGraphicsFormat_BC6H:
+            return TextureContainerFormat_BC6H;
+
+        case ElemToolsGraphicsFormat_R32G32B32A32_FLOAT:
+            return TextureContainerFormat_R32G32B32A32_FLOAT;
+
+        default:
+            return TextureContainerFormat_Unknown;
+    }
+}
+
+uint64_t AlignTextureContainerOffset(uint64_t offset, uint32_t alignment)
+{
+    return (offset + alignment - 1) & ~((uint64_t)alignment - 1);
+}
+
+ElemToolsAPI ElemBuildTextureContainerResult ElemBuildTextureContainer(ElemToolsGraphicsFormat format, ElemTextureMipDataSpan mipData, const ElemBuildTextureContainerOptions* options)
+{
+    InitTextureContainerMemoryArena(0);
+
+    ElemBuildTextureContainerOptions containerOptions = {};
+
+    if (options)
+    {
+        containerOptions = *options;
+    }
+
+    if (containerOptions.MipAlignment == 0)
+    {
+        containerOptions.MipAlignment = 4096;
+    }
+
+    if ((containerOptions.MipAlignment & (containerOptions.MipAlignment - 1)) != 0)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(TextureContainerMemoryArena, "Mip alignment must be a power of 2."),
+            .HasErrors = true
+        };
+    }
+
+    auto containerFormat = GetTextureContainerFormat(format);
+
+    if (containerFormat == TextureContainerFormat_Unknown)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(TextureContainerMemoryArena, "Texture format is not supported by the texture container."),
+            .HasErrors = true
+        };
+    }
+
+    if (mipData.Length == 0)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(TextureContainerMemoryArena, "Texture container needs at least one mip."),
+            .HasErrors = true
+        };
+    }
+
+    // NOTE: The reader checks each mip against the size of the first mip.
+    for (uint32_t i = 1; i < mipData.Length; i++)
+    {
+        if (i >= 32 || mipData.Items[i].Width != SystemMax(mipData.Items[0].Width >> i, 1u) || mipData.Items[i].Height != SystemMax(mipData.Items[0].Height >> i, 1u))
+        {
+            return
+            {
+                .Messages = ConstructErrorMessageSpan(TextureContainerMemoryArena, "Texture container mips must form a mip chain from the first mip."),
+                .HasErrors = true
+            };
+        }
+    }
+
+    auto stackMemoryArena = SystemGetStackMemoryArena();
+    auto mipEntries = SystemPushArrayZero<TextureContainerMipEntry>(stackMemoryArena, mipData.Length);
+    auto currentOffset = AlignTextureContainerOffset(sizeof(TextureContainerHeader) + mipData.Length * sizeof(TextureContainerMipEntry), containerOptions.MipAlignment);
+
+    // NOTE: The mips smaller than the alignment are packed together so the small mips don't waste space.
+    for (int32_t i = (int32_t)mipData.Length - 1; i >= 0; i--)
+    {
+        auto mip = &mipData.Items[i];
+
+        if (mip->Data.Length >= containerOptions.MipAlignment)
+        {
+            currentOffset = AlignTextureContainerOffset(currentOffset, containerOptions.MipAlignment);
+        }
+
+        mipEntries[i] =
+        {
+            .Width = mip->Width,
+            .Height = mip->Height,
+            .Offset = currentOffset,
+            .SizeInBytes = mip->Data.Length
+        };
+
+        currentOffset += mip->Data.Length;
+    }
+
+    currentOffset = AlignTextureContainerOffset(currentOffset, containerOptions.MipAlignment);
+
+    // NOTE: Some space is kept after the container data for the messages.
+    InitTextureContainerMemoryArena(currentOffset + 1024 * 1024);
+    auto containerData = SystemPushArray<uint8_t>(TextureContainerMemoryArena, currentOffset);
+
+    if (containerData.Pointer == nullptr)
+    {
+        return
+        {
+            .Messages = ConstructErrorMessageSpan(TextureContainerMemoryArena, "Not enough memory to build the texture container."),
+            .HasErrors = true
+        };
+    }
+
+    SystemPlatformClearMemory(containerData.Pointer, containerData.Length);
+
+    TextureContainerHeader header =
+    {
+        .FileId = { 'E', 'L', 'E', 'M', 'T', 'E', 'X', 'C' },
+        .Version = TEXTURE_CONTAINER_VERSION,
+        .Format = containerFormat,
+        .Width = mipData.Items[0].Width,
+        .Height = mipData.Items[0].Height,
+        .MipCount = mipData.Length,
+        .MipAlignment = containerOptions.MipAlignment,
+        .SizeInBytes = currentOffset
+    };
+
+    SystemCopyBuffer<uint8_t>(containerData, ReadOnlySpan<uint8_t>((uint8_t*)&header, sizeof(TextureContainerHeader)));
+    SystemCopyBuffer<uint8_t>(containerData.Slice(sizeof(TextureContainerHeader)), ReadOnlySpan<uint8_t>((uint8_t*)mipEntries.Pointer, mipEntries.Length * sizeof(TextureContainerMipEntry)));
+
+    for (uint32_t i = 0; i < mipData.Length; i++)
+    {
+        if (mipData.Items[i].Data.Length > 0)
+        {
+            SystemCopyBuffer<uint8_t>(containerData.Slice(mipEntries[i].Offset), ReadOnlySpan<uint8_t>(mipData.Items[i].Data.Items, mipData.Items[i].Data.Length));
+        }
+    }
+
+    return
+    {
+        .Data = { .Items = containerData.Pointer, .Length = (uint32_t)containerData.Length }
+    };
+}
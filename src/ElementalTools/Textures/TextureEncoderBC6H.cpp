@@ -0,0 +1,157 @@
+#include "ElementalTools.h"
+#include "SystemFunctions.h"
+
+// NOTE: Small BC6H (unsigned) encoder that only uses mode 11 (one region, 10 bits endpoints, 4 bits indices).
+// The endpoints are the bounding box of the block so the quality is below the multi region encoders but the
+// speed is close to the BC1 encoder.
+// See: https://learn.microsoft.com/en-us/windows/win32/direct3d11/bc6h-format
+
+#define BC6H_MAX_HALF_VALUE 0x7BFF
+#define BC6H_MODE11_ENDPOINT_BITS 10
+
+static const uint32_t BC6HInterpolationWeights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+struct BC6HBlockWriter
+{
+    uint64_t Data[2];
+    uint32_t BitOffset;
+};
+
+void WriteBC6HBits(BC6HBlockWriter* writer, uint32_t value, uint32_t bitCount)
+{
+    for (uint32_t i = 0; i < bitCount; i++)
+    {
+        auto bitIndex = writer->BitOffset + i;
+        writer->Data[bitIndex / 64] |= (uint64_t)((value >> i) & 1) << (bitIndex % 64);
+    }
+
+    writer->BitOffset += bitCount;
+}
+
+uint32_t ConvertToBC6HHalf(float value)
+{
+    if (!(value > 0.0f))
+    {
+        return 0;
+    }
+
+    return SystemMin((uint32_t)meshopt_quantizeHalf(value), (uint32_t)BC6H_MAX_HALF_VALUE);
+}
+
+// NOTE: The decoder unquantizes the endpoints and rescales the interpolated value by 31/64 so an endpoint
+// value x is decoded as 31 * x + 15.
+uint32_t QuantizeBC6HEndpoint(uint32_t halfValue)
+{
+    return SystemMin(halfValue / 31, (1u << BC6H_MODE11_ENDPOINT_BITS) - 1);
+}
+
+uint32_t UnquantizeBC6HEndpoint(uint32_t value)
+{
+    if (value == 0)
+    {
+        return 0;
+    }
+    else if (value == (1u << BC6H_MODE11_ENDPOINT_BITS) - 1)
+    {
+        return 0xFFFF;
+    }
+
+    return ((value << 16) + 0x8000) >> BC6H_MODE11_ENDPOINT_BITS;
+}
+
+uint32_t DecodeBC6HValue(uint32_t endpoint0, uint32_t endpoint1, uint32_t weight)
+{
+    auto value = ((64 - weight) * endpoint0 + weight * endpoint1 + 32) >> 6;
+    return (value * 31) >> 6;
+}
+
+// NOTE: The source block is 16 RGBA float pixels.
+void EncodeBC6HBlock(uint8_t* destination, const float* sourceBlockData)
+{
+    uint32_t pixels[16][3];
+    uint32_t minValues[3] = { BC6H_MAX_HALF_VALUE, BC6H_MAX_HALF_VALUE, BC6H_MAX_HALF_VALUE };
+    uint32_t maxValues[3] = { 0, 0, 0 };
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            pixels[i][j] = ConvertToBC6HHalf(sourceBlockData[i * 4 + j]);
+            minValues[j] = SystemMin(minValues[j], pixels[i][j]);
+            maxValues[j] = SystemMax(maxValues[j], pixels[i][j]);
+        }
+    }
+
+    uint32_t endpoints[2][3];
+    uint32_t unquantizedEndpoints[2][3];
+
+    for (uint32_t j = 0; j < 3; j++)
+    {
+        endpoints[0][j] = QuantizeBC6HEndpoint(minValues[j]);
+        endpoints[1][j] = QuantizeBC6HEndpoint(maxValues[j]);
+        unquantizedEndpoints[0][j] = UnquantizeBC6HEndpoint(endpoints[0][j]);
+        unquantizedEndpoints[1][j] = UnquantizeBC6HEndpoint(endpoints[1][j]);
+    }
+
+    uint32_t indices[16];
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        auto bestError = UINT64_MAX;
+        indices[i] = 0;
+
+        for (uint32_t k = 0; k < 16; k++)
+        {
+            uint64_t error = 0;
+
+            for (uint32_t j = 0; j < 3; j++)
+            {
+                auto difference = (int64_t)DecodeBC6HValue(unquantizedEndpoints[0][j], unquantizedEndpoints[1][j], BC6HInterpolationWeights[k]) - (int64_t)pixels[i][j];
+                error += (uint64_t)(difference * difference);
+            }
+
+            if (error < bestError)
+            {
+                bestError = error;
+                indices[i] = k;
+            }
+        }
+    }
+
+    // NOTE: The most significant bit of the first index is implicit and must be 0.
+    if (indices[0] >= 8)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            auto temp = endpoints[0][j];
+            endpoints[0][j] = endpoints[1][j];
+            endpoints[1][j] = temp;
+        }
+
+        for (uint32_t i = 0; i < 16; i++)
+        {
+            indices[i] = 15 - indices[i];
+        }
+    }
+
+    BC6HBlockWriter writer = {};
+    WriteBC6HBits(&writer, 0x03, 5);
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            WriteBC6HBits(&writer, endpoints[i][j], BC6H_MODE11_ENDPOINT_BITS);
+        }
+    }
+
+    WriteBC6HBits(&writer, indices[0], 3);
+
+    for (uint32_t i = 1; i < 16; i++)
+    {
+        WriteBC6HBits(&writer, indices[i], 4);
+    }
+
+    SystemAssert(writer.BitOffset == 128);
+    memcpy(destination, writer.Data, sizeof(writer.Data));
+}
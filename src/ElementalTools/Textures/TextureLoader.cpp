@@ -3,23 +3,11 @@
 #include "TextureLoaderStb.cpp"
 #include "TextureLoaderDds.cpp"
 
-// TODO: Do one for each thread
-static MemoryArena TextureLoaderMemoryArena;
+// NOTE: Space for the messages and the result structures, the pixel data is added to it.
+#define TEXTURE_LOADER_MIN_MEMORY_SIZE 1024 * 1024
 
-void InitTextureLoaderMemoryArena()
-{
-    if (TextureLoaderMemoryArena.Storage == nullptr)
-    {
-        TextureLoaderMemoryArena = SystemAllocateMemoryArena(512 * 1024 * 1024);
-    }
-
-    SystemClearMemoryArena(TextureLoaderMemoryArena);
-}
-
-MemoryArena GetTextureLoaderMemoryArena()
-{
-    return TextureLoaderMemoryArena;
-}
+// NOTE: Keeps the result of the last ElemLoadTexture call alive until the next call.
+static LoadedTextureStorage TextureLoaderStorage;
 
 ElemLoadTextureFileFormat GetLoadTextureFileFormatFromPath(const char* path)
 {
@@ -48,14 +36,17 @@ ElemLoadTextureFileFormat GetLoadTextureFileFormatFromPath(const char* path)
     {
         return ElemLoadTextureFileFormat_Dds;
     }
+    else if (SystemFindSubString(extension, "hdr") != -1)
+    {
+        return ElemLoadTextureFileFormat_Hdr;
+    }
 
     return ElemLoadTextureFileFormat_Unknown;
 }
 
-ElemToolsAPI ElemLoadTextureResult ElemLoadTexture(const char* path, const ElemLoadTextureOptions* options)
+ElemLoadTextureResult LoadTexture(const char* path, const ElemLoadTextureOptions* options, LoadedTextureStorage* storage)
 {
-    InitTextureLoaderMemoryArena();
-
+    *storage = {};
     ElemLoadTextureOptions loadTextureOptions = {};
 
     if (options)
@@ -64,6 +55,34 @@ ElemToolsAPI ElemLoadTextureResult ElemLoadTexture(const char* path, const ElemL
     }
 
     auto textureFileFormat = GetLoadTextureFileFormatFromPath(path);
+    auto memorySize = (size_t)TEXTURE_LOADER_MIN_MEMORY_SIZE;
+    ToolsMappedFile mappedFile = {};
+
+    switch (textureFileFormat)
+    {
+        case ElemLoadTextureFileFormat_Tga:
+        case ElemLoadTextureFileFormat_Jpg:
+        case ElemLoadTextureFileFormat_Png:
+        case ElemLoadTextureFileFormat_Hdr:
+            mappedFile = MapFileData(path, true);
+            memorySize += GetStbTextureMemorySize(mappedFile.Data, textureFileFormat);
+            break;
+
+        case ElemLoadTextureFileFormat_Dds:
+            mappedFile = MapFileData(path, false);
+            memorySize += GetDdsTextureMemorySize(mappedFile.Data);
+            break;
+
+        default:
+            break;
+    }
+
+    storage->MemoryArena = SystemAllocateMemoryArena(memorySize);
+
+    if (textureFileFormat != ElemLoadTextureFileFormat_Unknown && mappedFile.Data.Length == 0)
+    {
+        return { .Messages = ConstructErrorMessageSpan(storage->MemoryArena, "Error while reading texture file."), .HasErrors = true };
+    }
 
     // TODO: Refactor that with array entries and function pointer
     switch (textureFileFormat)
@@ -71,16 +90,52 @@ ElemToolsAPI ElemLoadTextureResult ElemLoadTexture(const char* path, const ElemL
         case ElemLoadTextureFileFormat_Tga:
         case ElemLoadTextureFileFormat_Jpg:
         case ElemLoadTextureFileFormat_Png:
-            return LoadStbTexture(path, textureFileFormat, &loadTextureOptions);
+        case ElemLoadTextureFileFormat_Hdr:
+        {
+            // NOTE: The decoded pixels don't reference the file so it is unmapped right away.
+            auto result = LoadStbTexture(storage->MemoryArena, mappedFile.Data, textureFileFormat, &loadTextureOptions);
+            UnmapFileData(mappedFile);
+            return result;
+        }
 
         case ElemLoadTextureFileFormat_Dds:
-            return LoadDdsTexture(path, textureFileFormat, &loadTextureOptions);
+        {
+            auto result = LoadDdsTexture(storage->MemoryArena, mappedFile.Data, textureFileFormat, &loadTextureOptions);
+
+            if (result.HasErrors)
+            {
+                UnmapFileData(mappedFile);
+            }
+            else
+            {
+                storage->MappedFile = mappedFile;
+            }
+
+            return result;
+        }
 
         default:
             return
             {
-                .Messages = ConstructErrorMessageSpan(GetTextureLoaderMemoryArena(), "Texture format is not supported."),
+                .Messages = ConstructErrorMessageSpan(storage->MemoryArena, "Texture format is not supported."),
                 .HasErrors = true
             };
     };
 }
+
+void FreeLoadedTextureStorage(LoadedTextureStorage* storage)
+{
+    if (storage->MemoryArena.Storage != nullptr)
+    {
+        SystemFreeMemoryArena(storage->MemoryArena);
+    }
+
+    UnmapFileData(storage->MappedFile);
+    *storage = {};
+}
+
+ElemToolsAPI ElemLoadTextureResult ElemLoadTexture(const char* path, const ElemLoadTextureOptions* options)
+{
+    FreeLoadedTextureStorage(&TextureLoaderStorage);
+    return LoadTexture(path, options, &TextureLoaderStorage);
+}
@@ -1,5 +1,27 @@
 #pragma once
 
+#include "ElementalTools.h"
 #include "SystemMemory.h"
+#include "ToolsUtils.h"
 
-MemoryArena GetTextureLoaderMemoryArena();
+struct LoadedTextureStorage
+{
+    MemoryArena MemoryArena;
+    ToolsMappedFile MappedFile;
+};
+
+// NOTE: The memory arena is reserved with the size read from the file header. The arena and the file mapping
+// (when the mip data points into the file) are returned in storage and must be released with
+// FreeLoadedTextureStorage when the result is not used anymore.
+ElemLoadTextureResult LoadTexture(const char* path, const ElemLoadTextureOptions* options, LoadedTextureStorage* storage);
+void FreeLoadedTextureStorage(LoadedTextureStorage* storage);
+
+// NOTE: Allocation functions used by stb_image. The allocations are done in the memory arena passed to
+// LoadTexture so the decoded pixels don't need to be copied.
+void* TextureDecoderAllocate(size_t sizeInBytes);
+void* TextureDecoderReallocate(void* pointer, size_t sizeInBytes);
+void TextureDecoderFree(void* pointer);
+
+// NOTE: Returns 0 for the formats that are not block compressed.
+uint32_t GetTextureFormatBlockSizeInBytes(ElemToolsGraphicsFormat format);
+uint32_t GetTextureMipCount(uint32_t width, uint32_t height);
@@ -4,9 +4,14 @@
 #include "SystemMemory.h"
 #include "SystemFunctions.h"
 
+#define DDSD_MIPMAPCOUNT 0x20000
+#define DDSD_DEPTH 0x800000
 #define DDSCAPS2_CUBEMAP 0x200
+#define DDSCAPS2_CUBEMAP_ALLFACES 0xFC00
 #define DDSCAPS2_VOLUME 0x200000
 #define DDS_DIMENSION_TEXTURE2D 3
+#define DDS_DIMENSION_TEXTURE3D 4
+#define DDS_RESOURCE_MISC_TEXTURECUBE 0x4
 
 struct DdsPixelFormat
 {
@@ -72,48 +77,78 @@ uint32_t FourCC(const char value[5])
 
 ElemToolsGraphicsFormat GetDdsTextureFormat(const DdsHeader* ddsHeader, const DdsHeaderDirectX10* directX10Header)
 {
-    // TODO: Other formats
-    if (ddsHeader->ddspf.dwFourCC == FourCC("DX10"))
+    auto fourCC = ddsHeader->ddspf.dwFourCC;
+
+    if (fourCC == FourCC("DX10"))
     {
-        if (directX10Header->dxgiFormat == DXGI_FORMAT_BC7_UNORM_SRGB || directX10Header->dxgiFormat == DXGI_FORMAT_BC7_UNORM)
+        switch (directX10Header->dxgiFormat)
         {
-            return ElemToolsGraphicsFormat_BC7;
+            case DXGI_FORMAT_BC1_UNORM:
+            case DXGI_FORMAT_BC1_UNORM_SRGB:
+                return ElemToolsGraphicsFormat_BC1;
+
+            case DXGI_FORMAT_BC3_UNORM:
+            case DXGI_FORMAT_BC3_UNORM_SRGB:
+                return ElemToolsGraphicsFormat_BC3;
+
+            case DXGI_FORMAT_BC4_UNORM:
+                return ElemToolsGraphicsFormat_BC4;
+
+            case DXGI_FORMAT_BC5_UNORM:
+                return ElemToolsGraphicsFormat_BC5;
+
+            case DXGI_FORMAT_BC6H_UF16:
+                return ElemToolsGraphicsFormat_BC6H;
+
+            case DXGI_FORMAT_BC7_UNORM:
+            case DXGI_FORMAT_BC7_UNORM_SRGB:
+                return ElemToolsGraphicsFormat_BC7;
+
+            // TODO: Other formats
+            default:
+                return ElemToolsGraphicsFormat_Unknown;
         }
     }
 
-    return ElemToolsGraphicsFormat_Unknown;
-}
-
-uint32_t GetDdsFormatBlockSize(ElemToolsGraphicsFormat format)
-{
-    // TODO: other formats
-    if (format == ElemToolsGraphicsFormat_BC7)
+    // NOTE: Legacy files written without the DirectX10 header.
+    if (fourCC == FourCC("DXT1"))
     {
-        return 16;
+        return ElemToolsGraphicsFormat_BC1;
+    }
+    else if (fourCC == FourCC("DXT5"))
+    {
+        return ElemToolsGraphicsFormat_BC3;
+    }
+    else if (fourCC == FourCC("ATI1") || fourCC == FourCC("BC4U"))
+    {
+        return ElemToolsGraphicsFormat_BC4;
+    }
+    else if (fourCC == FourCC("ATI2") || fourCC == FourCC("BC5U"))
+    {
+        return ElemToolsGraphicsFormat_BC5;
     }
 
-    return 8;
+    return ElemToolsGraphicsFormat_Unknown;
 }
 
-ElemLoadTextureResult LoadDdsTexture(const char* path, ElemLoadTextureFileFormat fileFormat, const ElemLoadTextureOptions* options)
+// NOTE: All the supported formats are block compressed so each mip takes at least 8 bytes of the file.
+size_t GetDdsTextureMemorySize(ReadOnlySpan<uint8_t> fileData)
 {
-    auto stackMemoryArena = SystemGetStackMemoryArena();
-    auto textureLoaderMemoryArena = GetTextureLoaderMemoryArena();
+    return (fileData.Length / 8 + 1) * sizeof(ElemTextureMipData);
+}
 
+// NOTE: The mip data points directly into the file data so that compressed textures can be copied to an
+// upload buffer without an intermediate copy. The file must stay mapped while the result is used.
+ElemLoadTextureResult LoadDdsTexture(MemoryArena textureLoaderMemoryArena, ReadOnlySpan<uint8_t> fileData, ElemLoadTextureFileFormat fileFormat, const ElemLoadTextureOptions* options)
+{
     auto messages = SystemPushArray<ElemToolsMessage>(textureLoaderMemoryArena, 1024);
     auto messageCount = 0u;
     auto hasErrors = false;
 
-    auto objFileData = LoadFileData(path); 
+    auto fileEndPointer = fileData.Pointer + fileData.Length;
+    auto currentFilePointer = fileData.Pointer;
 
-    if (objFileData.Length == 0)
-    {
-        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Error while reading texture file."), .HasErrors = true };
-    }
-
-    auto currentFilePointer = objFileData.Pointer;
-
-    if (*(uint32_t*)currentFilePointer != FourCC("DDS "))
+    if (fileData.Length < sizeof(uint32_t) + sizeof(DdsHeader) || *(uint32_t*)currentFilePointer != FourCC("DDS "))
     {
         return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Texture is not a DDS file."), .HasErrors = true };
     }
@@ -129,16 +164,53 @@ ElemLoadTextureResult LoadDdsTexture(const char* path, ElemLoadTextureFileFormat
     {
         directX10Header = (DdsHeaderDirectX10*)currentFilePointer;
         currentFilePointer += sizeof(DdsHeaderDirectX10);
+
+        if (currentFilePointer > fileEndPointer)
+        {
+                return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Texture file is truncated."), .HasErrors = true };
+        }
     }
 
-    if (header->dwCaps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))
+    auto textureType = ElemToolsTextureType_Texture2D;
+    auto depth = 1u;
+    auto arraySize = 1ull;
+
+    if (directX10Header)
     {
-        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Cubemaps and volume textures are not supported."), .HasErrors = true };
+        if (directX10Header->resourceDimension == DDS_DIMENSION_TEXTURE3D)
+        {
+            textureType = ElemToolsTextureType_Texture3D;
+            depth = SystemMax(1u, header->dwDepth);
+        }
+        else if (directX10Header->resourceDimension == DDS_DIMENSION_TEXTURE2D)
+        {
+            arraySize = SystemMax(1u, directX10Header->arraySize);
+
+            if (directX10Header->miscFlag & DDS_RESOURCE_MISC_TEXTURECUBE)
+            {
+                textureType = ElemToolsTextureType_TextureCube;
+                arraySize *= 6;
+            }
+        }
+        else
+        {
+                return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Only Texture2D, Texture3D and cubemaps are supported."), .HasErrors = true };
+        }
     }
+    else if (header->dwCaps2 & DDSCAPS2_CUBEMAP)
+    {
+        if ((header->dwCaps2 & DDSCAPS2_CUBEMAP_ALLFACES) != DDSCAPS2_CUBEMAP_ALLFACES)
+        {
+                return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Cubemaps must contain all their faces."), .HasErrors = true };
+        }
 
-    if (header->ddspf.dwFourCC == FourCC("DX10") && directX10Header->resourceDimension != DDS_DIMENSION_TEXTURE2D)
+        textureType = ElemToolsTextureType_TextureCube;
+        arraySize = 6;
+    }
+    else if ((header->dwCaps2 & DDSCAPS2_VOLUME) && (header->dwFlags & DDSD_DEPTH))
     {
-        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Only Texture2D are supported."), .HasErrors = true };
+        textureType = ElemToolsTextureType_Texture3D;
+        depth = SystemMax(1u, header->dwDepth);
     }
 
     auto format = GetDdsTextureFormat(header, directX10Header);
@@ -150,39 +222,71 @@ ElemLoadTextureResult LoadDdsTexture(const char* path, ElemLoadTextureFileFormat
 
     auto width = header->dwWidth;
     auto height = header->dwHeight;
-    auto mipLevels = header->dwMipMapCount;
-    auto blockSize = GetDdsFormatBlockSize(format);
-
-    auto mipData = SystemPushArray<ElemTextureMipData>(textureLoaderMemoryArena, mipLevels);
 
-    for (uint32_t i = 0; i < mipLevels; i++)
+    if (width == 0 || height == 0)
     {
-        auto mipLevelData = &mipData[i];
-        printf("Processing mip level %d\n", i);
+        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Texture dimensions are invalid."), .HasErrors = true };
+    }
 
-        auto mipWidth = SystemMax(1u, width >> i);
-        auto mipHeight = SystemMax(1u, height >> i);
+    // NOTE: The depth of volume textures is also halved for each mip.
+    auto maxMipLevels = GetTextureMipCount(SystemMax(width, depth), height);
+    auto mipLevels = (header->dwFlags & DDSD_MIPMAPCOUNT) ? SystemMax(1u, header->dwMipMapCount) : 1u;
+    mipLevels = SystemMin(mipLevels, maxMipLevels);
 
-        auto dataSizeInBytes = ((mipWidth + 3) / 4) * ((mipHeight + 3) / 4) * blockSize;
-        printf("Data size: %d\n", dataSizeInBytes);
+    auto blockSize = GetTextureFormatBlockSizeInBytes(format);
 
-        mipLevelData->Width = mipWidth;
-        mipLevelData->Height = mipHeight;
+    // NOTE: Each mip takes at least one block so the mip count is checked against the remaining file size before
+    // the mips are allocated. The count is computed in 64 bits so a corrupted array size cannot wrap around.
+    auto mipCount = arraySize * mipLevels;
 
-        auto mipLevelRawData = SystemDuplicateBuffer(textureLoaderMemoryArena, ReadOnlySpan<uint8_t>((uint8_t*)currentFilePointer, dataSizeInBytes));
-        mipLevelData->Data = { .Items = mipLevelRawData.Pointer, .Length = (uint32_t)mipLevelRawData.Length };
+    if (mipCount * blockSize > (uint64_t)(fileEndPointer - currentFilePointer))
+    {
+        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Texture file is truncated."), .HasErrors = true };
+    }
 
-        currentFilePointer += dataSizeInBytes;
+    // NOTE: The slices are stored one after the other with all their mips.
+    auto mipData = SystemPushArray<ElemTextureMipData>(textureLoaderMemoryArena, mipCount);
+
+    if (mipData.Pointer == nullptr)
+    {
+        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Not enough memory to load the texture."), .HasErrors = true };
     }
 
-    ResetLoadFileDataMemory();
+    for (uint32_t i = 0; i < arraySize; i++)
+    {
+        for (uint32_t j = 0; j < mipLevels; j++)
+        {
+            auto mipLevelData = &mipData[i * mipLevels + j];
+
+            auto mipWidth = SystemMax(1u, width >> j);
+            auto mipHeight = SystemMax(1u, height >> j);
+            auto mipDepth = SystemMax(1u, depth >> j);
+
+            auto dataSizeInBytes = (uint64_t)((mipWidth + 3) / 4) * ((mipHeight + 3) / 4) * blockSize * mipDepth;
+
+            if (dataSizeInBytes > (uint64_t)(fileEndPointer - currentFilePointer))
+            {
+                        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Texture file is truncated."), .HasErrors = true };
+            }
+
+            mipLevelData->Width = mipWidth;
+            mipLevelData->Height = mipHeight;
+            mipLevelData->Data = { .Items = (uint8_t*)currentFilePointer, .Length = (uint32_t)dataSizeInBytes };
+
+            currentFilePointer += dataSizeInBytes;
+        }
+    }
 
     return 
     {
         .FileFormat = fileFormat,
         .Format = format,
+        .Type = textureType,
         .Width = (uint32_t)width,
         .Height = (uint32_t)height,
+        .Depth = depth,
+        .ArraySize = (uint32_t)arraySize,
+        .MipLevelCount = mipLevels,
         .MipData = { .Items = mipData.Pointer, .Length = (uint32_t)mipData.Length },
         .Messages = { .Items = messages.Pointer, .Length = messageCount },
         .HasErrors = hasErrors
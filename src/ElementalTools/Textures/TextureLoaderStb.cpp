@@ -3,47 +3,138 @@
 #include "ElementalTools.h"
 #include "SystemMemory.h"
 
-ElemLoadTextureResult LoadStbTexture(const char* path, ElemLoadTextureFileFormat fileFormat, const ElemLoadTextureOptions* options)
+// NOTE: The size of each allocation is stored before the data so it can be reallocated. The header is a
+// multiple of the arena alignment (8 bytes) so the returned pointers keep it. The SIMD paths of the decoder
+// use unaligned loads and stores so they don't need more.
+#define TEXTURE_DECODER_ALLOCATION_HEADER_SIZE 16
+
+// NOTE: The compressed chunks of a PNG file are gathered in a buffer that grows while the file is read, and
+// the decoders keep up to a few intermediate images (raw rows, 16 bits images or format conversions) next
+// to the final pixels.
+#define TEXTURE_DECODER_MEMORY_SIZE_PER_FILE_BYTE 4
+#define TEXTURE_DECODER_MEMORY_SIZE_PER_PIXEL_BYTE 8
+
+// NOTE: The decoder pushes its allocations to the texture loader arena of the calling thread. The arena is set
+// around each decode so the decoded pixels are used without a copy. The temporaries are released with the arena.
+thread_local MemoryArena* textureDecoderMemoryArena;
+
+void* TextureDecoderAllocate(size_t sizeInBytes)
+{
+    SystemAssert(textureDecoderMemoryArena);
+
+    auto data = (uint8_t*)SystemPushMemory(*textureDecoderMemoryArena, sizeInBytes + TEXTURE_DECODER_ALLOCATION_HEADER_SIZE);
+
+    if (data == nullptr)
+    {
+        return nullptr;
+    }
+
+    *(size_t*)data = sizeInBytes;
+
+    return data + TEXTURE_DECODER_ALLOCATION_HEADER_SIZE;
+}
+
+void* TextureDecoderReallocate(void* pointer, size_t sizeInBytes)
+{
+    if (pointer == nullptr)
+    {
+        return TextureDecoderAllocate(sizeInBytes);
+    }
+
+    auto currentSizeInBytes = *(size_t*)((uint8_t*)pointer - TEXTURE_DECODER_ALLOCATION_HEADER_SIZE);
+
+    if (sizeInBytes <= currentSizeInBytes)
+    {
+        return pointer;
+    }
+
+    auto data = TextureDecoderAllocate(sizeInBytes);
+
+    if (data == nullptr)
+    {
+        return nullptr;
+    }
+
+    memcpy(data, pointer, currentSizeInBytes);
+
+    return data;
+}
+
+// NOTE: The temporary buffers of the decoder are released when the texture loader arena is freed.
+void TextureDecoderFree(void* pointer)
+{
+}
+
+uint32_t GetStbTexturePixelSizeInBytes(ElemLoadTextureFileFormat fileFormat)
+{
+    // NOTE: HDR images are kept in linear float so they can be compressed to BC6H.
+    return fileFormat == ElemLoadTextureFileFormat_Hdr ? STBI_rgb_alpha * sizeof(float) : STBI_rgb_alpha;
+}
+
+size_t GetStbTextureMemorySize(ReadOnlySpan<uint8_t> fileData, ElemLoadTextureFileFormat fileFormat)
 {
-    auto stackMemoryArena = SystemGetStackMemoryArena();
-    auto textureLoaderMemoryArena = GetTextureLoaderMemoryArena();
+    int32_t width, height, channels;
+
+    if (fileData.Length == 0 || !stbi_info_from_memory(fileData.Pointer, fileData.Length, &width, &height, &channels))
+    {
+        return 0;
+    }
+
+    auto pixelsSizeInBytes = (size_t)width * height * GetStbTexturePixelSizeInBytes(fileFormat);
+    return fileData.Length * TEXTURE_DECODER_MEMORY_SIZE_PER_FILE_BYTE + pixelsSizeInBytes * TEXTURE_DECODER_MEMORY_SIZE_PER_PIXEL_BYTE;
+}
 
+ElemLoadTextureResult LoadStbTexture(MemoryArena textureLoaderMemoryArena, ReadOnlySpan<uint8_t> fileData, ElemLoadTextureFileFormat fileFormat, const ElemLoadTextureOptions* options)
+{
     auto messages = SystemPushArray<ElemToolsMessage>(textureLoaderMemoryArena, 1024);
     auto messageCount = 0u;
     auto hasErrors = false;
 
-    auto objFileData = LoadFileData(path); 
+    auto isHdr = fileFormat == ElemLoadTextureFileFormat_Hdr;
+    auto pixelSize = GetStbTexturePixelSizeInBytes(fileFormat);
+
+    int32_t width, height, channels;
+    void* stbImageData;
+
+    textureDecoderMemoryArena = &textureLoaderMemoryArena;
 
-    if (objFileData.Length == 0)
+    if (isHdr)
     {
-        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Error while reading texture file."), .HasErrors = true };
+        stbImageData = stbi_loadf_from_memory(fileData.Pointer, fileData.Length, &width, &height, &channels, STBI_rgb_alpha);
+    }
+    else
+    {
+        stbImageData = stbi_load_from_memory(fileData.Pointer, fileData.Length, &width, &height, &channels, STBI_rgb_alpha);
     }
 
-    int32_t width, height, channels;
-    auto stbImageData = stbi_load_from_memory(objFileData.Pointer, objFileData.Length, &width, &height, &channels, STBI_rgb_alpha);
+    textureDecoderMemoryArena = nullptr;
 
     if (!stbImageData)
     {
         return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Error while loading texture file."), .HasErrors = true };
     }
 
-    auto imageDataLength = width * height * STBI_rgb_alpha;
-    auto imageData = SystemDuplicateBuffer(textureLoaderMemoryArena, ReadOnlySpan<uint8_t>(stbImageData, imageDataLength));
-
     auto mipData = SystemPushStruct<ElemTextureMipData>(textureLoaderMemoryArena);
+
+    if (mipData == nullptr)
+    {
+        return { .Messages = ConstructErrorMessageSpan(textureLoaderMemoryArena, "Not enough memory to load texture file."), .HasErrors = true };
+    }
+
     mipData->Width = width;
     mipData->Height = height;
-    mipData->Data = { .Items = imageData.Pointer, .Length = (uint32_t)imageData.Length },
-
-    stbi_image_free(stbImageData);
-    ResetLoadFileDataMemory();
+    mipData->Data = { .Items = (uint8_t*)stbImageData, .Length = (uint32_t)((size_t)width * height * pixelSize) };
 
     return 
     {
         .FileFormat = fileFormat,
-        .Format = ElemToolsGraphicsFormat_R8G8B8A8,
+        .Format = isHdr ? ElemToolsGraphicsFormat_R32G32B32A32_FLOAT : ElemToolsGraphicsFormat_R8G8B8A8,
+        .Type = ElemToolsTextureType_Texture2D,
         .Width = (uint32_t)width,
         .Height = (uint32_t)height,
+        .Depth = 1,
+        .ArraySize = 1,
+        .MipLevelCount = 1,
         .MipData = { .Items = mipData, .Length = 1 },
         .Messages = { .Items = messages.Pointer, .Length = messageCount },
         .HasErrors = hasErrors
@@ -3,36 +3,105 @@
 #include "SystemMemory.h"
 #include "SystemFunctions.h"
 
-#define TEXTURE_BC_BLOCK_SIZE_IN_BYTES 16
+#define TEXTURE_BC1_QUALITY_LEVEL 10
+
+struct TextureCompressionParameters
+{
+    bc7enc_compress_block_params BC7Parameters;
+    uint32_t BC1QualityLevel;
+};
 
 // TODO: See example: https://github.com/Hork-Engine/Hork-Source/blob/97c3630480983b20bd054e06ca6c26ae2e87095a/Hork/Image/ImageEncoders.cpp
-// TODO: Do one for each thread
+// NOTE: Space for the messages and the result structures, the texture data is added to it.
+#define TEXTURE_PROCESSING_MIN_MEMORY_SIZE 1024 * 1024
+
+// NOTE: Keep the results of the last call alive until the next call. The arenas are reserved again for each call
+// with the size of its output so the memory of a big texture is not kept after the next call.
 static MemoryArena generateMipDataMemoryArena;
 static MemoryArena compressMipDataMemoryArena;
 
-void InitGenerateMipDataMemoryArena()
+void ResetTextureProcessingMemoryArena(MemoryArena* memoryArena, size_t sizeInBytes)
 {
-    if (generateMipDataMemoryArena.Storage == nullptr)
+    if (memoryArena->Storage != nullptr)
     {
-        generateMipDataMemoryArena = SystemAllocateMemoryArena(512 * 1024 * 1024);
+        SystemFreeMemoryArena(*memoryArena);
     }
 
-    SystemClearMemoryArena(generateMipDataMemoryArena);
+    *memoryArena = SystemAllocateMemoryArena(TEXTURE_PROCESSING_MIN_MEMORY_SIZE + sizeInBytes);
+}
+
+uint32_t GetTextureMipCount(uint32_t width, uint32_t height)
+{
+    auto maxDimension = SystemMax(width, height);
+    return (uint32_t)floorf(log2f((float)maxDimension)) + 1;
+}
+
+uint32_t GetTexturePixelSizeInBytes(ElemToolsGraphicsFormat format)
+{
+    return format == ElemToolsGraphicsFormat_R32G32B32A32_FLOAT ? 16 : 4;
+}
+
+uint32_t GetTextureFormatBlockSizeInBytes(ElemToolsGraphicsFormat format)
+{
+    switch (format)
+    {
+        case ElemToolsGraphicsFormat_BC1:
+        case ElemToolsGraphicsFormat_BC4:
+            return 8;
+
+        case ElemToolsGraphicsFormat_BC3:
+        case ElemToolsGraphicsFormat_BC5:
+        case ElemToolsGraphicsFormat_BC6H:
+        case ElemToolsGraphicsFormat_BC7:
+            return 16;
+
+        default:
+            return 0;
+    }
 }
 
-void InitCompressMipDataMemoryArena()
+// NOTE: Each mip level is resized from the base mip so the levels don't depend on each other and
+// can be generated in parallel.
+ElemTextureMipData GenerateTextureMipLevel(MemoryArena memoryArena, ElemToolsGraphicsFormat format, const ElemTextureMipData* baseMip, uint32_t mipLevel)
 {
-    if (compressMipDataMemoryArena.Storage == nullptr)
+    auto pixelSize = GetTexturePixelSizeInBytes(format);
+
+    ElemTextureMipData mipLevelData =
     {
-        compressMipDataMemoryArena = SystemAllocateMemoryArena(512 * 1024 * 1024);
+        .Width = SystemMax(1u, baseMip->Width >> mipLevel),
+        .Height = SystemMax(1u, baseMip->Height >> mipLevel)
+    };
+
+    auto mipLevelPixels = SystemPushArray<uint8_t>(memoryArena, mipLevelData.Width * mipLevelData.Height * pixelSize);
+
+    if (mipLevelPixels.Pointer == nullptr)
+    {
+        // NOTE: An empty mip signals to the caller that the arena is full.
+        return {};
+    }
+
+    if (format == ElemToolsGraphicsFormat_R32G32B32A32_FLOAT)
+    {
+        stbir_resize_float_linear((const float*)baseMip->Data.Items, baseMip->Width, baseMip->Height, 0,
+                                  (float*)mipLevelPixels.Pointer, mipLevelData.Width, mipLevelData.Height, 0,
+                                  STBIR_RGBA);
+    }
+    else
+    {
+        stbir_resize_uint8_srgb(baseMip->Data.Items, baseMip->Width, baseMip->Height, 0,
+                                mipLevelPixels.Pointer, mipLevelData.Width, mipLevelData.Height, 0,
+                                STBIR_RGBA);
     }
 
-    SystemClearMemoryArena(compressMipDataMemoryArena);
+    mipLevelData.Data = { .Items = mipLevelPixels.Pointer, .Length = (uint32_t)mipLevelPixels.Length };
+    return mipLevelData;
 }
 
 ElemToolsAPI ElemGenerateTextureMipDataResult ElemGenerateTextureMipData(ElemToolsGraphicsFormat format, const ElemTextureMipData* baseMip, const ElemGenerateTextureMipDataOptions* options)
 {
-    InitGenerateMipDataMemoryArena();
+    // NOTE: The base mip is copied and the other mips take less than half of its size.
+    auto baseMipSizeInBytes = (size_t)baseMip->Width * baseMip->Height * GetTexturePixelSizeInBytes(format);
+    ResetTextureProcessingMemoryArena(&generateMipDataMemoryArena, baseMip->Data.Length + baseMipSizeInBytes);
 
     auto messages = SystemPushArray<ElemToolsMessage>(generateMipDataMemoryArena, 1024);
     auto messageCount = 0u;
@@ -45,12 +114,22 @@ ElemToolsAPI ElemGenerateTextureMipDataResult ElemGenerateTextureMipData(ElemToo
         generateMipDataOptions = *options;
     }
 
-    auto pixelSize = 4; // TODO: Check format first
-    auto maxDimension = SystemMax(baseMip->Width, baseMip->Height);
-    auto mipCount = (uint32_t)floorf(log2f((float)maxDimension)) + 1;
+    if (format != ElemToolsGraphicsFormat_R8G8B8A8 && format != ElemToolsGraphicsFormat_R32G32B32A32_FLOAT)
+    {
+        return { .Messages = ConstructErrorMessageSpan(generateMipDataMemoryArena, "The format of the base mip should be R8G8B8A8 or R32G32B32A32_FLOAT."), .HasErrors = true };
+    }
+
+    auto mipCount = GetTextureMipCount(baseMip->Width, baseMip->Height);
 
     auto mipData = SystemPushArray<ElemTextureMipData>(generateMipDataMemoryArena, mipCount);
-    auto baseMipCopy = SystemDuplicateBuffer(generateMipDataMemoryArena, ReadOnlySpan<uint8_t>(baseMip->Data.Items, baseMip->Data.Length));
+    auto baseMipCopy = SystemPushArray<uint8_t>(generateMipDataMemoryArena, baseMip->Data.Length);
+
+    if (mipData.Pointer == nullptr || baseMipCopy.Pointer == nullptr)
+    {
+        return { .Messages = ConstructErrorMessageSpan(generateMipDataMemoryArena, "Not enough memory to generate the mip data."), .HasErrors = true };
+    }
+
+    SystemCopyBuffer(baseMipCopy, ReadOnlySpan<uint8_t>(baseMip->Data.Items, baseMip->Data.Length));
 
     mipData[0] = 
     {
@@ -61,18 +140,12 @@ ElemToolsAPI ElemGenerateTextureMipDataResult ElemGenerateTextureMipData(ElemToo
 
     for (uint32_t i = 1; i < mipCount; i++)
     {
-        auto mipLevelData = &mipData[i];
+        mipData[i] = GenerateTextureMipLevel(generateMipDataMemoryArena, format, baseMip, i);
 
-        mipLevelData->Width = SystemMax(1u, baseMip->Width >> i);
-        mipLevelData->Height = SystemMax(1u, baseMip->Height >> i);
-
-        auto mipLevelPixels = SystemPushArray<uint8_t>(generateMipDataMemoryArena, mipLevelData->Width * mipLevelData->Height * pixelSize);
-
-        stbir_resize_uint8_srgb(baseMip->Data.Items, baseMip->Width, baseMip->Height, 0,
-                                mipLevelPixels.Pointer, mipLevelData->Width, mipLevelData->Height, 0,
-                                STBIR_RGBA);
-
-        mipLevelData->Data = { .Items = mipLevelPixels.Pointer, .Length = (uint32_t)mipLevelPixels.Length };
+        if (mipData[i].Data.Items == nullptr)
+        {
+            return { .Messages = ConstructErrorMessageSpan(generateMipDataMemoryArena, "Not enough memory to generate the mip data."), .HasErrors = true };
+        }
     }
 
     return
@@ -83,18 +156,114 @@ ElemToolsAPI ElemGenerateTextureMipDataResult ElemGenerateTextureMipData(ElemToo
     };
 }
 
+uint32_t GetTextureCompressedSize(ElemToolsGraphicsFormat format, uint32_t width, uint32_t height)
+{
+    return ((width + 3) / 4) * ((height + 3) / 4) * GetTextureFormatBlockSizeInBytes(format);
+}
+
+void InitTextureCompressionParameters(TextureCompressionParameters* parameters)
+{
+    // TODO: Fow now we don't use the GPU
+    // NOTE: The init functions fill global tables so they must be called before starting any worker.
+    bc7enc_compress_block_init();
+    rgbcx::init();
+
+    bc7enc_compress_block_params_init(&parameters->BC7Parameters);
+    parameters->BC7Parameters.m_uber_level = 4; // TODO: Do a global quality level option
+    parameters->BC1QualityLevel = TEXTURE_BC1_QUALITY_LEVEL;
+}
+
+// NOTE: Reads a 4x4 block in both 8 bits and float so that each encoder can use the data it needs. The
+// pixels outside of the mip are clamped to the edge.
+void ReadTextureBlock(ElemToolsGraphicsFormat sourceFormat, const ElemTextureMipData* mipData, uint32_t blockX, uint32_t blockY, uint8_t* blockData, float* floatBlockData)
+{
+    for (uint32_t row = 0; row < 4; row++)
+    {
+        auto sy = SystemMin(blockY * 4 + row, mipData->Height - 1);
+
+        for (uint32_t col = 0; col < 4; col++)
+        {
+            auto sx = SystemMin(blockX * 4 + col, mipData->Width - 1);
+
+            auto sourceIndex = (sy * mipData->Width + sx) * 4;
+            auto destinationIndex = (row * 4 + col) * 4;
+
+            for (uint32_t channel = 0; channel < 4; channel++)
+            {
+                if (sourceFormat == ElemToolsGraphicsFormat_R32G32B32A32_FLOAT)
+                {
+                    auto value = ((const float*)mipData->Data.Items)[sourceIndex + channel];
+                    floatBlockData[destinationIndex + channel] = value;
+                    blockData[destinationIndex + channel] = (uint8_t)(SystemMax(0.0f, SystemMin(value, 1.0f)) * 255.0f + 0.5f);
+                }
+                else
+                {
+                    auto value = mipData->Data.Items[sourceIndex + channel];
+                    blockData[destinationIndex + channel] = value;
+                    floatBlockData[destinationIndex + channel] = (float)value / 255.0f;
+                }
+            }
+        }
+    }
+}
+
+// NOTE: Compresses a range of block rows so that big mips can be split across several jobs.
+void CompressTextureBlockRows(ElemToolsGraphicsFormat format, ElemToolsGraphicsFormat sourceFormat, const ElemTextureMipData* mipData, uint32_t startBlockRow, uint32_t blockRowCount, const TextureCompressionParameters* parameters, uint8_t* compressedData)
+{
+    auto blockWidth = (mipData->Width + 3) / 4;
+    auto blockSizeInBytes = GetTextureFormatBlockSizeInBytes(format);
+
+    uint8_t sourceBlockData[4 * 4 * 4];
+    float sourceFloatBlockData[4 * 4 * 4];
+
+    for (uint32_t by = startBlockRow; by < startBlockRow + blockRowCount; by++)
+    {
+        for (uint32_t bx = 0; bx < blockWidth; bx++)
+        {
+            auto destinationPointer = &compressedData[(by * blockWidth + bx) * blockSizeInBytes];
+            ReadTextureBlock(sourceFormat, mipData, bx, by, sourceBlockData, sourceFloatBlockData);
+
+            switch (format)
+            {
+                case ElemToolsGraphicsFormat_BC1:
+                    rgbcx::encode_bc1(parameters->BC1QualityLevel, destinationPointer, sourceBlockData, false, false);
+                    break;
+
+                case ElemToolsGraphicsFormat_BC3:
+                    rgbcx::encode_bc3(parameters->BC1QualityLevel, destinationPointer, sourceBlockData);
+                    break;
+
+                case ElemToolsGraphicsFormat_BC4:
+                    rgbcx::encode_bc4(destinationPointer, sourceBlockData, 4);
+                    break;
+
+                case ElemToolsGraphicsFormat_BC5:
+                    rgbcx::encode_bc5(destinationPointer, sourceBlockData, 0, 1, 4);
+                    break;
+
+                case ElemToolsGraphicsFormat_BC6H:
+                    EncodeBC6HBlock(destinationPointer, sourceFloatBlockData);
+                    break;
+
+                default:
+                    bc7enc_compress_block(destinationPointer, sourceBlockData, &parameters->BC7Parameters);
+                    break;
+            }
+        }
+    }
+}
+
 ElemToolsAPI ElemCompressTextureMipDataResult ElemCompressTextureMipData(ElemToolsGraphicsFormat format, const ElemTextureMipData* mipData, const ElemCompressTextureMipDataOptions* options)
 {
-    auto stackMemoryArena = SystemGetStackMemoryArena();
-    InitCompressMipDataMemoryArena();
+    ResetTextureProcessingMemoryArena(&compressMipDataMemoryArena, GetTextureCompressedSize(format, mipData->Width, mipData->Height));
 
     auto messages = SystemPushArray<ElemToolsMessage>(compressMipDataMemoryArena, 1024);
     auto messageCount = 0u;
     auto hasErrors = false;
 
-    if (format != ElemToolsGraphicsFormat_BC7)
+    if (GetTextureFormatBlockSizeInBytes(format) == 0)
     {
-        return { .Messages = ConstructErrorMessageSpan(compressMipDataMemoryArena, "The format of the mip data should be BC7 for now."), .HasErrors = true };
+        return { .Messages = ConstructErrorMessageSpan(compressMipDataMemoryArena, "The compressed format should be BC1, BC3, BC4, BC5, BC6H or BC7."), .HasErrors = true };
     }
 
     ElemCompressTextureMipDataOptions compressMipDataOptions = {};
@@ -104,52 +273,31 @@ ElemToolsAPI ElemCompressTextureMipDataResult ElemCompressTextureMipData(ElemToo
         compressMipDataOptions = *options;
     }
 
-    // TODO: Fow now we don't use the GPU
-    bc7enc_compress_block_init();
-
-    bc7enc_compress_block_params bc7Params;
-    bc7enc_compress_block_params_init(&bc7Params);
-    bc7Params.m_uber_level = 4; // TODO: Do a global quality level option
-    //bc7Params.m_uber_level = 0; // TODO: Do a global quality level option
-
-    auto blockWidth = (mipData->Width + 3) / 4;
-    auto blockHeight = (mipData->Height + 3) / 4;
-    auto blockCount = blockWidth * blockHeight;
-
-    auto compressedData = SystemPushArray<uint8_t>(compressMipDataMemoryArena, blockCount * TEXTURE_BC_BLOCK_SIZE_IN_BYTES);
-    auto sourceBlockData = SystemPushArray<uint8_t>(stackMemoryArena, 4 * 4 * 4); // TODO: DEFINE
+    if (compressMipDataOptions.SourceFormat == ElemToolsGraphicsFormat_Unknown)
+    {
+        compressMipDataOptions.SourceFormat = ElemToolsGraphicsFormat_R8G8B8A8;
+    }
 
-    for (uint32_t by = 0; by < blockHeight; by++)
+    if (compressMipDataOptions.SourceFormat != ElemToolsGraphicsFormat_R8G8B8A8 && compressMipDataOptions.SourceFormat != ElemToolsGraphicsFormat_R32G32B32A32_FLOAT)
     {
-        for (uint32_t bx = 0; bx < blockWidth; bx++)
-        {
-            auto destinationPointer = &compressedData[(by * blockWidth + bx) * TEXTURE_BC_BLOCK_SIZE_IN_BYTES];
+        return { .Messages = ConstructErrorMessageSpan(compressMipDataMemoryArena, "The source format should be R8G8B8A8 or R32G32B32A32_FLOAT."), .HasErrors = true };
+    }
 
-            for (uint32_t row = 0; row < 4; row++)
-            {
-                auto sy = by * 4 + row;
-                sy = SystemMax(0u, SystemMin(sy, mipData->Height - 1));
+    TextureCompressionParameters compressionParameters;
+    InitTextureCompressionParameters(&compressionParameters);
 
-                for (uint32_t col = 0; col < 4; col++)
-                {
-                    uint32_t sx = bx * 4 + col;
-                    sx = SystemMax(0u, SystemMin(sx, mipData->Width - 1));
-
-                    int srcIndex = (sy * mipData->Width + sx) * 4;
-                    int dstIndex = (row * 4 + col) * 4; 
-                    sourceBlockData[dstIndex + 0] = mipData->Data.Items[srcIndex + 0];
-                    sourceBlockData[dstIndex + 1] = mipData->Data.Items[srcIndex + 1];
-                    sourceBlockData[dstIndex + 2] = mipData->Data.Items[srcIndex + 2];
-                    sourceBlockData[dstIndex + 3] = mipData->Data.Items[srcIndex + 3];
-                }
-            }
+    auto compressedData = SystemPushArray<uint8_t>(compressMipDataMemoryArena, GetTextureCompressedSize(format, mipData->Width, mipData->Height));
 
-            bc7enc_compress_block(destinationPointer, sourceBlockData.Pointer, &bc7Params);
-        }
+    if (compressedData.Pointer == nullptr)
+    {
+        return { .Messages = ConstructErrorMessageSpan(compressMipDataMemoryArena, "Not enough memory to compress the mip data."), .HasErrors = true };
     }
+
+    CompressTextureBlockRows(format, compressMipDataOptions.SourceFormat, mipData, 0, (mipData->Height + 3) / 4, &compressionParameters, compressedData.Pointer);
     
     return
     {
+        .Format = format,
         .MipData = 
         { 
             .Width = mipData->Width,
@@ -2,10 +2,26 @@
 #include "ElementalTools.h"
 #include "SystemFunctions.h"
 #include "SystemMemory.h"
+#include "SystemPlatformFunctions.h"
+
+#define TOOLS_MAX_WORKER_THREADS 32
+
+struct ToolsParallelForData
+{
+    ToolsParallelForFunction Function;
+    void* Payload;
+    uint32_t Count;
+    uint32_t NextIndex;
+};
 
 // TODO: Do one for each threads
 static MemoryArena FileIOMemoryArena;
 
+// NOTE: Set on the threads that run the items of a parallel for with several workers. Nested parallel fors
+// (eg: entry points of shader libraries that are already compiled in parallel) run on the calling worker so
+// the number of threads stays bounded by the number of processors.
+thread_local bool toolsParallelForIsRunning = false;
+
 ElemToolsDataSpan DefaultFileHandler(const char* path)
 {
     if (SystemFileExists(path))
@@ -25,6 +41,16 @@ ElemToolsAPI void ElemToolsConfigureFileIO(ElemToolsLoadFileHandlerPtr loadFileH
     loadFileHandlerPtr = loadFileHandler;
 }
 
+ElemToolsAPI uint64_t ElemToolsComputeDataHash(ElemToolsDataSpan data, uint64_t seed)
+{
+    return XXH64(data.Items, data.Length, seed);
+}
+
+ElemToolsAPI const char* ElemToolsGetVersionLabel()
+{
+    return ELEM_TOOLS_VERSION_LABEL;
+}
+
 void InitStorageMemoryArena()
 {
     if (FileIOMemoryArena.Storage == nullptr)
@@ -46,6 +72,92 @@ void ResetLoadFileDataMemory()
     SystemClearMemoryArena(FileIOMemoryArena);
 }
 
+ToolsMappedFile MapFileData(const char* path, bool sequentialAccess)
+{
+    if (loadFileHandlerPtr != DefaultFileHandler)
+    {
+        return { .Data = LoadFileData(path) };
+    }
+
+    if (!SystemFileExists(path))
+    {
+        return {};
+    }
+
+    auto fileMapping = SystemFileMap(path, sequentialAccess);
+    return { .Data = fileMapping.Data, .FileMapping = fileMapping };
+}
+
+void UnmapFileData(ToolsMappedFile mappedFile)
+{
+    SystemFileUnmap(mappedFile.FileMapping);
+}
+
+void RunToolsParallelForItems(ToolsParallelForData* data)
+{
+    while (true)
+    {
+        auto index = SystemAtomicAdd(data->NextIndex, 1u);
+
+        if (index >= data->Count)
+        {
+            break;
+        }
+
+        data->Function(index, data->Payload);
+    }
+}
+
+void ToolsParallelForWorker(void* parameters)
+{
+    toolsParallelForIsRunning = true;
+    RunToolsParallelForItems((ToolsParallelForData*)parameters);
+    SystemFreeStackMemoryArena();
+}
+
+void ToolsParallelFor(uint32_t count, ToolsParallelForFunction function, void* payload)
+{
+    ToolsParallelForData data =
+    {
+        .Function = function,
+        .Payload = payload,
+        .Count = count,
+        .NextIndex = 0
+    };
+
+    auto workerCount = SystemMin(SystemMin(SystemPlatformGetProcessorCount(), count), (uint32_t)TOOLS_MAX_WORKER_THREADS);
+
+    if (workerCount <= 1 || toolsParallelForIsRunning)
+    {
+        RunToolsParallelForItems(&data);
+        return;
+    }
+
+    // NOTE: The calling thread is also a worker so we only create workerCount - 1 threads.
+    SystemThread threads[TOOLS_MAX_WORKER_THREADS];
+
+    for (uint32_t i = 0; i < workerCount - 1; i++)
+    {
+        threads[i] = SystemCreateThread(ToolsParallelForWorker, &data);
+    }
+
+    toolsParallelForIsRunning = true;
+    RunToolsParallelForItems(&data);
+    toolsParallelForIsRunning = false;
+
+    for (uint32_t i = 0; i < workerCount - 1; i++)
+    {
+        SystemWaitThread(threads[i]);
+        SystemFreeThread(threads[i]);
+    }
+}
+
+double ToolsGetElapsedMilliseconds(uint64_t startTimestamp)
+{
+    auto elapsedTicks = SystemPlatformGetHighPerformanceCounter() - startTimestamp;
+    return (double)elapsedTicks * 1000.0 / (double)SystemPlatformGetHighPerformanceCounterFrequencyInSeconds();
+}
+
 void WriteToMessageList(ElemToolsMessageType type, const char* message, ToolsMessageList* messageList)
 {
     messageList->Messages[messageList->MessageCount++] =
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ElementalTools.h"
+#include "SystemFunctions.h"
 #include "SystemMemory.h"
 #include "SystemSpan.h"
 
@@ -11,9 +12,26 @@ struct ToolsMessageList
     bool HasErrors;
 };
 
+struct ToolsMappedFile
+{
+    ReadOnlySpan<uint8_t> Data;
+    SystemFileMapping FileMapping;
+};
+
 ReadOnlySpan<uint8_t> LoadFileData(const char* path);
 void ResetLoadFileDataMemory();
 
+// NOTE: Falls back to LoadFileData when a custom file handler was configured.
+ToolsMappedFile MapFileData(const char* path, bool sequentialAccess);
+void UnmapFileData(ToolsMappedFile mappedFile);
+
+typedef void (*ToolsParallelForFunction)(uint32_t index, void* payload);
+
+// NOTE: Each index is processed exactly once. Temporary allocations should use the stack memory arena of the
+// calling worker. Results should be written at their index so the output order doesn't depend on the scheduling.
+void ToolsParallelFor(uint32_t count, ToolsParallelForFunction function, void* payload);
+double ToolsGetElapsedMilliseconds(uint64_t startTimestamp);
+
 void WriteToMessageList(ElemToolsMessageType type, const char* message, ToolsMessageList* messageList);
 
 ElemToolsMessageSpan ConstructErrorMessageSpan(MemoryArena memoryArena, const char* errorMessage);
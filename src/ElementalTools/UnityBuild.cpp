@@ -2,6 +2,7 @@
 #include "Shaders/ShaderCompiler.cpp"
 #include "Shaders/ShaderCompilerUtils.cpp"
 #include "Shaders/DirectXShaderCompiler.cpp"
+#include "Shaders/SpirvOptimizer.cpp"
 
 #ifndef __linux__
 #include "Shaders/MetalShaderConverter.cpp"
@@ -13,13 +14,28 @@
 #include "cgltf.h"
 #include "fast_obj.c"
 #include "SceneLoading/SceneLoader.cpp"
+#include "SceneLoading/SceneContainer.cpp"
 
+#include "Meshes/VertexFormat.cpp"
 #include "Meshes/MeshletBuilder.cpp"
+#include "Meshes/MeshletLodBuilder.cpp"
+#include "Meshes/MeshletEncoder.cpp"
+#include "Meshes/MeshOptimizer.cpp"
 
 #ifdef _WIN32
 #define STBI_WINDOWS_UTF8
 #endif
 
+// NOTE: stb_image only enables its SIMD paths (JPEG IDCT and color conversion) automatically for SSE2.
+#if defined(__aarch64__) || defined(_M_ARM64)
+#define STBI_NEON
+#endif
+
+#include "Textures/TextureLoader.h"
+#define STBI_MALLOC(sizeInBytes) TextureDecoderAllocate(sizeInBytes)
+#define STBI_REALLOC(pointer, sizeInBytes) TextureDecoderReallocate(pointer, sizeInBytes)
+#define STBI_FREE(pointer) TextureDecoderFree(pointer)
+
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wc99-extensions"
 #pragma clang diagnostic ignored "-Wmacro-redefined"
@@ -35,9 +51,14 @@
 #pragma clang diagnostic pop
 
 #include "bc7enc.cpp"
+#define RGBCX_IMPLEMENTATION
+#include "rgbcx.h"
 
 #include "Textures/TextureLoader.cpp"
+#include "Textures/TextureEncoderBC6H.cpp"
 #include "Textures/TextureProcessing.cpp"
+#include "Textures/TextureBuilder.cpp"
+#include "Textures/TextureContainer.cpp"
 
 #include "SystemFunctions.cpp"
 #include "SystemDictionary.cpp"
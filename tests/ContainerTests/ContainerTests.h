@@ -0,0 +1,27 @@
+#pragma once
+
+#include <filesystem>
+#include <stdio.h>
+#include <string>
+#include "Elemental.h"
+
+std::string GetContainerTestFilePath(const char* fileName)
+{
+    return (std::filesystem::temp_directory_path() / fileName).string();
+}
+
+void WriteContainerTestFile(const char* path, const void* data, size_t sizeInBytes)
+{
+    auto file = fopen(path, "wb");
+
+    if (file)
+    {
+        fwrite(data, 1, sizeInBytes, file);
+        fclose(file);
+    }
+}
+
+void DeleteContainerTestFile(const char* path)
+{
+    remove(path);
+}
@@ -0,0 +1,177 @@
+#include "Elemental.h"
+#include "ContainerTests.h"
+#include "utest.h"
+#include <string.h>
+
+// NOTE: The layout must match the scene container reader (Common/Scenes/SceneContainer.cpp)
+struct TestSceneContainerHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t SectionCount;
+    uint32_t SectionAlignment;
+    uint32_t Reserved;
+    uint64_t SizeInBytes;
+};
+
+struct TestSceneContainerTableEntry
+{
+    uint32_t Id;
+    uint32_t ElementSize;
+    uint32_t ElementCount;
+    uint32_t Reserved;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+#define TEST_SCENE_CONTAINER_SIZE 256
+
+struct TestSceneContainer
+{
+    TestSceneContainerHeader Header;
+    TestSceneContainerTableEntry TableEntries[2];
+    uint8_t Data[TEST_SCENE_CONTAINER_SIZE - sizeof(TestSceneContainerHeader) - 2 * sizeof(TestSceneContainerTableEntry)];
+};
+
+static const uint32_t TestSceneContainerElements[] = { 1, 2, 3 };
+static const uint8_t TestSceneContainerRawData[] = { 4, 5, 6, 7, 8 };
+
+void TestBuildSceneContainer(TestSceneContainer* container)
+{
+    memset(container, 0, sizeof(TestSceneContainer));
+
+    container->Header =
+    {
+        .FileId = { 'E', 'L', 'E', 'M', 'S', 'C', 'N', 'E' },
+        .Version = 1,
+        .SectionCount = 2,
+        .SectionAlignment = 64,
+        .SizeInBytes = TEST_SCENE_CONTAINER_SIZE
+    };
+
+    container->TableEntries[0] = { .Id = 1, .ElementSize = sizeof(uint32_t), .ElementCount = 3, .Offset = 128, .SizeInBytes = sizeof(TestSceneContainerElements) };
+    container->TableEntries[1] = { .Id = 2, .ElementSize = 0, .ElementCount = 5, .Offset = 192, .SizeInBytes = sizeof(TestSceneContainerRawData) };
+
+    memcpy((uint8_t*)container + 128, TestSceneContainerElements, sizeof(TestSceneContainerElements));
+    memcpy((uint8_t*)container + 192, TestSceneContainerRawData, sizeof(TestSceneContainerRawData));
+}
+
+UTEST(SceneContainer, OpenSceneContainer)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestScene.scene");
+
+    TestSceneContainer container;
+    TestBuildSceneContainer(&container);
+    WriteContainerTestFile(path.c_str(), &container, sizeof(container));
+
+    // Act
+    auto sceneContainer = ElemOpenSceneContainer(path.c_str());
+    auto info = ElemGetSceneContainerInfo(sceneContainer);
+    auto elementSection = ElemGetSceneContainerSection(sceneContainer, 1);
+    auto rawSection = ElemGetSceneContainerSection(sceneContainer, 2);
+    auto missingSection = ElemGetSceneContainerSection(sceneContainer, 3);
+
+    uint32_t elements[3] = {};
+    uint8_t rawData[5] = {};
+
+    if (elementSection.Data.Length == sizeof(elements) && rawSection.Data.Length == sizeof(rawData))
+    {
+        memcpy(elements, elementSection.Data.Items, sizeof(elements));
+        memcpy(rawData, rawSection.Data.Items, sizeof(rawData));
+    }
+
+    ElemCloseSceneContainer(sceneContainer);
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_NE_MSG(sceneContainer, ELEM_HANDLE_NULL, "Scene container should be opened.");
+    ASSERT_EQ(info.Version, 1u);
+    ASSERT_EQ(info.Sections.Length, 2u);
+
+    ASSERT_EQ(elementSection.ElementSize, (uint32_t)sizeof(uint32_t));
+    ASSERT_EQ(elementSection.ElementCount, 3u);
+    ASSERT_EQ(elementSection.Data.Length, (uint32_t)sizeof(elements));
+    ASSERT_EQ(elements[0], 1u);
+    ASSERT_EQ(elements[1], 2u);
+    ASSERT_EQ(elements[2], 3u);
+
+    ASSERT_EQ(rawSection.ElementSize, 0u);
+    ASSERT_EQ(rawSection.ElementCount, 5u);
+    ASSERT_EQ(rawData[0], 4u);
+    ASSERT_EQ(rawData[4], 8u);
+
+    ASSERT_EQ(missingSection.Id, 3u);
+    ASSERT_EQ(missingSection.Data.Length, 0u);
+}
+
+UTEST(SceneContainer, OpenSceneContainer_Truncated)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestSceneTruncated.scene");
+
+    TestSceneContainer container;
+    TestBuildSceneContainer(&container);
+    WriteContainerTestFile(path.c_str(), &container, 150);
+
+    // Act
+    auto sceneContainer = ElemOpenSceneContainer(path.c_str());
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_EQ_MSG(sceneContainer, ELEM_HANDLE_NULL, "Truncated scene container should not be opened.");
+}
+
+struct SceneContainer_OpenSceneContainerInvalidSection
+{
+    uint32_t ElementCount;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+UTEST_F_SETUP(SceneContainer_OpenSceneContainerInvalidSection)
+{
+}
+
+UTEST_F_TEARDOWN(SceneContainer_OpenSceneContainerInvalidSection)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestSceneInvalid.scene");
+
+    TestSceneContainer container;
+    TestBuildSceneContainer(&container);
+
+    container.TableEntries[0].ElementCount = utest_fixture->ElementCount;
+    container.TableEntries[0].Offset = utest_fixture->Offset;
+    container.TableEntries[0].SizeInBytes = utest_fixture->SizeInBytes;
+
+    WriteContainerTestFile(path.c_str(), &container, sizeof(container));
+
+    // Act
+    auto sceneContainer = ElemOpenSceneContainer(path.c_str());
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_EQ_MSG(sceneContainer, ELEM_HANDLE_NULL, "Scene container with an invalid section should not be opened.");
+}
+
+UTEST_F(SceneContainer_OpenSceneContainerInvalidSection, ElementCountMismatch)
+{
+    utest_fixture->ElementCount = 4;
+    utest_fixture->Offset = 128;
+    utest_fixture->SizeInBytes = sizeof(TestSceneContainerElements);
+}
+
+UTEST_F(SceneContainer_OpenSceneContainerInvalidSection, SectionOutsideFile)
+{
+    utest_fixture->ElementCount = 3;
+    utest_fixture->Offset = TEST_SCENE_CONTAINER_SIZE - 4;
+    utest_fixture->SizeInBytes = sizeof(TestSceneContainerElements);
+}
+
+UTEST_F(SceneContainer_OpenSceneContainerInvalidSection, OffsetOverflow)
+{
+    utest_fixture->ElementCount = 3;
+    utest_fixture->Offset = UINT64_MAX - 4;
+    utest_fixture->SizeInBytes = sizeof(TestSceneContainerElements);
+}
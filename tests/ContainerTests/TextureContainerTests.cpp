@@ -0,0 +1,237 @@
+#include "Elemental.h"
+#include "ContainerTests.h"
+#include "utest.h"
+#include <string.h>
+
+// NOTE: The layout must match the texture container reader (Common/Textures/TextureContainer.cpp)
+struct TestTextureContainerHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t Format;
+    uint32_t Width;
+    uint32_t Height;
+    uint32_t MipCount;
+    uint32_t MipAlignment;
+    uint64_t SizeInBytes;
+};
+
+struct TestTextureContainerMipEntry
+{
+    uint32_t Width;
+    uint32_t Height;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+#define TEST_TEXTURE_CONTAINER_SIZE 192
+#define TEST_TEXTURE_CONTAINER_FORMAT_BC1 2
+
+struct TestTextureContainer
+{
+    TestTextureContainerHeader Header;
+    TestTextureContainerMipEntry MipEntries[3];
+    uint8_t Data[TEST_TEXTURE_CONTAINER_SIZE - sizeof(TestTextureContainerHeader) - 3 * sizeof(TestTextureContainerMipEntry)];
+};
+
+void TestBuildTextureContainer(TestTextureContainer* container)
+{
+    memset(container, 0, sizeof(TestTextureContainer));
+
+    container->Header =
+    {
+        .FileId = { 'E', 'L', 'E', 'M', 'T', 'E', 'X', 'C' },
+        .Version = 1,
+        .Format = TEST_TEXTURE_CONTAINER_FORMAT_BC1,
+        .Width = 8,
+        .Height = 8,
+        .MipCount = 3,
+        .MipAlignment = 64,
+        .SizeInBytes = TEST_TEXTURE_CONTAINER_SIZE
+    };
+
+    // NOTE: The smallest mip is stored first and the mips smaller than the alignment are packed.
+    container->MipEntries[0] = { .Width = 8, .Height = 8, .Offset = 144, .SizeInBytes = 32 };
+    container->MipEntries[1] = { .Width = 4, .Height = 4, .Offset = 136, .SizeInBytes = 8 };
+    container->MipEntries[2] = { .Width = 2, .Height = 2, .Offset = 128, .SizeInBytes = 8 };
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        memset((uint8_t*)container + container->MipEntries[i].Offset, i + 1, container->MipEntries[i].SizeInBytes);
+    }
+}
+
+UTEST(TextureContainer, OpenTextureContainer)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestTexture.texture");
+
+    TestTextureContainer container;
+    TestBuildTextureContainer(&container);
+    WriteContainerTestFile(path.c_str(), &container, sizeof(container));
+
+    // Act
+    auto textureContainer = ElemOpenTextureContainer(path.c_str());
+    auto info = ElemGetTextureContainerInfo(textureContainer);
+    auto mip0 = ElemGetTextureContainerMip(textureContainer, 0);
+    auto mip2 = ElemGetTextureContainerMip(textureContainer, 2);
+    auto missingMip = ElemGetTextureContainerMip(textureContainer, 3);
+
+    uint8_t mip0Data[32] = {};
+    uint8_t mip2Data[8] = {};
+
+    if (mip0.Data.Length == sizeof(mip0Data) && mip2.Data.Length == sizeof(mip2Data))
+    {
+        memcpy(mip0Data, mip0.Data.Items, sizeof(mip0Data));
+        memcpy(mip2Data, mip2.Data.Items, sizeof(mip2Data));
+    }
+
+    ElemCloseTextureContainer(textureContainer);
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_NE_MSG(textureContainer, ELEM_HANDLE_NULL, "Texture container should be opened.");
+    ASSERT_EQ(info.Format, ElemGraphicsFormat_BC1);
+    ASSERT_EQ(info.Width, 8u);
+    ASSERT_EQ(info.Height, 8u);
+    ASSERT_EQ(info.MipLevels, 3u);
+    ASSERT_EQ(info.MipAlignment, 64u);
+
+    ASSERT_EQ(mip0.MipLevel, 0u);
+    ASSERT_EQ(mip0.Width, 8u);
+    ASSERT_EQ(mip0.Height, 8u);
+    ASSERT_EQ(mip0.FileOffset, 144ull);
+    ASSERT_EQ(mip0.Data.Length, 32u);
+    ASSERT_EQ(mip0Data[0], 1u);
+    ASSERT_EQ(mip0Data[31], 1u);
+
+    ASSERT_EQ(mip2.Width, 2u);
+    ASSERT_EQ(mip2.Height, 2u);
+    ASSERT_EQ(mip2.FileOffset, 128ull);
+    ASSERT_EQ(mip2Data[0], 3u);
+
+    ASSERT_EQ(missingMip.MipLevel, 3u);
+    ASSERT_EQ(missingMip.Data.Length, 0u);
+}
+
+UTEST(TextureContainer, OpenTextureContainer_Truncated)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestTextureTruncated.texture");
+
+    TestTextureContainer container;
+    TestBuildTextureContainer(&container);
+    WriteContainerTestFile(path.c_str(), &container, 150);
+
+    // Act
+    auto textureContainer = ElemOpenTextureContainer(path.c_str());
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_EQ_MSG(textureContainer, ELEM_HANDLE_NULL, "Truncated texture container should not be opened.");
+}
+
+UTEST(TextureContainer, OpenTextureContainer_InvalidMipAlignment)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestTextureInvalidAlignment.texture");
+
+    TestTextureContainer container;
+    TestBuildTextureContainer(&container);
+    container.Header.MipAlignment = 48;
+
+    WriteContainerTestFile(path.c_str(), &container, sizeof(container));
+
+    // Act
+    auto textureContainer = ElemOpenTextureContainer(path.c_str());
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_EQ_MSG(textureContainer, ELEM_HANDLE_NULL, "Texture container with a mip alignment that is not a power of 2 should not be opened.");
+}
+
+struct TextureContainer_OpenTextureContainerInvalidMip
+{
+    uint32_t Width;
+    uint32_t Height;
+    uint64_t Offset;
+    uint64_t SizeInBytes;
+};
+
+UTEST_F_SETUP(TextureContainer_OpenTextureContainerInvalidMip)
+{
+}
+
+UTEST_F_TEARDOWN(TextureContainer_OpenTextureContainerInvalidMip)
+{
+    // Arrange
+    auto path = GetContainerTestFilePath("ElementalTestTextureInvalid.texture");
+
+    TestTextureContainer container;
+    TestBuildTextureContainer(&container);
+
+    container.MipEntries[1] =
+    {
+        .Width = utest_fixture->Width,
+        .Height = utest_fixture->Height,
+        .Offset = utest_fixture->Offset,
+        .SizeInBytes = utest_fixture->SizeInBytes
+    };
+
+    WriteContainerTestFile(path.c_str(), &container, sizeof(container));
+
+    // Act
+    auto textureContainer = ElemOpenTextureContainer(path.c_str());
+    DeleteContainerTestFile(path.c_str());
+
+    // Assert
+    ASSERT_EQ_MSG(textureContainer, ELEM_HANDLE_NULL, "Texture container with an invalid mip should not be opened.");
+}
+
+UTEST_F(TextureContainer_OpenTextureContainerInvalidMip, WidthMismatch)
+{
+    utest_fixture->Width = 8;
+    utest_fixture->Height = 4;
+    utest_fixture->Offset = 136;
+    utest_fixture->SizeInBytes = 8;
+}
+
+UTEST_F(TextureContainer_OpenTextureContainerInvalidMip, HeightMismatch)
+{
+    utest_fixture->Width = 4;
+    utest_fixture->Height = 2;
+    utest_fixture->Offset = 136;
+    utest_fixture->SizeInBytes = 8;
+}
+
+UTEST_F(TextureContainer_OpenTextureContainerInvalidMip, MipOutsideFile)
+{
+    utest_fixture->Width = 4;
+    utest_fixture->Height = 4;
+    utest_fixture->Offset = TEST_TEXTURE_CONTAINER_SIZE - 4;
+    utest_fixture->SizeInBytes = 8;
+}
+
+UTEST_F(TextureContainer_OpenTextureContainerInvalidMip, OffsetOverflow)
+{
+    utest_fixture->Width = 4;
+    utest_fixture->Height = 4;
+    utest_fixture->Offset = UINT64_MAX - 4;
+    utest_fixture->SizeInBytes = 8;
+}
+
+UTEST_F(TextureContainer_OpenTextureContainerInvalidMip, SizeMismatch)
+{
+    utest_fixture->Width = 4;
+    utest_fixture->Height = 4;
+    utest_fixture->Offset = 136;
+    utest_fixture->SizeInBytes = 4;
+}
+
+UTEST_F(TextureContainer_OpenTextureContainerInvalidMip, OffsetInsideMipTable)
+{
+    utest_fixture->Width = 4;
+    utest_fixture->Height = 4;
+    utest_fixture->Offset = 64;
+    utest_fixture->SizeInBytes = 8;
+}
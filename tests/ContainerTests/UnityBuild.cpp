@@ -0,0 +1,14 @@
+#include "SceneContainerTests.cpp"
+#include "TextureContainerTests.cpp"
+#include "utest.h"
+
+UTEST_STATE();
+
+int main(int argc, const char* argv[]) 
+{
+    #ifdef _DEBUG
+    ElemConfigureLogHandler(ElemConsoleLogHandler);
+    #endif
+
+    return utest_main(argc, argv);
+}
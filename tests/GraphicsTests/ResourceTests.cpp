@@ -479,6 +479,134 @@ UTEST(Resource, CreateTexture2DResourceInfo_RenderTargetWrite)
     ASSERT_STREQ_MSG(resourceInfo.DebugName, "TestTexture2D", "Debug name should match the creation usage.");
 }
 
+UTEST(Resource, CreateSparseGraphicsResource) 
+{
+    // Arrange
+    auto graphicsDevice = ElemCreateGraphicsDevice(nullptr);
+    auto resourceInfo = ElemCreateTexture2DResourceInfo(graphicsDevice, 512, 512, 10, ElemGraphicsFormat_B8G8R8A8, ElemGraphicsResourceUsage_Read, nullptr);
+
+    // Act
+    auto resource = ElemCreateSparseGraphicsResource(graphicsDevice, &resourceInfo);
+
+    // Assert
+    auto sparseResourceInfo = ElemGetGraphicsResourceInfo(resource);
+    auto tileInfo = ElemGetGraphicsResourceTileInfo(resource);
+
+    ElemFreeGraphicsResource(resource, nullptr);
+    ElemFreeGraphicsDevice(graphicsDevice);
+
+    ASSERT_LOG_NOERROR();
+    ASSERT_NE_MSG(resource, ELEM_HANDLE_NULL, "Handle should not be null.");
+
+    ASSERT_EQ_MSG(sparseResourceInfo.Type, ElemGraphicsResourceType_Texture2D, "Resource Type should be a Texture2D.");
+    ASSERT_EQ_MSG(sparseResourceInfo.Width, resourceInfo.Width, "Width should be equals to creation.");
+    ASSERT_EQ_MSG(sparseResourceInfo.Height, resourceInfo.Height, "Height should be equals to creation.");
+    ASSERT_EQ_MSG(sparseResourceInfo.MipLevels, resourceInfo.MipLevels, "MipLevels should be equals to creation.");
+    ASSERT_GT_MSG(tileInfo.TileWidth, 0u, "TileWidth should be greater than 0.");
+    ASSERT_GT_MSG(tileInfo.TileHeight, 0u, "TileHeight should be greater than 0.");
+    ASSERT_GT_MSG(tileInfo.TileSizeInBytes, 0u, "TileSizeInBytes should be greater than 0.");
+    ASSERT_GT_MSG(tileInfo.TileAlignmentInBytes, 0u, "TileAlignmentInBytes should be greater than 0.");
+    ASSERT_EQ_MSG(tileInfo.TileSizeInBytes % tileInfo.TileAlignmentInBytes, 0u, "TileSizeInBytes should be a multiple of TileAlignmentInBytes.");
+    ASSERT_LE_MSG(tileInfo.PackedMipLevel, resourceInfo.MipLevels, "PackedMipLevel should be less or equal to the mip levels.");
+}
+
+UTEST(Resource, CreateSparseGraphicsResource_UsageRenderTarget) 
+{
+    // Arrange
+    auto graphicsDevice = ElemCreateGraphicsDevice(nullptr);
+    auto resourceInfo = ElemCreateTexture2DResourceInfo(graphicsDevice, 512, 512, 1, ElemGraphicsFormat_B8G8R8A8, ElemGraphicsResourceUsage_RenderTarget, nullptr);
+
+    // Act
+    auto resource = ElemCreateSparseGraphicsResource(graphicsDevice, &resourceInfo);
+
+    // Assert
+    ElemFreeGraphicsDevice(graphicsDevice);
+
+    ASSERT_LOG_MESSAGE("Sparse Texture2D should only use the Read or Write usage.");
+    ASSERT_EQ_MSG(resource, ELEM_HANDLE_NULL, "Handle should be null.");
+}
+
+UTEST(Resource, GetGraphicsResourceTileInfo_NotSparse) 
+{
+    // Arrange
+    auto graphicsDevice = ElemCreateGraphicsDevice(nullptr);
+    auto graphicsHeap = ElemCreateGraphicsHeap(graphicsDevice, TestMegaBytesToBytes(1), nullptr);
+    auto resourceInfo = ElemCreateTexture2DResourceInfo(graphicsDevice, 256, 256, 1, ElemGraphicsFormat_B8G8R8A8, ElemGraphicsResourceUsage_Read, nullptr);
+    auto resource = ElemCreateGraphicsResource(graphicsHeap, 0, &resourceInfo);
+
+    // Act
+    auto tileInfo = ElemGetGraphicsResourceTileInfo(resource);
+
+    // Assert
+    ElemFreeGraphicsResource(resource, nullptr);
+    ElemFreeGraphicsHeap(graphicsHeap);
+    ElemFreeGraphicsDevice(graphicsDevice);
+
+    ASSERT_LOG_MESSAGE("Resource should be created with ElemCreateSparseGraphicsResource.");
+    ASSERT_EQ_MSG(tileInfo.TileSizeInBytes, 0u, "TileSizeInBytes should be equals to 0.");
+}
+
+UTEST(Resource, BindGraphicsResourceTiles) 
+{
+    // Arrange
+    auto graphicsDevice = ElemCreateGraphicsDevice(nullptr);
+    auto commandQueue = ElemCreateCommandQueue(graphicsDevice, ElemCommandQueueType_Graphics, nullptr);
+    auto graphicsHeap = ElemCreateGraphicsHeap(graphicsDevice, TestMegaBytesToBytes(4), nullptr);
+    auto resourceInfo = ElemCreateTexture2DResourceInfo(graphicsDevice, 512, 512, 10, ElemGraphicsFormat_B8G8R8A8, ElemGraphicsResourceUsage_Read, nullptr);
+    auto resource = ElemCreateSparseGraphicsResource(graphicsDevice, &resourceInfo);
+    auto tileInfo = ElemGetGraphicsResourceTileInfo(resource);
+
+    ElemGraphicsResourceTileBinding bindings[] =
+    {
+        { .MipLevel = tileInfo.PackedMipLevel, .GraphicsHeap = graphicsHeap, .GraphicsHeapOffset = 0 },
+        { .MipLevel = 0, .TileX = 0, .TileY = 0, .TileCountX = 1, .TileCountY = 1, .GraphicsHeap = graphicsHeap, .GraphicsHeapOffset = (uint64_t)tileInfo.PackedMipTileCount * tileInfo.TileSizeInBytes }
+    };
+
+    // NOTE: With the software fallback all the mips are packed so only the first binding is used.
+    uint32_t bindingCount = tileInfo.PackedMipLevel > 0 ? 2 : 1;
+
+    // Act
+    auto fence = ElemBindGraphicsResourceTiles(commandQueue, resource, { .Items = bindings, .Length = bindingCount }, nullptr);
+
+    // Assert
+    ElemWaitForFenceOnCpu(fence);
+    auto descriptor = ElemCreateGraphicsResourceDescriptor(resource, ElemGraphicsResourceDescriptorUsage_Read, nullptr);
+
+    ElemFreeGraphicsResourceDescriptor(descriptor, nullptr);
+    ElemFreeGraphicsResource(resource, nullptr);
+    ElemFreeGraphicsHeap(graphicsHeap);
+    ElemFreeCommandQueue(commandQueue);
+    ElemFreeGraphicsDevice(graphicsDevice);
+
+    ASSERT_LOG_NOERROR();
+    ASSERT_NE_MSG(fence.CommandQueue, ELEM_HANDLE_NULL, "Fence should be valid.");
+    ASSERT_NE_MSG(descriptor, -1, "Descriptor should not be invalid.");
+}
+
+UTEST(Resource, BindGraphicsResourceTiles_OutsideMip) 
+{
+    // Arrange
+    auto graphicsDevice = ElemCreateGraphicsDevice(nullptr);
+    auto commandQueue = ElemCreateCommandQueue(graphicsDevice, ElemCommandQueueType_Graphics, nullptr);
+    auto graphicsHeap = ElemCreateGraphicsHeap(graphicsDevice, TestMegaBytesToBytes(4), nullptr);
+    auto resourceInfo = ElemCreateTexture2DResourceInfo(graphicsDevice, 512, 512, 10, ElemGraphicsFormat_B8G8R8A8, ElemGraphicsResourceUsage_Read, nullptr);
+    auto resource = ElemCreateSparseGraphicsResource(graphicsDevice, &resourceInfo);
+
+    ElemGraphicsResourceTileBinding binding = { .MipLevel = 10, .GraphicsHeap = graphicsHeap };
+
+    // Act
+    auto fence = ElemBindGraphicsResourceTiles(commandQueue, resource, { .Items = &binding, .Length = 1 }, nullptr);
+
+    // Assert
+    ElemFreeGraphicsResource(resource, nullptr);
+    ElemFreeGraphicsHeap(graphicsHeap);
+    ElemFreeCommandQueue(commandQueue);
+    ElemFreeGraphicsDevice(graphicsDevice);
+
+    ASSERT_LOG_MESSAGE("Sparse tile binding mip level should be less than the texture mip levels.");
+    ASSERT_EQ_MSG(fence.CommandQueue, ELEM_HANDLE_NULL, "Fence should be empty.");
+}
+
 UTEST(Resource, FreeGraphicsResource) 
 {
     // Arrange
@@ -557,6 +685,73 @@ UTEST(Resource, FreeGraphicsResource_WithFenceExecuted)
     ASSERT_EQ_MSG(afterFreeResourceInfo.Width, 0u, "Width should be equals to 0.");
 }
 
+UTEST(Resource, FreeGraphicsResource_WithFencesAcrossFrames) 
+{
+    // Arrange
+    const uint32_t resourceCount = 3;
+
+    auto graphicsDevice = ElemCreateGraphicsDevice(nullptr);
+    auto commandQueue = ElemCreateCommandQueue(graphicsDevice, ElemCommandQueueType_Graphics, nullptr);
+    auto graphicsHeap = ElemCreateGraphicsHeap(graphicsDevice, TestMegaBytesToBytes(1), nullptr);
+    auto resourceInfo = ElemCreateGraphicsBufferResourceInfo(graphicsDevice, 1024, ElemGraphicsResourceUsage_Read, nullptr);
+
+    auto resourceStrideInBytes = (resourceInfo.SizeInBytes + resourceInfo.Alignment - 1) / resourceInfo.Alignment * resourceInfo.Alignment;
+
+    ElemGraphicsResource resources[resourceCount];
+    ElemFence fences[resourceCount];
+
+    for (uint32_t i = 0; i < resourceCount; i++)
+    {
+        resources[i] = ElemCreateGraphicsResource(graphicsHeap, i * resourceStrideInBytes, &resourceInfo);
+    }
+
+    ElemAdvanceGraphicsDeviceFrameOptions frameOptions = { .ProcessDeleteQueueOnBackgroundThread = true };
+    uint32_t deletedResourceCount = 0;
+
+    // Act
+    for (uint32_t i = 0; i < resourceCount; i++)
+    {
+        auto commandList = ElemGetCommandList(commandQueue, nullptr);
+        ElemCommitCommandList(commandList);
+        fences[i] = ElemExecuteCommandList(commandQueue, commandList, nullptr);
+
+        ElemFreeGraphicsResourceOptions options = { .FencesToWait = { .Items = &fences[i], .Length = 1 } };
+        ElemFreeGraphicsResource(resources[i], &options);
+
+        auto frameInfo = ElemAdvanceGraphicsDeviceFrame(graphicsDevice, &frameOptions);
+        deletedResourceCount += frameInfo.DeletedResourceCount;
+    }
+
+    ElemWaitForFenceOnCpu(fences[resourceCount - 1]);
+
+    // NOTE: The first advance joins the pass started before the wait, the second one joins the pass that saw all the fences completed.
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        auto frameInfo = ElemAdvanceGraphicsDeviceFrame(graphicsDevice, &frameOptions);
+        deletedResourceCount += frameInfo.DeletedResourceCount;
+    }
+
+    // Assert
+    ElemGraphicsResourceInfo afterFreeResourceInfos[resourceCount];
+
+    for (uint32_t i = 0; i < resourceCount; i++)
+    {
+        afterFreeResourceInfos[i] = ElemGetGraphicsResourceInfo(resources[i]);
+    }
+
+    ElemFreeGraphicsHeap(graphicsHeap);
+    ElemFreeCommandQueue(commandQueue);
+    ElemFreeGraphicsDevice(graphicsDevice);
+
+    ASSERT_LOG_NOERROR();
+    ASSERT_GE_MSG(deletedResourceCount, resourceCount, "All the resources should have been deleted.");
+
+    for (uint32_t i = 0; i < resourceCount; i++)
+    {
+        ASSERT_EQ_MSG(afterFreeResourceInfos[i].Width, 0u, "Width should be equals to 0.");
+    }
+}
+
 UTEST(Resource, CreateGraphicsResourceDescriptor_ReadWithBuffer) 
 {
     // Arrange
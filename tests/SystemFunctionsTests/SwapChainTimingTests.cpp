@@ -0,0 +1,95 @@
+#include "Graphics/SwapChainTiming.h"
+#include "utest.h"
+
+#define SWAPCHAIN_TEST_REFRESH_INTERVAL_TICKS 1000u
+
+UTEST(SwapChainTiming, ComputeSwapChainVSyncInterval) 
+{
+    // Act
+    auto fullRateInterval = ComputeSwapChainVSyncInterval(60, 60);
+    auto halfRateInterval = ComputeSwapChainVSyncInterval(120, 60);
+    auto higherTargetInterval = ComputeSwapChainVSyncInterval(60, 240);
+    auto zeroInterval = ComputeSwapChainVSyncInterval(0, 0);
+
+    // Assert
+    ASSERT_EQ(1u, fullRateInterval);
+    ASSERT_EQ(2u, halfRateInterval);
+    ASSERT_EQ(1u, higherTargetInterval);
+    ASSERT_EQ(1u, zeroInterval);
+}
+
+struct SwapChainTiming_UpdateSkipped
+{
+    uint64_t ElapsedTicks;
+    uint32_t VSyncInterval;
+    bool ExpectedSkipped;
+    bool ExpectedLate;
+};
+
+UTEST_F_SETUP(SwapChainTiming_UpdateSkipped) 
+{
+}
+
+UTEST_F_TEARDOWN(SwapChainTiming_UpdateSkipped) 
+{
+    // Arrange
+    auto previousUpdateTimestamp = 10000ull;
+    auto currentTimestamp = previousUpdateTimestamp + utest_fixture->ElapsedTicks;
+
+    // Act
+    auto isSkipped = IsSwapChainUpdateSkipped(previousUpdateTimestamp, currentTimestamp, utest_fixture->VSyncInterval, SWAPCHAIN_TEST_REFRESH_INTERVAL_TICKS);
+    auto isLate = IsSwapChainUpdateLate(previousUpdateTimestamp, currentTimestamp, utest_fixture->VSyncInterval, SWAPCHAIN_TEST_REFRESH_INTERVAL_TICKS);
+
+    // Assert
+    ASSERT_EQ(utest_fixture->ExpectedSkipped, isSkipped);
+    ASSERT_EQ(utest_fixture->ExpectedLate, isLate);
+}
+
+UTEST_F(SwapChainTiming_UpdateSkipped, FullRate) 
+{
+    utest_fixture->ElapsedTicks = 1000;
+    utest_fixture->VSyncInterval = 1;
+    utest_fixture->ExpectedSkipped = false;
+    utest_fixture->ExpectedLate = false;
+}
+
+UTEST_F(SwapChainTiming_UpdateSkipped, SkippedVBlank) 
+{
+    utest_fixture->ElapsedTicks = 1000;
+    utest_fixture->VSyncInterval = 2;
+    utest_fixture->ExpectedSkipped = true;
+    utest_fixture->ExpectedLate = false;
+}
+
+UTEST_F(SwapChainTiming_UpdateSkipped, TargetVBlankWithJitter) 
+{
+    utest_fixture->ElapsedTicks = 1600;
+    utest_fixture->VSyncInterval = 2;
+    utest_fixture->ExpectedSkipped = false;
+    utest_fixture->ExpectedLate = false;
+}
+
+UTEST_F(SwapChainTiming_UpdateSkipped, FrameCallbackWithheld) 
+{
+    utest_fixture->ElapsedTicks = 4000;
+    utest_fixture->VSyncInterval = 2;
+    utest_fixture->ExpectedSkipped = false;
+    utest_fixture->ExpectedLate = true;
+}
+
+UTEST_F(SwapChainTiming_UpdateSkipped, FrameCallbackWithheldFullRate) 
+{
+    utest_fixture->ElapsedTicks = 3000;
+    utest_fixture->VSyncInterval = 1;
+    utest_fixture->ExpectedSkipped = false;
+    utest_fixture->ExpectedLate = true;
+}
+
+UTEST(SwapChainTiming, IsSwapChainUpdateSkipped_FirstUpdate) 
+{
+    // Act
+    auto isSkipped = IsSwapChainUpdateSkipped(0, 500, 4, SWAPCHAIN_TEST_REFRESH_INTERVAL_TICKS);
+
+    // Assert
+    ASSERT_FALSE(isSkipped);
+}
@@ -7,6 +7,7 @@
 #include "LibraryProcessTests.cpp"
 #include "DictionaryTests.cpp"
 #include "DataPoolTests.cpp"
+#include "SwapChainTimingTests.cpp"
 
 #ifndef _WIN32
 #include "PosixPlatformFunctions.cpp"
@@ -18,6 +19,7 @@
 #include "SystemFunctions.cpp"
 #include "SystemDictionary.cpp"
 #include "SystemDataPool.cpp"
+#include "Graphics/SwapChainTiming.cpp"
 
 #ifdef _DEBUG
 void LogMessageHandler(ElemLogMessageType messageType, ElemLogMessageCategory, const char* function, const char* message)
@@ -1,8 +1,11 @@
 #include "ToolsTests.h"
 #include "utest.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
 
 // TODO: Add check when passing only vertex buffer for mod 3 
-// TODO: Test cone and bounding box and spheres
+// TODO: Test cone
 
 struct TestMeshVector2
 {
@@ -56,6 +59,49 @@ ElemUInt32Span TestBuildIndexBuffer(uint32_t* destination, uint32_t count)
     };
 }
 
+ElemVertexBuffer TestBuildGridMesh(TestMeshVertex* vertexList, uint32_t* indexList, uint32_t gridSize)
+{
+    for (uint32_t y = 0; y <= gridSize; y++)
+    {
+        for (uint32_t x = 0; x <= gridSize; x++)
+        {
+            vertexList[y * (gridSize + 1) + x] =
+            {
+                .Position = { (float)x, (float)y, 0.0f },
+                .Normal = { 0.0f, 0.0f, 1.0f },
+                .TextureCoordinates = { (float)x / gridSize, (float)y / gridSize }
+            };
+        }
+    }
+
+    auto currentIndex = 0u;
+
+    for (uint32_t y = 0; y < gridSize; y++)
+    {
+        for (uint32_t x = 0; x < gridSize; x++)
+        {
+            auto topLeft = y * (gridSize + 1) + x;
+            auto bottomLeft = topLeft + gridSize + 1;
+
+            indexList[currentIndex++] = topLeft;
+            indexList[currentIndex++] = bottomLeft;
+            indexList[currentIndex++] = topLeft + 1;
+            indexList[currentIndex++] = topLeft + 1;
+            indexList[currentIndex++] = bottomLeft;
+            indexList[currentIndex++] = bottomLeft + 1;
+        }
+    }
+
+    auto vertexCount = (gridSize + 1) * (gridSize + 1);
+
+    return
+    {
+        .Data = { .Items = (uint8_t*)vertexList, .Length = (uint32_t)(vertexCount * sizeof(TestMeshVertex)) },
+        .VertexSize = sizeof(TestMeshVertex),
+        .VertexCount = vertexCount
+    };
+}
+
 UTEST(MeshBuilder, CheckVertexBuffer) 
 {
     // Arrange
@@ -193,3 +239,484 @@ UTEST(MeshBuilder, CheckMeshletTriangleIndexBuffer)
         }
     }
 }
+
+UTEST(MeshBuilder, CheckMeshletBounds) 
+{
+    // Arrange
+    const uint32_t vertexCount = 210;
+
+    TestMeshVertex vertexList[vertexCount];
+    uint32_t indexList[vertexCount];
+
+    auto vertexBuffer = TestBuildVertexBuffer(vertexList, vertexCount);
+    auto indexBuffer = TestBuildIndexBuffer(indexList, vertexCount);
+
+    // Act
+    auto result = ElemBuildMeshlets(vertexBuffer, indexBuffer, NULL);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_EQ_MSG(result.MeshletBounds.Length, result.Meshlets.Length, "Meshlet bounds count is not correct.");
+    ASSERT_EQ_MSG(result.MeshletCompactBounds.Length, result.Meshlets.Length, "Meshlet compact bounds count is not correct.");
+
+    for (uint32_t i = 0; i < result.Meshlets.Length; i++)
+    {
+        ElemMeshlet meshlet = result.Meshlets.Items[i];
+        ElemMeshletBounds bounds = result.MeshletBounds.Items[i];
+
+        for (uint32_t j = 0; j < meshlet.VertexIndexCount; j++)
+        {
+            auto vertexIndex = result.MeshletVertexIndexBuffer.Items[meshlet.VertexIndexOffset + j];
+            auto vertex = (TestMeshVertex*)&result.VertexBuffer.Data.Items[vertexIndex * result.VertexBuffer.VertexSize];
+
+            auto deltaX = vertex->Position.X - bounds.SphereCenter.X;
+            auto deltaY = vertex->Position.Y - bounds.SphereCenter.Y;
+            auto deltaZ = vertex->Position.Z - bounds.SphereCenter.Z;
+            auto distance = sqrtf(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+
+            ASSERT_LT_MSG(distance, bounds.SphereRadius * 1.001f + 0.001f, "Vertex is outside the bounding sphere.");
+
+            ASSERT_LE(bounds.BoundingBox.MinPoint.X, vertex->Position.X);
+            ASSERT_LE(bounds.BoundingBox.MinPoint.Y, vertex->Position.Y);
+            ASSERT_LE(bounds.BoundingBox.MinPoint.Z, vertex->Position.Z);
+            ASSERT_GE(bounds.BoundingBox.MaxPoint.X, vertex->Position.X);
+            ASSERT_GE(bounds.BoundingBox.MaxPoint.Y, vertex->Position.Y);
+            ASSERT_GE(bounds.BoundingBox.MaxPoint.Z, vertex->Position.Z);
+        }
+    }
+}
+
+struct MeshBuilder_BuildMeshletsOptions
+{
+    ElemBuildMeshletsOptions Options;
+};
+
+UTEST_F_SETUP(MeshBuilder_BuildMeshletsOptions)
+{
+}
+
+UTEST_F_TEARDOWN(MeshBuilder_BuildMeshletsOptions)
+{
+    // Arrange
+    const uint32_t vertexCount = 600;
+
+    TestMeshVertex vertexList[vertexCount];
+    uint32_t indexList[vertexCount];
+
+    auto vertexBuffer = TestBuildVertexBuffer(vertexList, vertexCount);
+    auto indexBuffer = TestBuildIndexBuffer(indexList, vertexCount);
+
+    // Act
+    auto result = ElemBuildMeshlets(vertexBuffer, indexBuffer, &utest_fixture->Options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_GT_MSG(result.Meshlets.Length, 0u, "Meshlets must be generated.");
+
+    for (uint32_t i = 0; i < result.Meshlets.Length; i++)
+    {
+        ElemMeshlet meshlet = result.Meshlets.Items[i];
+
+        ASSERT_LE(meshlet.VertexIndexCount, (uint32_t)utest_fixture->Options.MeshletMaxVertexCount);
+        ASSERT_LE(meshlet.TriangleCount, (uint32_t)utest_fixture->Options.MeshletMaxTriangleCount);
+    }
+
+    ASSERT_EQ_MSG(result.MeshletMaxVertexCount, utest_fixture->Options.MeshletMaxVertexCount, "Meshlet max vertex count is not correct.");
+    ASSERT_EQ_MSG(result.MeshletMaxTriangleCount, utest_fixture->Options.MeshletMaxTriangleCount, "Meshlet max triangle count is not correct.");
+    ASSERT_GT_MSG(result.AverageTriangleFillRatio, 0.0f, "Average triangle fill ratio is not correct.");
+    ASSERT_LE(result.AverageTriangleFillRatio, 1.0f);
+    ASSERT_LE(result.AverageVertexFillRatio, 1.0f);
+}
+
+UTEST_F(MeshBuilder_BuildMeshletsOptions, Greedy_64_124) 
+{
+    utest_fixture->Options = { .MeshletMaxVertexCount = 64, .MeshletMaxTriangleCount = 124, .BuilderMode = ElemMeshletBuilderMode_Greedy };
+}
+
+UTEST_F(MeshBuilder_BuildMeshletsOptions, Greedy_128_124) 
+{
+    utest_fixture->Options = { .MeshletMaxVertexCount = 128, .MeshletMaxTriangleCount = 124, .BuilderMode = ElemMeshletBuilderMode_Greedy, .ConeWeight = 0.25f };
+}
+
+UTEST_F(MeshBuilder_BuildMeshletsOptions, Spatial_64_84) 
+{
+    utest_fixture->Options = { .MeshletMaxVertexCount = 64, .MeshletMaxTriangleCount = 84, .BuilderMode = ElemMeshletBuilderMode_Spatial };
+}
+
+UTEST_F(MeshBuilder_BuildMeshletsOptions, Greedy_64_64_ExplicitZeroConeWeight) 
+{
+    utest_fixture->Options = { .MeshletMaxVertexCount = 64, .MeshletMaxTriangleCount = 64, .BuilderMode = ElemMeshletBuilderMode_Greedy, .UseExplicitWeights = true, .ConeWeight = 0.0f };
+}
+
+UTEST_F(MeshBuilder_BuildMeshletsOptions, Spatial_64_64_ExplicitZeroFillWeight) 
+{
+    utest_fixture->Options = { .MeshletMaxVertexCount = 64, .MeshletMaxTriangleCount = 64, .BuilderMode = ElemMeshletBuilderMode_Spatial, .UseExplicitWeights = true, .FillWeight = 0.0f };
+}
+
+UTEST(MeshBuilder, BuildMeshletLodHierarchy) 
+{
+    // Arrange
+    const uint32_t gridSize = 64;
+    const uint32_t vertexCount = (gridSize + 1) * (gridSize + 1);
+    const uint32_t indexCount = gridSize * gridSize * 6;
+
+    static TestMeshVertex vertexList[vertexCount];
+    static uint32_t indexList[indexCount];
+
+    auto vertexBuffer = TestBuildGridMesh(vertexList, indexList, gridSize);
+
+    // Act
+    auto result = ElemBuildMeshletLodHierarchy(vertexBuffer, { .Items = indexList, .Length = indexCount }, NULL);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_GT_MSG(result.LodLevelCount, 1u, "Multiple LOD levels must be generated.");
+    ASSERT_EQ_MSG(result.MeshletLods.Length, result.Meshlets.Length, "Meshlet LOD count is not correct.");
+
+    auto rootCount = 0u;
+
+    for (uint32_t i = 0; i < result.MeshletLods.Length; i++)
+    {
+        auto lodInfo = result.MeshletLods.Items[i];
+
+        ASSERT_LE(lodInfo.SelfError, lodInfo.ParentError);
+        ASSERT_LT(lodInfo.LodLevel, result.LodLevelCount);
+
+        if (lodInfo.ParentError == FLT_MAX)
+        {
+            rootCount++;
+        }
+    }
+
+    ASSERT_GT_MSG(rootCount, 0u, "The hierarchy must have root meshlets.");
+}
+
+UTEST(MeshBuilder, BuildMeshletLodHierarchy_UnreducibleGroupsKeepBordersClosed) 
+{
+    // Arrange
+    const uint32_t gridSize = 16;
+    const uint32_t vertexCount = (gridSize + 1) * (gridSize + 1);
+    const uint32_t indexCount = gridSize * gridSize * 6;
+
+    static TestMeshVertex vertexList[vertexCount];
+    static uint32_t indexList[indexCount];
+    static uint8_t edgeCounts[vertexCount * vertexCount];
+
+    auto vertexBuffer = TestBuildGridMesh(vertexList, indexList, gridSize);
+
+    // NOTE: With one meshlet per group and 4 triangles per meshlet, every vertex inside the grid is shared between groups
+    // and is locked. Only the groups on the grid borders can be reduced, the other ones must stay unsimplified.
+    ElemBuildMeshletLodHierarchyOptions options = 
+    {
+        .MeshletOptions = { .MeshletMaxVertexCount = 8, .MeshletMaxTriangleCount = 4 },
+        .GroupSize = 1
+    };
+
+    // Act
+    auto result = ElemBuildMeshletLodHierarchy(vertexBuffer, { .Items = indexList, .Length = indexCount }, &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_GT_MSG(result.LodLevelCount, 1u, "Multiple LOD levels must be generated.");
+
+    auto unreducedCount = 0u;
+
+    for (uint32_t i = 0; i < result.MeshletLods.Length; i++)
+    {
+        if (result.MeshletLods.Items[i].LodLevel == 0 && result.MeshletLods.Items[i].ParentError == FLT_MAX)
+        {
+            unreducedCount++;
+        }
+    }
+
+    ASSERT_GT_MSG(unreducedCount, 0u, "Some groups must not be reduced.");
+
+    auto resultVertexCount = result.VertexBuffer.VertexCount;
+    ASSERT_LE(resultVertexCount, vertexCount);
+
+    for (uint32_t i = 0; i < result.MeshletLods.Length; i++)
+    {
+        auto threshold = result.MeshletLods.Items[i].SelfError;
+        memset(edgeCounts, 0, sizeof(edgeCounts));
+
+        for (uint32_t j = 0; j < result.Meshlets.Length; j++)
+        {
+            auto lodInfo = result.MeshletLods.Items[j];
+
+            if (lodInfo.SelfError > threshold || lodInfo.ParentError <= threshold)
+            {
+                continue;
+            }
+
+            auto meshlet = result.Meshlets.Items[j];
+
+            for (uint32_t k = 0; k < meshlet.TriangleCount; k++)
+            {
+                auto triangle = result.MeshletTriangleIndexBuffer.Items[meshlet.TriangleOffset + k];
+                uint32_t triangleVertices[3];
+
+                for (uint32_t l = 0; l < 3; l++)
+                {
+                    triangleVertices[l] = result.MeshletVertexIndexBuffer.Items[meshlet.VertexIndexOffset + ((triangle >> (l * 8)) & 0xFF)];
+                }
+
+                for (uint32_t l = 0; l < 3; l++)
+                {
+                    auto vertex0 = triangleVertices[l];
+                    auto vertex1 = triangleVertices[(l + 1) % 3];
+
+                    edgeCounts[vertex0 < vertex1 ? vertex0 * vertexCount + vertex1 : vertex1 * vertexCount + vertex0]++;
+                }
+            }
+        }
+
+        for (uint32_t j = 0; j < resultVertexCount; j++)
+        {
+            for (uint32_t k = j + 1; k < resultVertexCount; k++)
+            {
+                auto edgeCount = edgeCounts[j * vertexCount + k];
+
+                if (edgeCount == 0)
+                {
+                    continue;
+                }
+
+                ASSERT_LE_MSG(edgeCount, 2u, "An edge is shared by more than 2 triangles.");
+
+                if (edgeCount == 1)
+                {
+                    auto position0 = ((TestMeshVertex*)result.VertexBuffer.Data.Items)[j].Position;
+                    auto position1 = ((TestMeshVertex*)result.VertexBuffer.Data.Items)[k].Position;
+
+                    auto isGridBorder0 = position0.X == 0.0f || position0.X == gridSize || position0.Y == 0.0f || position0.Y == gridSize;
+                    auto isGridBorder1 = position1.X == 0.0f || position1.X == gridSize || position1.Y == 0.0f || position1.Y == gridSize;
+
+                    // NOTE: The grid borders can be simplified, so an open edge is only a crack when it touches an inner vertex.
+                    ASSERT_TRUE_MSG(isGridBorder0 && isGridBorder1, "The LOD cut has a crack inside the mesh.");
+                }
+            }
+        }
+    }
+}
+
+UTEST(MeshBuilder, EncodeMeshlets_RoundTrip) 
+{
+    // Arrange
+    const uint32_t vertexCount = 300;
+
+    TestMeshVertex vertexList[vertexCount];
+    uint32_t indexList[vertexCount];
+
+    auto vertexBuffer = TestBuildVertexBuffer(vertexList, vertexCount);
+    auto indexBuffer = TestBuildIndexBuffer(indexList, vertexCount);
+    auto meshletResult = ElemBuildMeshlets(vertexBuffer, indexBuffer, NULL);
+
+    ElemEncodeMeshletsOptions options = { .CompressStreams = true };
+
+    // Act
+    auto encodedResult = ElemEncodeMeshlets(&meshletResult, &options);
+    auto decodedResult = ElemDecodeMeshlets(&encodedResult);
+
+    // Assert
+    ASSERT_FALSE(meshletResult.HasErrors);
+    ASSERT_FALSE(encodedResult.HasErrors);
+    ASSERT_FALSE(decodedResult.HasErrors);
+    ASSERT_TRUE(encodedResult.IsCompressed);
+    ASSERT_FALSE(decodedResult.IsCompressed);
+    ASSERT_EQ_MSG(decodedResult.Meshlets.Length, meshletResult.Meshlets.Length, "Meshlet count is not correct.");
+    ASSERT_EQ_MSG(decodedResult.VertexBuffer.Length, meshletResult.VertexBuffer.Data.Length, "Vertex buffer size is not correct.");
+    ASSERT_EQ_MSG(memcmp(decodedResult.VertexBuffer.Items, meshletResult.VertexBuffer.Data.Items, decodedResult.VertexBuffer.Length), 0, "Vertex buffer data is not correct.");
+
+    for (uint32_t i = 0; i < meshletResult.Meshlets.Length; i++)
+    {
+        auto meshlet = meshletResult.Meshlets.Items[i];
+        auto encodedMeshlet = decodedResult.Meshlets.Items[i];
+
+        ASSERT_EQ(encodedMeshlet.VertexIndexCount, meshlet.VertexIndexCount);
+        ASSERT_EQ(encodedMeshlet.TriangleCount, meshlet.TriangleCount);
+        ASSERT_EQ(encodedMeshlet.VertexIndexOffset % 4, 0u);
+        ASSERT_EQ(encodedMeshlet.TriangleOffset % 4, 0u);
+
+        if (meshlet.TriangleCount > 0)
+        {
+            auto lastTriangleLoadOffset = (encodedMeshlet.TriangleOffset + (meshlet.TriangleCount - 1) * 3) & ~3u;
+            ASSERT_LE_MSG(lastTriangleLoadOffset + 8, decodedResult.MeshletTriangleIndexBuffer.Length, "Triangle stream is not padded for the 8 bytes loads.");
+        }
+
+        for (uint32_t j = 0; j < meshlet.VertexIndexCount; j++)
+        {
+            auto source = &decodedResult.MeshletVertexIndexBuffer.Items[encodedMeshlet.VertexIndexOffset + j * encodedMeshlet.VertexIndexSize];
+            auto localVertexIndex = 0u;
+
+            memcpy(&localVertexIndex, source, encodedMeshlet.VertexIndexSize);
+            ASSERT_EQ_MSG(encodedMeshlet.BaseVertex + localVertexIndex, meshletResult.MeshletVertexIndexBuffer.Items[meshlet.VertexIndexOffset + j], "Vertex index is not correct.");
+        }
+
+        for (uint32_t j = 0; j < meshlet.TriangleCount; j++)
+        {
+            auto source = &decodedResult.MeshletTriangleIndexBuffer.Items[encodedMeshlet.TriangleOffset + j * 3];
+            auto packedTriangle = (uint32_t)source[0] | ((uint32_t)source[1] << 8) | ((uint32_t)source[2] << 16);
+
+            ASSERT_EQ_MSG(packedTriangle, meshletResult.MeshletTriangleIndexBuffer.Items[meshlet.TriangleOffset + j], "Triangle is not correct.");
+        }
+    }
+}
+
+UTEST(MeshBuilder, DecodeMeshlets_InvalidTriangleCount) 
+{
+    // Arrange
+    const uint32_t vertexCount = 300;
+
+    TestMeshVertex vertexList[vertexCount];
+    uint32_t indexList[vertexCount];
+
+    auto vertexBuffer = TestBuildVertexBuffer(vertexList, vertexCount);
+    auto indexBuffer = TestBuildIndexBuffer(indexList, vertexCount);
+    auto meshletResult = ElemBuildMeshlets(vertexBuffer, indexBuffer, NULL);
+    auto encodedResult = ElemEncodeMeshlets(&meshletResult, NULL);
+
+    ASSERT_FALSE(encodedResult.HasErrors);
+    ASSERT_GT(encodedResult.Meshlets.Length, 0u);
+
+    ElemEncodedMeshlet meshlets[256];
+    ASSERT_LE(encodedResult.Meshlets.Length, 256u);
+    memcpy(meshlets, encodedResult.Meshlets.Items, encodedResult.Meshlets.Length * sizeof(ElemEncodedMeshlet));
+
+    meshlets[0].TriangleCount = (uint8_t)(encodedResult.MeshletMaxTriangleCount + 1);
+    encodedResult.Meshlets.Items = meshlets;
+
+    // Act
+    auto decodedResult = ElemDecodeMeshlets(&encodedResult);
+
+    // Assert
+    ASSERT_TRUE_MSG(decodedResult.HasErrors, "Decoding should fail when a triangle count exceeds the meshlet limit.");
+}
+
+UTEST(MeshBuilder, OptimizeMesh) 
+{
+    // Arrange
+    const uint32_t gridSize = 16;
+    const uint32_t vertexCount = (gridSize + 1) * (gridSize + 1);
+    const uint32_t indexCount = gridSize * gridSize * 6;
+
+    TestMeshVertex vertexList[vertexCount];
+    uint32_t indexList[indexCount];
+
+    auto vertexBuffer = TestBuildGridMesh(vertexList, indexList, gridSize);
+
+    // Act
+    auto result = ElemOptimizeMesh(vertexBuffer, { .Items = indexList, .Length = indexCount }, NULL);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_EQ_MSG(result.VertexBuffer.VertexCount, vertexCount, "Vertex count is not correct.");
+    ASSERT_EQ_MSG(result.IndexBuffer.Length, indexCount, "Index count is not correct.");
+
+    // NOTE: The first triangles are always fetched in order after the vertex fetch optimization.
+    ASSERT_EQ(result.IndexBuffer.Items[0], 0u);
+    ASSERT_EQ(result.IndexBuffer.Items[1], 1u);
+    ASSERT_EQ(result.IndexBuffer.Items[2], 2u);
+}
+
+UTEST(MeshBuilder, SimplifyMesh_TargetIndexCount) 
+{
+    // Arrange
+    const uint32_t gridSize = 32;
+    const uint32_t vertexCount = (gridSize + 1) * (gridSize + 1);
+    const uint32_t indexCount = gridSize * gridSize * 6;
+
+    static TestMeshVertex vertexList[vertexCount];
+    static uint32_t indexList[indexCount];
+
+    auto vertexBuffer = TestBuildGridMesh(vertexList, indexList, gridSize);
+    ElemSimplifyMeshOptions options = { .TargetIndexCount = indexCount / 4, .TargetError = 1.0f };
+
+    // Act
+    auto result = ElemSimplifyMesh(vertexBuffer, { .Items = indexList, .Length = indexCount }, &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_GT_MSG(result.IndexBuffer.Length, 0u, "Simplified mesh must not be empty.");
+    ASSERT_LE(result.IndexBuffer.Length, options.TargetIndexCount);
+    ASSERT_LT_MSG(result.VertexBuffer.VertexCount, vertexCount, "Unused vertices must be removed.");
+    ASSERT_LE(result.SimplifyError, options.TargetError);
+}
+
+UTEST(MeshBuilder, SimplifyMesh_KeepVertexBuffer) 
+{
+    // Arrange
+    const uint32_t gridSize = 32;
+    const uint32_t vertexCount = (gridSize + 1) * (gridSize + 1);
+    const uint32_t indexCount = gridSize * gridSize * 6;
+
+    static TestMeshVertex vertexList[vertexCount];
+    static uint32_t indexList[indexCount];
+    static uint32_t lod1IndexList[indexCount];
+
+    auto vertexBuffer = TestBuildGridMesh(vertexList, indexList, gridSize);
+    ElemSimplifyMeshOptions lod1Options = { .TargetIndexRatio = 0.5f, .TargetError = 1.0f, .KeepVertexBuffer = true };
+    ElemSimplifyMeshOptions lod2Options = { .TargetIndexRatio = 0.1f, .TargetError = 1.0f, .KeepVertexBuffer = true };
+
+    // Act
+    auto lod1Result = ElemSimplifyMesh(vertexBuffer, { .Items = indexList, .Length = indexCount }, &lod1Options);
+    ASSERT_FALSE(lod1Result.HasErrors);
+
+    auto lod1IndexCount = lod1Result.IndexBuffer.Length;
+    memcpy(lod1IndexList, lod1Result.IndexBuffer.Items, lod1IndexCount * sizeof(uint32_t));
+
+    auto lod2Result = ElemSimplifyMesh(vertexBuffer, { .Items = indexList, .Length = indexCount }, &lod2Options);
+
+    // Assert
+    ASSERT_FALSE(lod2Result.HasErrors);
+    ASSERT_TRUE_MSG(lod1Result.VertexBuffer.Data.Items == vertexBuffer.Data.Items, "The source vertex buffer must be returned.");
+    ASSERT_TRUE_MSG(lod2Result.VertexBuffer.Data.Items == vertexBuffer.Data.Items, "The source vertex buffer must be returned.");
+    ASSERT_EQ(lod2Result.VertexBuffer.VertexCount, vertexCount);
+    ASSERT_GT_MSG(lod2Result.IndexBuffer.Length, 0u, "Simplified mesh must not be empty.");
+    ASSERT_LT_MSG(lod2Result.IndexBuffer.Length, lod1IndexCount, "Each LOD must have less indices than the previous one.");
+    ASSERT_LT(lod1IndexCount, indexCount);
+
+    for (uint32_t i = 0; i < lod1IndexCount; i++)
+    {
+        ASSERT_LT_MSG(lod1IndexList[i], vertexCount, "Indices must reference the source vertex buffer.");
+    }
+
+    for (uint32_t i = 0; i < lod2Result.IndexBuffer.Length; i++)
+    {
+        ASSERT_LT_MSG(lod2Result.IndexBuffer.Items[i], vertexCount, "Indices must reference the source vertex buffer.");
+    }
+}
+
+UTEST(MeshBuilder, SimplifyMesh_LockBorders) 
+{
+    // Arrange
+    const uint32_t gridSize = 32;
+    const uint32_t vertexCount = (gridSize + 1) * (gridSize + 1);
+    const uint32_t indexCount = gridSize * gridSize * 6;
+
+    static TestMeshVertex vertexList[vertexCount];
+    static uint32_t indexList[indexCount];
+
+    auto vertexBuffer = TestBuildGridMesh(vertexList, indexList, gridSize);
+    ElemSimplifyMeshOptions options = { .TargetIndexRatio = 0.1f, .TargetError = 1.0f, .LockBorders = true };
+
+    // Act
+    auto result = ElemSimplifyMesh(vertexBuffer, { .Items = indexList, .Length = indexCount }, &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+
+    auto resultVertexList = (TestMeshVertex*)result.VertexBuffer.Data.Items;
+    auto borderVertexCount = 0u;
+
+    for (uint32_t i = 0; i < result.VertexBuffer.VertexCount; i++)
+    {
+        auto position = resultVertexList[i].Position;
+
+        if (position.X == 0.0f || position.Y == 0.0f || position.X == (float)gridSize || position.Y == (float)gridSize)
+        {
+            borderVertexCount++;
+        }
+    }
+
+    ASSERT_EQ_MSG(borderVertexCount, gridSize * 4, "Border vertices must be kept.");
+}
@@ -1,5 +1,6 @@
 #include "ToolsTests.h"
 #include "utest.h"
+#include <math.h>
 
 // TODO: Add real test files on disk?
 
@@ -46,6 +47,160 @@ auto cubeObjSceneSource = R"(o Cube
     f 4/13/5 3/9/5 8/11/5
     f 5/6/6 1/12/6 8/11/6)";
 
+auto offCenterCubeObjSceneSource = R"(o OffCenterCube
+    v 11.000000 4.000000 2.000000
+    v 11.000000 4.000000 4.000000
+    v 9.000000 4.000000 4.000000
+    v 9.000000 4.000000 2.000000
+    v 11.000000 6.000000 2.000001
+    v 10.999999 6.000000 4.000001
+    v 9.000000 6.000000 4.000000
+    v 9.000000 6.000000 2.000000
+    vt 1.000000 0.333333
+    vt 1.000000 0.666667
+    vt 0.666667 0.666667
+    vt 0.666667 0.333333
+    vt 0.666667 0.000000
+    vt 0.000000 0.333333
+    vt 0.000000 0.000000
+    vt 0.333333 0.000000
+    vt 0.333333 1.000000
+    vt 0.000000 1.000000
+    vt 0.000000 0.666667
+    vt 0.333333 0.333333
+    vt 0.333333 0.666667
+    vt 1.000000 0.000000
+    vn 0.000000 -1.000000 0.000000
+    vn 0.000000 1.000000 0.000000
+    vn 1.000000 0.000000 0.000000
+    vn -0.000000 0.000000 1.000000
+    vn -1.000000 -0.000000 -0.000000
+    vn 0.000000 0.000000 -1.000000
+    s off
+    f 2/1/1 3/2/1 4/3/1
+    f 8/1/2 7/4/2 6/5/2
+    f 5/6/3 6/7/3 2/8/3
+    f 6/8/4 7/5/4 3/4/4
+    f 3/9/5 7/10/5 8/11/5
+    f 1/12/6 4/13/6 8/11/6
+    f 1/4/1 2/1/1 4/3/1
+    f 5/14/2 8/1/2 6/5/2
+    f 1/12/3 5/6/3 2/8/3
+    f 2/12/4 6/8/4 3/4/4
+    f 4/13/5 3/9/5 8/11/5
+    f 5/6/6 1/12/6 8/11/6)";
+
+// NOTE: Smooth curved patch with one normal per position. The OBJ loader outputs one vertex per face corner.
+auto curvedPatchObjSceneSource = R"(o CurvedPatch
+    v 0.000000 0.000000 2.600000
+    v 1.000000 0.000000 1.400000
+    v 2.000000 0.000000 1.000000
+    v 3.000000 0.000000 1.400000
+    v 4.000000 0.000000 2.600000
+    v 0.000000 1.000000 1.850000
+    v 1.000000 1.000000 0.650000
+    v 2.000000 1.000000 0.250000
+    v 3.000000 1.000000 0.650000
+    v 4.000000 1.000000 1.850000
+    v 0.000000 2.000000 1.600000
+    v 1.000000 2.000000 0.400000
+    v 2.000000 2.000000 0.000000
+    v 3.000000 2.000000 0.400000
+    v 4.000000 2.000000 1.600000
+    v 0.000000 3.000000 1.850000
+    v 1.000000 3.000000 0.650000
+    v 2.000000 3.000000 0.250000
+    v 3.000000 3.000000 0.650000
+    v 4.000000 3.000000 1.850000
+    v 0.000000 4.000000 2.600000
+    v 1.000000 4.000000 1.400000
+    v 2.000000 4.000000 1.000000
+    v 3.000000 4.000000 1.400000
+    v 4.000000 4.000000 2.600000
+    vt 0.000000 0.000000
+    vt 0.250000 0.000000
+    vt 0.500000 0.000000
+    vt 0.750000 0.000000
+    vt 1.000000 0.000000
+    vt 0.000000 0.250000
+    vt 0.250000 0.250000
+    vt 0.500000 0.250000
+    vt 0.750000 0.250000
+    vt 1.000000 0.250000
+    vt 0.000000 0.500000
+    vt 0.250000 0.500000
+    vt 0.500000 0.500000
+    vt 0.750000 0.500000
+    vt 1.000000 0.500000
+    vt 0.000000 0.750000
+    vt 0.250000 0.750000
+    vt 0.500000 0.750000
+    vt 0.750000 0.750000
+    vt 1.000000 0.750000
+    vt 0.000000 1.000000
+    vt 0.250000 1.000000
+    vt 0.500000 1.000000
+    vt 0.750000 1.000000
+    vt 1.000000 1.000000
+    vn 0.749269 0.468293 0.468293
+    vn 0.492366 0.615457 0.615457
+    vn -0.000000 0.707107 0.707107
+    vn -0.492366 0.615457 0.615457
+    vn -0.749269 0.468293 0.468293
+    vn 0.819705 0.256158 0.512316
+    vn 0.581914 0.363696 0.727393
+    vn -0.000000 0.447214 0.894427
+    vn -0.581914 0.363696 0.727393
+    vn -0.819705 0.256158 0.512316
+    vn 0.847998 -0.000000 0.529999
+    vn 0.624695 -0.000000 0.780869
+    vn -0.000000 -0.000000 1.000000
+    vn -0.624695 -0.000000 0.780869
+    vn -0.847998 -0.000000 0.529999
+    vn 0.819705 -0.256158 0.512316
+    vn 0.581914 -0.363696 0.727393
+    vn -0.000000 -0.447214 0.894427
+    vn -0.581914 -0.363696 0.727393
+    vn -0.819705 -0.256158 0.512316
+    vn 0.749269 -0.468293 0.468293
+    vn 0.492366 -0.615457 0.615457
+    vn -0.000000 -0.707107 0.707107
+    vn -0.492366 -0.615457 0.615457
+    vn -0.749269 -0.468293 0.468293
+    s 1
+    f 1/1/1 2/2/2 7/7/7
+    f 1/1/1 7/7/7 6/6/6
+    f 2/2/2 3/3/3 8/8/8
+    f 2/2/2 8/8/8 7/7/7
+    f 3/3/3 4/4/4 9/9/9
+    f 3/3/3 9/9/9 8/8/8
+    f 4/4/4 5/5/5 10/10/10
+    f 4/4/4 10/10/10 9/9/9
+    f 6/6/6 7/7/7 12/12/12
+    f 6/6/6 12/12/12 11/11/11
+    f 7/7/7 8/8/8 13/13/13
+    f 7/7/7 13/13/13 12/12/12
+    f 8/8/8 9/9/9 14/14/14
+    f 8/8/8 14/14/14 13/13/13
+    f 9/9/9 10/10/10 15/15/15
+    f 9/9/9 15/15/15 14/14/14
+    f 11/11/11 12/12/12 17/17/17
+    f 11/11/11 17/17/17 16/16/16
+    f 12/12/12 13/13/13 18/18/18
+    f 12/12/12 18/18/18 17/17/17
+    f 13/13/13 14/14/14 19/19/19
+    f 13/13/13 19/19/19 18/18/18
+    f 14/14/14 15/15/15 20/20/20
+    f 14/14/14 20/20/20 19/19/19
+    f 16/16/16 17/17/17 22/22/22
+    f 16/16/16 22/22/22 21/21/21
+    f 17/17/17 18/18/18 23/23/23
+    f 17/17/17 23/23/23 22/22/22
+    f 18/18/18 19/19/19 24/24/24
+    f 18/18/18 24/24/24 23/23/23
+    f 19/19/19 20/20/20 25/25/25
+    f 19/19/19 25/25/25 24/24/24)";
+
 struct SceneLoader_LoadScene
 {
     const char* Path;
@@ -107,3 +262,325 @@ UTEST_F(SceneLoader_LoadScene, Obj)
     // TODO: To change
     utest_fixture->ExpectedVertexCount = 36;
 }
+
+UTEST(SceneLoader, LoadScene_ReportsLoadTimings) 
+{
+    // Arrange
+    AddTestFile("Cube.obj", { .Items = (uint8_t*)cubeObjSceneSource, .Length = (uint32_t)strlen(cubeObjSceneSource) });
+
+    // Act
+    auto result = ElemLoadScene("Cube.obj", NULL);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+
+    auto informationMessageCount = 0u;
+
+    for (uint32_t i = 0; i < result.Messages.Length; i++)
+    {
+        if (result.Messages.Items[i].Type == ElemToolsMessageType_Information)
+        {
+            informationMessageCount++;
+        }
+    }
+
+    ASSERT_GT_MSG(informationMessageCount, 2u, "Parse, vertex build and tangents timings must be reported.");
+}
+
+UTEST(SceneLoader, LoadScene_CompactVertexFormat) 
+{
+    // Arrange
+    AddTestFile("OffCenterCube.obj", { .Items = (uint8_t*)offCenterCubeObjSceneSource, .Length = (uint32_t)strlen(offCenterCubeObjSceneSource) });
+
+    ElemLoadSceneOptions options = { .VertexFormat = ElemVertexFormat_CompactUnorm16 };
+
+    // Act
+    auto result = ElemLoadScene("OffCenterCube.obj", &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+
+    auto vertexBuffer = result.Meshes.Items[0].MeshPrimitives.Items[0].VertexBuffer;
+    auto positionBounds = vertexBuffer.PositionBounds;
+
+    ASSERT_EQ_MSG(vertexBuffer.Format, ElemVertexFormat_CompactUnorm16, "Vertex format is not correct.");
+    ASSERT_EQ_MSG(vertexBuffer.VertexSize, 20u, "Vertex size is not correct.");
+    ASSERT_EQ_MSG(vertexBuffer.Data.Length, vertexBuffer.VertexCount * 20u, "Vertex buffer length is not correct.");
+
+    ASSERT_LT_MSG(fabsf(positionBounds.MinPoint.X - (-1.0f)), 0.001f, "Position bounds are not correct.");
+    ASSERT_LT_MSG(fabsf(positionBounds.MaxPoint.X - 1.0f), 0.001f, "Position bounds are not correct.");
+    ASSERT_LT_MSG(fabsf(positionBounds.MinPoint.Y - (-1.0f)), 0.001f, "Position bounds are not correct.");
+    ASSERT_LT_MSG(fabsf(positionBounds.MaxPoint.Y - 1.0f), 0.001f, "Position bounds are not correct.");
+    ASSERT_LT_MSG(fabsf(positionBounds.MinPoint.Z - (-1.0f)), 0.001f, "Position bounds are not correct.");
+    ASSERT_LT_MSG(fabsf(positionBounds.MaxPoint.Z - 1.0f), 0.001f, "Position bounds are not correct.");
+
+    for (uint32_t i = 0; i < vertexBuffer.VertexCount; i++)
+    {
+        uint16_t position[3];
+        memcpy(position, vertexBuffer.Data.Items + i * vertexBuffer.VertexSize, sizeof(uint16_t) * 3);
+
+        float decodedPosition[3] =
+        {
+            positionBounds.MinPoint.X + ((float)position[0] / 65535.0f) * (positionBounds.MaxPoint.X - positionBounds.MinPoint.X),
+            positionBounds.MinPoint.Y + ((float)position[1] / 65535.0f) * (positionBounds.MaxPoint.Y - positionBounds.MinPoint.Y),
+            positionBounds.MinPoint.Z + ((float)position[2] / 65535.0f) * (positionBounds.MaxPoint.Z - positionBounds.MinPoint.Z)
+        };
+
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            ASSERT_LT_MSG(fabsf(fabsf(decodedPosition[j]) - 1.0f), 0.001f, "Decoded position is not correct.");
+        }
+    }
+}
+
+void TestDecodeOctahedral(const int16_t* encoded, float* destination)
+{
+    auto x = (float)encoded[0] / 32767.0f;
+    auto y = (float)encoded[1] / 32767.0f;
+    auto z = 1.0f - fabsf(x) - fabsf(y);
+
+    if (z < 0.0f)
+    {
+        auto previousX = x;
+
+        x = (1.0f - fabsf(y)) * (previousX >= 0.0f ? 1.0f : -1.0f);
+        y = (1.0f - fabsf(previousX)) * (y >= 0.0f ? 1.0f : -1.0f);
+    }
+
+    auto length = sqrtf(x * x + y * y + z * z);
+
+    destination[0] = x / length;
+    destination[1] = y / length;
+    destination[2] = z / length;
+}
+
+struct SceneLoader_CompactVertexFormatRoundTrip
+{
+    ElemVertexFormat VertexFormat;
+    float PositionTolerance;
+};
+
+UTEST_F_SETUP(SceneLoader_CompactVertexFormatRoundTrip)
+{
+    AddTestFile("CurvedPatch.obj", { .Items = (uint8_t*)curvedPatchObjSceneSource, .Length = (uint32_t)strlen(curvedPatchObjSceneSource) });
+}
+
+UTEST_F_TEARDOWN(SceneLoader_CompactVertexFormatRoundTrip)
+{
+    // Arrange
+    const uint32_t compactVertexSize = 20;
+
+    auto referenceResult = ElemLoadScene("CurvedPatch.obj", NULL);
+    ASSERT_FALSE(referenceResult.HasErrors);
+
+    auto referenceVertexBuffer = referenceResult.Meshes.Items[0].MeshPrimitives.Items[0].VertexBuffer;
+    ElemLoadSceneOptions options = { .VertexFormat = utest_fixture->VertexFormat };
+
+    // Act
+    auto result = ElemLoadScene("CurvedPatch.obj", &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+
+    auto vertexBuffer = result.Meshes.Items[0].MeshPrimitives.Items[0].VertexBuffer;
+    auto positionBounds = vertexBuffer.PositionBounds;
+
+    ASSERT_EQ_MSG(vertexBuffer.Format, utest_fixture->VertexFormat, "Vertex format is not correct.");
+    ASSERT_EQ_MSG(vertexBuffer.VertexSize, compactVertexSize, "Vertex size is not correct.");
+    ASSERT_EQ_MSG(vertexBuffer.VertexCount, referenceVertexBuffer.VertexCount, "Vertex count is not correct.");
+
+    for (uint32_t i = 0; i < vertexBuffer.VertexCount; i++)
+    {
+        // NOTE: Float32 layout is position (3), normal (3), tangent (4) and texture coordinates (2).
+        float reference[12];
+        memcpy(reference, referenceVertexBuffer.Data.Items + i * referenceVertexBuffer.VertexSize, sizeof(reference));
+
+        uint16_t position[4];
+        int16_t normal[2];
+        int16_t tangent[2];
+        uint16_t textureCoordinates[2];
+
+        auto vertexData = vertexBuffer.Data.Items + i * vertexBuffer.VertexSize;
+        memcpy(position, vertexData, sizeof(position));
+        memcpy(normal, vertexData + 8, sizeof(normal));
+        memcpy(tangent, vertexData + 12, sizeof(tangent));
+        memcpy(textureCoordinates, vertexData + 16, sizeof(textureCoordinates));
+
+        float decodedPosition[3];
+        float decodedHandedness;
+
+        if (utest_fixture->VertexFormat == ElemVertexFormat_CompactUnorm16)
+        {
+            decodedPosition[0] = positionBounds.MinPoint.X + ((float)position[0] / 65535.0f) * (positionBounds.MaxPoint.X - positionBounds.MinPoint.X);
+            decodedPosition[1] = positionBounds.MinPoint.Y + ((float)position[1] / 65535.0f) * (positionBounds.MaxPoint.Y - positionBounds.MinPoint.Y);
+            decodedPosition[2] = positionBounds.MinPoint.Z + ((float)position[2] / 65535.0f) * (positionBounds.MaxPoint.Z - positionBounds.MinPoint.Z);
+            decodedHandedness = position[3] == 0 ? -1.0f : 1.0f;
+        }
+        else
+        {
+            decodedPosition[0] = TestDecodeHalf(position[0]);
+            decodedPosition[1] = TestDecodeHalf(position[1]);
+            decodedPosition[2] = TestDecodeHalf(position[2]);
+            decodedHandedness = TestDecodeHalf(position[3]);
+        }
+
+        float decodedNormal[3];
+        float decodedTangent[3];
+        TestDecodeOctahedral(normal, decodedNormal);
+        TestDecodeOctahedral(tangent, decodedTangent);
+
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            ASSERT_LT_MSG(fabsf(decodedPosition[j] - reference[j]), utest_fixture->PositionTolerance, "Decoded position is not correct.");
+            ASSERT_LT_MSG(fabsf(decodedNormal[j] - reference[3 + j]), 0.001f, "Decoded normal is not correct.");
+            ASSERT_LT_MSG(fabsf(decodedTangent[j] - reference[6 + j]), 0.001f, "Decoded tangent is not correct.");
+        }
+
+        ASSERT_EQ_MSG(decodedHandedness, reference[9] < 0.0f ? -1.0f : 1.0f, "Decoded tangent handedness is not correct.");
+        ASSERT_LT_MSG(fabsf(TestDecodeHalf(textureCoordinates[0]) - reference[10]), 0.001f, "Decoded texture coordinates are not correct.");
+        ASSERT_LT_MSG(fabsf(TestDecodeHalf(textureCoordinates[1]) - reference[11]), 0.001f, "Decoded texture coordinates are not correct.");
+    }
+}
+
+UTEST_F(SceneLoader_CompactVertexFormatRoundTrip, CompactUnorm16) 
+{
+    utest_fixture->VertexFormat = ElemVertexFormat_CompactUnorm16;
+    utest_fixture->PositionTolerance = 0.001f;
+}
+
+UTEST_F(SceneLoader_CompactVertexFormatRoundTrip, CompactHalf) 
+{
+    // NOTE: Half floats have 11 bits of precision so the error is up to 2^-10 for positions between 2 and 4.
+    utest_fixture->VertexFormat = ElemVertexFormat_CompactHalf;
+    utest_fixture->PositionTolerance = 0.002f;
+}
+
+struct SceneLoader_FastTangentsMatchMikkTSpace
+{
+    const char* Path;
+    const char* Source;
+};
+
+UTEST_F_SETUP(SceneLoader_FastTangentsMatchMikkTSpace)
+{
+}
+
+UTEST_F_TEARDOWN(SceneLoader_FastTangentsMatchMikkTSpace)
+{
+    // Arrange
+    AddTestFile(utest_fixture->Path, { .Items = (uint8_t*)utest_fixture->Source, .Length = (uint32_t)strlen(utest_fixture->Source) });
+
+    const uint32_t maxVertexCount = 128;
+    const uint32_t tangentOffset = sizeof(float) * 6;
+    float referenceTangents[maxVertexCount * 4];
+
+    auto referenceResult = ElemLoadScene(utest_fixture->Path, NULL);
+    ASSERT_FALSE(referenceResult.HasErrors);
+
+    auto referenceVertexBuffer = referenceResult.Meshes.Items[0].MeshPrimitives.Items[0].VertexBuffer;
+    auto vertexCount = referenceVertexBuffer.VertexCount;
+    ASSERT_LE(vertexCount, maxVertexCount);
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        memcpy(&referenceTangents[i * 4], referenceVertexBuffer.Data.Items + i * referenceVertexBuffer.VertexSize + tangentOffset, sizeof(float) * 4);
+    }
+
+    ElemLoadSceneOptions options = { .TangentMode = ElemSceneTangentMode_Fast };
+
+    // Act
+    auto result = ElemLoadScene(utest_fixture->Path, &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+
+    auto vertexBuffer = result.Meshes.Items[0].MeshPrimitives.Items[0].VertexBuffer;
+    ASSERT_EQ_MSG(vertexBuffer.VertexCount, vertexCount, "Vertex count is not correct.");
+
+    auto maxAngleError = 0.0f;
+
+    for (uint32_t i = 0; i < vertexCount; i++)
+    {
+        auto tangent = (float*)(vertexBuffer.Data.Items + i * vertexBuffer.VertexSize + tangentOffset);
+        auto referenceTangent = &referenceTangents[i * 4];
+
+        auto cosAngle = tangent[0] * referenceTangent[0] + tangent[1] * referenceTangent[1] + tangent[2] * referenceTangent[2];
+        auto angleError = acosf(fminf(1.0f, fmaxf(-1.0f, cosAngle))) * 180.0f / 3.14159265f;
+
+        maxAngleError = fmaxf(maxAngleError, angleError);
+        ASSERT_EQ_MSG(tangent[3], referenceTangent[3], "Tangent handedness is not correct.");
+    }
+
+    ASSERT_LT_MSG(maxAngleError, 1.0f, "Tangent angle error must be lower than 1 degree.");
+}
+
+UTEST_F(SceneLoader_FastTangentsMatchMikkTSpace, Cube) 
+{
+    utest_fixture->Path = "Cube.obj";
+    utest_fixture->Source = cubeObjSceneSource;
+}
+
+UTEST_F(SceneLoader_FastTangentsMatchMikkTSpace, CurvedMesh) 
+{
+    // NOTE: Without the welding of the face corners, the error on this mesh is around 15 degrees.
+    utest_fixture->Path = "CurvedPatch.obj";
+    utest_fixture->Source = curvedPatchObjSceneSource;
+}
+
+UTEST(SceneLoader, BuildSceneContainer) 
+{
+    // Arrange
+    uint32_t elementData[] = { 1, 2, 3 };
+    uint8_t rawData[] = { 4, 5, 6, 7, 8 };
+
+    ElemSceneContainerSectionData sections[] =
+    {
+        { .Id = 1, .ElementSize = sizeof(uint32_t), .Data = { .Items = (uint8_t*)elementData, .Length = sizeof(elementData) } },
+        { .Id = 2, .Data = { .Items = rawData, .Length = sizeof(rawData) } }
+    };
+
+    ElemBuildSceneContainerOptions options = { .SectionAlignment = 256 };
+
+    // Act
+    auto result = ElemBuildSceneContainer({ .Items = sections, .Length = 2 }, &options);
+
+    // Assert
+    ASSERT_FALSE(result.HasErrors);
+    ASSERT_EQ_MSG(strncmp((const char*)result.Data.Items, "ELEMSCNE", 8), 0, "Container signature is not correct.");
+
+    auto sectionCount = *(uint32_t*)(result.Data.Items + 12);
+    ASSERT_EQ_MSG(sectionCount, 2u, "Section count is not correct.");
+
+    // NOTE: Table of contents entries are 32 bytes and start after the 32 bytes header.
+    for (uint32_t i = 0; i < sectionCount; i++)
+    {
+        auto tableEntry = result.Data.Items + 32 + i * 32;
+        auto offset = *(uint64_t*)(tableEntry + 16);
+        auto sizeInBytes = *(uint64_t*)(tableEntry + 24);
+
+        ASSERT_EQ_MSG(*(uint32_t*)tableEntry, sections[i].Id, "Section id is not correct.");
+        ASSERT_EQ_MSG(offset % options.SectionAlignment, 0u, "Section is not aligned.");
+        ASSERT_EQ_MSG(sizeInBytes, (uint64_t)sections[i].Data.Length, "Section size is not correct.");
+        ASSERT_EQ_MSG(memcmp(result.Data.Items + offset, sections[i].Data.Items, sections[i].Data.Length), 0, "Section data is not correct.");
+    }
+
+    ASSERT_EQ_MSG(*(uint32_t*)(result.Data.Items + 32 + 8), 3u, "Element count is not correct.");
+}
+
+UTEST(SceneLoader, BuildSceneContainer_DuplicatedSectionId) 
+{
+    // Arrange
+    uint8_t data[] = { 1, 2, 3, 4 };
+
+    ElemSceneContainerSectionData sections[] =
+    {
+        { .Id = 1, .Data = { .Items = data, .Length = sizeof(data) } },
+        { .Id = 1, .Data = { .Items = data, .Length = sizeof(data) } }
+    };
+
+    // Act
+    auto result = ElemBuildSceneContainer({ .Items = sections, .Length = 2 }, NULL);
+
+    // Assert
+    ASSERT_TRUE(result.HasErrors);
+}
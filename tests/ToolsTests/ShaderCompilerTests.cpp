@@ -1,5 +1,6 @@
 #include "ToolsTests.h"
 #include "utest.h"
+#include <filesystem>
 
 enum ShaderType
 {
@@ -62,6 +63,24 @@ auto hlslTestSourceError = R"(
     }
 )";
 
+auto hlslTestSourcePermutation = R"(
+    #ifndef REQUIRED_DEFINE
+    #error REQUIRED_DEFINE is not defined
+    #endif
+
+    RWStructuredBuffer<uint> OutputBuffer: register(u0);
+
+    [shader("compute")]
+    [numthreads(16, 1, 1)]
+    void TestCompute(uint3 threadId: SV_DispatchThreadID)
+    {
+        #if USE_OFFSET
+        OutputBuffer[threadId.x] = threadId.x + 10;
+        #else
+        OutputBuffer[threadId.x] = threadId.x;
+        #endif
+    }
+)";
 
 UTEST(ShaderCompiler, CanCompileShaderTest_HlslToDirectX12) 
 {
@@ -98,6 +117,37 @@ struct ShaderMetadata
     uint32_t Value[4];
 };
 
+struct ShaderLibraryHeader
+{
+    char FileId[8];
+    uint32_t Version;
+    uint32_t DataSizeInBytes;
+    uint32_t ShaderCount;
+    uint32_t FunctionCount;
+    uint32_t FunctionHashTableSize;
+    uint32_t PermutationCount;
+    uint32_t AxisCount;
+    uint32_t AxisValueCount;
+    uint32_t ShadersOffset;
+    uint32_t FunctionsOffset;
+    uint32_t FunctionHashTableOffset;
+    uint32_t PermutationTableOffset;
+    uint32_t AxesOffset;
+    uint32_t AxisValuesOffset;
+};
+
+struct ShaderLibraryShaderEntry
+{
+    uint32_t ShaderType;
+    uint32_t NameOffset;
+    uint32_t NameLength;
+    uint32_t MetadataOffset;
+    uint32_t MetadataCount;
+    uint32_t CodeOffset;
+    uint32_t CodeSizeInBytes;
+    uint32_t Reserved;
+};
+
 struct ShaderInfo
 {
     ShaderType Type;
@@ -194,43 +244,30 @@ void AssertShaderData(int32_t* utest_result, ShaderCompiler_CompileShader* utest
         return;
     }
 
-    uint8_t* dataPointer = compilationResult->Data.Items;
-   
-    char headerSignature[9] = {};
+    auto data = compilationResult->Data.Items;
+    auto header = (const ShaderLibraryHeader*)data;
 
-    for (uint32_t i = 0; i < 8; i++)
-    {
-        headerSignature[i] = *dataPointer;
-        dataPointer++;
-    }
+    char headerSignature[9] = {};
+    memcpy(headerSignature, header->FileId, 8);
 
     ASSERT_STREQ_MSG("ELEMSLIB", headerSignature, "Shader signature is wrong.");
+    ASSERT_EQ_MSG(2u, header->Version, "Shader library version is wrong.");
+    ASSERT_EQ_MSG(compilationResult->Data.Length, header->DataSizeInBytes, "Shader library size is wrong.");
+    ASSERT_EQ_MSG(utest_fixture->ExpectedShaderCount, header->ShaderCount, "Shaders count is wrong.");
+    ASSERT_EQ_MSG(1u, header->PermutationCount, "Permutation count is wrong.");
 
-    auto shaderCount = *(uint32_t*)dataPointer;
-    dataPointer += sizeof(uint32_t);
-    ASSERT_EQ_MSG(utest_fixture->ExpectedShaderCount, shaderCount, "Shaders count is wrong.");
+    auto shaderEntries = (const ShaderLibraryShaderEntry*)(data + header->ShadersOffset);
 
-    for (uint32_t i = 0; i < shaderCount; i++)
+    for (uint32_t i = 0; i < header->ShaderCount; i++)
     {
-        auto shaderType = *(ShaderType*)dataPointer;
-        dataPointer += sizeof(shaderType);
-
-        auto nameLength = *(uint32_t*)dataPointer;
-        dataPointer += sizeof(uint32_t);
-
-        char name[255] = {};
-
-        for (uint32_t j = 0; j < nameLength; j++)
-        {
-            name[j] = *(char*)dataPointer;
-            dataPointer++;
-        }
+        auto shaderEntry = &shaderEntries[i];
+        auto name = (const char*)(data + shaderEntry->NameOffset);
 
         ShaderInfo* expectedShader = nullptr;
 
         for (uint32_t j = 0; j < utest_fixture->ExpectedShaderCount; j++)
         {
-            if (strstr(utest_fixture->ExpectedShaders[j].Name, name))
+            if (strcmp(utest_fixture->ExpectedShaders[j].Name, name) == 0)
             {
                 expectedShader = &utest_fixture->ExpectedShaders[j];
                 break;
@@ -238,36 +275,24 @@ void AssertShaderData(int32_t* utest_result, ShaderCompiler_CompileShader* utest
         }
 
         ASSERT_TRUE_MSG(expectedShader != nullptr, "Cannot find an expected shader.");
-        ASSERT_EQ_MSG(expectedShader->Type, shaderType, "Shader Type is wrong.");
+        ASSERT_EQ_MSG((uint32_t)expectedShader->Type, shaderEntry->ShaderType, "Shader Type is wrong.");
+        ASSERT_EQ_MSG(expectedShader->MetaDataCount, shaderEntry->MetadataCount, "Metadata count is wrong.");
 
-        auto shaderMetadataCount = *(uint32_t*)dataPointer;
-        dataPointer += sizeof(uint32_t);
-        ASSERT_EQ_MSG(expectedShader->MetaDataCount, shaderMetadataCount, "Metadata count is wrong.");
+        auto metadata = (const ShaderMetadata*)(data + shaderEntry->MetadataOffset);
 
-        for (uint32_t j = 0; j < shaderMetadataCount; j++)
+        for (uint32_t j = 0; j < shaderEntry->MetadataCount; j++)
         {
             auto expectedMetadata = expectedShader->Metadata[j];
-
-            auto metadataType = *(ShaderMetadataType*)dataPointer;
-            dataPointer += sizeof(ShaderMetadataType);
-
-            ASSERT_EQ_MSG(expectedMetadata.Type, metadataType, "Metadata type is wrong.");
+            ASSERT_EQ_MSG(expectedMetadata.Type, metadata[j].Type, "Metadata type is wrong.");
 
             for (uint32_t k = 0; k < 4; k++)
             {
-                auto metadataValue = *(uint32_t*)dataPointer;
-                dataPointer += sizeof(uint32_t);
-
-                ASSERT_EQ_MSG(expectedMetadata.Value[k], metadataValue, "Metadata value is wrong.");
+                ASSERT_EQ_MSG(expectedMetadata.Value[k], metadata[j].Value[k], "Metadata value is wrong.");
             }
-
-
-            auto shaderSizeInBytes = *(uint32_t*)dataPointer;
-            dataPointer += sizeof(uint32_t);
-
-            ASSERT_LT_MSG(0u, shaderSizeInBytes, "Shader size should be greater than 0.");
-            dataPointer += shaderSizeInBytes;
         }
+
+        ASSERT_LT_MSG(0u, shaderEntry->CodeSizeInBytes, "Shader size should be greater than 0.");
+        ASSERT_EQ_MSG(0u, shaderEntry->CodeOffset % 16, "Shader code should be aligned.");
     }
 }
 
@@ -362,3 +387,210 @@ UTEST_F(ShaderCompiler_CompileShader, Hlsl_Metal_iOS_Error)
     utest_fixture->WithError = true;
 }
 #endif
+
+UTEST(ShaderCompiler, CompileShaderLibrary_WithCache) 
+{
+    // Arrange
+    AddTestFile("HlslTestSource.hlsl", { .Items = (uint8_t*)hlslTestSource, .Length = (uint32_t)strlen(hlslTestSource) });
+
+    auto cacheDirectory = std::filesystem::temp_directory_path() / "ElementalToolsShaderCache";
+    std::filesystem::remove_all(cacheDirectory);
+    std::filesystem::create_directories(cacheDirectory);
+    auto cacheDirectoryPath = cacheDirectory.string();
+
+    ElemCompileShaderOptions options = { .CacheDirectory = cacheDirectoryPath.c_str() };
+    auto firstResult = ElemCompileShaderLibrary(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, "HlslTestSource.hlsl", &options);
+    auto firstResultHasErrors = firstResult.HasErrors;
+
+    // NOTE: The result memory is reused by the next call so it is copied.
+    auto firstResultLength = firstResult.Data.Length;
+    auto firstResultData = (uint8_t*)malloc(firstResultLength);
+    memcpy(firstResultData, firstResult.Data.Items, firstResultLength);
+
+    // Act
+    auto result = ElemCompileShaderLibrary(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, "HlslTestSource.hlsl", &options);
+
+    auto isCachedDataEqual = result.Data.Length == firstResultLength && memcmp(result.Data.Items, firstResultData, firstResultLength) == 0;
+    auto cacheFileCount = 0u;
+
+    for (const auto& cacheFile : std::filesystem::directory_iterator(cacheDirectory))
+    {
+        if (cacheFile.is_regular_file())
+        {
+            cacheFileCount++;
+        }
+    }
+
+    free(firstResultData);
+    std::filesystem::remove_all(cacheDirectory);
+
+    // Assert
+    ASSERT_FALSE_MSG(firstResultHasErrors, "Compilation should not have errors.");
+    ASSERT_FALSE_MSG(result.HasErrors, "Compilation should not have errors.");
+    ASSERT_EQ_MSG(cacheFileCount, 1u, "The cache should contain one entry.");
+    ASSERT_EQ_MSG(result.Messages.Length, 1u, "Cache hit should have one message.");
+    ASSERT_TRUE_MSG(strstr(result.Messages.Items[0].Message, "read from cache") != nullptr, "Second compilation should be read from the cache.");
+    ASSERT_EQ_MSG(result.Data.Length, firstResultLength, "Cached data size doesn't match.");
+    ASSERT_TRUE_MSG(isCachedDataEqual, "Cached data doesn't match.");
+}
+
+struct SpirvLibraryStatistics
+{
+    uint32_t CodeSizeInBytes;
+    uint32_t DebugInstructionCount;
+};
+
+// NOTE: Counts the OpSource (3), OpName (5) and OpLine (8) instructions of all the shaders of the library.
+SpirvLibraryStatistics GetSpirvLibraryStatistics(ElemToolsDataSpan data)
+{
+    SpirvLibraryStatistics result = {};
+
+    if (data.Length < sizeof(ShaderLibraryHeader))
+    {
+        return result;
+    }
+
+    auto header = (const ShaderLibraryHeader*)data.Items;
+    auto shaderEntries = (const ShaderLibraryShaderEntry*)(data.Items + header->ShadersOffset);
+
+    for (uint32_t i = 0; i < header->ShaderCount; i++)
+    {
+        auto code = (const uint32_t*)(data.Items + shaderEntries[i].CodeOffset);
+        auto wordCount = shaderEntries[i].CodeSizeInBytes / sizeof(uint32_t);
+
+        result.CodeSizeInBytes += shaderEntries[i].CodeSizeInBytes;
+
+        for (uint32_t offset = 5; offset < wordCount;)
+        {
+            auto instructionWordCount = code[offset] >> 16;
+            auto opCode = code[offset] & 0xFFFF;
+
+            if (instructionWordCount == 0)
+            {
+                break;
+            }
+
+            if (opCode == 3 || opCode == 5 || opCode == 8)
+            {
+                result.DebugInstructionCount++;
+            }
+
+            offset += instructionWordCount;
+        }
+    }
+
+    return result;
+}
+
+UTEST(ShaderCompiler, CompileShaderLibrary_SpirvOptimization) 
+{
+    // Arrange
+    AddTestFile("HlslTestSource.hlsl", { .Items = (uint8_t*)hlslTestSource, .Length = (uint32_t)strlen(hlslTestSource) });
+    ElemCompileShaderOptions debugOptions = { .DebugMode = true };
+
+    auto debugResult = ElemCompileShaderLibrary(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, "HlslTestSource.hlsl", &debugOptions);
+    auto debugResultHasErrors = debugResult.HasErrors;
+    auto debugStatistics = GetSpirvLibraryStatistics(debugResult.Data);
+
+    // Act
+    auto result = ElemCompileShaderLibrary(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, "HlslTestSource.hlsl", nullptr);
+
+    // Assert
+    ASSERT_FALSE_MSG(debugResultHasErrors, "Debug compilation should not have errors.");
+    ASSERT_FALSE_MSG(result.HasErrors, "Compilation should not have errors.");
+
+    auto sizeMessageCount = 0u;
+
+    for (uint32_t i = 0; i < result.Messages.Length; i++)
+    {
+        if (result.Messages.Items[i].Type == ElemToolsMessageType_Information && strstr(result.Messages.Items[i].Message, "SPIR-V") != nullptr)
+        {
+            sizeMessageCount++;
+        }
+    }
+
+    auto statistics = GetSpirvLibraryStatistics(result.Data);
+
+    ASSERT_EQ_MSG(sizeMessageCount, 3u, "There should be one size message per entry point.");
+    ASSERT_LT_MSG(0u, debugStatistics.DebugInstructionCount, "Debug SPIR-V should contain debug instructions.");
+    ASSERT_LT_MSG(statistics.CodeSizeInBytes, debugStatistics.CodeSizeInBytes, "Optimized SPIR-V should be smaller than the debug SPIR-V.");
+    ASSERT_EQ_MSG(statistics.DebugInstructionCount, 0u, "Optimized SPIR-V should not contain OpName, OpSource or OpLine instructions.");
+}
+
+UTEST(ShaderCompiler, CompileShaderLibraries) 
+{
+    // Arrange
+    AddTestFile("HlslTestSource.hlsl", { .Items = (uint8_t*)hlslTestSource, .Length = (uint32_t)strlen(hlslTestSource) });
+    AddTestFile("HlslTestSourceError.hlsl", { .Items = (uint8_t*)hlslTestSourceError, .Length = (uint32_t)strlen(hlslTestSourceError) });
+
+    ElemCompileShaderLibraryEntry entries[] =
+    {
+        { .Path = "HlslTestSource.hlsl" },
+        { .Path = "HlslTestSourceError.hlsl" },
+        { .Path = "HlslTestSource.hlsl" }
+    };
+
+    // Act
+    auto result = ElemCompileShaderLibraries(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, { .Items = entries, .Length = 3 }, nullptr);
+
+    // Assert
+    ASSERT_TRUE_MSG(result.HasErrors, "Compilation should have errors.");
+    ASSERT_EQ_MSG(result.Results.Length, 3u, "There should be one result per entry.");
+    ASSERT_FALSE_MSG(result.Results.Items[0].HasErrors, "First library should not have errors.");
+    ASSERT_TRUE_MSG(result.Results.Items[1].HasErrors, "Second library should have errors.");
+    ASSERT_FALSE_MSG(result.Results.Items[2].HasErrors, "Third library should not have errors.");
+    ASSERT_GT_MSG(result.Results.Items[0].Data.Length, 0u, "First library should have data.");
+    ASSERT_EQ_MSG(result.Results.Items[0].Data.Length, result.Results.Items[2].Data.Length, "Identical libraries should have the same size.");
+    ASSERT_EQ_MSG(memcmp(result.Results.Items[0].Data.Items, result.Results.Items[2].Data.Items, result.Results.Items[0].Data.Length), 0, "Identical libraries should have the same data.");
+}
+
+UTEST(ShaderCompiler, CompileShaderLibrary_WithDefines) 
+{
+    // Arrange
+    AddTestFile("HlslTestSourcePermutation.hlsl", { .Items = (uint8_t*)hlslTestSourcePermutation, .Length = (uint32_t)strlen(hlslTestSourcePermutation) });
+
+    ElemShaderDefine defines[] = { { .Name = "REQUIRED_DEFINE" }, { .Name = "USE_OFFSET", .Value = "1" } };
+    ElemCompileShaderOptions options = { .Defines = { .Items = defines, .Length = 2 } };
+
+    // Act
+    auto result = ElemCompileShaderLibrary(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, "HlslTestSourcePermutation.hlsl", &options);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Compilation should not have errors.");
+    ASSERT_GT_MSG(result.Data.Length, 0u, "Compilation data should not be empty.");
+}
+
+UTEST(ShaderCompiler, CompileShaderPermutations) 
+{
+    // Arrange
+    AddTestFile("HlslTestSourcePermutation.hlsl", { .Items = (uint8_t*)hlslTestSourcePermutation, .Length = (uint32_t)strlen(hlslTestSourcePermutation) });
+
+    const char* values[] = { "0", "1" };
+
+    ElemShaderPermutationAxis axes[] =
+    {
+        { .Name = "USE_OFFSET", .Values = { .Items = values, .Length = 2 } },
+        { .Name = "UNUSED_DEFINE", .Values = { .Items = values, .Length = 2 } }
+    };
+
+    ElemShaderDefine defines[] = { { .Name = "REQUIRED_DEFINE" } };
+    ElemCompileShaderOptions options = { .Defines = { .Items = defines, .Length = 1 } };
+
+    // Act
+    auto result = ElemCompileShaderPermutations(ElemToolsGraphicsApi_Vulkan, ElemToolsPlatform_Linux, "HlslTestSourcePermutation.hlsl", { .Items = axes, .Length = 2 }, &options);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Compilation should not have errors.");
+
+    auto header = (const ShaderLibraryHeader*)result.Data.Items;
+    ASSERT_EQ_MSG(memcmp(header->FileId, "ELEMSLIB", 8), 0, "Shader signature is wrong.");
+    ASSERT_EQ_MSG(header->PermutationCount, 4u, "Permutation count is wrong.");
+    ASSERT_EQ_MSG(header->FunctionCount, 1u, "Function count is wrong.");
+
+    // NOTE: UNUSED_DEFINE doesn't change the code so only the USE_OFFSET permutations are stored.
+    ASSERT_EQ_MSG(header->ShaderCount, 2u, "Identical shaders should be stored once.");
+
+    auto permutationTable = (const uint32_t*)(result.Data.Items + header->PermutationTableOffset);
+    ASSERT_EQ_MSG(permutationTable[0], permutationTable[2], "Permutations that only differ by UNUSED_DEFINE should share their shader.");
+    ASSERT_NE_MSG(permutationTable[0], permutationTable[1], "Permutations that differ by USE_OFFSET should not share their shader.");
+}
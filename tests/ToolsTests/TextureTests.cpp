@@ -0,0 +1,587 @@
+#include "ToolsTests.h"
+#include "utest.h"
+#include <string.h>
+#include <math.h>
+
+#define TEST_TEXTURE_MAX_TEXTURE_COUNT 8
+
+struct TestBuildTextureResults
+{
+    uint32_t Indices[TEST_TEXTURE_MAX_TEXTURE_COUNT];
+    ElemToolsGraphicsFormat Formats[TEST_TEXTURE_MAX_TEXTURE_COUNT];
+    uint32_t MipCounts[TEST_TEXTURE_MAX_TEXTURE_COUNT];
+    uint32_t MipDataSizes[TEST_TEXTURE_MAX_TEXTURE_COUNT];
+    bool HasErrors[TEST_TEXTURE_MAX_TEXTURE_COUNT];
+    uint32_t Count;
+};
+
+// NOTE: Uncompressed 32 bits TGA with a bottom left origin.
+ElemToolsDataSpan TestBuildTgaFile(uint8_t* destination, uint32_t width, uint32_t height)
+{
+    memset(destination, 0, 18);
+    destination[2] = 2;
+    destination[12] = width & 0xFF;
+    destination[13] = (width >> 8) & 0xFF;
+    destination[14] = height & 0xFF;
+    destination[15] = (height >> 8) & 0xFF;
+    destination[16] = 32;
+    destination[17] = 8;
+
+    auto pixels = destination + 18;
+
+    for (uint32_t i = 0; i < width * height; i++)
+    {
+        pixels[i * 4 + 0] = (uint8_t)(i * 3);
+        pixels[i * 4 + 1] = (uint8_t)(i * 5);
+        pixels[i * 4 + 2] = (uint8_t)(i * 7);
+        pixels[i * 4 + 3] = 255;
+    }
+
+    return { .Items = destination, .Length = 18 + width * height * 4 };
+}
+
+void TestBuildTextureHandler(const ElemBuildTextureResult* result, void* payload)
+{
+    auto results = (TestBuildTextureResults*)payload;
+    auto index = results->Count++;
+
+    results->Indices[index] = result->Index;
+    results->Formats[index] = result->Format;
+    results->MipCounts[index] = result->MipData.Length;
+    results->HasErrors[index] = result->HasErrors;
+
+    for (uint32_t i = 0; i < result->MipData.Length; i++)
+    {
+        results->MipDataSizes[index] += result->MipData.Items[i].Data.Length;
+    }
+}
+
+UTEST(TextureBuilder, BuildTextures)
+{
+    // Arrange
+    uint8_t textureData[18 + 8 * 8 * 4];
+    AddTestFile("BuildTextures.tga", TestBuildTgaFile(textureData, 8, 8));
+
+    ElemBuildTextureEntry entries[] =
+    {
+        { .Path = "BuildTextures.tga" },
+        { .Path = "BuildTextures_Missing.tga" },
+        { .Path = "BuildTextures.tga", .Format = ElemToolsGraphicsFormat_R8G8B8A8 }
+    };
+
+    TestBuildTextureResults results = {};
+
+    ElemBuildTexturesOptions options =
+    {
+        .MaxTextureCountInFlight = 2,
+        .BuildTextureHandler = TestBuildTextureHandler,
+        .BuildTextureHandlerPayload = &results
+    };
+
+    // Act
+    auto result = ElemBuildTextures({ .Items = entries, .Length = 3 }, &options);
+
+    // Assert
+    ASSERT_TRUE_MSG(result.HasErrors, "Build textures should have errors.");
+    ASSERT_EQ_MSG(result.BuiltTextureCount, 2u, "Built texture count doesn't match.");
+    ASSERT_EQ_MSG(results.Count, 3u, "Handler should be called for each entry.");
+
+    for (uint32_t i = 0; i < results.Count; i++)
+    {
+        ASSERT_EQ_MSG(results.Indices[i], i, "Handler should be called in the entries order.");
+    }
+
+    ASSERT_FALSE_MSG(results.HasErrors[0], "First texture should be built.");
+    ASSERT_EQ_MSG(results.Formats[0], ElemToolsGraphicsFormat_BC7, "Default format should be BC7.");
+    ASSERT_EQ_MSG(results.MipCounts[0], 4u, "Mip count doesn't match.");
+    ASSERT_EQ_MSG(results.MipDataSizes[0], 64u + 16u + 16u + 16u, "Compressed size doesn't match.");
+
+    ASSERT_TRUE_MSG(results.HasErrors[1], "Missing texture should have errors.");
+
+    ASSERT_FALSE_MSG(results.HasErrors[2], "Third texture should be built.");
+    ASSERT_EQ_MSG(results.Formats[2], ElemToolsGraphicsFormat_R8G8B8A8, "Format doesn't match.");
+    ASSERT_EQ_MSG(results.MipCounts[2], 4u, "Mip count doesn't match.");
+    ASSERT_EQ_MSG(results.MipDataSizes[2], (8u * 8u + 4u * 4u + 2u * 2u + 1u) * 4u, "Uncompressed size doesn't match.");
+}
+
+UTEST(TextureBuilder, BuildTextures_WithoutHandler)
+{
+    // Arrange
+    ElemBuildTextureEntry entries[] = { { .Path = "BuildTextures.tga" } };
+
+    // Act
+    auto result = ElemBuildTextures({ .Items = entries, .Length = 1 }, nullptr);
+
+    // Assert
+    ASSERT_TRUE_MSG(result.HasErrors, "Build textures should have errors.");
+}
+
+UTEST(TextureBuilder, BuildTextures_BlockFormats)
+{
+    // Arrange
+    uint8_t textureData[18 + 8 * 8 * 4];
+    AddTestFile("BuildTextures_BlockFormats.tga", TestBuildTgaFile(textureData, 8, 8));
+
+    ElemBuildTextureEntry entries[] =
+    {
+        { .Path = "BuildTextures_BlockFormats.tga", .Format = ElemToolsGraphicsFormat_BC1 },
+        { .Path = "BuildTextures_BlockFormats.tga", .Format = ElemToolsGraphicsFormat_BC3 },
+        { .Path = "BuildTextures_BlockFormats.tga", .Format = ElemToolsGraphicsFormat_BC4 },
+        { .Path = "BuildTextures_BlockFormats.tga", .Format = ElemToolsGraphicsFormat_BC5 },
+        { .Path = "BuildTextures_BlockFormats.tga", .Format = ElemToolsGraphicsFormat_BC6H }
+    };
+
+    // NOTE: 8x8 texture, 4 blocks for the first mip and 1 block for the 3 others.
+    uint32_t expectedSizes[] = { 7u * 8u, 7u * 16u, 7u * 8u, 7u * 16u, 7u * 16u };
+
+    TestBuildTextureResults results = {};
+
+    ElemBuildTexturesOptions options =
+    {
+        .BuildTextureHandler = TestBuildTextureHandler,
+        .BuildTextureHandlerPayload = &results
+    };
+
+    // Act
+    auto result = ElemBuildTextures({ .Items = entries, .Length = 5 }, &options);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Build textures should not have errors.");
+    ASSERT_EQ_MSG(results.Count, 5u, "Handler should be called for each entry.");
+
+    for (uint32_t i = 0; i < results.Count; i++)
+    {
+        ASSERT_FALSE_MSG(results.HasErrors[i], "Texture should be built.");
+        ASSERT_EQ_MSG(results.Formats[i], entries[i].Format, "Format doesn't match.");
+        ASSERT_EQ_MSG(results.MipDataSizes[i], expectedSizes[i], "Compressed size doesn't match.");
+    }
+}
+
+UTEST(TextureProcessing, CompressTextureMipData_BC6H)
+{
+    // Arrange
+    float pixels[4 * 4 * 4];
+
+    for (uint32_t i = 0; i < 4 * 4 * 4; i++)
+    {
+        pixels[i] = 1.0f;
+    }
+
+    ElemTextureMipData mipData = { .Width = 4, .Height = 4, .Data = { .Items = (uint8_t*)pixels, .Length = sizeof(pixels) } };
+    ElemCompressTextureMipDataOptions options = { .SourceFormat = ElemToolsGraphicsFormat_R32G32B32A32_FLOAT };
+
+    // Act
+    auto result = ElemCompressTextureMipData(ElemToolsGraphicsFormat_BC6H, &mipData, &options);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Compress mip data should not have errors.");
+    ASSERT_EQ_MSG(result.MipData.Data.Length, 16u, "Compressed size doesn't match.");
+
+    auto blockData = result.MipData.Data.Items;
+    auto redEndpoint = (((uint32_t)blockData[0] >> 5) | ((uint32_t)blockData[1] << 3)) & 0x3FF;
+
+    // NOTE: Mode 11 and 1.0 (0x3C00 in half) quantized on 10 bits.
+    ASSERT_EQ_MSG(blockData[0] & 0x1Fu, 0x03u, "Block mode doesn't match.");
+    ASSERT_EQ_MSG(redEndpoint, 0x3C00u / 31u, "Red endpoint doesn't match.");
+}
+
+uint32_t TestReadBlockBits(const uint8_t* block, uint32_t* bitOffset, uint32_t bitCount)
+{
+    auto value = 0u;
+
+    for (uint32_t i = 0; i < bitCount; i++)
+    {
+        auto bitIndex = *bitOffset + i;
+        value |= ((block[bitIndex / 8] >> (bitIndex % 8)) & 1u) << i;
+    }
+
+    *bitOffset += bitCount;
+    return value;
+}
+
+void TestDecodeBC1Color(uint16_t color, float* destination)
+{
+    auto red = (color >> 11) & 0x1F;
+    auto green = (color >> 5) & 0x3F;
+    auto blue = color & 0x1F;
+
+    destination[0] = (float)((red << 3) | (red >> 2));
+    destination[1] = (float)((green << 2) | (green >> 4));
+    destination[2] = (float)((blue << 3) | (blue >> 2));
+}
+
+void TestDecodeBC1Block(const uint8_t* block, float (*pixels)[3])
+{
+    uint16_t colors[2];
+    memcpy(colors, block, sizeof(colors));
+
+    float palette[4][3];
+    TestDecodeBC1Color(colors[0], palette[0]);
+    TestDecodeBC1Color(colors[1], palette[1]);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        if (colors[0] > colors[1])
+        {
+            palette[2][i] = (2.0f * palette[0][i] + palette[1][i]) / 3.0f;
+            palette[3][i] = (palette[0][i] + 2.0f * palette[1][i]) / 3.0f;
+        }
+        else
+        {
+            palette[2][i] = (palette[0][i] + palette[1][i]) / 2.0f;
+            palette[3][i] = 0.0f;
+        }
+    }
+
+    auto bitOffset = 32u;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        memcpy(pixels[i], palette[TestReadBlockBits(block, &bitOffset, 2)], sizeof(float) * 3);
+    }
+}
+
+void TestDecodeBC4Block(const uint8_t* block, float (*pixels)[3], uint32_t channel)
+{
+    float palette[8] = { (float)block[0], (float)block[1] };
+
+    for (uint32_t i = 1; i < 7; i++)
+    {
+        if (block[0] > block[1])
+        {
+            palette[i + 1] = ((7 - i) * palette[0] + i * palette[1]) / 7.0f;
+        }
+        else if (i < 5)
+        {
+            palette[i + 1] = ((5 - i) * palette[0] + i * palette[1]) / 5.0f;
+        }
+    }
+
+    if (block[0] <= block[1])
+    {
+        palette[6] = 0.0f;
+        palette[7] = 255.0f;
+    }
+
+    auto bitOffset = 16u;
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        pixels[i][channel] = palette[TestReadBlockBits(block, &bitOffset, 3)];
+    }
+}
+
+// NOTE: Only decodes the mode 11 (one region, 10 bits endpoints) of the unsigned BC6H format.
+bool TestDecodeBC6HBlock(const uint8_t* block, float (*pixels)[3])
+{
+    const uint32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+    auto bitOffset = 0u;
+
+    if (TestReadBlockBits(block, &bitOffset, 5) != 0x03)
+    {
+        return false;
+    }
+
+    uint32_t endpoints[2][3];
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            auto value = TestReadBlockBits(block, &bitOffset, 10);
+            endpoints[i][j] = value == 0 ? 0 : (value == 0x3FF ? 0xFFFF : ((value << 16) + 0x8000) >> 10);
+        }
+    }
+
+    for (uint32_t i = 0; i < 16; i++)
+    {
+        auto weight = weights[TestReadBlockBits(block, &bitOffset, i == 0 ? 3 : 4)];
+
+        for (uint32_t j = 0; j < 3; j++)
+        {
+            auto value = ((64 - weight) * endpoints[0][j] + weight * endpoints[1][j] + 32) >> 6;
+            pixels[i][j] = TestDecodeHalf((uint16_t)((value * 31) >> 6));
+        }
+    }
+
+    return true;
+}
+
+// NOTE: The colors follow a line inside each block so the error mostly comes from the endpoint quantization.
+void TestGetBlockCompressionSourceColor(uint32_t x, uint32_t y, bool isHdr, float* destination)
+{
+    if (isHdr)
+    {
+        auto value = 0.25f + (x + y * 8) * (3.75f / 63.0f);
+
+        destination[0] = value;
+        destination[1] = value * 0.5f;
+        destination[2] = value * 0.25f;
+        destination[3] = 1.0f;
+    }
+    else
+    {
+        destination[0] = 16.0f + x * 28.0f;
+        destination[1] = 32.0f + x * 20.0f;
+        destination[2] = 224.0f - x * 24.0f;
+        destination[3] = 255.0f;
+    }
+}
+
+struct TextureProcessing_CompressTextureMipDataRoundTrip
+{
+    ElemToolsGraphicsFormat Format;
+    uint32_t ChannelCount;
+    float Tolerance;
+};
+
+UTEST_F_SETUP(TextureProcessing_CompressTextureMipDataRoundTrip)
+{
+}
+
+UTEST_F_TEARDOWN(TextureProcessing_CompressTextureMipDataRoundTrip)
+{
+    // Arrange
+    const uint32_t textureSize = 8;
+
+    auto isHdr = utest_fixture->Format == ElemToolsGraphicsFormat_BC6H;
+    float sourceColors[textureSize * textureSize][4];
+    float floatPixels[textureSize * textureSize * 4];
+    uint8_t pixels[textureSize * textureSize * 4];
+
+    for (uint32_t i = 0; i < textureSize * textureSize; i++)
+    {
+        TestGetBlockCompressionSourceColor(i % textureSize, i / textureSize, isHdr, sourceColors[i]);
+
+        for (uint32_t j = 0; j < 4; j++)
+        {
+            floatPixels[i * 4 + j] = sourceColors[i][j];
+            pixels[i * 4 + j] = (uint8_t)sourceColors[i][j];
+        }
+    }
+
+    ElemTextureMipData mipData =
+    {
+        .Width = textureSize,
+        .Height = textureSize,
+        .Data = isHdr ? ElemToolsDataSpan { .Items = (uint8_t*)floatPixels, .Length = sizeof(floatPixels) } : ElemToolsDataSpan { .Items = pixels, .Length = sizeof(pixels) }
+    };
+
+    ElemCompressTextureMipDataOptions options = { .SourceFormat = isHdr ? ElemToolsGraphicsFormat_R32G32B32A32_FLOAT : ElemToolsGraphicsFormat_R8G8B8A8 };
+
+    // Act
+    auto result = ElemCompressTextureMipData(utest_fixture->Format, &mipData, &options);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Compress mip data should not have errors.");
+
+    auto blockCountPerRow = textureSize / 4;
+    auto blockSize = result.MipData.Data.Length / (blockCountPerRow * blockCountPerRow);
+    auto maxError = 0.0f;
+
+    for (uint32_t i = 0; i < blockCountPerRow * blockCountPerRow; i++)
+    {
+        auto block = result.MipData.Data.Items + i * blockSize;
+        float decodedPixels[16][3] = {};
+
+        switch (utest_fixture->Format)
+        {
+            case ElemToolsGraphicsFormat_BC1:
+                TestDecodeBC1Block(block, decodedPixels);
+                break;
+
+            case ElemToolsGraphicsFormat_BC5:
+                TestDecodeBC4Block(block, decodedPixels, 0);
+                TestDecodeBC4Block(block + 8, decodedPixels, 1);
+                break;
+
+            default:
+                ASSERT_TRUE_MSG(TestDecodeBC6HBlock(block, decodedPixels), "Block mode doesn't match.");
+                break;
+        }
+
+        for (uint32_t j = 0; j < 16; j++)
+        {
+            auto x = (i % blockCountPerRow) * 4 + j % 4;
+            auto y = (i / blockCountPerRow) * 4 + j / 4;
+            auto sourceColor = sourceColors[y * textureSize + x];
+
+            for (uint32_t k = 0; k < utest_fixture->ChannelCount; k++)
+            {
+                auto error = fabsf(decodedPixels[j][k] - sourceColor[k]);
+
+                // NOTE: HDR values are compared with a relative error.
+                if (isHdr)
+                {
+                    error /= sourceColor[k];
+                }
+
+                maxError = fmaxf(maxError, error);
+            }
+        }
+    }
+
+    ASSERT_LE_MSG(maxError, utest_fixture->Tolerance, "Decoded pixels are too far from the source pixels.");
+}
+
+UTEST_F(TextureProcessing_CompressTextureMipDataRoundTrip, BC1)
+{
+    utest_fixture->Format = ElemToolsGraphicsFormat_BC1;
+    utest_fixture->ChannelCount = 3;
+    utest_fixture->Tolerance = 16.0f;
+}
+
+UTEST_F(TextureProcessing_CompressTextureMipDataRoundTrip, BC5)
+{
+    utest_fixture->Format = ElemToolsGraphicsFormat_BC5;
+    utest_fixture->ChannelCount = 2;
+    utest_fixture->Tolerance = 8.0f;
+}
+
+UTEST_F(TextureProcessing_CompressTextureMipDataRoundTrip, BC6H)
+{
+    // NOTE: The mode 11 endpoints keep 10 bits of the half values and the indices have 16 levels.
+    utest_fixture->Format = ElemToolsGraphicsFormat_BC6H;
+    utest_fixture->ChannelCount = 3;
+    utest_fixture->Tolerance = 0.1f;
+}
+
+// NOTE: BC1 DDS file with the DirectX10 header. The data of each slice contains all the mips.
+ElemToolsDataSpan TestBuildDdsFile(uint8_t* destination, uint32_t width, uint32_t height, uint32_t mipCount, uint32_t arraySize, bool isCubemap, uint32_t dataSizeInBytes)
+{
+    uint32_t header[37] = {};
+    header[0] = 0x20534444;
+    header[1] = 124;
+    header[2] = 0x20000;
+    header[3] = height;
+    header[4] = width;
+    header[7] = mipCount;
+    header[21] = 0x30315844;
+    header[32] = 71;
+    header[33] = 3;
+    header[34] = isCubemap ? 0x4 : 0;
+    header[35] = arraySize;
+
+    memcpy(destination, header, sizeof(header));
+    memset(destination + sizeof(header), 0xAB, dataSizeInBytes);
+
+    return { .Items = destination, .Length = (uint32_t)sizeof(header) + dataSizeInBytes };
+}
+
+UTEST(TextureLoader, LoadTexture_DdsCubemap)
+{
+    // Arrange
+    // NOTE: Mips 8x8, 4x4, 2x2 and 1x1 of 8 bytes per BC1 block for the 6 faces.
+    uint8_t textureData[148 + 6 * (32 + 8 + 8 + 8)];
+    AddTestFile("LoadTexture_Cubemap.dds", TestBuildDdsFile(textureData, 8, 8, 4, 1, true, 6 * (32 + 8 + 8 + 8)));
+
+    // Act
+    auto result = ElemLoadTexture("LoadTexture_Cubemap.dds", nullptr);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Load texture should not have errors.");
+    ASSERT_EQ_MSG(result.Format, ElemToolsGraphicsFormat_BC1, "Format doesn't match.");
+    ASSERT_EQ_MSG(result.Type, ElemToolsTextureType_TextureCube, "Texture type doesn't match.");
+    ASSERT_EQ_MSG(result.ArraySize, 6u, "Array size doesn't match.");
+    ASSERT_EQ_MSG(result.MipLevelCount, 4u, "Mip level count doesn't match.");
+    ASSERT_EQ_MSG(result.MipData.Length, 24u, "Mip data count doesn't match.");
+    ASSERT_EQ_MSG(result.MipData.Items[0].Data.Length, 32u, "First mip size doesn't match.");
+    ASSERT_EQ_MSG(result.MipData.Items[3].Data.Length, 8u, "Last mip size doesn't match.");
+    ASSERT_EQ_MSG(result.MipData.Items[4].Width, 8u, "Second face should start with the first mip.");
+}
+
+UTEST(TextureLoader, LoadTexture_DdsTruncated)
+{
+    // Arrange
+    uint8_t textureData[148 + 32];
+    AddTestFile("LoadTexture_Truncated.dds", TestBuildDdsFile(textureData, 8, 8, 4, 2, false, 32));
+
+    // Act
+    auto result = ElemLoadTexture("LoadTexture_Truncated.dds", nullptr);
+
+    // Assert
+    ASSERT_TRUE_MSG(result.HasErrors, "Load texture should have errors.");
+}
+
+UTEST(TextureLoader, LoadTexture_DdsInvalidArraySize)
+{
+    // Arrange
+    // NOTE: The cube array size multiplied by 6 wraps around to 2 slices in 32 bits and the file contains 2 slices.
+    uint8_t textureData[148 + 2 * 32];
+    AddTestFile("LoadTexture_InvalidArraySize.dds", TestBuildDdsFile(textureData, 8, 8, 1, 0x2AAAAAAB, true, 2 * 32));
+
+    // Act
+    auto result = ElemLoadTexture("LoadTexture_InvalidArraySize.dds", nullptr);
+
+    // Assert
+    ASSERT_TRUE_MSG(result.HasErrors, "Load texture should have errors.");
+}
+
+UTEST(TextureLoader, LoadTexture_DdsMipCountClamped)
+{
+    // Arrange
+    // NOTE: An 8x8 texture has at most 4 mips, the other mips declared in the header are ignored.
+    uint8_t textureData[148 + 32 + 8 + 8 + 8];
+    AddTestFile("LoadTexture_MipCountClamped.dds", TestBuildDdsFile(textureData, 8, 8, 32, 1, false, 32 + 8 + 8 + 8));
+
+    // Act
+    auto result = ElemLoadTexture("LoadTexture_MipCountClamped.dds", nullptr);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Load texture should not have errors.");
+    ASSERT_EQ_MSG(result.MipLevelCount, 4u, "Mip level count should be clamped to the texture size.");
+    ASSERT_EQ_MSG(result.MipData.Length, 4u, "Mip data count doesn't match.");
+}
+
+UTEST(TextureContainer, BuildTextureContainer)
+{
+    // Arrange
+    uint8_t mip0[8192];
+    uint8_t mip1[2048];
+    uint8_t mip2[512];
+
+    memset(mip0, 0, sizeof(mip0));
+    memset(mip1, 1, sizeof(mip1));
+    memset(mip2, 2, sizeof(mip2));
+
+    ElemTextureMipData mipData[] =
+    {
+        { .Width = 256, .Height = 128, .Data = { .Items = mip0, .Length = sizeof(mip0) } },
+        { .Width = 128, .Height = 64, .Data = { .Items = mip1, .Length = sizeof(mip1) } },
+        { .Width = 64, .Height = 32, .Data = { .Items = mip2, .Length = sizeof(mip2) } }
+    };
+
+    // Act
+    auto result = ElemBuildTextureContainer(ElemToolsGraphicsFormat_BC1, { .Items = mipData, .Length = 3 }, nullptr);
+
+    // Assert
+    ASSERT_FALSE_MSG(result.HasErrors, "Build texture container should not have errors.");
+    ASSERT_EQ_MSG(memcmp(result.Data.Items, "ELEMTEXC", 8), 0, "Texture container signature is wrong.");
+
+    // NOTE: The header is 40 bytes and each mip entry is 24 bytes with the offset at byte 8.
+    uint64_t mipOffsets[3];
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        memcpy(&mipOffsets[i], result.Data.Items + 40 + i * 24 + 8, sizeof(uint64_t));
+    }
+
+    ASSERT_EQ_MSG(mipOffsets[2], 4096ull, "The smallest mip should be stored first.");
+    ASSERT_EQ_MSG(mipOffsets[1], 4096ull + 512ull, "The mips smaller than the alignment should be packed.");
+    ASSERT_EQ_MSG(mipOffsets[0], 8192ull, "The mips bigger than the alignment should be aligned.");
+    ASSERT_EQ_MSG(result.Data.Length, 16384u, "Texture container size doesn't match.");
+    ASSERT_EQ_MSG(result.Data.Items[mipOffsets[1]], 1u, "Mip data doesn't match.");
+}
+
+UTEST(TextureContainer, BuildTextureContainer_UnsupportedFormat)
+{
+    // Arrange
+    uint8_t pixels[4 * 4 * 4] = {};
+    ElemTextureMipData mipData = { .Width = 4, .Height = 4, .Data = { .Items = pixels, .Length = sizeof(pixels) } };
+
+    // Act
+    auto result = ElemBuildTextureContainer(ElemToolsGraphicsFormat_R8G8B8A8, { .Items = &mipData, .Length = 1 }, nullptr);
+
+    // Assert
+    ASSERT_TRUE_MSG(result.HasErrors, "Build texture container should have errors.");
+}
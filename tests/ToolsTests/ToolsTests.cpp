@@ -1,4 +1,5 @@
 #include "ToolsTests.h"
+#include <math.h>
 
 #define MAX_TEST_FILES 256
 
@@ -42,3 +43,35 @@ void AddTestFile(const char* path, ElemToolsDataSpan data)
 
     GlobalTestFiles[GlobalTestFilesCount++] = fileEntry;
 }
+
+float TestDecodeHalf(uint16_t value)
+{
+    auto exponent = (value >> 10) & 0x1f;
+    auto mantissa = value & 0x3ff;
+    auto sign = (value & 0x8000) ? -1.0f : 1.0f;
+
+    if (exponent == 0)
+    {
+        return sign * ldexpf((float)mantissa, -24);
+    }
+
+    return sign * ldexpf((float)(mantissa + 1024), exponent - 25);
+}
+
+UTEST(Tools, ComputeDataHash)
+{
+    // Arrange
+    uint8_t data[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    uint8_t modifiedData[] = { 1, 2, 3, 4, 5, 6, 7, 9 };
+
+    // Act
+    auto hash = ElemToolsComputeDataHash({ .Items = data, .Length = sizeof(data) }, 0);
+    auto sameHash = ElemToolsComputeDataHash({ .Items = data, .Length = sizeof(data) }, 0);
+    auto modifiedHash = ElemToolsComputeDataHash({ .Items = modifiedData, .Length = sizeof(modifiedData) }, 0);
+    auto seededHash = ElemToolsComputeDataHash({ .Items = data, .Length = sizeof(data) }, hash);
+
+    // Assert
+    ASSERT_EQ_MSG(hash, sameHash, "Hash should be stable for the same data.");
+    ASSERT_NE_MSG(hash, modifiedHash, "Hash should change when the data changes.");
+    ASSERT_NE_MSG(hash, seededHash, "Hash should change when the seed changes.");
+}
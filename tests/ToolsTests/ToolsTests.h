@@ -5,3 +5,4 @@
 
 void ConfigureTestFileIO();
 void AddTestFile(const char* path, ElemToolsDataSpan data);
+float TestDecodeHalf(uint16_t value);
@@ -2,6 +2,7 @@
 #include "ShaderCompilerTests.cpp"
 #include "SceneLoaderTests.cpp"
 #include "MeshBuilderTests.cpp"
+#include "TextureTests.cpp"
 
 UTEST_STATE();
 